@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgreIteratorWrappers.h"
 #include "OgreAnimable.h"
 #include "OgreAnimationTrack.h"
+#include "OgreCompressedNodeAnimationTrack.h"
 #include "OgreAnimationState.h"
 #include "OgreHeaderPrefix.h"
 
@@ -208,9 +209,42 @@ namespace Ogre {
         /** Does a track exist with the given handle? */
         bool hasVertexTrack(unsigned short handle) const;
         
+        /** Creates a CompressedNodeAnimationTrack, to fill in with
+            CompressedNodeAnimationTrack::compress or by a serializer.
+        @param handle Handle to give the track, must be unique within the node
+            and compressed node tracks of this Animation.
+        @param node The Node affected by apply, if any
+        */
+        CompressedNodeAnimationTrack* createCompressedNodeTrack(unsigned short handle,
+            Node* node = 0);
+
+        /** Gets the number of CompressedNodeAnimationTrack objects contained in this animation. */
+        unsigned short getNumCompressedNodeTracks(void) const;
+
+        /** Gets a compressed node track by it's handle. */
+        CompressedNodeAnimationTrack* getCompressedNodeTrack(unsigned short handle) const;
+
+        /** Does a compressed node track exist with the given handle? */
+        bool hasCompressedNodeTrack(unsigned short handle) const;
+
+        /** Replaces every node track by a compressed version of it.
+        @remarks
+            The memory used by the keyframes is released, the compressed
+            tracks are applied with the rest of the animation but cannot be
+            edited (see CompressedNodeAnimationTrack). Any base keyframe is
+            applied first. Tracks which cannot be compressed within the
+            tolerances are kept as they are.
+        @param tolerances The errors allowed when dropping and quantising keys
+        */
+        void compressNodeTracks(const CompressedNodeAnimationTrack::Tolerances& tolerances =
+            CompressedNodeAnimationTrack::Tolerances());
+
         /** Destroys the node track with the given handle. */
         void destroyNodeTrack(unsigned short handle);
 
+        /** Destroys the compressed node track with the given handle. */
+        void destroyCompressedNodeTrack(unsigned short handle);
+
         /** Destroys the numeric track with the given handle. */
         void destroyNumericTrack(unsigned short handle);
 
@@ -222,6 +256,8 @@ namespace Ogre {
 
         /** Removes and destroys all tracks making up this animation. */
         void destroyAllNodeTracks(void);
+        /** Removes and destroys all compressed node tracks of this animation. */
+        void destroyAllCompressedNodeTracks(void);
         /** Removes and destroys all tracks making up this animation. */
         void destroyAllNumericTracks(void);
         /** Removes and destroys all tracks making up this animation. */
@@ -372,6 +408,9 @@ namespace Ogre {
         typedef map<unsigned short, NodeAnimationTrack*>::type NodeTrackList;
         typedef ConstMapIterator<NodeTrackList> NodeTrackIterator;
 
+        typedef map<unsigned short, CompressedNodeAnimationTrack*>::type CompressedNodeTrackList;
+        typedef ConstMapIterator<CompressedNodeTrackList> CompressedNodeTrackIterator;
+
         typedef map<unsigned short, NumericAnimationTrack*>::type NumericTrackList;
         typedef ConstMapIterator<NumericTrackList> NumericTrackIterator;
 
@@ -384,6 +423,14 @@ namespace Ogre {
         /// Get non-updateable iterator over node tracks
         NodeTrackIterator getNodeTrackIterator(void) const
         { return NodeTrackIterator(mNodeTrackList.begin(), mNodeTrackList.end()); }
+
+        /// Fast access to NON-UPDATEABLE compressed node track list
+        const CompressedNodeTrackList& _getCompressedNodeTrackList(void) const
+        { return mCompressedNodeTrackList; }
+
+        /// Get non-updateable iterator over compressed node tracks
+        CompressedNodeTrackIterator getCompressedNodeTrackIterator(void) const
+        { return CompressedNodeTrackIterator(mCompressedNodeTrackList.begin(), mCompressedNodeTrackList.end()); }
         
         /// Fast access to NON-UPDATEABLE numeric track list
         const NumericTrackList& _getNumericTrackList(void) const;
@@ -497,6 +544,16 @@ namespace Ogre {
         
         /// Internal method to adjust keyframes relative to a base keyframe (@see setUseBaseKeyFrame) */
         void _applyBaseKeyFrame();
+
+        /** Internal method building everything the node tracks build on demand
+            when applied: the base keyframe adjustment, the keyframe time list
+            and the interpolation splines.
+        @remarks
+            Once done, and as long as the animation is not modified, the node
+            tracks may be applied to different skeletons from several threads
+            at once.
+        */
+        void _prepareNodeTracks(void);
         
         void _notifyContainer(AnimationContainer* c);
         /** Retrieve the container of this animation. */
@@ -505,6 +562,8 @@ namespace Ogre {
     protected:
         /// Node tracks, indexed by handle
         NodeTrackList mNodeTrackList;
+        /// Compressed node tracks, indexed by handle
+        CompressedNodeTrackList mCompressedNodeTrackList;
         /// Numeric tracks, indexed by handle
         NumericTrackList mNumericTrackList;
         /// Vertex tracks, indexed by handle
@@ -522,6 +581,8 @@ namespace Ogre {
         /// Global keyframe time list used to search global keyframe index.
         typedef vector<Real>::type KeyFrameTimeList;
         mutable KeyFrameTimeList mKeyFrameTimes;
+        /// Cursor used by _getTimeIndex to search mKeyFrameTimes
+        KeyFrameTimeCursor mKeyFrameTimeCursor;
         /// Dirty flag indicate that keyframe time list need to rebuild
         mutable bool mKeyFrameTimesDirty;
 
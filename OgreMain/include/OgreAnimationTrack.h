@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreKeyFrame.h"
 #include "OgreAnimable.h"
 #include "OgrePose.h"
+#include "OgreAtomicScalar.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre 
@@ -100,6 +101,33 @@ namespace Ogre
         }
     };
 
+    /** Searches a sorted list of keyframe times, starting from the result of
+        the previous search.
+    @remarks
+        Playback usually moves forward (or backward) by less than a key
+        between two searches, so the result of the previous search, or the
+        key next to it, is tried before falling back to a binary search. This
+        makes sequential sampling of long tracks amortised O(1).
+    @par
+        The remembered index is only a hint checked before use, so a cursor
+        may be used from several threads at once, the worst case being extra
+        binary searches.
+    */
+    class _OgreExport KeyFrameTimeCursor
+    {
+    public:
+        KeyFrameTimeCursor() : mIndex(0) {}
+
+        /** Returns the index of the first time not less than timePos, as
+            std::lower_bound would.
+        */
+        size_t lowerBound(const vector<Real>::type& times, Real timePos) const;
+
+    protected:
+        /// Result of the previous search
+        mutable AtomicScalar<size_t> mIndex;
+    };
+
     /** A 'track' in an animation sequence, i.e. a sequence of keyframes which affect a
         certain type of animable object.
     @remarks
@@ -242,6 +270,10 @@ namespace Ogre
     protected:
         typedef vector<KeyFrame*>::type KeyFrameList;
         KeyFrameList mKeyFrames;
+        /// Times of mKeyFrames, contiguous for faster searches
+        vector<Real>::type mKeyFrameTimes;
+        /// Cursor used to search mKeyFrameTimes when no global key index is given
+        KeyFrameTimeCursor mKeyFrameTimeCursor;
         Animation* mParent;
 		unsigned short mHandle;
 		Listener* mListener;
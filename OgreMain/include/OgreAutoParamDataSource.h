@@ -56,11 +56,31 @@ namespace Ogre {
         will calculate concatenated matrices etc only when required, passing back precalculated
         matrices when they are requested more than once when the underlying information has
         not altered.
+    @par
+        Each result is only recalculated when one of the inputs it depends on
+        has changed: changing the renderable only fetches its world matrix
+        again, the matrices derived from it are kept when its value is the same
+        as before and the view and projection matrices are kept unless the
+        renderable uses a different identity view or projection setting. Light
+        space matrices are kept while the same light stays at the same index.
+        Everything depending on the camera or the lights is recalculated when
+        the camera is set, so changes made to them during a render must be
+        followed by another call to setCurrentCamera.
     */
 	class _OgreExport AutoParamDataSource : public SceneMgtAlloc
     {
     protected:
 		const Light& getLight(size_t index) const;
+		/// Fetches the world matrices of the current renderable if required
+		void updateWorldMatrix(void) const;
+		/// Invalidates the world dependent matrices if the world matrix changed
+		void worldMatrixUpdated(void) const;
+		/// Invalidates everything derived from the world matrix
+		void markWorldDependentDirty(void) const;
+		/// Invalidates everything derived from the view matrix
+		void markViewDependentDirty(void);
+		/// Invalidates everything derived from the projection matrix
+		void markProjectionDependentDirty(void);
         mutable Matrix4 mWorldMatrix[256];
         mutable size_t mWorldMatrixCount;
         mutable const Matrix4* mWorldMatrixArray;
@@ -111,6 +131,13 @@ namespace Ogre {
 		mutable bool mSceneDepthRangeDirty;
 		mutable bool mLodCameraPositionDirty;
 		mutable bool mLodCameraPositionObjectSpaceDirty;
+		/// Value of the world matrix the world dependent matrices were derived from
+		mutable Matrix4 mLastWorldMatrix;
+		/// Identity view and projection settings of the current renderable
+		bool mUseIdentityView;
+		bool mUseIdentityProjection;
+		/// Lights the spotlight matrices were derived from
+		const Light* mSpotlight[OGRE_MAX_SIMULTANEOUS_LIGHTS];
 
         const Renderable* mCurrentRenderable;
         const Camera* mCurrentCamera;
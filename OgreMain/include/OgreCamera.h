@@ -204,6 +204,8 @@ namespace Ogre {
 
         /** Helper function for forwardIntersect that intersects rays with canonical plane */
         virtual vector<Vector4>::type getRayForwardIntersect(const Vector3& anchor, const Vector3 *dir, Real planeOffset) const;
+        /// @copydoc Frustum::isBatchVisibilityExact
+        bool isBatchVisibilityExact(void) const;
 
     public:
         /** Standard constructor.
@@ -606,6 +608,9 @@ namespace Ogre {
         bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const;
         /// @copydoc Frustum::isVisible(const Vector3&, FrustumPlane*) const
         bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
+        /// @copydoc Frustum::calculateVisibility
+        void calculateVisibility(const AxisAlignedBox* const* bounds, size_t count,
+            uint32* visibility) const;
         /// @copydoc Frustum::getWorldSpaceCorners
         const Vector3* getWorldSpaceCorners(void) const;
         /// @copydoc Frustum::getFrustumPlane
@@ -0,0 +1,206 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __CompressedNodeAnimationTrack_H__
+#define __CompressedNodeAnimationTrack_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreMath.h"
+#include "OgreVector3.h"
+#include "OgreQuaternion.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+	class TimeIndex;
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Animation
+	*  @{
+	*/
+	/** A compact, read only version of a NodeAnimationTrack.
+	@remarks
+		A NodeAnimationTrack stores a whole TransformKeyFrame object per key.
+		This track instead stores translation, rotation and scale separately,
+		each either as a single constant value or as its own list of keys
+		taking 10 bytes each: the time of the key and 3 quantised components.
+		Keys which can be rebuilt by
+		interpolating their neighbours within a given tolerance are dropped,
+		vectors are quantised over the range of the values of the channel and
+		rotations are stored as their 3 smallest components.
+	@par
+		Compressed tracks are owned by an Animation like other tracks (see
+		Animation::compressNodeTracks) and applied with it, but they have no
+		KeyFrame objects: use decompress to get editable keys back. They are
+		always interpolated linearly, rotations along the shortest path and as
+		chosen by Animation::getRotationInterpolationMode.
+	*/
+	class _OgreExport CompressedNodeAnimationTrack : public AnimationAlloc
+	{
+	public:
+		/// Largest errors allowed when dropping keys
+		struct _OgreExport Tolerances
+		{
+			/// Largest distance between a dropped translation and the interpolated one
+			Real translation;
+			/// Largest angle between a dropped rotation and the interpolated one
+			Radian rotation;
+			/// Largest difference between a dropped scale and the interpolated one
+			Real scale;
+
+			Tolerances()
+				: translation(0.001f), rotation(Degree(0.1f)), scale(0.001f) {}
+		};
+
+		/// The channels making up the transform
+		enum ChannelIndex
+		{
+			CI_TRANSLATE = 0,
+			CI_ROTATE = 1,
+			CI_SCALE = 2,
+			CI_COUNT = 3
+		};
+
+		/// How a channel varies over the track
+		enum ChannelType
+		{
+			/// Same value for the whole track, held in Channel::base
+			CT_CONSTANT = 0,
+			/// Quantised keys
+			CT_ANIMATED = 1
+		};
+
+		/** One component of the transform.
+		@remarks
+			keys holds the 3 quantised components of each key, whose time is
+			in times. A translation or scale component is
+			base[i] + key[i] * step[i].
+			A rotation key holds its 3 smallest components mapped from
+			[-1/sqrt(2), 1/sqrt(2)], the 2 top bits of the first 2 giving the
+			index of the largest, positive, component.
+		*/
+		struct Channel
+		{
+			uint16 type;
+			/// Constant value (x, y, z or w, x, y, z), or minimum of the keys
+			float base[4];
+			/// Size of a quantisation step of each component
+			float step[3];
+			/// Time of each key in seconds, as in the source keyframes
+			vector<float>::type times;
+			/// 3 quantised components per key
+			vector<uint16>::type keys;
+
+			Channel() : type(CT_CONSTANT)
+			{
+				base[0] = base[1] = base[2] = base[3] = 0;
+				step[0] = step[1] = step[2] = 0;
+			}
+		};
+
+		/// Constructor, you should use Animation::createCompressedNodeTrack instead
+		CompressedNodeAnimationTrack(Animation* parent, unsigned short handle,
+			Node* targetNode = 0);
+
+		/// Gets the handle associated with this track
+		unsigned short getHandle(void) const { return mHandle; }
+		/// Returns the parent Animation object for this track
+		Animation* getParent(void) const { return mParent; }
+		/// Returns the Node affected by apply, if any
+		Node* getAssociatedNode(void) const { return mTargetNode; }
+		/// Sets the Node affected by apply
+		void setAssociatedNode(Node* node) { mTargetNode = node; }
+
+		/** Replaces the content of this track by a compressed version of
+			the keys of another.
+		@remarks
+			The values interpolated at any key of the source track are within
+			the tolerances of the source ones. Half of each tolerance is left
+			to the quantisation, whose step is 1/65535 of the range of each
+			translation or scale component: a channel moving too far for its
+			tolerance cannot be compressed. Key times are kept as they are.
+		@param track The source track, whose parent should have the same length
+		@param tolerances The errors allowed when dropping and quantising keys
+		@return False, leaving this track unchanged, if a channel cannot be
+			compressed within its tolerance
+		*/
+		bool compress(const NodeAnimationTrack* track,
+			const Tolerances& tolerances = Tolerances());
+
+		/** Creates keyframes in a track, at every time a channel of this one
+			has a key, holding the transforms this track interpolates.
+		@param track An empty track
+		*/
+		void decompress(NodeAnimationTrack* track) const;
+
+		/** Gets the transform of this track at a given time.
+		@param timeIndex The time, the key index is ignored
+		*/
+		void getTransform(const TimeIndex& timeIndex, Vector3& translate,
+			Quaternion& rotate, Vector3& scale) const;
+
+		/// @copydoc NodeAnimationTrack::apply
+		void apply(const TimeIndex& timeIndex, Real weight = 1.0, Real scale = 1.0f);
+
+		/// @copydoc NodeAnimationTrack::applyToNode
+		void applyToNode(Node* node, const TimeIndex& timeIndex, Real weight = 1.0,
+			Real scale = 1.0f);
+
+		/// Returns the number of bytes used by this track
+		size_t getMemoryUsage(void) const;
+
+		/// Gets a channel, for serialisation purposes
+		Channel& _getChannel(ChannelIndex index) { return mChannels[index]; }
+		/// Gets a channel, for serialisation purposes
+		const Channel& _getChannel(ChannelIndex index) const { return mChannels[index]; }
+
+		/// Clone this track (internal use only)
+		CompressedNodeAnimationTrack* _clone(Animation* newParent) const;
+
+	protected:
+		/// Finds the keys around a time, and the position between them
+		void findKeys(const Channel& channel, Real time, size_t& key1,
+			size_t& key2, Real& t) const;
+		/// Gets the value of a translation or scale channel
+		Vector3 sampleVector(const Channel& channel, Real time) const;
+		/// Gets the value of a rotation channel
+		Quaternion sampleRotation(const Channel& channel, Real time) const;
+
+		Animation* mParent;
+		unsigned short mHandle;
+		Node* mTargetNode;
+		Channel mChannels[CI_COUNT];
+	};
+	/** @} */
+	/** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -658,6 +658,36 @@ namespace Ogre {
         void close(void);
 
 	};
+
+	/** Subclass of MemoryDataStream giving read-only access to a file by
+		mapping it into memory.
+	@remarks
+		The contents of the file are paged in by the operating system as they
+		are accessed instead of being read into a heap allocation. Since this
+		is a MemoryDataStream, code which needs the whole stream in memory can
+		use the mapping in place (see MemoryDataStream::getPtr) rather than
+		copying it; the memory must not be written to.
+	@par
+		The file must not be truncated while it is mapped. Mapping files is
+		only supported on some platforms, see isSupported.
+	*/
+	class _OgreExport MMapDataStream : public MemoryDataStream
+	{
+	public:
+		/** Maps a file into memory.
+		@param name The name to give the stream
+		@param path The path of the file to map
+		*/
+		MMapDataStream(const String& name, const String& path);
+		~MMapDataStream();
+
+		/// Returns whether files can be mapped on this platform
+		static bool isSupported(void);
+
+		/** @copydoc DataStream::close
+		*/
+		void close(void);
+	};
 	/** @} */
 	/** @} */
 }
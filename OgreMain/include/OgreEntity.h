@@ -89,6 +89,34 @@ namespace Ogre {
         typedef set<Entity*>::type EntitySet;
         typedef map<unsigned short, bool>::type SchemeHardwareAnimMap;
 
+        /// A level of detail of the skeletal animation, see setAnimationLodLevels
+        struct AnimationLodLevel
+        {
+            AnimationLodLevel()
+                : userValue(0), updateInterval(1), interpolate(false)
+            {
+            }
+
+            /** Value from which this level applies, in the units of the LOD
+                strategy of the mesh (e.g. a distance), as given to
+                Mesh::setLodLevels.
+            */
+            Real userValue;
+            /// Number of frames between two evaluations of the skeleton, 1 for every frame
+            unsigned short updateInterval;
+            /** Whether the bone matrices are interpolated between the two last
+                evaluations on the skipped frames rather than held, which is
+                smoother but lags one update interval behind.
+            */
+            bool interpolate;
+            /** Handles of the bones which are no longer animated, keeping their
+                binding pose relative to their parent (e.g. fingers, face).
+                Their children are still animated unless listed too.
+            */
+            vector<unsigned short>::type disabledBones;
+        };
+        typedef vector<AnimationLodLevel>::type AnimationLodLevelList;
+
     protected:
 
         /** Private constructor (instances cannot be created directly).
@@ -225,6 +253,46 @@ namespace Ogre {
         bool mSkipAnimStateUpdates;
         /// Flag indicating whether to update the main entity skeleton even when an LOD is displayed.
         bool mAlwaysUpdateMainSkeleton;
+        /// Flag indicating whether software skinning blends dual quaternions rather than matrices.
+        bool mSoftwareDualQuaternionSkinning;
+        /// Bone matrices converted for software dual quaternion skinning, never shared.
+        DualQuaternion* mBoneDualQuaternions;
+
+        /// Levels of detail of the skeletal animation, see setAnimationLodLevels.
+        AnimationLodLevelList mAnimationLodLevels;
+        /// Bones disabled by each animation LOD level.
+        vector<Skeleton::BoneMask>::type mAnimationLodBoneMasks;
+        /// Animation LOD values transformed by the mesh LOD strategy, the first being its base value.
+        Mesh::LodValueList mAnimationLodValues;
+        /// Current animation LOD index, 0 for full detail.
+        ushort mAnimationLodIndex;
+        /// Frame the animation LOD index was computed for.
+        unsigned long mAnimationLodFrame;
+        /// Offset spreading the skeleton evaluations of the entities across the frames.
+        unsigned long mAnimationLodPhase;
+        /// Frame of the last evaluation of the skeleton.
+        unsigned long mAnimationLodEvaluatedFrame;
+        /// Frames of the two evaluations in mAnimationLodPoses, the previous then the last.
+        unsigned long mAnimationLodPoseFrames[2];
+        /// Decomposed bone matrix, blended by the animation LOD.
+        struct AnimationLodBonePose
+        {
+            Vector3 position;
+            Vector3 scale;
+            Quaternion orientation;
+        };
+        typedef vector<AnimationLodBonePose>::type AnimationLodBonePoseList;
+        /// Bones of the two last evaluations, the previous then the last, interpolated on skipped frames.
+        AnimationLodBonePoseList mAnimationLodPoses;
+
+        /// Computes the animation LOD index for the current camera.
+        void updateAnimationLodIndex(Real lodValue);
+        /// Returns whether the current animation LOD may skip frames.
+        bool isAnimationLodSkippingFrames(void) const;
+        /// Returns whether the skeleton is not evaluated this frame because of the animation LOD.
+        bool isAnimationLodFrameSkipped(void) const;
+        /// Interpolates the bone matrices between the two last evaluations if required.
+        void updateAnimationLodPose(void);
 
 
         /// The LOD number of the mesh to use, calculated by _notifyCurrentCamera.
@@ -606,6 +674,37 @@ namespace Ogre {
         const Matrix4* _getBoneMatrices(void) const { return mBoneMatrices;}
         /** Internal method for retrieving bone matrix information. */
         unsigned short _getNumBoneMatrices(void) const { return mNumBoneMatrices; }
+        /** Returns whether this entity is skeletally animated, in the scene and
+            visible, and its bone matrices are not up to date for the next frame.
+        */
+        bool _isBoneMatricesUpdatePending(void) const;
+        /** Evaluates the bone matrices of this entity for the next frame, as
+            rendering it would, updating its bones and tag points.
+        @note
+            Internal method, which does not use the SkeletonPoseCache and may
+            therefore be called from several threads at once for entities not
+            sharing their skeleton instance, once Animation::_prepareNodeTracks
+            has been called on the animations they play.
+        */
+        void _evaluateBoneMatrices(void);
+        /** Returns whether the bone matrices of this entity for the next frame
+            may be evaluated by a SkeletonPoseBatch or shared through a
+            SkeletonPoseCache.
+        @remarks
+            False if they are already up to date, or if the bones of the
+            skeleton instance are needed for something else than skinning:
+            manually controlled bones, objects attached to bones, skeleton
+            display or skipped animation state updates, on this entity or on
+            any entity sharing its skeleton instance.
+        */
+        bool _isSkeletonPoseBatchable(void) const;
+        /** Adds the evaluation of the bone matrices of this entity for the
+            next frame to a batch, and marks them as up to date.
+        @param batch Batch for the skeleton of the mesh of this entity.
+        @param cache If not null, the pose is shared through this cache.
+        @note Only valid if _isSkeletonPoseBatchable returns true.
+        */
+        void _addToSkeletonPoseBatch(SkeletonPoseBatch* batch, SkeletonPoseCache* cache = 0);
         /** Returns whether or not this entity is skeletally animated. */
         bool hasSkeleton(void) const { return mSkeletonInstance != 0; }
         /** Get this Entity's personal skeleton instance. */
@@ -853,6 +952,58 @@ namespace Ogre {
             return mAlwaysUpdateMainSkeleton;
         }
 
+        /** Sets whether software skinning blends the bones as dual quaternions
+            rather than as matrices.
+        @remarks
+            Dual quaternion skinning keeps the volume of twisted and bent joints,
+            it gives the same results as the dual quaternion skinning shaders and
+            should be enabled when such a shader is used, so that the software
+            blended geometry (e.g. for stencil shadows) matches the rendered one.
+            Scales of the bones are ignored. Only affects software skinning.
+        @note Disabled by default
+        */
+        void setSoftwareDualQuaternionSkinning(bool enabled) {
+            mSoftwareDualQuaternionSkinning = enabled;
+        }
+
+        /// Gets whether software skinning blends the bones as dual quaternions
+        bool getSoftwareDualQuaternionSkinning() const {
+            return mSoftwareDualQuaternionSkinning;
+        }
+
+        /** Sets the levels of detail of the skeletal animation.
+        @remarks
+            The LOD values given by the LOD strategy of the mesh select the
+            level, the most detailed one applying to any camera rendering the
+            entity in the frame being used. Below the value of the first level
+            the skeleton is fully evaluated every frame. Less detailed levels
+            evaluate it less often and stop animating some bones, so that
+            large crowds can be animated for a fraction of the cost.
+        @par
+            Frames are only skipped when the bones are used for skinning
+            alone: not when the skeleton instance is shared, has manually
+            controlled bones, is displayed, has objects attached or when
+            animation state updates are skipped. Entities evaluate their
+            skeletons on different frames so that the cost is spread evenly.
+            The levels are ignored while the skeleton instance is shared.
+        @param levels Levels from the most to the least detailed, their user
+            values being sorted as the LOD strategy requires. Empty to always
+            animate at full detail.
+        */
+        void setAnimationLodLevels(const AnimationLodLevelList& levels);
+
+        /// Gets the levels of detail of the skeletal animation
+        const AnimationLodLevelList& getAnimationLodLevels(void) const {
+            return mAnimationLodLevels;
+        }
+
+        /** Gets the current level of detail of the skeletal animation, 0 for
+            full detail, otherwise 1 + the index of the level applied.
+        */
+        ushort getCurrentAnimationLodIndex(void) const {
+            return mAnimationLodIndex;
+        }
+
         
     };
 
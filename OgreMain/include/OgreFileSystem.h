@@ -120,7 +120,27 @@ namespace Ogre {
             return msIgnoreHidden;
         }
 
+        /** Set whether files opened read-only are mapped into memory.
+        @remarks
+            When enabled, open returns an MMapDataStream for files opened
+            read-only, which loaders wanting the whole file in memory use in
+            place instead of copying it. Files must then not be truncated
+            while they are open. Falls back on regular streams if the file
+            cannot be mapped. The default is false.
+        */
+        static void setUseMemoryMapping(bool use)
+        {
+            msUseMemoryMapping = use;
+        }
+
+        /// Get whether files opened read-only are mapped into memory.
+        static bool getUseMemoryMapping()
+        {
+            return msUseMemoryMapping;
+        }
+
         static bool msIgnoreHidden;
+        static bool msUseMemoryMapping;
     };
 
     /** Specialisation of ArchiveFactory for FileSystem files. */
@@ -192,6 +192,16 @@ namespace Ogre
         /// Record of the last world-space oblique depth projection plane info used
         mutable Plane mLastLinkedObliqueProjPlane;
 
+        /** Whether isVisible(const AxisAlignedBox&, FrustumPlane*) is the plane
+            test of this class, which calculateVisibility then runs on several
+            boxes at once.
+        @remarks
+            Only true for objects of the class itself, so that subclasses which
+            override isVisible have their boxes tested one at a time with it.
+            Subclasses keeping the test of their base class can override this.
+        */
+        virtual bool isBatchVisibilityExact(void) const;
+
     public:
 
         /// Named constructor
@@ -469,6 +479,23 @@ namespace Ogre
         */
         virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
 
+        /** Tests whether each of a batch of bounding boxes is visible in the Frustum.
+        @remarks
+            Gives the same results as calling isVisible for each box, but tests
+            several boxes at once with SIMD instructions where available.
+            Subclasses which override isVisible(const AxisAlignedBox&, FrustumPlane*)
+            but not this method get their isVisible called for each box.
+        @param bounds
+            Pointers to the bounding boxes to be checked (world space).
+        @param count
+            Number of boxes.
+        @param visibility
+            Receives one bit per box, bit i % 32 of entry i / 32 being set if
+            box i is visible. The (count + 31) / 32 entries are overwritten.
+        */
+        virtual void calculateVisibility(const AxisAlignedBox* const* bounds, size_t count,
+            uint32* visibility) const;
+
         /// Overridden from MovableObject::getTypeFlags
         uint32 getTypeFlags(void) const;
 
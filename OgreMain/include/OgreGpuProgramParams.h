@@ -1282,6 +1282,65 @@ namespace Ogre {
 		bool mIgnoreMissingParams;
 		/// physical index for active pass iteration parameter real constant entry;
 		size_t mActivePassIterationIndex;
+		/** Constants changed since the last _clearDirtyRanges, one bit per
+			constant so that separate changes do not flag what lies between.
+		*/
+		struct DirtyConstants
+		{
+			vector<uint32>::type bits;
+			/// Range holding all the bits set, empty if begin >= end
+			size_t begin;
+			size_t end;
+
+			DirtyConstants() : begin(0), end(0) {}
+
+			/// Flags count constants from first
+			void mark(size_t first, size_t count)
+			{
+				size_t last = first + count;
+				if (bits.size() * 32 < last)
+					bits.resize((last + 31) / 32, 0);
+				for (size_t i = first; i < last; ++i)
+					bits[i >> 5] |= 1u << (i & 31);
+				if (begin >= end)
+				{
+					begin = first;
+					end = last;
+				}
+				else
+				{
+					begin = std::min(begin, first);
+					end = std::max(end, last);
+				}
+			}
+			/// Returns whether any of count constants from first is flagged
+			bool isDirty(size_t first, size_t count) const
+			{
+				size_t last = std::min(first + count, end);
+				for (size_t i = std::max(first, begin); i < last; ++i)
+				{
+					if (bits[i >> 5] & (1u << (i & 31)))
+						return true;
+				}
+				return false;
+			}
+			/// Flags every one of size constants
+			void markAll(size_t size)
+			{
+				bits.assign((size + 31) / 32, 0xFFFFFFFF);
+				begin = 0;
+				end = size;
+			}
+			/// Flags nothing, only touching the words which may be set
+			void clear(void)
+			{
+				if (begin < end)
+					std::fill(bits.begin() + (begin >> 5), bits.begin() + ((end + 31) >> 5), 0);
+				begin = end = 0;
+			}
+		};
+		DirtyConstants mFloatDirty;
+		DirtyConstants mIntDirty;
 
 		/** Gets the low-level structure for a logical index. 
 		*/
@@ -1612,6 +1671,79 @@ namespace Ogre {
 		int* getIntPointer(size_t pos) { return &mIntConstants[pos]; }
 		/// Get a pointer to the 'nth' item in the int buffer
 		const int* getIntPointer(size_t pos) const { return &mIntConstants[pos]; }
+
+		/** Returns whether any of count float constants from a physical index
+			changed since the dirty ranges were last cleared.
+		@remarks
+			The _writeRawConstant methods, which all the setConstant and auto
+			constant updates go through, only flag the values which actually
+			change. Values written through getFloatPointer or getIntPointer
+			are not tracked, call _markAllDirty after doing so.
+		*/
+		bool isFloatRangeDirty(size_t physicalIndex, size_t count) const
+		{
+			return mFloatDirty.isDirty(physicalIndex, count);
+		}
+		/** Returns whether any of count int constants from a physical index
+			changed since the dirty ranges were last cleared.
+		*/
+		bool isIntRangeDirty(size_t physicalIndex, size_t count) const
+		{
+			return mIntDirty.isDirty(physicalIndex, count);
+		}
+		/// Returns whether any constant changed since the dirty ranges were last cleared
+		bool hasDirtyConstants(void) const
+		{
+			return mFloatDirty.begin < mFloatDirty.end || mIntDirty.begin < mIntDirty.end;
+		}
+		/** Returns whether a render system binding these parameters with a 
+			variability mask must upload a low-level float constant.
+		@remarks
+			When the mask includes GPV_GLOBAL the program may just have been
+			bound, so every constant of a matching variability must be uploaded.
+			Otherwise those which have not changed since the last upload can be
+			skipped, since the program still holds their values.
+		*/
+		bool _isFloatUploadRequired(const GpuLogicalIndexUse& use, uint16 mask) const
+		{
+			return (use.variability & mask) && ((mask & (uint16)GPV_GLOBAL) ||
+				isFloatRangeDirty(use.physicalIndex, use.currentSize));
+		}
+		/// @copydoc _isFloatUploadRequired
+		bool _isIntUploadRequired(const GpuLogicalIndexUse& use, uint16 mask) const
+		{
+			return (use.variability & mask) && ((mask & (uint16)GPV_GLOBAL) ||
+				isIntRangeDirty(use.physicalIndex, use.currentSize));
+		}
+		/// @copydoc _isFloatUploadRequired
+		bool _isUploadRequired(const GpuConstantDefinition& def, uint16 mask) const
+		{
+			if (!(def.variability & mask))
+				return false;
+			if (mask & (uint16)GPV_GLOBAL)
+				return true;
+			// Double constants are not tracked, isDouble also holds for float matrices
+			if (def.constType >= GCT_DOUBLE1 && def.constType <= GCT_MATRIX_DOUBLE_4X4)
+				return true;
+			size_t count = def.elementSize * def.arraySize;
+			return def.isFloat() ? isFloatRangeDirty(def.physicalIndex, count) :
+				isIntRangeDirty(def.physicalIndex, count);
+		}
+		/** Flags every constant as unchanged, to be called by render systems
+			once they have uploaded the parameters.
+		*/
+		void _clearDirtyRanges(void)
+		{
+			mFloatDirty.clear();
+			mIntDirty.clear();
+		}
+		/// Flags every constant as changed
+		void _markAllDirty(void)
+		{
+			mFloatDirty.markAll(mFloatConstants.size());
+			mIntDirty.markAll(mIntConstants.size());
+		}
+
 		/// Get a reference to the list of auto constant bindings
 		const AutoConstantList& getAutoConstantList() const { return mAutoConstants; }
 
@@ -0,0 +1,200 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __MappedZip_H__
+#define __MappedZip_H__
+
+#include "OgrePrerequisites.h"
+
+#if OGRE_NO_ZIP_ARCHIVE == 0
+
+#include "OgreArchive.h"
+#include "OgreArchiveFactory.h"
+#include "OgreDataStream.h"
+#if OGRE_THREAD_SUPPORT
+#include "Threading/OgreThreadHeaders.h"
+#endif
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Resources
+	*  @{
+	*/
+	/** Archive reading zip files without zziplib.
+	@remarks
+		The whole archive is mapped into memory (see MMapDataStream) or read
+		into memory if it cannot be mapped, and its central directory is read
+		once into hash tables indexed by path and by file name, so looking up
+		a file costs the same whatever the size of the archive.
+	@par
+		Stored (uncompressed) files are returned as streams pointing straight
+		into the mapping, deflated files are decompressed in one go when
+		opened. Apart from load and unload the archive holds no lock while
+		opening files, so files opened from several threads are decompressed
+		concurrently; openMultiple does the same for a list of files using
+		the threads of the WorkQueue.
+	@par
+		Files and folders are listed the same way as ZipArchive does, so both
+		can read the same archives. Only the methods used by zip files in
+		practice, stored and deflate, are supported; encrypted files and
+		ZIP64 archives are not.
+	*/
+	class _OgreExport MappedZipArchive : public Archive
+	{
+	public:
+		MappedZipArchive(const String& name, const String& archType);
+		~MappedZipArchive();
+
+		/// @copydoc Archive::isCaseSensitive
+		bool isCaseSensitive(void) const { return false; }
+
+		/// @copydoc Archive::load
+		void load();
+		/// @copydoc Archive::unload
+		void unload();
+
+		/// @copydoc Archive::open
+		DataStreamPtr open(const String& filename, bool readOnly = true) const;
+
+		/** Opens several files at once.
+		@remarks
+			The deflated files are decompressed in parallel on the threads of
+			the WorkQueue (see ParallelFor).
+		@param filenames The files to open, as passed to open
+		@param streams Receives one stream per file name, in the same order,
+			null for the files which were not found
+		*/
+		void openMultiple(const StringVector& filenames,
+			vector<DataStreamPtr>::type& streams) const;
+
+		/// @copydoc Archive::create
+		DataStreamPtr create(const String& filename) const;
+
+		/// @copydoc Archive::remove
+		void remove(const String& filename) const;
+
+		/// @copydoc Archive::list
+		StringVectorPtr list(bool recursive = true, bool dirs = false);
+
+		/// @copydoc Archive::listFileInfo
+		FileInfoListPtr listFileInfo(bool recursive = true, bool dirs = false);
+
+		/// @copydoc Archive::find
+		StringVectorPtr find(const String& pattern, bool recursive = true,
+			bool dirs = false);
+
+		/// @copydoc Archive::findFileInfo
+		FileInfoListPtr findFileInfo(const String& pattern, bool recursive = true,
+			bool dirs = false) const;
+
+		/// @copydoc Archive::exists
+		bool exists(const String& filename);
+
+		/// @copydoc Archive::getModifiedTime
+		time_t getModifiedTime(const String& filename);
+
+	protected:
+		/// Location of a file in the archive, read from the central directory
+		struct Entry
+		{
+			/// Offset of the local file header
+			size_t headerOffset;
+			size_t compressedSize;
+			size_t uncompressedSize;
+			/// Compression method, 0 for stored, 8 for deflated
+			uint16 method;
+			/// General purpose flags, bit 0 is set for encrypted files
+			uint16 flags;
+		};
+		typedef vector<Entry>::type EntryList;
+		/// Lower case names to indices in mEntries and mFileList
+		typedef HashMap<String, size_t> EntryIndex;
+
+		/// Value of mNameIndex for names shared by several files
+		static const size_t AMBIGUOUS_NAME = ~(size_t)0;
+
+		/// Decompresses the files requested by openMultiple
+		class OpenTask;
+
+		/// Reads the central directory of the archive data
+		void readCentralDirectory(void);
+		/// Returns the index of a file, AMBIGUOUS_NAME if not found or ambiguous
+		size_t findEntry(const String& filename) const;
+		/** Returns a stream on the data of an entry.
+		@remarks
+			Called without holding the lock, hence the arguments are copies.
+		@param data The archive data, kept alive by the stored file streams
+		*/
+		static DataStreamPtr openEntry(const MemoryDataStreamPtr& data,
+			const Entry& entry, const String& filename);
+
+		/// The whole archive, mapped or in memory
+		MemoryDataStreamPtr mData;
+		/// Entries and their file information, in central directory order
+		EntryList mEntries;
+		FileInfoList mFileList;
+		/// Files by full path
+		EntryIndex mPathIndex;
+		/// Files by name alone, AMBIGUOUS_NAME when several share a name
+		EntryIndex mNameIndex;
+
+		OGRE_AUTO_MUTEX;
+	};
+
+	/** Specialisation of ArchiveFactory for MappedZipArchive. */
+	class _OgrePrivate MappedZipArchiveFactory : public ArchiveFactory
+	{
+	public:
+		virtual ~MappedZipArchiveFactory() {}
+		/// @copydoc FactoryObj::getType
+		const String& getType(void) const;
+		/// @copydoc FactoryObj::createInstance
+		Archive *createInstance( const String& name, bool readOnly )
+		{
+			if(!readOnly)
+				return NULL;
+
+			return OGRE_NEW MappedZipArchive(name, "MappedZip");
+		}
+		/// @copydoc FactoryObj::destroyInstance
+		void destroyInstance( Archive* ptr) { OGRE_DELETE ptr; }
+	};
+
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
+
+#endif
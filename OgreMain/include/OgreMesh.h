@@ -158,6 +158,13 @@ namespace Ogre {
             unsigned short numBlendWeightsPerVertex, 
             IndexMap& blendIndexToBoneIndexMap,
             VertexData* targetVertexData);
+        /** Performs a software vertex blend of either matrices or dual
+            quaternions, the other pointer being null. */
+        static void softwareVertexBlendImpl(const VertexData* sourceVertexData,
+            const VertexData* targetVertexData,
+            const Matrix4* const* blendMatrices,
+            const DualQuaternion* const* blendDualQuaternions,
+            bool blendNormals);
 
         const LodStrategy *mLodStrategy;
         bool mIsLodManual;
@@ -737,6 +744,20 @@ namespace Ogre {
         static void prepareMatricesForVertexBlend(const Matrix4** blendMatrices,
             const Matrix4* boneMatrices, const IndexMap& indexMap);
 
+        /** Prepare dual quaternions for software indexed vertex blend, as
+            prepareMatricesForVertexBlend does for matrices.
+        @param blendDualQuaternions
+            Pointer to an array of dual quaternion pointers to store
+            prepared results, which indexed by blend index.
+        @param boneDualQuaternions
+            Pointer to an array of dual quaternions to be used to blend,
+            which indexed by bone index.
+        @param indexMap
+            The index map used to translate blend index to bone index.
+        */
+        static void prepareDualQuaternionsForVertexBlend(const DualQuaternion** blendDualQuaternions,
+            const DualQuaternion* boneDualQuaternions, const IndexMap& indexMap);
+
         /** Performs a software indexed vertex blend, of the kind used for
             skeletal animation although it can be used for other purposes. 
         @remarks
@@ -765,6 +786,25 @@ namespace Ogre {
             const Matrix4* const* blendMatrices, size_t numMatrices,
             bool blendNormals);
 
+        /** Performs a software indexed vertex blend of dual quaternions,
+            which unlike blending matrices preserves the volume around twisting
+            joints.
+        @remarks
+            Same as the matrix version, the results match those of dual
+            quaternion skinning shaders. Scales of the bones are ignored.
+        @param blendDualQuaternions
+            Pointer to an array of dual quaternion pointers to be used to blend,
+            indexed by blend indices in the sourceVertexData
+        @param numDualQuaternions
+            Number of dual quaternions in the blendDualQuaternions, it might be
+            used as a hint for optimisation.
+        @see OptimisedUtil::softwareVertexDualQuaternionSkinning
+        */
+        static void softwareVertexBlend(const VertexData* sourceVertexData, 
+            const VertexData* targetVertexData,
+            const DualQuaternion* const* blendDualQuaternions, size_t numDualQuaternions,
+            bool blendNormals);
+
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
         @remarks
@@ -809,6 +849,24 @@ namespace Ogre {
             const map<size_t, Vector3>::type& vertexOffsetMap,
             const map<size_t, Vector3>::type& normalsMap,
             VertexData* targetVertexData);
+
+        /** Performs a software vertex pose blend of several poses at once.
+        @remarks
+            Gives the same results as calling the version above for each pose,
+            but locks the destination buffer once and accumulates all the
+            poses with OptimisedUtil::softwareVertexPoseBlend.
+        @param poses
+            The poses to apply.
+        @param weights
+            Parametric weight of each pose, poses with a zero weight are skipped.
+        @param numPoses
+            Number of poses.
+        @param targetVertexData 
+            VertexData destination, as for the version above.
+        */
+        static void softwareVertexPoseBlend(const Pose* const* poses,
+            const Real* weights, size_t numPoses,
+            VertexData* targetVertexData);
         /** Gets a reference to the optional name assignments of the SubMeshes. */
         const SubMeshNameMap& getSubMeshNameMap(void) const { return mSubMeshNameMap; }
 
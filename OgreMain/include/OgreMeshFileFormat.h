@@ -53,6 +53,19 @@ namespace Ogre {
 
     A .mesh file only contains a single mesh, which can itself have multiple submeshes.
 
+    Baked .mesh files (version string [MeshSerializer_v1.8_baked]) use the same chunks, but
+    every block of buffer data (vertex buffer data, submesh and generated LOD face indexes)
+    is surrounded by 16 bytes of padding so that it starts at an offset of the file
+    aligned on 16 bytes:
+        unsigned char  LEAD            : number of padding bytes following LEAD
+        ...            PADDING         : LEAD bytes
+        void*          DATA            : the block of data
+        ...            PADDING         : 15 - LEAD bytes
+    In baked files the triangles of an M_EDGE_LIST_LOD are stored as two padded blocks,
+    unsigned long[8] per triangle followed by float normal[4] per triangle, and the edges
+    of an M_EDGE_GROUP as one padded block of unsigned long[7] per edge, degenerate being
+    the last value.
+
 */
 
 	enum MeshChunkID {
@@ -54,7 +54,10 @@ namespace Ogre {
 		MESH_VERSION_1_0,
 		
 		/// Legacy versions, DO NOT USE for writing
-		MESH_VERSION_LEGACY
+		MESH_VERSION_LEGACY,
+
+		/// Latest version, with buffer data aligned for faster loading
+		MESH_VERSION_BAKED
 	};
 
 	/** \addtogroup Core
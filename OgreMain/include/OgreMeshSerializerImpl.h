@@ -237,6 +237,7 @@ namespace Ogre {
         virtual void writeLodUsageGenerated(const Mesh* pMesh, const MeshLodUsage& usage, unsigned short lodNum);
         virtual void writeBoundsInfo(const Mesh* pMesh);
         virtual void writeEdgeList(const Mesh* pMesh);
+        virtual void writeEdgeListLodInfo(const EdgeData* edgeData);
 		virtual void writeAnimations(const Mesh* pMesh);
 		virtual void writeAnimation(const Animation* anim);
 		virtual void writePoses(const Mesh* pMesh);
@@ -269,6 +270,20 @@ namespace Ogre {
 		virtual size_t calcPoseVertexSize(const Pose* pose);
         virtual size_t calcSubMeshTextureAliasesSize(const SubMesh* pSub);
 
+        /** Writes the padding placed in front of a block of buffer data.
+        @remarks
+            Together with writeDataPaddingAfter this adds calcDataPaddingSize
+            bytes around each block, none in this version.
+        */
+        virtual void writeDataPaddingBefore(void) {}
+        /// Writes the padding placed after a block of buffer data
+        virtual void writeDataPaddingAfter(void) {}
+        /// Total size of the padding written around a block of buffer data
+        virtual size_t calcDataPaddingSize(void) { return 0; }
+        /// Skips the padding placed in front of a block of buffer data
+        virtual void readDataPaddingBefore(DataStreamPtr& stream) {}
+        /// Skips the padding placed after a block of buffer data
+        virtual void readDataPaddingAfter(DataStreamPtr& stream) {}
 
         virtual void readTextureLayer(DataStreamPtr& stream, Mesh* pMesh, MaterialPtr& pMat);
         virtual void readSubMeshNameTable(DataStreamPtr& stream, Mesh* pMesh);
@@ -325,6 +340,43 @@ namespace Ogre {
 
     };
 
+    /** Class for reading / writing baked meshes, a variant of the latest version of the
+        .mesh format laid out for loading speed.
+    @remarks
+        The chunks are those of MeshSerializerImpl, but every block of buffer data is
+        padded so that it starts at an offset of the file aligned on DATA_ALIGNMENT
+        bytes, and edge lists are stored as flat arrays (see OgreMeshFileFormat.h).
+        Each vertex and index buffer is thus loaded by a single read from aligned
+        memory (when the stream is memory mapped, see FileSystemArchive::setUseMemoryMapping)
+        straight into the buffer locked with HBL_DISCARD, and each edge list by one
+        read per array instead of a few per triangle and per edge.
+	@note
+		Written with MeshSerializer::exportMesh and MESH_VERSION_BAKED.
+    */
+    class _OgrePrivate MeshSerializerImpl_Baked : public MeshSerializerImpl
+    {
+    public:
+        MeshSerializerImpl_Baked();
+        ~MeshSerializerImpl_Baked();
+
+        /// Alignment of the blocks of buffer data in the file
+        static const size_t DATA_ALIGNMENT = 16;
+    protected:
+        void writeDataPaddingBefore(void);
+        void writeDataPaddingAfter(void);
+        size_t calcDataPaddingSize(void);
+        void readDataPaddingBefore(DataStreamPtr& stream);
+        void readDataPaddingAfter(DataStreamPtr& stream);
+
+        size_t calcEdgeListLodSize(const EdgeData* edgeData, bool isManual);
+        size_t calcEdgeGroupSize(const EdgeData::EdgeGroup& group);
+        void writeEdgeListLodInfo(const EdgeData* edgeData);
+        void readEdgeListLodInfo(DataStreamPtr& stream, EdgeData* edgeData);
+
+        /// Number of padding bytes in front of the current block of buffer data
+        size_t mDataPadding;
+    };
+
     /** Class for providing backwards-compatibility for loading version 1.41 of the .mesh format. 
 	 This mesh format was used from Ogre v1.7.
 	 */
@@ -75,9 +75,12 @@ namespace Ogre {
             /// Transform is relative to world space
             TS_WORLD
         };
-        typedef HashMap<String, Node*> ChildNodeMap;
-        typedef MapIterator<ChildNodeMap> ChildNodeIterator;
-        typedef ConstMapIterator<ChildNodeMap> ConstChildNodeIterator;
+        typedef vector<Node*>::type ChildNodeList;
+        typedef VectorIterator<ChildNodeList> ChildNodeIterator;
+        typedef ConstVectorIterator<ChildNodeList> ConstChildNodeIterator;
+        /// A node still to be updated, with the parentHasChanged flag to pass to _update
+        typedef std::pair<Node*, bool> PendingUpdate;
+        typedef vector<PendingUpdate>::type PendingUpdateList;
 
         /** Listener which gets called back on Node events.
         */
@@ -125,12 +128,29 @@ namespace Ogre {
     protected:
         /// Pointer to parent node
         Node* mParent;
-        /// Collection of pointers to direct children; hashmap for efficiency
-        ChildNodeMap mChildren;
+        /// Collection of pointers to direct children, in no particular order
+        ChildNodeList mChildren;
+        /// Index of this node in the children of its parent
+        size_t mIndexInParent;
 
-        typedef set<Node*>::type ChildUpdateSet;
+        typedef HashMap<String, Node*> ChildNameIndex;
+        /// Children by name, only built once a child is looked up by name
+        mutable ChildNameIndex* mChildNameIndex;
+
+        /// Gets the children by name, building the index if needed
+        ChildNameIndex& getChildNameIndex(void) const;
+        /// Removes a child from mChildren and the name index, without notifying it
+        void eraseChild(Node* child);
+
+        typedef vector<Node*>::type ChildUpdateList;
         /// List of children which need updating, used if self is not out of date but children are
-        mutable ChildUpdateSet mChildrenToUpdate;
+        mutable ChildUpdateList mChildrenToUpdate;
+        /// Is this node in mChildrenToUpdate of its parent?
+        mutable bool mInParentUpdateList;
+        /// Index of this node in mChildrenToUpdate of its parent, if in it
+        mutable size_t mIndexInParentUpdateList;
+        /// Empties mChildrenToUpdate, telling the children they left it
+        void clearChildrenToUpdate(void) const;
         /// Flag to indicate own transform from parent is out of date
         mutable bool mNeedParentUpdate;
         /// Flag indicating that all children need to be updated
@@ -207,6 +227,14 @@ namespace Ogre {
         */
         virtual void updateFromParentImpl(void) const;
 
+        /** Class-specific implementation of _setDerivedTransform.
+        @remarks
+            Subclasses which react to their transform changing in
+            updateFromParentImpl should do the same here.
+        */
+        virtual void setDerivedTransformImpl(const Vector3& position,
+            const Quaternion& orientation, const Vector3& scale);
+
 
         /** Internal method for creating a new child node - must be overridden per subclass. */
         virtual Node* createChildImpl(void) = 0;
@@ -549,10 +577,14 @@ namespace Ogre {
         /** Gets a pointer to a child node.
         @remarks
             There is an alternate getChild method which returns a named child.
+            The order of the children changes when one of them is removed.
         */
         virtual Node* getChild(unsigned short index) const;    
 
         /** Gets a pointer to a named child node.
+        @remarks
+            The first lookup by name builds an index of the children by name,
+            which is then kept up to date until all the children are removed.
         */
         virtual Node* getChild(const String& name) const;
 
@@ -658,6 +690,63 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /** Internal method to update this Node only and collect the children
+            which still need updating.
+        @remarks
+            This performs the part of _update(true, parentHasChanged) which
+            concerns this node and appends the children it would have cascaded
+            to, each with the parentHasChanged flag it must be updated with.
+            Since the children only depend on this node, each of them can then
+            have _update(true, flag) called independently, e.g. on another thread.
+            This allows a SceneManager to split the hierarchy into subtrees.
+        @note
+            Unlike _update, SceneNode bounds are not updated by this method
+            since they depend on the children; call SceneNode::_updateBounds
+            once the collected children are done.
+        */
+        virtual void _updateAndCollectChildren(bool parentHasChanged, PendingUpdateList& children);
+
+        /** Internal method to clear the pending update state of this Node and
+            collect the children which still need updating, without updating
+            the transform of this Node itself.
+        @remarks
+            Used to update whole levels of the hierarchy in one batch, see
+            NodeTransformPool. The caller is responsible for deriving the
+            transform of this Node (from the derived transform of its parent)
+            when this returns true, either through _updateFromParent or
+            through _setDerivedTransform.
+        @return
+            Whether the derived transform of this Node must be recalculated.
+        */
+        bool _prepareUpdate(bool parentHasChanged, PendingUpdateList& children);
+
+        /** Internal method to set the derived transform of this Node when it
+            was calculated outside of _updateFromParent.
+        @remarks
+            The values must be those which updateFromParentImpl would have
+            produced. Listeners are notified as for _updateFromParent.
+        */
+        void _setDerivedTransform(const Vector3& position, const Quaternion& orientation,
+            const Vector3& scale);
+
+        /** Internal method returning whether this Node or any of its children
+            still has to be updated.
+        */
+        bool _isUpdatePending(void) const
+        {
+            return mNeedParentUpdate || mNeedChildUpdate || !mChildrenToUpdate.empty();
+        }
+
+        /** Internal method to forget the update requests of the children of
+            this Node.
+        @remarks
+            Used when the children which requested an update have been updated
+            directly rather than through _update on this Node, see
+            SceneManager::setIncrementalSceneGraphUpdate. The transform of this
+            Node itself must be up to date.
+        */
+        void _clearChildUpdateRequests(void);
+
         /** Sets a listener for this Node.
         @remarks
             Note for size and performance reasons only one listener per node is
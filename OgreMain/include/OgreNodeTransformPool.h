@@ -0,0 +1,125 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NodeTransformPool_H__
+#define __NodeTransformPool_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreNode.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Scene
+	*  @{
+	*/
+	/** Updates the derived transforms of a Node hierarchy one level at a time.
+	@remarks
+		Node::_update walks the hierarchy depth first and derives every
+		transform on its own. This class instead collects all the nodes of
+		one depth which need updating, copies their local transforms and those
+		of their parents into aligned structure of arrays buffers, derives
+		them all with OptimisedUtil::concatenateNodeTransforms (4 at a time
+		with SSE) and copies the results back with Node::_setDerivedTransform.
+		The results are the same as those of Node::_update.
+	@par
+		Nodes whose class overrides Node::updateFromParentImpl to compute
+		their transform differently must not be updated this way.
+	@note
+		Bounds are not updated, the nodes visited by the last update are
+		available per level so that the caller can update them deepest first.
+	*/
+	class _OgreExport NodeTransformPool : public NodeAlloc
+	{
+	public:
+		NodeTransformPool();
+		~NodeTransformPool();
+
+		/** Updates a hierarchy, as root->_update(true, parentHasChanged) would.
+		@param root The top of the hierarchy to update.
+		@param parentHasChanged Whether the parent of root has changed.
+		@param parallel Whether each level may be distributed over the
+			threads of the WorkQueue, see ParallelFor. Node listeners are
+			then called concurrently.
+		*/
+		void update(Node* root, bool parentHasChanged, bool parallel);
+
+		/// Returns the number of levels visited by the last update
+		size_t getNumLevels(void) const { return mLevelStarts.size() - 1; }
+		/// Returns the index in getVisitedNodes of the first node of a level
+		size_t getLevelBegin(size_t level) const { return mLevelStarts[level]; }
+		/// Returns the index in getVisitedNodes one past the last node of a level
+		size_t getLevelEnd(size_t level) const { return mLevelStarts[level + 1]; }
+		/** Returns the nodes visited by the last update, in breadth first order.
+		@remarks
+			Includes the nodes whose transform was up to date but which were
+			traversed because one of their descendants needed an update.
+		*/
+		const vector<Node*>::type& getVisitedNodes(void) const { return mVisitedNodes; }
+
+		/** Derives the transforms of a range of entries of the current batch.
+		@note Internal method, begin and end are in blocks of 4 entries.
+		*/
+		void _processBlocks(size_t begin, size_t end);
+
+	protected:
+		/// Makes sure the buffers can hold the given number of entries
+		void reserve(size_t count);
+		/// Processes the nodes of mBatch
+		void processBatch(bool parallel);
+
+		/// Nodes still to visit in the current and next level
+		Node::PendingUpdateList mPending;
+		Node::PendingUpdateList mNextPending;
+		/// Nodes visited by the last update
+		vector<Node*>::type mVisitedNodes;
+		/// Start of each level in mVisitedNodes, followed by the total
+		vector<size_t>::type mLevelStarts;
+		/// Nodes of the current level whose transform must be derived
+		vector<Node*>::type mBatch;
+
+		/// Aligned storage for all the arrays below
+		Real* mBuffer;
+		/// Number of entries each array can hold
+		size_t mCapacity;
+		TransformSoA mParent;
+		TransformSoA mLocal;
+		Real* mInheritOrientation;
+		Real* mInheritScale;
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -40,6 +40,33 @@ namespace Ogre {
 	/** \addtogroup Math
 	*  @{
 	*/
+	/** Pointers to the components of a batch of transforms, stored as
+		structure of arrays so that several transforms can be processed by
+		one SIMD instruction.
+	*/
+	struct TransformSoA
+	{
+		Real* posX;
+		Real* posY;
+		Real* posZ;
+		Real* rotW;
+		Real* rotX;
+		Real* rotY;
+		Real* rotZ;
+		Real* scaleX;
+		Real* scaleY;
+		Real* scaleZ;
+
+		/// Returns the same arrays starting at the given entry
+		TransformSoA offset(size_t index) const
+		{
+			TransformSoA ret = { posX + index, posY + index, posZ + index,
+				rotW + index, rotX + index, rotY + index, rotZ + index,
+				scaleX + index, scaleY + index, scaleZ + index };
+			return ret;
+		}
+	};
+
 	/** Utility class for provides optimised functions.
     @note
         This class are supposed used by internal engine only.
@@ -107,6 +134,32 @@ namespace Ogre {
             size_t numWeightsPerVertex,
             size_t numVertices) = 0;
 
+        /** Performs software vertex skinning by blending dual quaternions.
+        @remarks
+            Gives the same results as the dual quaternion skinning vertex
+            programs (see the RTShaderSystem DualQuaternionSkinning): the dual
+            quaternions of the bones are blended with the weights of the
+            vertex, those which are not in the same hemisphere as the
+            dual quaternion of the first bone of the vertex being negated, the
+            result is normalised and used to transform the vertex. Normals are
+            only rotated, so unit source normals stay unit length. Unlike
+            linear blend skinning, rotations do not make the mesh collapse,
+            but bone scaling is not supported.
+        @param blendDualQuaternions An array of pointer of blend dual
+            quaternion, indexed by blend index.
+        @see softwareVertexSkinning for the other parameters.
+        */
+        virtual void softwareVertexDualQuaternionSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices) = 0;
+
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
         @remarks
@@ -129,6 +182,31 @@ namespace Ogre {
             size_t numVertices,
 			bool morphNormals) = 0;
 
+        /** Accumulates the weighted sparse offsets of several poses into a
+            vertex buffer, of the kind used for pose animation.
+        @remarks
+            For each pose, adds weight times each offset to the x, y and z of
+            the vertex it applies to. All the poses are accumulated by one
+            call, so the destination only has to be locked once.
+        @param weights Weight of each pose.
+        @param indices For each pose, the indices of the vertices it offsets.
+        @param offsets For each pose, the offsets packed as 4 floats per
+            vertex, the fourth being zero. No alignment requirement.
+        @param numOffsets Number of offsets of each pose.
+        @param numPoses Number of poses to accumulate.
+        @param dstPtr Pointer to the first float3 of the destination buffer,
+            e.g. the position or normal of vertex 0.
+        @param dstStride The stride of the destination buffer in bytes.
+        */
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride) = 0;
+
         /** Concatenate an affine matrix to an array of affine matrices.
         @note
             An affine matrix is a 4x4 matrix with row 3 equal to (0, 0, 0, 1),
@@ -203,6 +281,61 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Derives the transforms of a batch of nodes from those of their parents.
+        @remarks
+            Computes the same as Node::updateFromParentImpl for every node:
+            the derived orientation is the parent orientation times the
+            orientation and the derived scale the parent scale times the scale
+            where the node inherits them, and the derived position is the
+            parent orientation times the parent scale times the position, plus
+            the parent position.
+        @param parent Derived transforms of the parents of the nodes.
+        @param local Local transforms of the nodes.
+        @param inheritOrientation Per node flag, non zero where the node
+            combines its orientation with that of its parent.
+        @param inheritScale Per node flag, non zero where the node combines
+            its scale with that of its parent.
+        @param derived Receives the derived transforms, may be the same
+            arrays as local.
+        @param numNodes Number of nodes to process. All arrays must be
+            aligned to SIMD alignment and padded to a multiple of 4 entries.
+        */
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes) = 0;
+
+        /** Tests a batch of axis aligned boxes against a set of planes, e.g.
+            those of a frustum.
+        @remarks
+            A box is culled if it is entirely on the negative side of any
+            plane, as Plane::getSide(const Vector3&, const Vector3&) would
+            report; so the results match Frustum::isVisible for finite boxes.
+        @param planes The planes to test against.
+        @param numPlanes Number of planes.
+        @param centreX, centreY, centreZ Centres of the boxes.
+        @param halfSizeX, halfSizeY, halfSizeZ Half sizes of the boxes.
+        @param visibility Receives one bit per box, bit i % 32 of entry i / 32
+            being set if box i is not culled. (numBoxes + 31) / 32 entries are
+            overwritten.
+        @param numBoxes Number of boxes. All the box arrays must be aligned to
+            SIMD alignment and padded to a multiple of 4 entries.
+        */
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -0,0 +1,192 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __PackArchive_H__
+#define __PackArchive_H__
+
+#include "OgrePrerequisites.h"
+
+#include "OgreArchive.h"
+#include "OgreArchiveFactory.h"
+#include "OgreDataStream.h"
+#if OGRE_THREAD_SUPPORT
+#include "Threading/OgreThreadHeaders.h"
+#endif
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Resources
+	*  @{
+	*/
+	/** Archive reading the pack files written by the OgrePackTool.
+	@remarks
+		Pack files are made for fast loading rather than for small size: each
+		file is either stored or compressed with LZ4, which decompresses much
+		faster than deflate, and the index is sorted by name when the pack is
+		built so that files are found with a binary search straight in the
+		mapped index (see MMapDataStream), without building any table.
+	@par
+		All values are little endian. The pack starts with a 32 byte header:
+		<ul>
+		<li>char[8] "OGREPACK"</li>
+		<li>uint32 version, currently 1</li>
+		<li>uint32 alignment of the file data, 4096 by default</li>
+		<li>uint32 number of files</li>
+		<li>uint32 size of the index</li>
+		<li>uint64 offset of the index</li>
+		</ul>
+		The data of each file starts at a multiple of the alignment, so stored
+		files are returned as aligned streams pointing into the mapping. The
+		index holds one 24 byte record per file, sorted by lower case name:
+		<ul>
+		<li>uint64 offset of the data</li>
+		<li>uint32 size of the data</li>
+		<li>uint32 size of the file once decompressed</li>
+		<li>uint32 offset of the name, from the end of the records</li>
+		<li>uint16 length of the name</li>
+		<li>uint8 compression method, see PackCompression</li>
+		<li>uint8 unused</li>
+		</ul>
+		followed by the names, full paths using '/' as separator.
+	@par
+		As with FileSystemArchive, files are listed with their path, and
+		names are case insensitive.
+	*/
+	class _OgreExport PackArchive : public Archive
+	{
+	public:
+		/// Compression methods of the files in a pack
+		enum PackCompression
+		{
+			PC_STORED = 0,
+			/// LZ4 block format, without frame
+			PC_LZ4 = 1
+		};
+
+		static const uint32 PACK_VERSION = 1;
+		static const size_t HEADER_SIZE = 32;
+		static const size_t RECORD_SIZE = 24;
+
+		PackArchive(const String& name, const String& archType);
+		~PackArchive();
+
+		/// @copydoc Archive::isCaseSensitive
+		bool isCaseSensitive(void) const { return false; }
+
+		/// @copydoc Archive::load
+		void load();
+		/// @copydoc Archive::unload
+		void unload();
+
+		/// @copydoc Archive::open
+		DataStreamPtr open(const String& filename, bool readOnly = true) const;
+
+		/// @copydoc Archive::create
+		DataStreamPtr create(const String& filename) const;
+
+		/// @copydoc Archive::remove
+		void remove(const String& filename) const;
+
+		/// @copydoc Archive::list
+		StringVectorPtr list(bool recursive = true, bool dirs = false);
+
+		/// @copydoc Archive::listFileInfo
+		FileInfoListPtr listFileInfo(bool recursive = true, bool dirs = false);
+
+		/// @copydoc Archive::find
+		StringVectorPtr find(const String& pattern, bool recursive = true,
+			bool dirs = false);
+
+		/// @copydoc Archive::findFileInfo
+		FileInfoListPtr findFileInfo(const String& pattern, bool recursive = true,
+			bool dirs = false) const;
+
+		/// @copydoc Archive::exists
+		bool exists(const String& filename);
+
+		/// @copydoc Archive::getModifiedTime
+		time_t getModifiedTime(const String& filename);
+
+		/** Decompresses a block of LZ4 data.
+		@param src The compressed data
+		@param srcSize The size of the compressed data
+		@param dest Receives the decompressed data
+		@param destSize The size of the data once decompressed
+		@return false if the data is corrupted
+		*/
+		static bool decompressLZ4(const uchar* src, size_t srcSize, uchar* dest, size_t destSize);
+
+	protected:
+		/// Returns the index of a file in the pack index, or -1 if not found
+		size_t findRecord(const String& filename) const;
+		/// Returns a pointer to the record of a file in the pack index
+		const uchar* getRecord(size_t index) const { return mRecords + index * RECORD_SIZE; }
+
+		/// The whole pack, mapped or in memory
+		MemoryDataStreamPtr mData;
+		/// Records and names of the index, in mData
+		const uchar* mRecords;
+		const uchar* mNames;
+		size_t mNumRecords;
+		/// Files in index order then folders, built when loading for listing
+		FileInfoList mFileList;
+		FileInfoList mDirList;
+
+		OGRE_AUTO_MUTEX;
+	};
+
+	/** Specialisation of ArchiveFactory for PackArchive. */
+	class _OgrePrivate PackArchiveFactory : public ArchiveFactory
+	{
+	public:
+		virtual ~PackArchiveFactory() {}
+		/// @copydoc FactoryObj::getType
+		const String& getType(void) const;
+		/// @copydoc FactoryObj::createInstance
+		Archive *createInstance( const String& name, bool readOnly )
+		{
+			if(!readOnly)
+				return NULL;
+
+			return OGRE_NEW PackArchive(name, "Pack");
+		}
+		/// @copydoc FactoryObj::destroyInstance
+		void destroyInstance( Archive* ptr) { OGRE_DELETE ptr; }
+	};
+
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -0,0 +1,104 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __OgreParallelFor_H__
+#define __OgreParallelFor_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup General
+	*  @{
+	*/
+
+	/** A range of independent work items which ParallelFor can split
+		across several threads.
+	*/
+	class _OgreExport ParallelForTask
+	{
+	public:
+		virtual ~ParallelForTask() {}
+
+		/** Process the items in the range [begin, end).
+		@remarks
+			This is called concurrently from the thread which started the
+			ParallelFor and from the worker threads of the WorkQueue, always
+			with disjoint ranges. Items must therefore not depend on each other.
+		*/
+		virtual void execute(size_t begin, size_t end) = 0;
+	};
+
+	/** Runs a ParallelForTask on the worker threads of Root's WorkQueue and
+		waits for it to complete.
+	@remarks
+		The range is cut into chunks which are claimed by the calling thread
+		and by the workers of the DefaultWorkQueue until none are left; the
+		calling thread then blocks until every claimed chunk is finished. The
+		caller always takes part, so no progress depends on a worker being
+		free: if all workers are busy with other requests the caller simply
+		processes the whole range itself. It is therefore also safe to start
+		a ParallelFor from inside a ParallelForTask.
+	@par
+		When OGRE is built without thread support, when Root does not exist
+		or when its work queue is not a DefaultWorkQueue, the task is executed
+		in one go on the calling thread.
+	*/
+	class _OgreExport ParallelFor
+	{
+	public:
+		/** Process all items of a task and return when they are done.
+		@param task The task to execute
+		@param count The number of items, the task is called with ranges in [0, count)
+		@param minChunkSize The smallest number of items worth handing to another
+			thread; use a larger value when individual items are cheap.
+		@note
+			An exception thrown by the task on any thread is rethrown on the
+			calling thread once every chunk has completed. Exceptions derived
+			from Exception keep their type, any other is rethrown as an
+			InternalErrorException.
+		*/
+		static void run(ParallelForTask* task, size_t count, size_t minChunkSize = 1);
+
+		/** Returns the number of threads which can take part in run, including
+			the calling one, or 1 if work cannot be distributed.
+		*/
+		static size_t getThreadCount(void);
+	};
+
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
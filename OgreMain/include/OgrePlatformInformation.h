@@ -116,10 +116,26 @@ namespace Ogre {
 #   define __OGRE_HAVE_MSA  1
 #endif
 
+/* Define whether or not Ogre compiled with AVX2 support. The AVX2 code is
+   compiled for its own functions only and selected at run time, so the
+   compiler only needs to support the intrinsics and target attributes.
+*/
+#if __OGRE_HAVE_SSE && OGRE_COMPILER == OGRE_COMPILER_MSVC && OGRE_COMP_VER >= 1700
+#   define __OGRE_HAVE_AVX2  1
+#elif __OGRE_HAVE_SSE && OGRE_COMPILER == OGRE_COMPILER_GNUC && OGRE_COMP_VER >= 490
+#   define __OGRE_HAVE_AVX2  1
+#elif __OGRE_HAVE_SSE && OGRE_COMPILER == OGRE_COMPILER_CLANG && OGRE_COMP_VER >= 380
+#   define __OGRE_HAVE_AVX2  1
+#endif
+
 #ifndef __OGRE_HAVE_SSE
 #   define __OGRE_HAVE_SSE  0
 #endif
 
+#ifndef __OGRE_HAVE_AVX2
+#   define __OGRE_HAVE_AVX2  0
+#endif
+
 #ifndef __OGRE_HAVE_VFP
 #   define __OGRE_HAVE_VFP  0
 #endif
@@ -173,6 +189,9 @@ namespace Ogre {
             CPU_FEATURE_FPU         = 1 << 9,
             CPU_FEATURE_PRO         = 1 << 10,
             CPU_FEATURE_HTT         = 1 << 11,
+            CPU_FEATURE_AVX         = 1 << 12,
+            CPU_FEATURE_AVX2        = 1 << 13,
+            CPU_FEATURE_FMA         = 1 << 14,
 #elif OGRE_CPU == OGRE_CPU_ARM
             CPU_FEATURE_VFP         = 1 << 12,
             CPU_FEATURE_NEON        = 1 << 13,
@@ -116,6 +116,23 @@ namespace Ogre {
 		/** Get a hardware vertex buffer version of the vertex offsets. */
 		const HardwareVertexBufferSharedPtr& _getHardwareVertexBuffer(const VertexData* origData) const;
 
+		/** Gets the indices of the vertices of the pose, in the order of the
+			packed offsets and normals.
+		@note Internal method, the packed arrays are derived from the maps on
+			demand and used by OptimisedUtil::softwareVertexPoseBlend.
+		*/
+		const vector<uint32>::type& _getPackedIndices(void) const;
+		/** Gets the vertex offsets packed as 4 floats per vertex, the fourth
+			being zero.
+		@note Internal method, see _getPackedIndices.
+		*/
+		const vector<float>::type& _getPackedVertexOffsets(void) const;
+		/** Gets the normals packed as 4 floats per vertex, the fourth being
+			zero, or an empty array if the pose does not include normals.
+		@note Internal method, see _getPackedIndices.
+		*/
+		const vector<float>::type& _getPackedNormals(void) const;
+
 		/** Clone this pose and create another one configured exactly the same
 			way (only really useful for cloning holders of this class).
 		*/
@@ -131,6 +148,14 @@ namespace Ogre {
 		NormalsMap mNormalsMap;
 		/// Derived hardware buffer, covers all vertices
 		mutable HardwareVertexBufferSharedPtr mBuffer;
+		/// Derived contiguous copies of the maps, valid unless mPackedDirty
+		mutable vector<uint32>::type mPackedIndices;
+		mutable vector<float>::type mPackedVertexOffsets;
+		mutable vector<float>::type mPackedNormals;
+		mutable bool mPackedDirty;
+
+		/// Rebuilds the packed arrays from the maps if they changed
+		void updatePackedData(void) const;
 	};
 	typedef vector<Pose*>::type PoseList;
 
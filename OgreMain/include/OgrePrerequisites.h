@@ -143,6 +143,7 @@ namespace Ogre {
     class Camera;
     class Codec;
     class ColourValue;
+	class CompressedNodeAnimationTrack;
     class ConfigDialog;
     template <typename T> class Controller;
     template <typename T> class ControllerFunction;
@@ -151,6 +152,7 @@ namespace Ogre {
 	class DefaultWorkQueue;
     class Degree;
 	class DepthBuffer;
+    class DualQuaternion;
     class DynLib;
     class DynLibManager;
     class EdgeData;
@@ -204,6 +206,7 @@ namespace Ogre {
     class MovableObject;
     class MovablePlane;
     class Node;
+	class NodeTransformPool;
 	class NodeAnimationTrack;
 	class NodeKeyFrame;
 	class NumericAnimationTrack;
@@ -276,6 +279,9 @@ namespace Ogre {
     class Skeleton;
     class SkeletonInstance;
     class SkeletonManager;
+    class SkeletonPoseBatch;
+    class SkeletonPoseCache;
+    class SoftwareVertexBlendBatch;
     class Sphere;
     class SphereSceneQuery;
 	class StaticGeometry;
@@ -130,7 +130,20 @@ namespace Ogre {
 			/** Sort ascending camera distance 
 				Note value overlaps with descending since both use same sort
 			*/
-			OM_SORT_ASCENDING = 6
+			OM_SORT_ASCENDING = 6,
+			/** Sort by a packed 64-bit key, pass first in hash order then 
+				ascending camera distance.
+			@remarks
+				Items are stored in a single flat array which is reused from
+				frame to frame and ordered with one radix sort, so queueing does
+				not allocate once the array has grown. The key holds the rank of
+				the pass among those queued, so the sort only makes 5 passes
+				over the items while fewer than 256 passes are queued. When iterated the items 
+				are visited grouped by pass, so this mode can replace OM_PASS_GROUP; 
+				if OM_PASS_GROUP is requested from a collection which was 
+				only set up for this mode, this mode is used instead.
+			*/
+			OM_SORT_KEY = 8
 		};
 
 	protected:
@@ -231,6 +244,19 @@ namespace Ogre {
         /// Radix sorter for sort value 2 (distance)
 		static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
 
+		/// Item of the OM_SORT_KEY organisation
+		struct SortKeyEntry
+		{
+			/// Rank of the pass in the upper 32 bits, squared view depth in the lower
+			uint64 key;
+			Renderable* renderable;
+			Pass* pass;
+
+			SortKeyEntry(uint64 k, Renderable* rend, Pass* p)
+				: key(k), renderable(rend), pass(p) {}
+		};
+		typedef vector<SortKeyEntry>::type SortKeyEntryList;
+
 		/// Bitmask of the organisation modes requested
 		uint8 mOrganisationMode;
 
@@ -238,6 +264,17 @@ namespace Ogre {
 		PassGroupRenderableMap mGrouped;
 		/// Sorted descending (can iterate backwards to get ascending)
 		RenderablePassList mSortedDescending;
+		/// Sorted by key
+		SortKeyEntryList mSortKeyed;
+		/// Scratch area of the key radix sort, kept to avoid reallocating it
+		SortKeyEntryList mSortKeyedScratch;
+		typedef HashMap<const Pass*, uint32> PassRankMap;
+		/// Passes of mSortKeyed in key order, and their rank, built by sortByKey
+		vector<Pass*>::type mSortKeyPasses;
+		PassRankMap mSortKeyPassRanks;
+
+		/// Builds the keys from the passes and depths and sorts mSortKeyed
+		void sortByKey(const Camera* cam);
 
 		/// Internal visitor implementation
 		void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
@@ -245,6 +282,8 @@ namespace Ogre {
 		void acceptVisitorDescending(QueuedRenderableVisitor* visitor) const;
 		/// Internal visitor implementation
 		void acceptVisitorAscending(QueuedRenderableVisitor* visitor) const;
+		/// Internal visitor implementation
+		void acceptVisitorSortKey(QueuedRenderableVisitor* visitor) const;
 
 	public:
 		QueuedRenderableCollection();
@@ -0,0 +1,258 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __RenderStateCache_H__
+#define __RenderStateCache_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreCommon.h"
+#include "OgreBlendMode.h"
+#include "OgreColourValue.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup RenderSystem
+	*  @{
+	*/
+	/** Filters render state changes which would not change anything.
+	@remarks
+		SceneManager::_setPass sets every piece of fixed pipeline state of a
+		pass, even when the previous pass used the same values. This class
+		sits between the SceneManager and the RenderSystem, remembers the last
+		values passed to each state setter and only forwards the calls which
+		change something.
+	@par
+		Texture units are remembered by TextureUnitState and texture, so a
+		TextureUnitState must not be changed while it may still be bound
+		without calling invalidate().
+	@par
+		The cache only knows about the calls made through it, so whenever
+		something else may have changed the state of the RenderSystem (a new
+		frame, a listener, another SceneManager) the affected states must be
+		invalidated. When disabled every call is forwarded, the counters are
+		still updated.
+	*/
+	class _OgreExport RenderStateCache : public RenderSysAlloc
+	{
+	public:
+		/// Groups of states which can be invalidated separately
+		enum CachedState
+		{
+			CS_SURFACE = 0x1,
+			CS_LIGHTING = 0x2,
+			CS_FOG = 0x4,
+			CS_BLENDING = 0x8,
+			CS_POINT_PARAMETERS = 0x10,
+			CS_POINT_SPRITES = 0x20,
+			CS_TEXTURE_UNITS = 0x40,
+			CS_DEPTH_FUNCTION = 0x80,
+			CS_DEPTH_CHECK = 0x100,
+			CS_DEPTH_WRITE = 0x200,
+			CS_DEPTH_BIAS = 0x400,
+			CS_ALPHA_REJECT = 0x800,
+			CS_COLOUR_WRITE = 0x1000,
+			CS_CULLING = 0x2000,
+			CS_SHADING = 0x4000,
+			CS_POLYGON_MODE = 0x8000,
+
+			CS_ALL = 0xFFFF
+		};
+
+		RenderStateCache();
+
+		/// Sets the RenderSystem the calls are forwarded to, invalidates everything
+		void setRenderSystem(RenderSystem* rs);
+		/// Gets the RenderSystem the calls are forwarded to
+		RenderSystem* getRenderSystem(void) const { return mRenderSystem; }
+
+		/** Sets whether redundant calls are filtered, invalidates everything.
+		@note Disabled by default
+		*/
+		void setEnabled(bool enabled);
+		/// Gets whether redundant calls are filtered
+		bool getEnabled(void) const { return mEnabled; }
+
+		/** Forgets the values of some states, so that the next call setting
+			them is forwarded.
+		@param states Combination of CachedState values
+		*/
+		void invalidate(uint32 states = CS_ALL);
+		/** Forgets the settings of one texture unit, so that the next
+			setTextureUnitSettings on it is forwarded.
+		@remarks
+			For settings which depend on more than the TextureUnitState and
+			its texture, such as view relative texture coordinate generation
+			or projective texturing from a light.
+		*/
+		void invalidateTextureUnit(size_t texUnit);
+
+		/// Number of calls forwarded to the RenderSystem since the last reset
+		size_t getIssuedCount(void) const { return mIssuedCount; }
+		/// Number of calls filtered out since the last reset
+		size_t getFilteredCount(void) const { return mFilteredCount; }
+		/// Resets the counters
+		void resetStatistics(void);
+
+		/// @see RenderSystem::_setSurfaceParams
+		void setSurfaceParams(const ColourValue& ambient,
+			const ColourValue& diffuse, const ColourValue& specular,
+			const ColourValue& emissive, Real shininess,
+			TrackVertexColourType tracking);
+		/// @see RenderSystem::setLightingEnabled
+		void setLightingEnabled(bool enabled);
+		/// @see RenderSystem::_setFog
+		void setFog(FogMode mode, const ColourValue& colour, Real expDensity,
+			Real linearStart, Real linearEnd);
+		/// @see RenderSystem::_setSceneBlending
+		void setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+			SceneBlendOperation op);
+		/// @see RenderSystem::_setSeparateSceneBlending
+		void setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+			SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha,
+			SceneBlendOperation op, SceneBlendOperation alphaOp);
+		/// @see RenderSystem::_setPointParameters
+		void setPointParameters(Real size, bool attenuationEnabled,
+			Real constant, Real linear, Real quadratic, Real minSize, Real maxSize);
+		/// @see RenderSystem::_setPointSpritesEnabled
+		void setPointSpritesEnabled(bool enabled);
+		/// @see RenderSystem::_setTextureUnitSettings
+		void setTextureUnitSettings(size_t texUnit, TextureUnitState& tl);
+		/// @see RenderSystem::_disableTextureUnitsFrom
+		void disableTextureUnitsFrom(size_t texUnit);
+		/// @see RenderSystem::_setDepthBufferParams
+		void setDepthBufferParams(bool depthTest = true, bool depthWrite = true,
+			CompareFunction depthFunction = CMPF_LESS_EQUAL);
+		/// @see RenderSystem::_setDepthBufferFunction
+		void setDepthBufferFunction(CompareFunction func);
+		/// @see RenderSystem::_setDepthBufferCheckEnabled
+		void setDepthBufferCheckEnabled(bool enabled);
+		/// @see RenderSystem::_setDepthBufferWriteEnabled
+		void setDepthBufferWriteEnabled(bool enabled);
+		/// @see RenderSystem::_setDepthBias
+		void setDepthBias(float constantBias, float slopeScaleBias);
+		/// @see RenderSystem::_setAlphaRejectSettings
+		void setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage);
+		/// @see RenderSystem::_setColourBufferWriteEnabled
+		void setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha);
+		/// @see RenderSystem::_setCullingMode
+		void setCullingMode(CullingMode mode);
+		/// @see RenderSystem::setShadingType
+		void setShadingType(ShadeOptions so);
+		/// @see RenderSystem::_setPolygonMode
+		void setPolygonMode(PolygonMode mode);
+
+	protected:
+		/** Returns whether a call setting states to a new value must be forwarded
+			and updates the counters.
+		@param states The states set by the call
+		@param unchanged Whether the values are those of the last forwarded call
+		*/
+		bool mustIssue(uint32 states, bool unchanged)
+		{
+			if (mEnabled && unchanged && (mValidStates & states) == states)
+			{
+				++mFilteredCount;
+				return false;
+			}
+			mValidStates |= states;
+			++mIssuedCount;
+			return true;
+		}
+
+		RenderSystem* mRenderSystem;
+		bool mEnabled;
+		/// Combination of CachedState values whose value below is known
+		uint32 mValidStates;
+		size_t mIssuedCount;
+		size_t mFilteredCount;
+
+		ColourValue mAmbient;
+		ColourValue mDiffuse;
+		ColourValue mSpecular;
+		ColourValue mEmissive;
+		Real mShininess;
+		TrackVertexColourType mTracking;
+
+		bool mLightingEnabled;
+
+		FogMode mFogMode;
+		ColourValue mFogColour;
+		Real mFogDensity;
+		Real mFogStart;
+		Real mFogEnd;
+
+		bool mSeparateBlending;
+		SceneBlendFactor mSourceBlendFactor;
+		SceneBlendFactor mDestBlendFactor;
+		SceneBlendFactor mSourceBlendFactorAlpha;
+		SceneBlendFactor mDestBlendFactorAlpha;
+		SceneBlendOperation mBlendOperation;
+		SceneBlendOperation mAlphaBlendOperation;
+
+		Real mPointSize;
+		bool mPointAttenuationEnabled;
+		Real mPointAttenuationConstant;
+		Real mPointAttenuationLinear;
+		Real mPointAttenuationQuadratic;
+		Real mPointMinSize;
+		Real mPointMaxSize;
+
+		bool mPointSpritesEnabled;
+
+		/// Texture unit states and textures bound to each unit, null if unknown
+		const TextureUnitState* mTextureUnits[OGRE_MAX_TEXTURE_LAYERS];
+		const Texture* mTextures[OGRE_MAX_TEXTURE_LAYERS];
+		/// All the texture units from this one are known to be disabled
+		size_t mDisabledTextureUnitsFrom;
+
+		CompareFunction mDepthFunction;
+		bool mDepthCheckEnabled;
+		bool mDepthWriteEnabled;
+		float mDepthBiasConstant;
+		float mDepthBiasSlopeScale;
+
+		CompareFunction mAlphaRejectFunction;
+		unsigned char mAlphaRejectValue;
+		bool mAlphaToCoverage;
+
+		bool mColourWrite[4];
+		CullingMode mCullingMode;
+		ShadeOptions mShadingType;
+		PolygonMode mPolygonMode;
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -1109,6 +1109,12 @@ namespace Ogre
 		virtual unsigned int _getBatchCount(void) const;
 		/** Reports the number of vertices passed to the renderer since the last _beginGeometryCount call. */
 		virtual unsigned int _getVertexCount(void) const;
+		/** Reports the number of bytes of GPU program constants uploaded during
+			the last frame, i.e. the last _updateAllRenderTargets call.
+		@remarks
+			Only counted by the render systems which track it.
+		*/
+		size_t _getGpuProgramParameterBytes(void) const { return mLastFrameGpuProgramParameterBytes; }
 
 		/** Generates a packed data version of the passed in ColourValue suitable for
 		use as with this RenderSystem.
@@ -1618,6 +1624,22 @@ namespace Ogre
 		size_t mBatchCount;
 		size_t mFaceCount;
 		size_t mVertexCount;
+		/// Bytes of GPU program constants uploaded during the current frame
+		size_t mGpuProgramParameterBytes;
+		/// Bytes of GPU program constants uploaded during the last frame
+		size_t mLastFrameGpuProgramParameterBytes;
+
+		/// Counts constants uploaded by bindGpuProgramParameters in the current frame
+		void addGpuProgramParameterBytes(size_t bytes) { mGpuProgramParameterBytes += bytes; }
+		/** Returns the bytes of the constants bindGpuProgramParameters sends for
+			the given parameters and variability, for render systems which do not
+			count them as they upload.
+		@param onlyChanged Whether the render system skips the constants which did
+			not change since the last upload (see GpuProgramParameters::_isUploadRequired)
+			or sends every constant of the variability
+		*/
+		size_t calculateGpuProgramParameterBytes(const GpuProgramParametersSharedPtr& params,
+			uint16 variabilityMask, bool onlyChanged = true) const;
 
 		/// Saved manual colour blends
 		ColourValue mManualBlendColours[OGRE_MAX_TEXTURE_LAYERS][2];
@@ -305,6 +305,8 @@ namespace Ogre {
         ResourceGroupListenerList mResourceGroupListenerList;
 
 		ResourceLoadingListener *mLoadingListener;
+		/// Whether loadResourceGroup prepares the resources concurrently first
+		bool mParallelPrepare;
 
         /// Resource index entry, resourcename->location 
         typedef map<String, Archive*>::type ResourceLocationIndex;
@@ -570,6 +572,41 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
 			bool loadWorldGeom = true);
 
+		/** Prepares the resources of several resource groups concurrently.
+		@remarks
+			Calls Resource::prepare on every resource of the groups which is
+			not loaded yet, distributing them across the worker threads of
+			the WorkQueue (see ParallelFor). Preparing is where resources do
+			the work which does not involve the GPU, such as reading and
+			parsing their files: a Mesh parses its .mesh file and loads its
+			skeleton, a Texture reads and decodes its images. Loading the
+			groups afterwards only has the GPU work left to do, in order on
+			the calling thread.
+		@par
+			Manually loaded resources are left to be prepared when loaded, as
+			their loaders may not expect to be called from other threads. No
+			ResourceGroupListener nor Resource::Listener events are fired, and
+			a resource which fails to prepare is left unloaded, so that the
+			error is raised when it is loaded.
+		@note
+			Must not be called while holding the lock of this manager or of one
+			of the groups, which the preparing threads need to open files.
+		@param names The names of the resource groups to prepare
+		*/
+		void prepareResourceGroupsParallel(const StringVector& names);
+
+		/** Sets whether loadResourceGroup first prepares the resources of the
+			group concurrently.
+		@remarks
+			When enabled, loadResourceGroup calls prepareResourceGroupsParallel
+			for the group before loading its resources as usual, see the
+			restrictions there.
+		@note Disabled by default
+		*/
+		void setParallelPrepare(bool enabled) { mParallelPrepare = enabled; }
+		/// Gets whether loadResourceGroup first prepares the resources concurrently
+		bool getParallelPrepare(void) const { return mParallelPrepare; }
+
         /** Unloads a resource group.
         @remarks
             This method unloads all the resources that have been declared as
@@ -97,7 +97,9 @@ namespace Ogre
         
         ArchiveFactory *mZipArchiveFactory;
         ArchiveFactory *mEmbeddedZipArchiveFactory;
+        ArchiveFactory *mMappedZipArchiveFactory;
         ArchiveFactory *mFileSystemArchiveFactory;
+        ArchiveFactory *mPackArchiveFactory;
         
 #if OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
         AndroidLogListener* mAndroidLogger;
@@ -55,6 +55,8 @@ Torus Knot Software Ltd.
 #include "OgreLodListener.h"
 #include "OgreInstanceManager.h"
 #include "OgreRenderSystem.h"
+#include "OgreRenderStateCache.h"
+#include "OgreSkeletonPoseCache.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreNameGenerator.h"
 
@@ -875,6 +877,90 @@ namespace Ogre {
 		uint32 mVisibilityMask;
 		bool mFindVisibleObjects;
 
+		/// Update the scene graph on the WorkQueue threads?
+		bool mParallelSceneGraphUpdate;
+		/// Nodes updated on this thread to split the scene graph, in breadth first order
+		vector<SceneNode*>::type mSceneGraphUpdateSplitNodes;
+		/// Subtrees collected while splitting the scene graph
+		Node::PendingUpdateList mSceneGraphUpdateSubtrees;
+
+		/** Updates the scene graph from the root, distributing independent
+			subtrees across the threads of the WorkQueue.
+		*/
+		virtual void updateSceneGraphParallel(void);
+
+		/// Update the scene graph one level at a time with a NodeTransformPool?
+		bool mBatchedSceneGraphUpdate;
+		/// Pool used by batched scene graph updates, created on first use
+		NodeTransformPool* mNodeTransformPool;
+
+		/** Updates the scene graph from the root with mNodeTransformPool, then
+			updates the bounds of the visited nodes deepest first.
+		*/
+		virtual void updateSceneGraphBatched(void);
+
+		/// Update only the nodes marked dirty since the last update?
+		bool mIncrementalSceneGraphUpdate;
+		/// Whether every node needing an update is in mDirtySceneNodes
+		bool mDirtySceneNodesComplete;
+		/// Nodes marked dirty since the last update, in no particular order
+		vector<SceneNode*>::type mDirtySceneNodes;
+		typedef std::pair<size_t, SceneNode*> DepthSceneNode;
+		/// Dirty nodes or their ancestors with their depth, sorted by depth
+		vector<DepthSceneNode>::type mDepthSortedSceneNodes;
+
+		/** Updates the dirty nodes shallowest first, then the bounds of their
+			ancestors deepest first.
+		*/
+		virtual void updateSceneGraphIncremental(void);
+
+		/// Cull the scene graph on the WorkQueue threads?
+		bool mParallelFrustumCulling;
+		/// Depth below which subtrees are culled on the worker threads
+		size_t mFrustumCullingSplitDepth;
+		/// Entries found while splitting the scene graph, in traversal order
+		SceneNode::VisibleObjectEntryList mFrustumCullingEntries;
+		/// Subtrees culled on the worker threads
+		vector<SceneNode*>::type mFrustumCullingSubtrees;
+		/// Index in mFrustumCullingEntries before which the entries of each subtree belong
+		vector<size_t>::type mFrustumCullingSubtreePositions;
+		/// Entries found in each subtree
+		vector<SceneNode::VisibleObjectEntryList>::type mFrustumCullingSubtreeEntries;
+
+		/** Finds the visible objects of the scene graph like _findVisibleObjects,
+			distributing independent subtrees across the threads of the WorkQueue.
+		*/
+		virtual void findVisibleObjectsParallel(Camera* cam,
+			VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
+		/// Culls the top of the scene graph on this thread, collecting the subtrees
+		void splitFrustumCulling(SceneNode* node, const Camera* cam, size_t depth);
+
+		/// Render state changes are sent to mDestRenderSystem through this
+		RenderStateCache mRenderStateCache;
+
+		/// Collect the software skinning of visible entities?
+		bool mBatchedSoftwareSkinning;
+		/// Whether visible objects are being searched for with mBatchedSoftwareSkinning
+		bool mCollectingSoftwareSkinning;
+		/// Blends collected while searching for visible objects, created on first use
+		SoftwareVertexBlendBatch* mSoftwareVertexBlendBatch;
+
+		/// Evaluate the skeletons of entities in batches?
+		bool mBatchedSkeletonAnimation;
+		typedef vector<SkeletonPoseBatch*>::type SkeletonPoseBatchList;
+		/// Batches reused from frame to frame, one per skeleton animated in a frame
+		SkeletonPoseBatchList mSkeletonPoseBatches;
+		/// Evaluate the skeletons of entities on the threads of the WorkQueue?
+		bool mParallelAnimationUpdate;
+		/// Entities whose skeleton is evaluated on its own by updateSkeletonPoses
+		vector<Entity*>::type mSkeletonUpdateEntities;
+		/** Evaluates the bone matrices of the entities, through
+			mSkeletonPoseBatches and/or on the threads of the WorkQueue.
+		*/
+		virtual void updateSkeletonPoses(void);
+		/// Identical poses of entities are shared through this
+		SkeletonPoseCache mSkeletonPoseCache;
+
 		/// Suppress render state changes?
 		bool mSuppressRenderStateChanges;
 		/// Suppress shadows?
@@ -2570,6 +2656,16 @@ namespace Ogre {
         /** Internal method for notifying the manager that a SceneNode is autotracking. */
         virtual void _notifyAutotrackingSceneNode(SceneNode* node, bool autoTrack);
 
+		/** Internal method for notifying the manager that a SceneNode needs an
+			update, see setIncrementalSceneGraphUpdate.
+		*/
+		virtual void _notifySceneNodeDirty(SceneNode* node);
+
+		/** Internal method for notifying the manager that a SceneNode marked
+			dirty no longer needs an update, e.g. because it is being destroyed.
+		*/
+		virtual void _notifySceneNodeClean(SceneNode* node);
+
         
         /** Creates an AxisAlignedBoxSceneQuery for this scene manager. 
         @remarks
@@ -3356,6 +3452,234 @@ namespace Ogre {
  		*/
 		virtual bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+		/** Sets whether _updateSceneGraph should update node transforms and
+			bounds on the worker threads of the WorkQueue.
+		@remarks
+			The hierarchy is split into independent subtrees near the root, which
+			are then updated concurrently; the call only returns once all of them
+			are done, so the scene graph is complete before visible objects are
+			searched for. The resulting transforms are identical to a serial
+			update, however Node::Listener::nodeUpdated and
+			MovableObject::Listener::objectMoved may then be called from worker
+			threads, in no particular order. Only enable this if your listeners
+			and custom MovableObject bounds are safe to call concurrently.
+		@par
+			Has no effect if the SceneManager does not support it (see
+			isParallelSceneGraphUpdateSupported) or if OGRE was built without
+			thread support. Disabled by default.
+		*/
+		virtual void setParallelSceneGraphUpdate(bool parallel) { mParallelSceneGraphUpdate = parallel; }
+
+		/** Gets whether _updateSceneGraph should update nodes on the worker threads.
+		*/
+		virtual bool getParallelSceneGraphUpdate(void) const { return mParallelSceneGraphUpdate; }
+
+		/** Returns whether the nodes of this SceneManager can be updated concurrently.
+		@remarks
+			SceneManagers whose nodes modify shared structures while being
+			updated (e.g. to reposition themselves in a spatial tree) must
+			return false.
+		*/
+		virtual bool isParallelSceneGraphUpdateSupported(void) const { return true; }
+
+		/** Sets whether _updateSceneGraph should derive node transforms a whole
+			level of the hierarchy at a time.
+		@remarks
+			The transforms of all the nodes of one depth are derived together
+			using SIMD instructions where available (see NodeTransformPool),
+			instead of one node at a time while walking the hierarchy. This is
+			faster for scene graphs with many moving nodes. If parallel scene
+			graph updates are enabled too, large levels are also split across
+			the threads of the WorkQueue.
+		@par
+			Has no effect if the SceneManager does not support it (see
+			isBatchedSceneGraphUpdateSupported). Disabled by default.
+		*/
+		virtual void setBatchedSceneGraphUpdate(bool batched) { mBatchedSceneGraphUpdate = batched; }
+
+		/** Gets whether _updateSceneGraph derives node transforms a level at a time.
+		*/
+		virtual bool getBatchedSceneGraphUpdate(void) const { return mBatchedSceneGraphUpdate; }
+
+		/** Returns whether the nodes of this SceneManager can be updated a level
+			at a time.
+		@remarks
+			SceneManagers whose nodes customise Node::_update or
+			Node::updateFromParentImpl must return false.
+		*/
+		virtual bool isBatchedSceneGraphUpdateSupported(void) const { return true; }
+
+		/** Sets whether _updateSceneGraph should only update the nodes which
+			changed since the last update.
+		@remarks
+			Normally the scene graph is walked from the root down to every node
+			which changed, through the children each node has been told need an
+			update. Instead the SceneManager can keep a list of the nodes which
+			changed; only these nodes and their descendants are then updated,
+			shallowest first, after which the bounds of their ancestors are
+			refreshed deepest first. The cost of the update then depends on the
+			number of moving nodes rather than on the size of the scene graph,
+			which suits large scenes of mostly static nodes.
+		@par
+			Takes precedence over batched and parallel scene graph updates. The
+			first update after enabling it updates the whole scene graph. Has no
+			effect if the SceneManager does not support it (see
+			isIncrementalSceneGraphUpdateSupported). Disabled by default.
+		*/
+		virtual void setIncrementalSceneGraphUpdate(bool incremental);
+
+		/** Gets whether _updateSceneGraph only updates the nodes which changed.
+		*/
+		virtual bool getIncrementalSceneGraphUpdate(void) const { return mIncrementalSceneGraphUpdate; }
+
+		/** Returns whether the nodes of this SceneManager can be updated
+			incrementally.
+		@remarks
+			SceneManagers which need every node to be reached from the root
+			when updating the scene graph must return false.
+		*/
+		virtual bool isIncrementalSceneGraphUpdateSupported(void) const { return true; }
+
+		/** Sets whether visible objects should be searched for on the worker
+			threads of the WorkQueue.
+		@remarks
+			Culling the nodes against the camera is split across the threads,
+			each subtree recording what it finds in its own list. The lists
+			are then merged in scene graph order on the calling thread, which
+			is also where the objects are notified of the camera and queued,
+			so the render queue is filled exactly as in a serial search. This
+			pays off when many nodes are culled per frame, e.g. with several
+			viewports or shadow cameras.
+		@par
+			Camera::isVisible is called concurrently, so custom cameras must
+			allow that. Scene nodes of a derived type are searched on the
+			calling thread through their _findVisibleObjects, when they are
+			reached in the merge. SceneManagers that search for visible objects
+			in their own way may or may not take this setting into account.
+			Disabled by default.
+		*/
+		virtual void setParallelFrustumCulling(bool parallel) { mParallelFrustumCulling = parallel; }
+
+		/** Gets whether visible objects are searched for on the worker threads.
+		*/
+		virtual bool getParallelFrustumCulling(void) const { return mParallelFrustumCulling; }
+
+		/** Sets whether render state changes which would not change anything
+			are filtered out before reaching the RenderSystem.
+		@remarks
+			Passes sharing much of their state, such as the passes of many
+			similar materials, then only cost the calls which differ. The cache
+			is reset at the start of every frame and after render queue
+			listeners have been called. Code which changes the state of the
+			RenderSystem directly in between, for example in
+			Renderable::preRender or while rendering manually, must invalidate
+			it, see getRenderStateCache. Disabled by default.
+		*/
+		virtual void setRenderStateCacheEnabled(bool enabled) { mRenderStateCache.setEnabled(enabled); }
+
+		/** Gets whether redundant render state changes are filtered out.
+		*/
+		virtual bool getRenderStateCacheEnabled(void) const { return mRenderStateCache.getEnabled(); }
+
+		/** Gets the cache render state changes go through, to invalidate it
+			or read how many changes were issued and filtered.
+		*/
+		RenderStateCache& getRenderStateCache(void) { return mRenderStateCache; }
+
+		/** Sets whether the software skinning of the entities found visible
+			should be performed together, on the worker threads of the WorkQueue.
+		@remarks
+			Instead of blending its vertices as soon as it is queued, each
+			software skinned entity adds its blends to a SoftwareVertexBlendBatch
+			while visible objects are searched for. The whole batch is then
+			executed before rendering, distributed across the threads (see
+			ParallelFor). This pays off when many entities are skinned in
+			software, e.g. without hardware skinning support. Disabled by default.
+		*/
+		virtual void setBatchedSoftwareSkinning(bool batched) { mBatchedSoftwareSkinning = batched; }
+
+		/** Gets whether the software skinning of visible entities is performed together.
+		*/
+		virtual bool getBatchedSoftwareSkinning(void) const { return mBatchedSoftwareSkinning; }
+
+		/** Returns the batch software vertex blends should be added to rather
+			than performed immediately, or null if they must be performed now.
+		@note Internal method used by Entity while visible objects are searched for.
+		*/
+		SoftwareVertexBlendBatch* _getSoftwareVertexBlendBatch(void);
+
+		/** Sets whether the bone matrices of skeletally animated entities
+			should be evaluated together, for all the entities sharing a skeleton.
+		@remarks
+			Once per frame, after the scene animations have been applied, the
+			entities are grouped by skeleton and each group is evaluated by a
+			SkeletonPoseBatch, which avoids the per bone node overhead of
+			Skeleton::setAnimationState. This pays off for crowds of entities
+			sharing few skeletons. Entities are evaluated whether they turn out
+			visible or not, and those whose bones are needed for something else
+			than skinning (see Entity::_isSkeletonPoseBatchable) are still
+			evaluated when rendered. The bones of batched skeleton instances are
+			not updated. Disabled by default.
+		*/
+		virtual void setBatchedSkeletonAnimation(bool batched) { mBatchedSkeletonAnimation = batched; }
+
+		/** Gets whether the bone matrices of entities are evaluated together.
+		*/
+		virtual bool getBatchedSkeletonAnimation(void) const { return mBatchedSkeletonAnimation; }
+
+		/** Sets whether the skeletons of animated entities should be evaluated
+			on the worker threads of the WorkQueue.
+		@remarks
+			Once per frame, once the scene graph has been updated and before
+			visible objects are searched for, the bone matrices, bones and tag
+			points of every entity in the scene which is skeletally animated and
+			visible are evaluated in parallel (see ParallelFor), entities sharing
+			a skeleton instance being evaluated once. The batches of
+			setBatchedSkeletonAnimation are distributed too. This stage ends
+			before visible objects are searched for, so rendering only sees
+			finished poses. Node listeners of bones and tag points, and object
+			listeners of objects attached to tag points, are then called from
+			the worker threads.
+		@par
+			Visibility is only known once objects are culled, after this
+			stage, so entities outside of the view frustum are evaluated
+			too, while rendering alone would skip them. Hide entities known
+			to be out of sight (see MovableObject::setVisible), or use the
+			animation level of detail, to leave them out.
+		@par
+			Vertex and pose animations, as well as software skinning, write to
+			hardware buffers and are therefore still applied when entities are
+			rendered, on the calling thread (see setBatchedSoftwareSkinning).
+			Disabled by default.
+		*/
+		virtual void setParallelAnimationUpdate(bool parallel) { mParallelAnimationUpdate = parallel; }
+
+		/** Gets whether the skeletons of entities are evaluated on worker threads.
+		*/
+		virtual bool getParallelAnimationUpdate(void) const { return mParallelAnimationUpdate; }
+
+		/** Sets whether entities playing the same animations at the same time
+			should share their bone matrices.
+		@remarks
+			The first entity to evaluate a pose in a frame stores its bone
+			matrices in the SkeletonPoseCache of this scene manager, entities
+			evaluating the same pose later in the frame (including through
+			setBatchedSkeletonAnimation) copy them. Time positions are compared
+			after rounding to the time quantum of the cache, see
+			getSkeletonPoseCache. Like batched evaluation, this only applies to
+			entities whose bones are only used for skinning. Disabled by default.
+		*/
+		virtual void setSkeletonPoseCacheEnabled(bool enabled) { mSkeletonPoseCache.setEnabled(enabled); }
+
+		/** Gets whether entities share the bone matrices of identical poses.
+		*/
+		virtual bool getSkeletonPoseCacheEnabled(void) const { return mSkeletonPoseCache.getEnabled(); }
+
+		/** Gets the cache identical poses are shared through, to set its time
+			quantum or read its hit rate.
+		*/
+		SkeletonPoseCache& getSkeletonPoseCache(void) { return mSkeletonPoseCache; }
+
 		/** Set whether to automatically normalise normals on objects whenever they
 			are scaled.
 		@remarks
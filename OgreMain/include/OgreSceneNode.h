@@ -61,6 +61,24 @@ namespace Ogre {
         typedef HashMap<String, MovableObject*> ObjectMap;
         typedef MapIterator<ObjectMap> ObjectIterator;
 		typedef ConstMapIterator<ObjectMap> ConstObjectIterator;
+		/** What _findVisibleObjectEntries found, see _addVisibleObjectEntryToQueue.
+		*/
+		struct VisibleObjectEntry
+		{
+			SceneNode* node;
+			/// Object found visible, or null when the node's own debug renderables are due
+			MovableObject* object;
+			/** Whether node is of a derived type, whose _findVisibleObjects
+				is called instead of culling it with the others.
+			*/
+			bool deferred;
+
+			VisibleObjectEntry(SceneNode* n, MovableObject* o, bool d = false)
+				: node(n), object(o), deferred(d)
+			{
+			}
+		};
+		typedef vector<VisibleObjectEntry>::type VisibleObjectEntryList;
 
     protected:
         ObjectMap mObjectsByName;
@@ -80,6 +98,28 @@ namespace Ogre {
         /** @copydoc Node::updateFromParentImpl. */
         void updateFromParentImpl(void) const;
 
+        /// Number of children tested against the camera at once
+        static const size_t CHILD_CULLING_BATCH = 32;
+
+        /// _findVisibleObjects once this node is known to be visible
+        void findVisibleObjectsImpl(Camera* cam, RenderQueue* queue,
+            VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren,
+            bool displayNodes, bool onlyShadowCasters);
+        /// _findVisibleObjectEntries once this node is known to be visible
+        void findVisibleObjectEntriesImpl(const Camera* cam, VisibleObjectEntryList& entries);
+        /** Tests the next children (up to CHILD_CULLING_BATCH) against the
+            camera at once, advancing the iterator.
+        @param children Receives the children tested
+        @param visibility Bit i is set if children[i] is visible
+        @return The number of children written to children
+        */
+        size_t cullChildren(const Camera* cam, ChildNodeList::iterator& child,
+            SceneNode** children, uint32& visibility);
+
+        /** @copydoc Node::setDerivedTransformImpl. */
+        void setDerivedTransformImpl(const Vector3& position,
+            const Quaternion& orientation, const Vector3& scale);
+
         /** See Node. */
         Node* createChildImpl(void);
 
@@ -107,6 +147,10 @@ namespace Ogre {
         Vector3 mAutoTrackLocalDirection;
 		/// Is this node a current part of the scene graph?
 		bool mIsInSceneGraph;
+		/// Is this node in the dirty list of its creator?
+		bool mInDirtyList;
+		/// Index of this node in the dirty list of its creator, if in it
+		size_t mIndexInDirtyList;
     public:
         /** Constructor, only to be called by the creator SceneManager.
         @remarks
@@ -188,6 +232,26 @@ namespace Ogre {
 		*/
 		virtual void _updateBounds(void);
 
+		/** @copydoc Node::needUpdate
+		@remarks
+			Also adds this node to the dirty list of its creator when it updates
+			the scene graph incrementally, see
+			SceneManager::setIncrementalSceneGraphUpdate.
+		*/
+		virtual void needUpdate(bool forceParentUpdate = false);
+
+		/** Sets whether this node is in the dirty list of its creator, and
+			at which index.
+		@remarks
+			Only SceneManager should call this!
+		*/
+		void _setInDirtyList(bool listed, size_t index = 0)
+		{ mInDirtyList = listed; mIndexInDirtyList = index; }
+		/// Gets whether this node is in the dirty list of its creator
+		bool _isInDirtyList(void) const { return mInDirtyList; }
+		/// Gets the index of this node in the dirty list of its creator
+		size_t _getIndexInDirtyList(void) const { return mIndexInDirtyList; }
+
         /** Internal method which locates any visible objects attached to this node and adds them to the passed in queue.
             @remarks
                 Should only be called by a SceneManager implementation, and only after the _updat method has been called to
@@ -210,6 +274,37 @@ namespace Ogre {
 			VisibleObjectsBoundsInfo* visibleBounds, 
             bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
 
+        /** Internal method which culls this node and its children like
+            _findVisibleObjects, but only records what it finds.
+        @remarks
+            Each object attached to a visible node is appended to the list,
+            followed by the entries of the children and finally by an entry
+            for the node itself with a null object, in the same order as
+            _findVisibleObjects would have added them to the queue. Children of
+            a derived type, which may override _findVisibleObjects, are only
+            recorded as deferred entries. Nothing but the list is modified, so
+            that independent subtrees can be culled concurrently; the entries
+            are then passed to _addVisibleObjectEntryToQueue in order on a
+            single thread.
+        @param cam The active camera, its frustum planes must be up to date
+        @param entries List which receives the results
+        */
+        virtual void _findVisibleObjectEntries(const Camera* cam, VisibleObjectEntryList& entries);
+
+        /** Internal method which adds an entry found by _findVisibleObjectEntries
+            to the queue, as _findVisibleObjects would have.
+        @remarks
+            For a deferred entry this calls _findVisibleObjects on the node.
+        */
+        static void _addVisibleObjectEntryToQueue(const VisibleObjectEntry& entry,
+            Camera* cam, RenderQueue* queue, VisibleObjectsBoundsInfo* visibleBounds,
+            bool displayNodes, bool onlyShadowCasters);
+
+        /** Internal method which adds the axes and bounding box of this node
+            to the queue where they are to be displayed.
+        */
+        virtual void _addDebugRenderablesToQueue(RenderQueue* queue, bool displayNodes);
+
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
             Recommended only if you are extending a SceneManager, because the bounding box returned
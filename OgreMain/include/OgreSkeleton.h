@@ -302,6 +302,16 @@ namespace Ogre {
 		*/
 		virtual void optimiseAllAnimations(bool preservingIdentityNodeTracks = false);
 
+		/** Replaces the node tracks of all of this skeleton's animations by
+			compressed versions of them.
+		@remarks
+			Base keyframes of every animation are applied before any is
+			compressed, since they may refer to each other.
+		@see Animation::compressNodeTracks
+		*/
+		virtual void compressAllAnimations(const CompressedNodeAnimationTrack::Tolerances& tolerances =
+			CompressedNodeAnimationTrack::Tolerances());
+
 		/** Allows you to use the animations from another Skeleton object to animate
 			this skeleton.
 		@remarks
@@ -358,6 +368,29 @@ namespace Ogre {
 		/// Are there any manually controlled bones?
 		virtual bool hasManualBones(void) const { return !mManualBones.empty(); }
 
+		/// One flag per bone handle
+		typedef vector<bool>::type BoneMask;
+
+		/** Sets the bones whose animation tracks are ignored when animations
+			are applied to this skeleton.
+		@remarks
+			Disabled bones keep their initial transform relative to their
+			parent, their children still being animated unless disabled too.
+			Used by the animation level of detail of Entity to stop animating
+			small bones such as fingers in the distance.
+		@param disabledBones Null to animate all the bones, otherwise true for
+			each bone handle to leave alone. Not copied, must remain valid
+			while set.
+		*/
+		void _setDisabledBones(const BoneMask* disabledBones) { mDisabledBones = disabledBones; }
+		/// Gets the bones whose animation tracks are ignored, null if none
+		const BoneMask* _getDisabledBones(void) const { return mDisabledBones; }
+		/// Returns whether the animation tracks of a bone are ignored
+		bool _isBoneDisabled(unsigned short handle) const
+		{
+			return mDisabledBones && handle < mDisabledBones->size() && (*mDisabledBones)[handle];
+		}
+
         /// Map to translate bone handle from one skeleton to another skeleton.
         typedef vector<ushort>::type BoneHandleMap;
 
@@ -430,6 +463,8 @@ namespace Ogre {
 		BoneSet mManualBones;
 		/// Manual bones dirty?
 		bool mManualBonesDirty;
+		/// Bones whose animation tracks are ignored, null if none
+		const BoneMask* mDisabledBones;
 
 
         /// Storage of animations, lookup by name
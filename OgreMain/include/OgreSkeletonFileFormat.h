@@ -101,6 +101,20 @@ namespace Ogre {
                     // Quaternion rotate            : Rotation to apply at this keyframe
                     // Vector3 translate            : Translation to apply at this keyframe
                     // Vector3 scale                : Scale to apply at this keyframe
+
+            SKELETON_ANIMATION_COMPRESSED_TRACK = 0x4200,
+            // [v1.90+] A compressed animation track (relates to a single bone),
+            // see CompressedNodeAnimationTrack
+            // Repeating section (within SKELETON_ANIMATION)
+
+                // unsigned short boneIndex     : Index of bone to apply to
+                // Then for each of the translate, rotate and scale channels:
+                    // unsigned short type          : CompressedNodeAnimationTrack::ChannelType
+                    // float base[4]                : Constant value or minimum of the keys
+                    // float step[3]                : Quantisation step of each component
+                    // unsigned int numKeys         : Number of keys
+                    // float times[numKeys]         : Time of each key (seconds)
+                    // unsigned short keys[numKeys * 3] : 3 quantised components per key
 		SKELETON_ANIMATION_LINK         = 0x5000
 		// Link to another skeleton, to re-use its animations
 
@@ -0,0 +1,206 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SkeletonPoseBatch_H__
+#define __SkeletonPoseBatch_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreAnimationState.h"
+#include "OgreAnimation.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Animation
+	*  @{
+	*/
+	/** Evaluates the bone matrices of many instances of the same Skeleton at
+		once.
+	@remarks
+		Skeleton::setAnimationState followed by Skeleton::_getBoneMatrices
+		resets, animates and updates every Bone node one at a time. This class
+		instead keeps the local and model space transforms of all the bones of
+		all the instances in flat structure of arrays buffers, one row of
+		instances per bone: the animation tracks are sampled and blended
+		straight into the local transforms, each bone is then derived from its
+		parent for all the instances at once with
+		OptimisedUtil::concatenateNodeTransforms (4 instances at a time with
+		SSE), and the offset matrices are built from the results. The matrices
+		are the same as those Skeleton::_getBoneMatrices would return after
+		Skeleton::setAnimationState.
+	@par
+		The Bone nodes of the instances are not updated, only their
+		inheritance flags are read, so instances with manually controlled bones, or whose bones are used for
+		anything else than skinning (tag points, skeleton display), must be
+		evaluated the usual way.
+	@par
+		The animation states and bone matrices given to add must remain valid
+		until the batch has been evaluated.
+	*/
+	class _OgreExport SkeletonPoseBatch : public AnimationAlloc
+	{
+	public:
+		SkeletonPoseBatch();
+		~SkeletonPoseBatch();
+
+		/** Sets the skeleton whose instances are evaluated and forgets all the
+			instances added.
+		@remarks
+			The bone hierarchy and binding pose are read at this point, so this
+			must be called again whenever the skeleton changes.
+		*/
+		void reset(Skeleton* skeleton);
+
+		/// Gets the skeleton whose instances are evaluated
+		Skeleton* getSkeleton(void) const { return mSkeleton; }
+
+		/** Adds an instance to evaluate on the next evaluate.
+		@param instance The skeleton instance the animation states apply to,
+			which provides the animations and blend mode. Its bones must be
+			those of the skeleton of the batch.
+		@param animSet The animation states to apply, as
+			Skeleton::setAnimationState would.
+		@param boneMatrices Receives one matrix per bone, as
+			Skeleton::_getBoneMatrices would.
+		*/
+		void add(const Skeleton* instance, const AnimationStateSet* animSet,
+			Matrix4* boneMatrices);
+
+		/** Copies bone matrices once the batch has been evaluated.
+		@remarks
+			Used to share the pose of an instance (see SkeletonPoseCache)
+			whose matrices may only be evaluated by this batch.
+		@param source Matrices to copy, one per bone.
+		@param dest Receives the copy.
+		*/
+		void addCopy(const Matrix4* source, Matrix4* dest);
+
+		/** Evaluates all the instances added since the last evaluate, performs
+			the copies and empties the batch.
+		@param parallel Whether the instances may be distributed across the
+			threads of the WorkQueue, see ParallelFor.
+		*/
+		void evaluate(bool parallel);
+
+		/// Forgets the instances and copies added since the last evaluate
+		void clear(void);
+
+		/// Returns the number of instances waiting to be evaluated
+		size_t getNumInstances(void) const { return mInstances.size(); }
+
+		/** Evaluates a range of the instances.
+		@note Internal method, begin and end are in blocks of 4 instances.
+		*/
+		void _evaluateBlocks(size_t begin, size_t end);
+
+	protected:
+		/// Bone data read from the skeleton by reset
+		struct BoneInfo
+		{
+			/// Handle of the parent bone, or NO_PARENT for a root bone
+			unsigned short parent;
+			Vector3 initialPosition;
+			Quaternion initialOrientation;
+			Vector3 initialScale;
+			Vector3 bindDerivedInversePosition;
+			Quaternion bindDerivedInverseOrientation;
+			Vector3 bindDerivedInverseScale;
+		};
+		typedef vector<BoneInfo>::type BoneInfoList;
+
+		/// An animation applied to an instance, resolved on the calling thread
+		struct Sample
+		{
+			Sample(Animation* anim, const TimeIndex& index, Real w, Real s,
+				const AnimationState::BoneBlendMask* mask)
+				: animation(anim), timeIndex(index), weight(w), scale(s), blendMask(mask)
+			{
+			}
+
+			Animation* animation;
+			TimeIndex timeIndex;
+			Real weight;
+			Real scale;
+			const AnimationState::BoneBlendMask* blendMask;
+		};
+		typedef vector<Sample>::type SampleList;
+
+		struct Instance
+		{
+			const Skeleton* skeleton;
+			const AnimationStateSet* animSet;
+			Matrix4* boneMatrices;
+			/// Range of the samples of this instance in mSamples
+			size_t firstSample;
+			size_t numSamples;
+		};
+		typedef vector<Instance>::type InstanceList;
+
+		static const unsigned short NO_PARENT = 0xFFFF;
+
+		/// Resolves the animations of every instance into mSamples
+		void prepare(void);
+		/// Makes sure the buffers can hold the given number of instances per bone
+		void reserve(size_t stride);
+		/// Adds the weighted transform of a track to a local transform, as
+		/// NodeAnimationTrack::applyToNode does to a node
+		void accumulate(size_t index, const Vector3& translate, Quaternion rotate,
+			Vector3 scale, Real weight, Real scl, Animation::RotationInterpolationMode rim,
+			bool shortestPath);
+
+		Skeleton* mSkeleton;
+		BoneInfoList mBones;
+		/// Bone handles, parents always coming before their children
+		vector<unsigned short>::type mBoneOrder;
+		InstanceList mInstances;
+		SampleList mSamples;
+		/// Source and destination of the copies made after evaluation
+		vector<std::pair<const Matrix4*, Matrix4*> >::type mCopies;
+
+		/// Aligned storage for all the arrays below
+		Real* mBuffer;
+		/// Number of instances each row of the arrays can hold
+		size_t mStride;
+		/// Local and model space transforms, entry bone * mStride + instance
+		TransformSoA mLocal;
+		TransformSoA mModel;
+		/// Inheritance flags of the bones of each instance, 1 or 0, same layout
+		Real* mInheritOrientation;
+		Real* mInheritScale;
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -0,0 +1,156 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SkeletonPoseCache_H__
+#define __SkeletonPoseCache_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreSkeleton.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Animation
+	*  @{
+	*/
+	/** Shares the bone matrices of identical skeleton poses evaluated in the
+		same frame.
+	@remarks
+		In crowds many entities often play the same animations with the same
+		weights at about the same time. The pose of a skeleton instance is
+		identified by its skeleton, blend mode, bones disabled by the
+		animation level of detail and the animation, weight and time position
+		of each enabled animation state, the time positions
+		being rounded to a multiple of the time quantum. The first entity to
+		evaluate a pose during a frame stores its bone matrices here, those
+		evaluating the same pose later in the frame copy them instead.
+	@par
+		With a non zero time quantum, entities whose times only differ by
+		less than the quantum get the pose of the first one evaluated, so the
+		quantum trades accuracy for hits. Poses using blend masks are not
+		cached. Entries only live until the end of the frame.
+	*/
+	class _OgreExport SkeletonPoseCache : public AnimationAlloc
+	{
+	public:
+		SkeletonPoseCache();
+		~SkeletonPoseCache();
+
+		/** Sets whether poses are shared, clears the cache.
+		@note Disabled by default
+		*/
+		void setEnabled(bool enabled);
+		/// Gets whether poses are shared
+		bool getEnabled(void) const { return mEnabled; }
+
+		/** Sets the step time positions are rounded to, clears the cache.
+		@param quantum Time in seconds, 0 to only share poses whose times are
+			exactly the same. Defaults to 0.
+		*/
+		void setTimeQuantum(Real quantum);
+		/// Gets the step time positions are rounded to
+		Real getTimeQuantum(void) const { return mTimeQuantum; }
+
+		/** Finds the entry of a pose, creating it if needed.
+		@param skeleton The skeleton the instance was created from.
+		@param instance The skeleton instance the animation states apply to.
+		@param animSet The animation states applied.
+		@param matrices Receives the bone matrices of the pose, or null if the
+			pose cannot be cached.
+		@return Whether the matrices have already been evaluated. If not and
+			they are not null, the caller must fill them in as
+			Skeleton::_getBoneMatrices would, before the end of the frame.
+		@note Internal method used by Entity.
+		*/
+		bool _acquirePose(const Skeleton* skeleton, const Skeleton* instance,
+			const AnimationStateSet& animSet, Matrix4*& matrices);
+
+		/** Forgets a pose created by _acquirePose whose matrices could not be
+			evaluated, so that no other entity copies them.
+		@note Internal method used by Entity.
+		*/
+		void _discardPose(Matrix4* matrices);
+
+		/// Forgets all the poses stored
+		void clear(void);
+
+		/// Returns the number of poses stored in the current frame
+		size_t getNumPoses(void) const { return mPoses.size(); }
+		/// Number of poses found already evaluated since the last reset
+		size_t getHitCount(void) const { return mHitCount; }
+		/// Number of poses which had to be evaluated since the last reset
+		size_t getMissCount(void) const { return mMissCount; }
+		/// Ratio of hits to cacheable poses looked up, 0 if none was
+		Real getHitRate(void) const;
+		/// Resets the counters
+		void resetStatistics(void);
+
+	protected:
+		/// What identifies the contribution of an animation state
+		struct StateKey
+		{
+			const Animation* animation;
+			Real time;
+			Real weight;
+			Real scale;
+		};
+
+		/// What identifies a pose
+		struct PoseKey
+		{
+			const Skeleton* skeleton;
+			SkeletonAnimationBlendMode blendMode;
+			/// See Skeleton::_setDisabledBones, empty if none
+			vector<bool>::type disabledBones;
+			vector<StateKey>::type states;
+
+			bool operator<(const PoseKey& rhs) const;
+		};
+		/// Poses mapped to their bone matrices
+		typedef map<PoseKey, Matrix4*>::type PoseMap;
+
+		bool mEnabled;
+		Real mTimeQuantum;
+		PoseMap mPoses;
+		/// Frame the poses stored were evaluated for
+		unsigned long mFrameNumber;
+		/// Key built by the last lookup, kept to reuse its memory
+		PoseKey mKey;
+		size_t mHitCount;
+		size_t mMissCount;
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
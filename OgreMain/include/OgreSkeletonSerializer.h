@@ -42,8 +42,10 @@ namespace Ogre {
 		SKELETON_VERSION_1_0,
 		/// OGRE version v1.8+
 		SKELETON_VERSION_1_8,
+		/// OGRE version v1.9+, adds compressed animation tracks
+		SKELETON_VERSION_1_9,
 		
-		/// Latest version available
+		/// Latest version available, 1.8 is written if it is enough
 		SKELETON_VERSION_LATEST = 100
 	};
 
@@ -115,6 +117,7 @@ namespace Ogre {
         void writeBoneParent(const Skeleton* pSkel, unsigned short boneId, unsigned short parentId);
 		void writeAnimation(const Skeleton* pSkel, const Animation* anim, SkeletonVersion ver);
         void writeAnimationTrack(const Skeleton* pSkel, const NodeAnimationTrack* track);
+        void writeCompressedAnimationTrack(const Skeleton* pSkel, const CompressedNodeAnimationTrack* track);
         void writeKeyFrame(const Skeleton* pSkel, const TransformKeyFrame* key);
 		void writeSkeletonAnimationLink(const Skeleton* pSkel, 
 			const LinkedSkeletonAnimationSource& link);
@@ -125,6 +128,7 @@ namespace Ogre {
         void readBoneParent(DataStreamPtr& stream, Skeleton* pSkel);
         void readAnimation(DataStreamPtr& stream, Skeleton* pSkel);
         void readAnimationTrack(DataStreamPtr& stream, Animation* anim, Skeleton* pSkel);
+        void readCompressedAnimationTrack(DataStreamPtr& stream, Animation* anim, Skeleton* pSkel);
         void readKeyFrame(DataStreamPtr& stream, NodeAnimationTrack* track, Skeleton* pSkel);
 		void readSkeletonAnimationLink(DataStreamPtr& stream, Skeleton* pSkel);
 
@@ -133,6 +137,7 @@ namespace Ogre {
         size_t calcBoneParentSize(const Skeleton* pSkel);
         size_t calcAnimationSize(const Skeleton* pSkel, const Animation* pAnim);
         size_t calcAnimationTrackSize(const Skeleton* pSkel, const NodeAnimationTrack* pTrack);
+        size_t calcCompressedAnimationTrackSize(const Skeleton* pSkel, const CompressedNodeAnimationTrack* pTrack);
         size_t calcKeyFrameSize(const Skeleton* pSkel, const TransformKeyFrame* pKey);
         size_t calcKeyFrameSizeWithoutScale(const Skeleton* pSkel, const TransformKeyFrame* pKey);
 		size_t calcSkeletonAnimationLinkSize(const Skeleton* pSkel, 
@@ -0,0 +1,155 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SoftwareVertexBlendBatch_H__
+#define __SoftwareVertexBlendBatch_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHardwareVertexBuffer.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Animation
+	*  @{
+	*/
+	/** Collects software vertex blends so that they can all be performed at
+		once, on the threads of the WorkQueue.
+	@remarks
+		Each blend added is the same as a call to Mesh::softwareVertexBlend.
+		When the batch is executed the buffers of every blend are locked on
+		the calling thread, a buffer used by several blends (such as the
+		source data of a mesh shared by many entities) being locked only
+		once, the blends are distributed across the threads with ParallelFor
+		and the buffers are unlocked on the calling thread again. Locking
+		therefore never happens on a worker thread, which is what most
+		render systems require.
+	@par
+		The vertex data and blend matrices given to add must remain valid and
+		unchanged until the batch has been executed.
+	*/
+	class _OgreExport SoftwareVertexBlendBatch : public AnimationAlloc
+	{
+	public:
+		SoftwareVertexBlendBatch();
+		~SoftwareVertexBlendBatch();
+
+		/** Adds a blend to perform on the next execute.
+		@remarks
+			The parameters are those of Mesh::softwareVertexBlend. The matrix
+			pointers are copied, the matrices themselves are only read when
+			the batch is executed.
+		*/
+		void add(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+			const Matrix4* const* blendMatrices, size_t numMatrices, bool blendNormals);
+
+		/** Adds a dual quaternion blend to perform on the next execute.
+		@remarks
+			The parameters are those of the dual quaternion version of
+			Mesh::softwareVertexBlend, the pointers are copied the same way.
+		*/
+		void add(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+			const DualQuaternion* const* blendDualQuaternions, size_t numDualQuaternions,
+			bool blendNormals);
+
+		/** Performs all the blends added since the last execute and empties
+			the batch.
+		@param parallel Whether the blends may be distributed across the
+			threads of the WorkQueue, see ParallelFor.
+		*/
+		void execute(bool parallel);
+
+		/// Forgets the blends added since the last execute
+		void clear(void);
+
+		/// Returns the number of blends waiting to be executed
+		size_t getNumBlends(void) const { return mBlends.size(); }
+
+		/// Returns whether no blend is waiting to be executed
+		bool empty(void) const { return mBlends.empty(); }
+
+		/** Performs a range of the locked blends.
+		@note Internal method called by the worker threads during execute.
+		*/
+		void _blend(size_t begin, size_t end);
+
+	protected:
+		/// A blend and, once locked, the pointers and strides it works with
+		struct Blend
+		{
+			const VertexData* source;
+			const VertexData* target;
+			/// Index of the first blend matrix in mBlendMatrices, or of the
+			/// first dual quaternion in mBlendDualQuaternions
+			size_t firstMatrix;
+			bool dualQuaternion;
+			bool blendNormals;
+
+			float* srcPos;
+			float* srcNorm;
+			float* destPos;
+			float* destNorm;
+			float* blendWeight;
+			unsigned char* blendIdx;
+			size_t srcPosStride;
+			size_t srcNormStride;
+			size_t destPosStride;
+			size_t destNormStride;
+			size_t blendWeightStride;
+			size_t blendIdxStride;
+			unsigned short numWeightsPerVertex;
+		};
+		typedef vector<Blend>::type BlendList;
+		/// Lockable buffers mapped to the locked memory
+		typedef map<HardwareVertexBuffer*, void*>::type LockedBufferMap;
+
+		/// Locks the buffers of a blend and fills in its pointers
+		void lock(Blend& blend);
+		/// Locks a buffer unless it already is
+		void* lockBuffer(const HardwareVertexBufferSharedPtr& buf,
+			HardwareBuffer::LockOptions options);
+		/// Unlocks all the buffers locked by lockBuffer
+		void unlockBuffers(void);
+
+		BlendList mBlends;
+		/// Blend matrices of all the blends, one after another
+		vector<const Matrix4*>::type mBlendMatrices;
+		/// Blend dual quaternions of all the dual quaternion blends
+		vector<const DualQuaternion*>::type mBlendDualQuaternions;
+		LockedBufferMap mLockedBuffers;
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
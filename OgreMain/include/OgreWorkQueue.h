@@ -181,7 +181,9 @@ namespace Ogre
 			Response regardless of success or failure.
 			@param srcQ The work queue that this request originated from
 			@return Pointer to a Response object - the caller is responsible
-			for deleting the object.
+			for deleting the object. A handler processing requests which nobody
+			waits a response for may instead abort the request (see
+			Request::abortRequest) and return null, the request is then deleted.
 			*/
 			virtual Response* handleRequest(const Request* req, const WorkQueue* srcQ) = 0;
 		};
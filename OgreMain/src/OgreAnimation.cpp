@@ -73,7 +73,7 @@ namespace Ogre {
     //---------------------------------------------------------------------
     NodeAnimationTrack* Animation::createNodeTrack(unsigned short handle)
     {
-        if (hasNodeTrack(handle))
+        if (hasNodeTrack(handle) || hasCompressedNodeTrack(handle))
         {
             OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM, 
                 "Node track with the specified handle " +
@@ -143,6 +143,97 @@ namespace Ogre {
         }
         mNodeTrackList.clear();
         _keyFrameListChanged();
+    }
+    //---------------------------------------------------------------------
+    CompressedNodeAnimationTrack* Animation::createCompressedNodeTrack(unsigned short handle,
+        Node* node)
+    {
+        if (hasNodeTrack(handle) || hasCompressedNodeTrack(handle))
+        {
+            OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM, 
+                "Node track with the specified handle " +
+                StringConverter::toString(handle) + " already exists",
+                "Animation::createCompressedNodeTrack");
+        }
+
+        CompressedNodeAnimationTrack* ret = OGRE_NEW CompressedNodeAnimationTrack(this, handle, node);
+
+        mCompressedNodeTrackList[handle] = ret;
+        return ret;
+    }
+    //---------------------------------------------------------------------
+    unsigned short Animation::getNumCompressedNodeTracks(void) const
+    {
+        return (unsigned short)mCompressedNodeTrackList.size();
+    }
+	//---------------------------------------------------------------------
+	bool Animation::hasCompressedNodeTrack(unsigned short handle) const
+	{
+		return (mCompressedNodeTrackList.find(handle) != mCompressedNodeTrackList.end());
+	}
+    //---------------------------------------------------------------------
+    CompressedNodeAnimationTrack* Animation::getCompressedNodeTrack(unsigned short handle) const
+    {
+        CompressedNodeTrackList::const_iterator i = mCompressedNodeTrackList.find(handle);
+
+        if (i == mCompressedNodeTrackList.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+                "Cannot find compressed node track with the specified handle " +
+                StringConverter::toString(handle),
+                "Animation::getCompressedNodeTrack");
+        }
+
+        return i->second;
+    }
+    //---------------------------------------------------------------------
+    void Animation::destroyCompressedNodeTrack(unsigned short handle)
+    {
+        CompressedNodeTrackList::iterator i = mCompressedNodeTrackList.find(handle);
+
+		if (i != mCompressedNodeTrackList.end())
+		{
+			OGRE_DELETE i->second;
+			mCompressedNodeTrackList.erase(i);
+		}
+    }
+    //---------------------------------------------------------------------
+    void Animation::destroyAllCompressedNodeTracks(void)
+    {
+        CompressedNodeTrackList::iterator i;
+        for (i = mCompressedNodeTrackList.begin(); i != mCompressedNodeTrackList.end(); ++i)
+        {
+            OGRE_DELETE i->second;
+        }
+        mCompressedNodeTrackList.clear();
+    }
+    //---------------------------------------------------------------------
+    void Animation::compressNodeTracks(const CompressedNodeAnimationTrack::Tolerances& tolerances)
+    {
+		// Keyframes must be final before they are dropped
+		_applyBaseKeyFrame();
+
+        NodeTrackList::iterator i = mNodeTrackList.begin();
+        while (i != mNodeTrackList.end())
+        {
+			NodeAnimationTrack* track = i->second;
+			if (track->getNumKeyFrames() > 0)
+			{
+				CompressedNodeAnimationTrack* compressed = OGRE_NEW CompressedNodeAnimationTrack(
+					this, track->getHandle(), track->getAssociatedNode());
+				if (!compressed->compress(track, tolerances))
+				{
+					// Keep the keyframes rather than lose precision
+					OGRE_DELETE compressed;
+					++i;
+					continue;
+				}
+				mCompressedNodeTrackList[track->getHandle()] = compressed;
+			}
+            OGRE_DELETE track;
+            mNodeTrackList.erase(i++);
+        }
+        _keyFrameListChanged();
     }
 	//---------------------------------------------------------------------
 	NumericAnimationTrack* Animation::createNumericTrack(unsigned short handle)
@@ -300,6 +391,7 @@ namespace Ogre {
 	void Animation::destroyAllTracks(void)
 	{
 		destroyAllNodeTracks();
+		destroyAllCompressedNodeTracks();
 		destroyAllNumericTracks();
 		destroyAllVertexTracks();
 	}
@@ -320,6 +412,11 @@ namespace Ogre {
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
         {
             i->second->apply(timeIndex, weight, scale);
+        }
+        CompressedNodeTrackList::iterator c;
+        for (c = mCompressedNodeTrackList.begin(); c != mCompressedNodeTrackList.end(); ++c)
+        {
+            c->second->apply(timeIndex, weight, scale);
         }
 		NumericTrackList::iterator j;
 		for (j = mNumericTrackList.begin(); j != mNumericTrackList.end(); ++j)
@@ -346,6 +443,11 @@ namespace Ogre {
         {
             i->second->applyToNode(node, timeIndex, weight, scale);
         }
+        CompressedNodeTrackList::iterator c;
+        for (c = mCompressedNodeTrackList.begin(); c != mCompressedNodeTrackList.end(); ++c)
+        {
+            c->second->applyToNode(node, timeIndex, weight, scale);
+        }
     }
     //---------------------------------------------------------------------
     void Animation::apply(Skeleton* skel, Real timePos, Real weight, 
@@ -359,10 +461,21 @@ namespace Ogre {
         NodeTrackList::iterator i;
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
         {
+            // Skip the bones disabled by the animation LOD
+            if (skel->_isBoneDisabled(i->first))
+                continue;
             // get bone to apply to 
             Bone* b = skel->getBone(i->first);
             i->second->applyToNode(b, timeIndex, weight, scale);
         }
+        CompressedNodeTrackList::iterator c;
+        for (c = mCompressedNodeTrackList.begin(); c != mCompressedNodeTrackList.end(); ++c)
+        {
+            if (skel->_isBoneDisabled(c->first))
+                continue;
+            Bone* b = skel->getBone(c->first);
+            c->second->applyToNode(b, timeIndex, weight, scale);
+        }
 
 
     }
@@ -378,10 +491,21 @@ namespace Ogre {
       NodeTrackList::iterator i;
       for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
       {
+        // Skip the bones disabled by the animation LOD
+        if (skel->_isBoneDisabled(i->first))
+          continue;
         // get bone to apply to 
         Bone* b = skel->getBone(i->first);
 		i->second->applyToNode(b, timeIndex, (*blendMask)[b->getHandle()] * weight, scale);
       }
+      CompressedNodeTrackList::iterator c;
+      for (c = mCompressedNodeTrackList.begin(); c != mCompressedNodeTrackList.end(); ++c)
+      {
+        if (skel->_isBoneDisabled(c->first))
+          continue;
+        Bone* b = skel->getBone(c->first);
+        c->second->applyToNode(b, timeIndex, (*blendMask)[b->getHandle()] * weight, scale);
+      }
     }
 	//---------------------------------------------------------------------
 	void Animation::apply(Entity* entity, Real timePos, Real weight, 
@@ -619,6 +743,11 @@ namespace Ogre {
 		{
 			i->second->_clone(newAnim);
 		}
+		for (CompressedNodeTrackList::const_iterator i = mCompressedNodeTrackList.begin();
+			i != mCompressedNodeTrackList.end(); ++i)
+		{
+			i->second->_clone(newAnim);
+		}
 		for (NumericTrackList::const_iterator i = mNumericTrackList.begin();
 			i != mNumericTrackList.end(); ++i)
 		{
@@ -652,11 +781,9 @@ namespace Ogre {
         if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
 			timePos = fmod( timePos, totalAnimationLength );
 
-        // Search for global index
-        KeyFrameTimeList::iterator it =
-            std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos);
-
-        return TimeIndex(timePos, static_cast<uint>(std::distance(mKeyFrameTimes.begin(), it)));
+        // Search for global index, starting from the previous one
+        return TimeIndex(timePos, static_cast<uint>(
+            mKeyFrameTimeCursor.lowerBound(mKeyFrameTimes, timePos)));
     }
     //-----------------------------------------------------------------------
     void Animation::buildKeyFrameTimeList(void) const
@@ -778,6 +905,24 @@ namespace Ogre {
 		}
 		
 	}
+	//-----------------------------------------------------------------------
+	void Animation::_prepareNodeTracks(void)
+	{
+		_applyBaseKeyFrame();
+		TimeIndex timeIndex = _getTimeIndex(0);
+
+		if (mInterpolationMode == IM_SPLINE)
+		{
+			// Splines are built by the first interpolation
+			TransformKeyFrame kf(0, 0);
+			NodeTrackList::iterator i, iend = mNodeTrackList.end();
+			for (i = mNodeTrackList.begin(); i != iend; ++i)
+			{
+				if (i->second->getNumKeyFrames())
+					i->second->getInterpolatedKeyFrame(timeIndex, &kf);
+			}
+		}
+	}
     //-----------------------------------------------------------------------
 	void Animation::_notifyContainer(AnimationContainer* c)
 	{
@@ -49,6 +49,43 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
+    size_t KeyFrameTimeCursor::lowerBound(const vector<Real>::type& times, Real timePos) const
+    {
+        size_t size = times.size();
+        size_t index = mIndex.get();
+
+        // index is the lower bound if the time before it is less than timePos
+        // and the time at it is not
+        if (index <= size)
+        {
+            if (index < size && times[index] < timePos)
+            {
+                // Moved forward, most likely to the next key
+                ++index;
+                if (index == size || !(times[index] < timePos))
+                {
+                    mIndex.set(index);
+                    return index;
+                }
+            }
+            else if (index == 0 || times[index - 1] < timePos)
+            {
+                return index;
+            }
+            else if (index == 1 || times[index - 2] < timePos)
+            {
+                // Moved backward to the previous key
+                mIndex.set(index - 1);
+                return index - 1;
+            }
+        }
+
+        index = std::distance(times.begin(),
+            std::lower_bound(times.begin(), times.end(), timePos));
+        mIndex.set(index);
+        return index;
+    }
+    //---------------------------------------------------------------------
     AnimationTrack::AnimationTrack(Animation* parent, unsigned short handle) :
 		mParent(parent), mHandle(handle), mListener(0)
     {
@@ -109,8 +146,7 @@ namespace Ogre {
 				timePos = fmod( timePos, totalAnimationLength );
 
             // No global keyframe index, need to search with local keyframes.
-            KeyFrame timeKey(0, timePos);
-            i = std::lower_bound(mKeyFrames.begin(), mKeyFrames.end(), &timeKey, KeyFrameTimeLess());
+            i = mKeyFrames.begin() + mKeyFrameTimeCursor.lowerBound(mKeyFrameTimes, timePos);
         }
 
         if (i == mKeyFrames.end())
@@ -162,6 +198,7 @@ namespace Ogre {
         // Insert just before upper bound
         KeyFrameList::iterator i =
             std::upper_bound(mKeyFrames.begin(), mKeyFrames.end(), kf, KeyFrameTimeLess());
+        mKeyFrameTimes.insert(mKeyFrameTimes.begin() + std::distance(mKeyFrames.begin(), i), timePos);
         mKeyFrames.insert(i, kf);
 
         _keyFrameDataChanged();
@@ -183,6 +220,7 @@ namespace Ogre {
         OGRE_DELETE *i;
 
         mKeyFrames.erase(i);
+        mKeyFrameTimes.erase(mKeyFrameTimes.begin() + index);
 
         _keyFrameDataChanged();
         mParent->_keyFrameListChanged();
@@ -203,6 +241,7 @@ namespace Ogre {
         mParent->_keyFrameListChanged();
 
         mKeyFrames.clear();
+        mKeyFrameTimes.clear();
 
     }
     //---------------------------------------------------------------------
@@ -247,6 +286,7 @@ namespace Ogre {
 			KeyFrame* clonekf = (*i)->_clone(clone);
 			clone->mKeyFrames.push_back(clonekf);
 		}
+		clone->mKeyFrameTimes = mKeyFrameTimes;
 	}
 	//---------------------------------------------------------------------
 	//---------------------------------------------------------------------
@@ -890,10 +930,17 @@ namespace Ogre {
 			VertexPoseKeyFrame* vkf1 = static_cast<VertexPoseKeyFrame*>(kf1);
 			VertexPoseKeyFrame* vkf2 = static_cast<VertexPoseKeyFrame*>(kf2);
 
-			// For each pose reference in key 1, we need to locate the entry in
-			// key 2 and interpolate the influence
+			// Gather the influence of every pose first, so that software blending
+			// can accumulate them all in one pass over the vertex data
 			const VertexPoseKeyFrame::PoseRefList& poseList1 = vkf1->getPoseReferences();
 			const VertexPoseKeyFrame::PoseRefList& poseList2 = vkf2->getPoseReferences();
+			vector<const Pose*>::type poses;
+			vector<Real>::type influences;
+			poses.reserve(poseList1.size() + poseList2.size());
+			influences.reserve(poseList1.size() + poseList2.size());
+
+			// For each pose reference in key 1, we need to locate the entry in
+			// key 2 and interpolate the influence
 			for (VertexPoseKeyFrame::PoseRefList::const_iterator p1 = poseList1.begin();
 				p1 != poseList1.end(); ++p1)
 			{
@@ -915,9 +962,8 @@ namespace Ogre {
 				influence = weight * influence;
 				// Get pose
 				assert (poseList && p1->poseIndex < poseList->size());
-				Pose* pose = (*poseList)[p1->poseIndex];
-				// apply
-				applyPoseToVertexData(pose, data, influence);
+				poses.push_back((*poseList)[p1->poseIndex]);
+				influences.push_back(influence);
 			}
 			// Now deal with any poses in key 2 which are not in key 1
 			for (VertexPoseKeyFrame::PoseRefList::const_iterator p2 = poseList2.begin();
@@ -941,11 +987,22 @@ namespace Ogre {
 					influence = weight * influence;
 					// Get pose
 					assert (poseList && p2->poseIndex <= poseList->size());
-					const Pose* pose = (*poseList)[p2->poseIndex];
-					// apply
-					applyPoseToVertexData(pose, data, influence);
+					poses.push_back((*poseList)[p2->poseIndex]);
+					influences.push_back(influence);
 				}
 			} // key 2 iteration
+
+			// apply
+			if (mTargetMode == TM_SOFTWARE)
+			{
+				if (!poses.empty())
+					Mesh::softwareVertexPoseBlend(&poses[0], &influences[0], poses.size(), data);
+			}
+			else
+			{
+				for (size_t p = 0; p < poses.size(); ++p)
+					applyPoseToVertexData(poses[p], data, influences[p]);
+			}
 		} // morph or pose animation
 	}
 	//-----------------------------------------------------------------------------
@@ -64,6 +64,9 @@ namespace Ogre {
 		 mSceneDepthRangeDirty(true),
 		 mLodCameraPositionDirty(true),
 		 mLodCameraPositionObjectSpaceDirty(true),
+         mLastWorldMatrix(Matrix4::ZERO),
+         mUseIdentityView(false),
+         mUseIdentityProjection(false),
          mCurrentRenderable(0),
          mCurrentCamera(0), 
 		 mCameraRelativeRendering(false),
@@ -85,6 +88,7 @@ namespace Ogre {
 			mSpotlightWorldViewProjMatrixDirty[i] = true;
 			mCurrentTextureProjector[i] = 0;
 			mShadowCamDepthRangesDirty[i] = false;
+			mSpotlight[i] = 0;
 		}
 
     }
@@ -109,14 +113,65 @@ namespace Ogre {
     void AutoParamDataSource::setCurrentRenderable(const Renderable* rend)
     {
 		mCurrentRenderable = rend;
+		// Only the world matrix is fetched again, what derives from it is
+		// recalculated if its value turns out to be different
 		mWorldMatrixDirty = true;
-        mViewMatrixDirty = true;
-        mProjMatrixDirty = true;
+
+		bool useIdentityView = rend && rend->getUseIdentityView();
+		if (useIdentityView != mUseIdentityView)
+		{
+			mUseIdentityView = useIdentityView;
+			markViewDependentDirty();
+		}
+		bool useIdentityProjection = rend && rend->getUseIdentityProjection();
+		if (useIdentityProjection != mUseIdentityProjection)
+		{
+			mUseIdentityProjection = useIdentityProjection;
+			markProjectionDependentDirty();
+		}
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::setCurrentCamera(const Camera* cam, bool useCameraRelative)
+    {
+        mCurrentCamera = cam;
+		mCameraRelativeRendering = useCameraRelative;
+		mCameraRelativePosition = cam->getDerivedPosition();
+        // Light space matrices depend on the camera too, and lights may
+        // have moved since the last camera
+        markViewDependentDirty();
+        markProjectionDependentDirty();
+        markWorldDependentDirty();
+        mCameraPositionDirty = true;
+		mLodCameraPositionDirty = true;
+		for(size_t i = 0; i < OGRE_MAX_SIMULTANEOUS_LIGHTS; ++i)
+		{
+			mSpotlight[i] = 0;
+			mSpotlightViewProjMatrixDirty[i] = true;
+		}
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::setCurrentLightList(const LightList* ll)
+    {
+        mCurrentLightList = ll;
+		for(size_t i = 0; i < ll->size() && i < OGRE_MAX_SIMULTANEOUS_LIGHTS; ++i)
+		{
+			// Keep the matrices of lights already in use at the same index
+			const Light* l = (*ll)[i];
+			if (l != mSpotlight[i])
+			{
+				mSpotlight[i] = l;
+				mSpotlightViewProjMatrixDirty[i] = true;
+				mSpotlightWorldViewProjMatrixDirty[i] = true;
+			}
+		}
+
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::markWorldDependentDirty(void) const
+    {
 		mWorldViewMatrixDirty = true;
-        mViewProjMatrixDirty = true;
 		mWorldViewProjMatrixDirty = true;
 		mInverseWorldMatrixDirty = true;
-        mInverseViewMatrixDirty = true;
 		mInverseWorldViewMatrixDirty = true;
 		mInverseTransposeWorldMatrixDirty = true;
 		mInverseTransposeWorldViewMatrixDirty = true;
@@ -127,37 +182,54 @@ namespace Ogre {
 			mTextureWorldViewProjMatrixDirty[i] = true;
 			mSpotlightWorldViewProjMatrixDirty[i] = true;
 		}
-
     }
     //-----------------------------------------------------------------------------
-    void AutoParamDataSource::setCurrentCamera(const Camera* cam, bool useCameraRelative)
+    void AutoParamDataSource::markViewDependentDirty(void)
     {
-        mCurrentCamera = cam;
-		mCameraRelativeRendering = useCameraRelative;
-		mCameraRelativePosition = cam->getDerivedPosition();
         mViewMatrixDirty = true;
-        mProjMatrixDirty = true;
-        mWorldViewMatrixDirty = true;
         mViewProjMatrixDirty = true;
-        mWorldViewProjMatrixDirty = true;
         mInverseViewMatrixDirty = true;
+        mWorldViewMatrixDirty = true;
+        mWorldViewProjMatrixDirty = true;
         mInverseWorldViewMatrixDirty = true;
         mInverseTransposeWorldViewMatrixDirty = true;
-        mCameraPositionObjectSpaceDirty = true;
-        mCameraPositionDirty = true;
-		mLodCameraPositionObjectSpaceDirty = true;
-		mLodCameraPositionDirty = true;
     }
     //-----------------------------------------------------------------------------
-    void AutoParamDataSource::setCurrentLightList(const LightList* ll)
+    void AutoParamDataSource::markProjectionDependentDirty(void)
     {
-        mCurrentLightList = ll;
-		for(size_t i = 0; i < ll->size() && i < OGRE_MAX_SIMULTANEOUS_LIGHTS; ++i)
+        mProjMatrixDirty = true;
+        mViewProjMatrixDirty = true;
+        mWorldViewProjMatrixDirty = true;
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::updateWorldMatrix(void) const
+    {
+        if (mWorldMatrixDirty)
+        {
+            mWorldMatrixArray = mWorldMatrix;
+            mCurrentRenderable->getWorldTransforms(mWorldMatrix);
+            mWorldMatrixCount = mCurrentRenderable->getNumWorldTransforms();
+			if (mCameraRelativeRendering)
+			{
+				for (size_t i = 0; i < mWorldMatrixCount; ++i)
+				{
+					mWorldMatrix[i].setTrans(mWorldMatrix[i].getTrans() - mCameraRelativePosition);
+				}
+			}
+            mWorldMatrixDirty = false;
+            worldMatrixUpdated();
+        }
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::worldMatrixUpdated(void) const
+    {
+		// Renderables sharing a transform (several sub entities, several
+		// passes) keep the matrices derived from it
+		if (mWorldMatrixArray[0] != mLastWorldMatrix)
 		{
-			mSpotlightViewProjMatrixDirty[i] = true;
-			mSpotlightWorldViewProjMatrixDirty[i] = true;
+			mLastWorldMatrix = mWorldMatrixArray[0];
+			markWorldDependentDirty();
 		}
-
     }
 	//---------------------------------------------------------------------
 	float AutoParamDataSource::getLightNumber(size_t index) const
@@ -269,24 +341,12 @@ namespace Ogre {
         mWorldMatrixArray = m;
         mWorldMatrixCount = count;
         mWorldMatrixDirty = false;
+        worldMatrixUpdated();
     }
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getWorldMatrix(void) const
     {
-        if (mWorldMatrixDirty)
-        {
-            mWorldMatrixArray = mWorldMatrix;
-            mCurrentRenderable->getWorldTransforms(mWorldMatrix);
-            mWorldMatrixCount = mCurrentRenderable->getNumWorldTransforms();
-			if (mCameraRelativeRendering)
-			{
-				for (size_t i = 0; i < mWorldMatrixCount; ++i)
-				{
-					mWorldMatrix[i].setTrans(mWorldMatrix[i].getTrans() - mCameraRelativePosition);
-				}
-			}
-            mWorldMatrixDirty = false;
-        }
+        updateWorldMatrix();
         return mWorldMatrixArray[0];
     }
     //-----------------------------------------------------------------------------
@@ -308,7 +368,7 @@ namespace Ogre {
     {
         if (mViewMatrixDirty)
         {
-            if (mCurrentRenderable && mCurrentRenderable->getUseIdentityView())
+            if (mUseIdentityView)
                 mViewMatrix = Matrix4::IDENTITY;
             else
 			{
@@ -340,7 +400,7 @@ namespace Ogre {
         {
             // NB use API-independent projection matrix since GPU programs
             // bypass the API-specific handedness and use right-handed coords
-            if (mCurrentRenderable && mCurrentRenderable->getUseIdentityProjection())
+            if (mUseIdentityProjection)
             {
                 // Use identity projection matrix, still need to take RS depth into account.
                 RenderSystem* rs = Root::getSingleton().getRenderSystem();
@@ -366,6 +426,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getWorldViewMatrix(void) const
     {
+        updateWorldMatrix();
         if (mWorldViewMatrixDirty)
         {
             mWorldViewMatrix = getViewMatrix().concatenateAffine(getWorldMatrix());
@@ -376,6 +437,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getWorldViewProjMatrix(void) const
     {
+        updateWorldMatrix();
         if (mWorldViewProjMatrixDirty)
         {
             mWorldViewProjMatrix = getProjectionMatrix() * getWorldViewMatrix();
@@ -386,6 +448,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getInverseWorldMatrix(void) const
     {
+        updateWorldMatrix();
         if (mInverseWorldMatrixDirty)
         {
             mInverseWorldMatrix = getWorldMatrix().inverseAffine();
@@ -396,6 +459,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getInverseWorldViewMatrix(void) const
     {
+        updateWorldMatrix();
         if (mInverseWorldViewMatrixDirty)
         {
             mInverseWorldViewMatrix = getWorldViewMatrix().inverseAffine();
@@ -416,6 +480,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getInverseTransposeWorldMatrix(void) const
     {
+        updateWorldMatrix();
         if (mInverseTransposeWorldMatrixDirty)
         {
             mInverseTransposeWorldMatrix = getInverseWorldMatrix().transpose();
@@ -426,6 +491,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Matrix4& AutoParamDataSource::getInverseTransposeWorldViewMatrix(void) const
     {
+        updateWorldMatrix();
         if (mInverseTransposeWorldViewMatrixDirty)
         {
             mInverseTransposeWorldViewMatrix = getInverseWorldViewMatrix().transpose();
@@ -454,6 +520,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     const Vector4& AutoParamDataSource::getCameraPositionObjectSpace(void) const
     {
+        updateWorldMatrix();
         if (mCameraPositionObjectSpaceDirty)
         {
 			if (mCameraRelativeRendering)
@@ -491,6 +558,7 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	const Vector4& AutoParamDataSource::getLodCameraPositionObjectSpace(void) const
 	{
+		updateWorldMatrix();
 		if (mLodCameraPositionObjectSpaceDirty)
 		{
             if (mCameraRelativeRendering)
@@ -681,6 +749,7 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	const Matrix4& AutoParamDataSource::getTextureWorldViewProjMatrix(size_t index) const
 	{
+		updateWorldMatrix();
 		if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
 		{
 			if (mTextureWorldViewProjMatrixDirty[index] && mCurrentTextureProjector[index])
@@ -754,6 +823,7 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	const Matrix4& AutoParamDataSource::getSpotlightWorldViewProjMatrix(size_t index) const
 	{
+		updateWorldMatrix();
 		if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
 		{
 			const Light& l = getLight(index);
@@ -791,7 +861,12 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderTarget(const RenderTarget* target)
     {
-        mCurrentRenderTarget = target;
+        if (target != mCurrentRenderTarget)
+        {
+            // Texture flipping is applied to the projection matrix
+            mCurrentRenderTarget = target;
+            markProjectionDependentDirty();
+        }
     }
     //-----------------------------------------------------------------------------
     const RenderTarget* AutoParamDataSource::getCurrentRenderTarget(void) const
@@ -40,6 +40,8 @@ THE SOFTWARE.
 #include "OgreRenderSystem.h"
 #include "OgreProfiler.h"
 
+#include <typeinfo>
+
 namespace Ogre {
 
     String Camera::msMovableType = "Camera";
@@ -888,6 +890,25 @@ namespace Ogre {
 		}
 	}
 	//-----------------------------------------------------------------------
+	bool Camera::isBatchVisibilityExact(void) const
+	{
+		return typeid(*this) == typeid(Camera);
+	}
+	//-----------------------------------------------------------------------
+	void Camera::calculateVisibility(const AxisAlignedBox* const* bounds, size_t count,
+		uint32* visibility) const
+	{
+		// A subclass overriding isVisible has it called from Frustum's version
+		if (mCullFrustum && isBatchVisibilityExact())
+		{
+			mCullFrustum->calculateVisibility(bounds, count, visibility);
+		}
+		else
+		{
+			Frustum::calculateVisibility(bounds, count, visibility);
+		}
+	}
+	//-----------------------------------------------------------------------
 	bool Camera::isVisible(const Sphere& bound, FrustumPlane* culledBy) const
 	{
 		if (mCullFrustum)
@@ -0,0 +1,455 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreCompressedNodeAnimationTrack.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreNode.h"
+
+namespace Ogre
+{
+	/// Largest value of the 3 smallest components of a unit quaternion
+	static const float COMPRESSED_ROTATION_RANGE = 0.70710678f;
+	/// Bound of the angle in radians lost by quantising a rotation
+	static const float ROTATION_QUANTISATION_ERROR = 2e-4f;
+
+	//-----------------------------------------------------------------------
+	static uint16 quantise(float value, float maxValue)
+	{
+		float q = Math::Floor(value * maxValue + 0.5f);
+		return static_cast<uint16>(std::min(std::max(q, 0.0f), maxValue));
+	}
+	//-----------------------------------------------------------------------
+	static void encodeRotation(const Quaternion& q, uint16* out)
+	{
+		float c[4] = { (float)q.w, (float)q.x, (float)q.y, (float)q.z };
+		size_t largest = 0;
+		for (size_t i = 1; i < 4; ++i)
+		{
+			if (Math::Abs(c[i]) > Math::Abs(c[largest]))
+				largest = i;
+		}
+		// q and -q are the same rotation, keep the largest component positive
+		float sign = c[largest] < 0 ? -1.0f : 1.0f;
+
+		float smallest[3];
+		for (size_t i = 0, n = 0; i < 4; ++i)
+		{
+			if (i != largest)
+				smallest[n++] = (c[i] * sign / COMPRESSED_ROTATION_RANGE) * 0.5f + 0.5f;
+		}
+		out[0] = static_cast<uint16>(((largest >> 1) << 15) | quantise(smallest[0], 32767.0f));
+		out[1] = static_cast<uint16>(((largest & 1) << 15) | quantise(smallest[1], 32767.0f));
+		out[2] = quantise(smallest[2], 65535.0f);
+	}
+	//-----------------------------------------------------------------------
+	static Quaternion decodeRotation(const uint16* in)
+	{
+		size_t largest = ((in[0] >> 15) << 1) | (in[1] >> 15);
+		float a = ((in[0] & 0x7FFF) * (2.0f / 32767.0f) - 1.0f) * COMPRESSED_ROTATION_RANGE;
+		float b = ((in[1] & 0x7FFF) * (2.0f / 32767.0f) - 1.0f) * COMPRESSED_ROTATION_RANGE;
+		float c = (in[2] * (2.0f / 65535.0f) - 1.0f) * COMPRESSED_ROTATION_RANGE;
+		float d = Math::Sqrt(std::max(0.0f, 1.0f - a * a - b * b - c * c));
+
+		// The smallest components are stored in order around the largest
+		float smallest[3] = { a, b, c };
+		float r[4];
+		for (size_t i = 0, n = 0; i < 4; ++i)
+			r[i] = i == largest ? d : smallest[n++];
+		return Quaternion(r[0], r[1], r[2], r[3]);
+	}
+	//-----------------------------------------------------------------------
+	static Vector3 interpolate(Real t, const Vector3& a, const Vector3& b)
+	{
+		return a + (b - a) * t;
+	}
+	//-----------------------------------------------------------------------
+	static Quaternion interpolate(Real t, const Quaternion& a, const Quaternion& b)
+	{
+		return Quaternion::nlerp(t, a, b, true);
+	}
+	//-----------------------------------------------------------------------
+	static Real distance(const Vector3& a, const Vector3& b)
+	{
+		return a.distance(b);
+	}
+	//-----------------------------------------------------------------------
+	static Real distance(const Quaternion& a, const Quaternion& b)
+	{
+		Real cosHalfAngle = std::min(Math::Abs(a.Dot(b)), Real(1));
+		return 2 * Math::ACos(cosHalfAngle).valueRadians();
+	}
+	//-----------------------------------------------------------------------
+	/** Selects the keys to keep so that interpolating between them rebuilds
+		every dropped key within the tolerance. Always keeps the first and
+		last keys, so that the wrap around of the track is unchanged.
+	*/
+	template <typename T>
+	static void selectKeys(const vector<float>::type& times,
+		const typename vector<T>::type& values, Real tolerance,
+		vector<size_t>::type& kept)
+	{
+		size_t numKeys = values.size();
+		kept.clear();
+		kept.push_back(0);
+
+		size_t start = 0;
+		for (size_t end = 2; end < numKeys; ++end)
+		{
+			// Can all the keys between start and end be dropped?
+			bool fits = true;
+			float span = times[end] - times[start];
+			for (size_t k = start + 1; k < end && fits; ++k)
+			{
+				Real t = span > 0 ? (times[k] - times[start]) / span : 0;
+				fits = distance(interpolate(t, values[start], values[end]), values[k]) <= tolerance;
+			}
+			if (!fits)
+			{
+				start = end - 1;
+				kept.push_back(start);
+			}
+		}
+		if (numKeys > 1)
+			kept.push_back(numKeys - 1);
+	}
+	//-----------------------------------------------------------------------
+	/// Returns whether all values are within the tolerance of the first
+	template <typename T>
+	static bool isConstant(const typename vector<T>::type& values, Real tolerance)
+	{
+		for (size_t i = 1; i < values.size(); ++i)
+		{
+			if (distance(values[i], values[0]) > tolerance)
+				return false;
+		}
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	/// Returns false if quantising the keys would not fit in the tolerance
+	static bool compressVectors(CompressedNodeAnimationTrack::Channel& channel,
+		const vector<float>::type& times, const vector<Vector3>::type& values,
+		Real tolerance)
+	{
+		channel.times.clear();
+		channel.keys.clear();
+		if (isConstant<Vector3>(values, tolerance))
+		{
+			channel.type = CompressedNodeAnimationTrack::CT_CONSTANT;
+			channel.base[0] = values[0].x;
+			channel.base[1] = values[0].y;
+			channel.base[2] = values[0].z;
+			channel.base[3] = 0;
+			channel.step[0] = channel.step[1] = channel.step[2] = 0;
+			return true;
+		}
+
+		// Half of the budget for dropping keys, half for quantisation
+		vector<size_t>::type kept;
+		selectKeys<Vector3>(times, values, tolerance * 0.5f, kept);
+
+		Vector3 minimum = values[kept[0]];
+		Vector3 maximum = minimum;
+		for (size_t i = 1; i < kept.size(); ++i)
+		{
+			minimum.makeFloor(values[kept[i]]);
+			maximum.makeCeil(values[kept[i]]);
+		}
+		// Each component is rounded by up to half a step
+		Vector3 halfSteps = (maximum - minimum) / (2 * 65535.0f);
+		if (halfSteps.length() > tolerance * 0.5f)
+			return false;
+
+		channel.type = CompressedNodeAnimationTrack::CT_ANIMATED;
+		for (size_t c = 0; c < 3; ++c)
+		{
+			channel.base[c] = minimum[c];
+			channel.step[c] = (maximum[c] - minimum[c]) / 65535.0f;
+		}
+		channel.base[3] = 0;
+
+		channel.times.resize(kept.size());
+		channel.keys.resize(kept.size() * 3);
+		uint16* key = &channel.keys[0];
+		for (size_t i = 0; i < kept.size(); ++i, key += 3)
+		{
+			const Vector3& v = values[kept[i]];
+			channel.times[i] = times[kept[i]];
+			for (size_t c = 0; c < 3; ++c)
+			{
+				key[c] = channel.step[c] > 0 ?
+					quantise((v[c] - minimum[c]) / (maximum[c] - minimum[c]), 65535.0f) : 0;
+			}
+		}
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	/// Returns false if quantising the keys would not fit in the tolerance
+	static bool compressRotations(CompressedNodeAnimationTrack::Channel& channel,
+		const vector<float>::type& times, const vector<Quaternion>::type& values,
+		Real tolerance)
+	{
+		channel.times.clear();
+		channel.keys.clear();
+		channel.step[0] = channel.step[1] = channel.step[2] = 0;
+		if (isConstant<Quaternion>(values, tolerance))
+		{
+			channel.type = CompressedNodeAnimationTrack::CT_CONSTANT;
+			channel.base[0] = values[0].w;
+			channel.base[1] = values[0].x;
+			channel.base[2] = values[0].y;
+			channel.base[3] = values[0].z;
+			return true;
+		}
+		if (ROTATION_QUANTISATION_ERROR > tolerance * 0.5f)
+			return false;
+
+		vector<size_t>::type kept;
+		selectKeys<Quaternion>(times, values, tolerance * 0.5f, kept);
+
+		channel.type = CompressedNodeAnimationTrack::CT_ANIMATED;
+		channel.base[0] = channel.base[1] = channel.base[2] = channel.base[3] = 0;
+		channel.times.resize(kept.size());
+		channel.keys.resize(kept.size() * 3);
+		uint16* key = &channel.keys[0];
+		for (size_t i = 0; i < kept.size(); ++i, key += 3)
+		{
+			channel.times[i] = times[kept[i]];
+			encodeRotation(values[kept[i]], key);
+		}
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	CompressedNodeAnimationTrack::CompressedNodeAnimationTrack(Animation* parent,
+		unsigned short handle, Node* targetNode)
+		: mParent(parent), mHandle(handle), mTargetNode(targetNode)
+	{
+		// Identity until compressed
+		mChannels[CI_ROTATE].base[0] = 1;
+		mChannels[CI_SCALE].base[0] = 1;
+		mChannels[CI_SCALE].base[1] = 1;
+		mChannels[CI_SCALE].base[2] = 1;
+	}
+	//-----------------------------------------------------------------------
+	bool CompressedNodeAnimationTrack::compress(const NodeAnimationTrack* track,
+		const Tolerances& tolerances)
+	{
+		size_t numKeys = track->getNumKeyFrames();
+		if (numKeys == 0)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Cannot compress a track without keyframes",
+				"CompressedNodeAnimationTrack::compress");
+		}
+
+		vector<float>::type times(numKeys);
+		vector<Vector3>::type translates(numKeys);
+		vector<Quaternion>::type rotates(numKeys);
+		vector<Vector3>::type scales(numKeys);
+		for (size_t i = 0; i < numKeys; ++i)
+		{
+			const TransformKeyFrame* kf = track->getNodeKeyFrame(static_cast<unsigned short>(i));
+			times[i] = static_cast<float>(kf->getTime());
+			translates[i] = kf->getTranslate();
+			rotates[i] = kf->getRotation();
+			rotates[i].normalise();
+			scales[i] = kf->getScale();
+		}
+
+		Channel channels[CI_COUNT];
+		if (!compressVectors(channels[CI_TRANSLATE], times, translates, tolerances.translation) ||
+			!compressRotations(channels[CI_ROTATE], times, rotates, tolerances.rotation.valueRadians()) ||
+			!compressVectors(channels[CI_SCALE], times, scales, tolerances.scale))
+		{
+			return false;
+		}
+		for (size_t c = 0; c < CI_COUNT; ++c)
+			mChannels[c] = channels[c];
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	void CompressedNodeAnimationTrack::decompress(NodeAnimationTrack* track) const
+	{
+		set<float>::type times;
+		for (size_t c = 0; c < CI_COUNT; ++c)
+			times.insert(mChannels[c].times.begin(), mChannels[c].times.end());
+		if (times.empty())
+			times.insert(0);
+
+		set<float>::type::const_iterator i, iend = times.end();
+		for (i = times.begin(); i != iend; ++i)
+		{
+			Real t = *i;
+			TransformKeyFrame* kf = track->createNodeKeyFrame(t);
+			kf->setTranslate(sampleVector(mChannels[CI_TRANSLATE], t));
+			kf->setRotation(sampleRotation(mChannels[CI_ROTATE], t));
+			kf->setScale(sampleVector(mChannels[CI_SCALE], t));
+		}
+	}
+	//-----------------------------------------------------------------------
+	void CompressedNodeAnimationTrack::getTransform(const TimeIndex& timeIndex,
+		Vector3& translate, Quaternion& rotate, Vector3& scale) const
+	{
+		Real t = std::min(std::max(timeIndex.getTimePos(), Real(0)), mParent->getLength());
+
+		translate = sampleVector(mChannels[CI_TRANSLATE], t);
+		rotate = sampleRotation(mChannels[CI_ROTATE], t);
+		scale = sampleVector(mChannels[CI_SCALE], t);
+	}
+	//-----------------------------------------------------------------------
+	void CompressedNodeAnimationTrack::apply(const TimeIndex& timeIndex, Real weight, Real scale)
+	{
+		applyToNode(mTargetNode, timeIndex, weight, scale);
+	}
+	//-----------------------------------------------------------------------
+	void CompressedNodeAnimationTrack::applyToNode(Node* node, const TimeIndex& timeIndex,
+		Real weight, Real scl)
+	{
+		// Nothing to do if zero weight or no node
+		if (!weight || !node)
+			return;
+
+		Vector3 translate, scale;
+		Quaternion rotate;
+		getTransform(timeIndex, translate, rotate, scale);
+
+		// Same as NodeAnimationTrack::applyToNode
+		node->translate(translate * weight * scl);
+
+		if (mParent->getRotationInterpolationMode() == Animation::RIM_LINEAR)
+			rotate = Quaternion::nlerp(weight, Quaternion::IDENTITY, rotate, true);
+		else
+			rotate = Quaternion::Slerp(weight, Quaternion::IDENTITY, rotate, true);
+		node->rotate(rotate);
+
+		if (scale != Vector3::UNIT_SCALE)
+		{
+			if (scl != 1.0f)
+				scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * scl;
+			else if (weight != 1.0f)
+				scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * weight;
+		}
+		node->scale(scale);
+	}
+	//-----------------------------------------------------------------------
+	size_t CompressedNodeAnimationTrack::getMemoryUsage(void) const
+	{
+		size_t size = sizeof(*this);
+		for (size_t c = 0; c < CI_COUNT; ++c)
+		{
+			size += mChannels[c].times.capacity() * sizeof(float);
+			size += mChannels[c].keys.capacity() * sizeof(uint16);
+		}
+		return size;
+	}
+	//-----------------------------------------------------------------------
+	CompressedNodeAnimationTrack* CompressedNodeAnimationTrack::_clone(Animation* newParent) const
+	{
+		CompressedNodeAnimationTrack* newTrack =
+			newParent->createCompressedNodeTrack(mHandle, mTargetNode);
+		for (size_t c = 0; c < CI_COUNT; ++c)
+			newTrack->mChannels[c] = mChannels[c];
+		return newTrack;
+	}
+	//-----------------------------------------------------------------------
+	void CompressedNodeAnimationTrack::findKeys(const Channel& channel, Real time,
+		size_t& key1, size_t& key2, Real& t) const
+	{
+		// Same rules as AnimationTrack::getKeyFramesAtTime
+		const float* times = &channel.times[0];
+		size_t numKeys = channel.times.size();
+
+		// First key after or on the time
+		size_t lo = 0, hi = numKeys;
+		while (lo < hi)
+		{
+			size_t mid = (lo + hi) / 2;
+			if (times[mid] < time)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		Real t1, t2;
+		if (lo == numKeys)
+		{
+			// Wrap back to the first key
+			key1 = numKeys - 1;
+			key2 = 0;
+			t2 = mParent->getLength() + times[0];
+		}
+		else
+		{
+			key2 = lo;
+			t2 = times[lo];
+			key1 = (lo != 0 && time < t2) ? lo - 1 : lo;
+		}
+		t1 = times[key1];
+		t = t1 == t2 ? 0 : (time - t1) / (t2 - t1);
+	}
+	//-----------------------------------------------------------------------
+	Vector3 CompressedNodeAnimationTrack::sampleVector(const Channel& channel, Real time) const
+	{
+		if (channel.type == CT_CONSTANT)
+			return Vector3(channel.base[0], channel.base[1], channel.base[2]);
+
+		size_t key1, key2;
+		Real t;
+		findKeys(channel, time, key1, key2, t);
+
+		const uint16* k1 = &channel.keys[key1 * 3];
+		const uint16* k2 = &channel.keys[key2 * 3];
+		Vector3 v;
+		for (size_t c = 0; c < 3; ++c)
+		{
+			Real v1 = k1[c];
+			v[c] = channel.base[c] + (v1 + (k2[c] - v1) * t) * channel.step[c];
+		}
+		return v;
+	}
+	//-----------------------------------------------------------------------
+	Quaternion CompressedNodeAnimationTrack::sampleRotation(const Channel& channel, Real time) const
+	{
+		if (channel.type == CT_CONSTANT)
+			return Quaternion(channel.base[0], channel.base[1], channel.base[2], channel.base[3]);
+
+		size_t key1, key2;
+		Real t;
+		findKeys(channel, time, key1, key2, t);
+
+		Quaternion q1 = decodeRotation(&channel.keys[key1 * 3]);
+		if (t == 0)
+			return q1;
+		Quaternion q2 = decodeRotation(&channel.keys[key2 * 3]);
+		if (mParent->getRotationInterpolationMode() == Animation::RIM_LINEAR)
+			return Quaternion::nlerp(t, q1, q2, true);
+		else
+			return Quaternion::Slerp(t, q1, q2, true);
+	}
+}
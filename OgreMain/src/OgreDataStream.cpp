@@ -30,6 +30,21 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreException.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#	define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#elif OGRE_PLATFORM == OGRE_PLATFORM_LINUX || OGRE_PLATFORM == OGRE_PLATFORM_APPLE || \
+    OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS || OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#  define OGRE_MMAP_POSIX
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -762,5 +777,117 @@ namespace Ogre {
 		}
     }
     //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    MMapDataStream::MMapDataStream(const String& name, const String& path)
+        : MemoryDataStream(name, 0, 0, false, true)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + path, "MMapDataStream::MMapDataStream");
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || (ULONGLONG)fileSize.QuadPart > (size_t)-1)
+        {
+            CloseHandle(file);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot map file: " + path, "MMapDataStream::MMapDataStream");
+        }
+        mSize = (size_t)fileSize.QuadPart;
+
+        // Empty files cannot be mapped, leave the stream empty
+        if (mSize)
+        {
+            // The view keeps the mapping alive, the handles are not needed
+            HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+            if (mapping)
+            {
+                mData = static_cast<uchar*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            if (!mData)
+            {
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                    "Cannot map file: " + path, "MMapDataStream::MMapDataStream");
+            }
+        }
+        else
+        {
+            CloseHandle(file);
+        }
+#elif defined(OGRE_MMAP_POSIX)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + path, "MMapDataStream::MMapDataStream");
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        {
+            ::close(fd);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot map file: " + path, "MMapDataStream::MMapDataStream");
+        }
+        mSize = (size_t)fileStat.st_size;
 
+        // Empty files cannot be mapped, leave the stream empty
+        if (mSize)
+        {
+            // The mapping stays valid once the file is closed
+            void* data = mmap(0, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED)
+            {
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                    "Cannot map file: " + path, "MMapDataStream::MMapDataStream");
+            }
+            mData = static_cast<uchar*>(data);
+        }
+        else
+        {
+            ::close(fd);
+        }
+#else
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+            "Mapping files is not supported on this platform",
+            "MMapDataStream::MMapDataStream");
+#endif
+        mPos = mData;
+        mEnd = mData + mSize;
+    }
+    //-----------------------------------------------------------------------
+    MMapDataStream::~MMapDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    bool MMapDataStream::isSupported(void)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || defined(OGRE_MMAP_POSIX)
+        return true;
+#else
+        return false;
+#endif
+    }
+    //-----------------------------------------------------------------------
+    void MMapDataStream::close(void)
+    {
+        if (mData)
+        {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            UnmapViewOfFile(mData);
+#elif defined(OGRE_MMAP_POSIX)
+            munmap(mData, mSize);
+#endif
+            mData = mPos = mEnd = 0;
+        }
+    }
 }
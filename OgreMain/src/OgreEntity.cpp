@@ -53,6 +53,11 @@ THE SOFTWARE.
 #include "OgreLodStrategy.h"
 #include "OgreLodListener.h"
 #include "OgreMaterialManager.h"
+#include "OgreSoftwareVertexBlendBatch.h"
+#include "OgreSkeletonPoseBatch.h"
+#include "OgreSkeletonPoseCache.h"
+#include "OgreDualQuaternion.h"
+#include "OgreAtomicScalar.h"
 
 namespace Ogre {
     //-----------------------------------------------------------------------
@@ -77,6 +82,12 @@ namespace Ogre {
 		  mSoftwareAnimationNormalsRequests(0),
           mSkipAnimStateUpdates(false),
 		  mAlwaysUpdateMainSkeleton(false),
+		  mSoftwareDualQuaternionSkinning(false),
+		  mBoneDualQuaternions(NULL),
+		  mAnimationLodIndex(0),
+		  mAnimationLodFrame(std::numeric_limits<unsigned long>::max()),
+		  mAnimationLodPhase(0),
+		  mAnimationLodEvaluatedFrame(std::numeric_limits<unsigned long>::max()),
 		  mMeshLodIndex(0),
 		  mMeshLodFactorTransformed(1.0f),
 		  mMinMeshLodIndex(99),
@@ -115,6 +126,12 @@ namespace Ogre {
 		mSoftwareAnimationNormalsRequests(0),
         mSkipAnimStateUpdates(false),
 		mAlwaysUpdateMainSkeleton(false),
+		mSoftwareDualQuaternionSkinning(false),
+		mBoneDualQuaternions(NULL),
+		mAnimationLodIndex(0),
+		mAnimationLodFrame(std::numeric_limits<unsigned long>::max()),
+		mAnimationLodPhase(0),
+		mAnimationLodEvaluatedFrame(std::numeric_limits<unsigned long>::max()),
 		mMeshLodIndex(0),
 		mMeshLodFactorTransformed(1.0f),
 		mMinMeshLodIndex(99),
@@ -197,6 +214,9 @@ namespace Ogre {
 			mFrameBonesLastUpdated = OGRE_NEW_T(unsigned long, MEMCATEGORY_ANIMATION)(std::numeric_limits<unsigned long>::max());
 			mNumBoneMatrices = mSkeletonInstance->getNumBones();
 			mBoneMatrices = static_cast<Matrix4*>(OGRE_MALLOC_SIMD(sizeof(Matrix4) * mNumBoneMatrices, MEMCATEGORY_ANIMATION));
+			// The new skeleton instance animates all its bones
+			mAnimationLodIndex = 0;
+			mAnimationLodEvaluatedFrame = std::numeric_limits<unsigned long>::max();
 		}
 		if (hasSkeleton() || hasVertexAnimation())
 		{
@@ -263,6 +283,10 @@ namespace Ogre {
 		if (mSkeletonInstance) {
 			OGRE_FREE_SIMD(mBoneWorldMatrices, MEMCATEGORY_ANIMATION);
             mBoneWorldMatrices = 0;
+			OGRE_FREE(mBoneDualQuaternions, MEMCATEGORY_ANIMATION);
+			mBoneDualQuaternions = 0;
+			mAnimationLodPoses.clear();
+			mAnimationLodIndex = 0;
 
             if (mSharedSkeletonEntities) {
                 mSharedSkeletonEntities->erase(this);
@@ -362,6 +386,8 @@ namespace Ogre {
 				OGRE_DELETE newEnt->mAnimationState;
 				newEnt->mAnimationState = OGRE_NEW AnimationStateSet(*mAnimationState);
 			}
+			if (!mAnimationLodLevels.empty())
+				newEnt->setAnimationLodLevels(mAnimationLodLevels);
 		}
 
         return newEnt;
@@ -429,6 +455,10 @@ namespace Ogre {
             // Change LOD index
             mMeshLodIndex = evt.newLodIndex;
 
+            // Animation LOD, from the unbiased value
+            if (!mAnimationLodLevels.empty())
+                updateAnimationLodIndex(lodValue);
+
             // Now do material LOD
             lodValue *= mMaterialLodFactorTransformed;
 
@@ -788,6 +818,11 @@ namespace Ogre {
         bool animationDirty =
             (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
             (hasSkeleton() && getSkeleton()->getManualBonesDirty());
+        // The bone matrices are held on the frames skipped by the animation LOD
+        if (animationDirty && hasSkeleton() && !hasVertexAnimation() &&
+            isAnimationLodFrameSkipped() &&
+            !mAnimationLodLevels[mAnimationLodIndex - 1].interpolate)
+            animationDirty = false;
 		
 		//update the current hardware animation state
 		mCurrentHWAnimationState = hwAnimation;
@@ -838,11 +873,28 @@ namespace Ogre {
 			if (hasSkeleton())
 			{
 				cacheBoneMatrices();
+				updateAnimationLodPose();
 
 				// Software blend?
 				if (softwareAnimation)
 				{
                     const Matrix4* blendMatrices[256];
+					const DualQuaternion* blendDualQuaternions[256];
+					if (mSoftwareDualQuaternionSkinning)
+					{
+						// Convert the bone matrices once for all the geometry
+						if (!mBoneDualQuaternions)
+						{
+							mBoneDualQuaternions = OGRE_ALLOC_T(DualQuaternion,
+								mNumBoneMatrices, MEMCATEGORY_ANIMATION);
+						}
+						for (unsigned short b = 0; b < mNumBoneMatrices; ++b)
+							mBoneDualQuaternions[b].fromTransformationMatrix(mBoneMatrices[b]);
+					}
+					// Defer the blends if the scene manager performs them in a batch
+					SceneManager* sceneMgr = root._getCurrentSceneManager();
+					SoftwareVertexBlendBatch* blendBatch =
+						sceneMgr ? sceneMgr->_getSoftwareVertexBlendBatch() : 0;
 
 					// Ok, we need to do a software blend
 					// Firstly, check out working vertex buffers
@@ -855,16 +907,37 @@ namespace Ogre {
 						mTempSkelAnimInfo.checkoutTempCopies(true, blendNormals);
 						mTempSkelAnimInfo.bindTempCopies(mSkelAnimVertexData,
 							hwAnimation);
-                        // Prepare blend matrices, TODO: Move out of here
-                        Mesh::prepareMatricesForVertexBlend(blendMatrices,
-                            mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
 						// Blend, taking source from either mesh data or morph data
-						Mesh::softwareVertexBlend(
+						const VertexData* srcData =
 							(mMesh->getSharedVertexDataAnimationType() != VAT_NONE) ?
-								mSoftwareVertexAnimVertexData :	mMesh->sharedVertexData,
-							mSkelAnimVertexData,
-							blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
-							blendNormals);
+								mSoftwareVertexAnimVertexData :	mMesh->sharedVertexData;
+						if (mSoftwareDualQuaternionSkinning)
+						{
+							Mesh::prepareDualQuaternionsForVertexBlend(blendDualQuaternions,
+								mBoneDualQuaternions, mMesh->sharedBlendIndexToBoneIndexMap);
+							if (blendBatch)
+								blendBatch->add(srcData, mSkelAnimVertexData,
+									blendDualQuaternions, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+									blendNormals);
+							else
+								Mesh::softwareVertexBlend(srcData, mSkelAnimVertexData,
+									blendDualQuaternions, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+									blendNormals);
+						}
+						else
+						{
+							// Prepare blend matrices, TODO: Move out of here
+							Mesh::prepareMatricesForVertexBlend(blendMatrices,
+								mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
+							if (blendBatch)
+								blendBatch->add(srcData, mSkelAnimVertexData,
+									blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+									blendNormals);
+							else
+								Mesh::softwareVertexBlend(srcData, mSkelAnimVertexData,
+									blendMatrices, mMesh->sharedBlendIndexToBoneIndexMap.size(),
+									blendNormals);
+						}
 					}
 					SubEntityList::iterator i, iend;
 					iend = mSubEntityList.end();
@@ -877,16 +950,37 @@ namespace Ogre {
 							se->mTempSkelAnimInfo.checkoutTempCopies(true, blendNormals);
 							se->mTempSkelAnimInfo.bindTempCopies(se->mSkelAnimVertexData,
 								hwAnimation);
-                            // Prepare blend matrices, TODO: Move out of here
-                            Mesh::prepareMatricesForVertexBlend(blendMatrices,
-                                mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
 							// Blend, taking source from either mesh data or morph data
-							Mesh::softwareVertexBlend(
+							const VertexData* srcData =
 								(se->getSubMesh()->getVertexAnimationType() != VAT_NONE)?
-									se->mSoftwareVertexAnimVertexData : se->mSubMesh->vertexData,
-								se->mSkelAnimVertexData,
-								blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
-								blendNormals);
+									se->mSoftwareVertexAnimVertexData : se->mSubMesh->vertexData;
+							if (mSoftwareDualQuaternionSkinning)
+							{
+								Mesh::prepareDualQuaternionsForVertexBlend(blendDualQuaternions,
+									mBoneDualQuaternions, se->mSubMesh->blendIndexToBoneIndexMap);
+								if (blendBatch)
+									blendBatch->add(srcData, se->mSkelAnimVertexData,
+										blendDualQuaternions, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+										blendNormals);
+								else
+									Mesh::softwareVertexBlend(srcData, se->mSkelAnimVertexData,
+										blendDualQuaternions, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+										blendNormals);
+							}
+							else
+							{
+								// Prepare blend matrices, TODO: Move out of here
+								Mesh::prepareMatricesForVertexBlend(blendMatrices,
+									mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
+								if (blendBatch)
+									blendBatch->add(srcData, se->mSkelAnimVertexData,
+										blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+										blendNormals);
+								else
+									Mesh::softwareVertexBlend(srcData, se->mSkelAnimVertexData,
+										blendMatrices, se->mSubMesh->blendIndexToBoneIndexMap.size(),
+										blendNormals);
+							}
 						}
 
 					}
@@ -1355,16 +1449,252 @@ namespace Ogre {
         if ((*mFrameBonesLastUpdated != currentFrameNumber) ||
 			(hasSkeleton() && getSkeleton()->getManualBonesDirty()))
 		{
+			// Keep the last matrices on the frames skipped by the animation LOD,
+			// which never have manual bones
+			if (isAnimationLodFrameSkipped())
+			{
+				*mFrameBonesLastUpdated = currentFrameNumber;
+				return false;
+			}
+
+			Matrix4* pose = 0;
 			if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
-	            mSkeletonInstance->setAnimationState(*mAnimationState);
-            mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+			{
+				// Share the pose with other entities if possible
+				SkeletonPoseCache* cache = mManager ? &mManager->getSkeletonPoseCache() : 0;
+				if (cache && cache->getEnabled() && _isSkeletonPoseBatchable() &&
+					cache->_acquirePose(mMesh->getSkeleton().get(), mSkeletonInstance,
+						*mAnimationState, pose))
+				{
+					memcpy(mBoneMatrices, pose, sizeof(Matrix4) * mNumBoneMatrices);
+					*mFrameBonesLastUpdated = currentFrameNumber;
+					mAnimationLodEvaluatedFrame = currentFrameNumber;
+					return true;
+				}
+				try
+				{
+					mSkeletonInstance->setAnimationState(*mAnimationState);
+					mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+				}
+				catch (...)
+				{
+					// Other entities must not copy the unevaluated pose
+					if (pose)
+						mManager->getSkeletonPoseCache()._discardPose(pose);
+					throw;
+				}
+			}
+			else
+			{
+				mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+			}
             *mFrameBonesLastUpdated  = currentFrameNumber;
+			mAnimationLodEvaluatedFrame = currentFrameNumber;
+			if (pose)
+				memcpy(pose, mBoneMatrices, sizeof(Matrix4) * mNumBoneMatrices);
 
 			return true;
         }
 		return false;
     }
     //-----------------------------------------------------------------------
+    bool Entity::_isBoneMatricesUpdatePending(void) const
+    {
+        return hasSkeleton() && getVisible() && isInScene() &&
+            *mFrameBonesLastUpdated != Root::getSingleton().getNextFrameNumber() &&
+            !isAnimationLodFrameSkipped();
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_evaluateBoneMatrices(void)
+    {
+        if (!mSkipAnimStateUpdates)
+            mSkeletonInstance->setAnimationState(*mAnimationState);
+        mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+        *mFrameBonesLastUpdated = Root::getSingleton().getNextFrameNumber();
+        mAnimationLodEvaluatedFrame = *mFrameBonesLastUpdated;
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::_isSkeletonPoseBatchable(void) const
+    {
+        if (!_isBoneMatricesUpdatePending() || mSkeletonInstance->hasManualBones())
+            return false;
+
+        // The bones must not be needed by this entity nor any sharing them
+        if (mSharedSkeletonEntities)
+        {
+            EntitySet::const_iterator i, iend = mSharedSkeletonEntities->end();
+            for (i = mSharedSkeletonEntities->begin(); i != iend; ++i)
+            {
+                const Entity* ent = *i;
+                if (ent->mSkipAnimStateUpdates || ent->mDisplaySkeleton ||
+                    !ent->mChildObjectList.empty())
+                    return false;
+            }
+            return true;
+        }
+        return !mSkipAnimStateUpdates && !mDisplaySkeleton && mChildObjectList.empty();
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_addToSkeletonPoseBatch(SkeletonPoseBatch* batch, SkeletonPoseCache* cache)
+    {
+        Matrix4* pose = 0;
+        bool evaluated = cache && cache->_acquirePose(mMesh->getSkeleton().get(),
+            mSkeletonInstance, *mAnimationState, pose);
+        if (!pose)
+        {
+            batch->add(mSkeletonInstance, mAnimationState, mBoneMatrices);
+        }
+        else
+        {
+            // The pose may only be evaluated by this batch
+            if (!evaluated)
+                batch->add(mSkeletonInstance, mAnimationState, pose);
+            batch->addCopy(pose, mBoneMatrices);
+        }
+        *mFrameBonesLastUpdated = Root::getSingleton().getNextFrameNumber();
+        mAnimationLodEvaluatedFrame = *mFrameBonesLastUpdated;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::setAnimationLodLevels(const AnimationLodLevelList& levels)
+    {
+        const LodStrategy* strategy = mMesh->getLodStrategy();
+        mAnimationLodLevels = levels;
+        mAnimationLodValues.clear();
+        mAnimationLodBoneMasks.clear();
+        if (!levels.empty())
+        {
+            mAnimationLodValues.push_back(strategy->getBaseValue());
+            AnimationLodLevelList::const_iterator i, iend = levels.end();
+            for (i = levels.begin(); i != iend; ++i)
+            {
+                mAnimationLodValues.push_back(strategy->transformUserValue(i->userValue));
+
+                Skeleton::BoneMask mask;
+                vector<unsigned short>::type::const_iterator b, bend = i->disabledBones.end();
+                for (b = i->disabledBones.begin(); b != bend; ++b)
+                {
+                    if (*b >= mask.size())
+                        mask.resize(*b + 1, false);
+                    mask[*b] = true;
+                }
+                mAnimationLodBoneMasks.push_back(mask);
+            }
+            strategy->assertSorted(mAnimationLodValues);
+        }
+
+        // Spread the evaluations of the entities across the frames
+        static AtomicScalar<unsigned long> nextPhase(0);
+        mAnimationLodPhase = nextPhase++;
+
+        // Back to full detail until the next camera notification
+        mAnimationLodIndex = 0;
+        mAnimationLodFrame = std::numeric_limits<unsigned long>::max();
+        if (mSkeletonInstance && !mSharedSkeletonEntities)
+            mSkeletonInstance->_setDisabledBones(0);
+    }
+    //-----------------------------------------------------------------------
+    void Entity::updateAnimationLodIndex(Real lodValue)
+    {
+        if (!mSkeletonInstance || mSharedSkeletonEntities)
+            return;
+
+        ushort index = mMesh->getLodStrategy()->getIndex(lodValue, mAnimationLodValues);
+        // Most detailed level for all the cameras of the frame
+        unsigned long frameNumber = Root::getSingleton().getNextFrameNumber();
+        if (mAnimationLodFrame == frameNumber)
+            index = std::min(index, mAnimationLodIndex);
+        mAnimationLodFrame = frameNumber;
+
+        if (index != mAnimationLodIndex)
+        {
+            mAnimationLodIndex = index;
+            const Skeleton::BoneMask* mask = index ? &mAnimationLodBoneMasks[index - 1] : 0;
+            mSkeletonInstance->_setDisabledBones(mask && !mask->empty() ? mask : 0);
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::isAnimationLodSkippingFrames(void) const
+    {
+        // Only when nothing but skinning uses the bones
+        return mAnimationLodIndex &&
+            mAnimationLodLevels[mAnimationLodIndex - 1].updateInterval > 1 &&
+            !mSharedSkeletonEntities && !mSkipAnimStateUpdates && !mDisplaySkeleton &&
+            mChildObjectList.empty() && !mSkeletonInstance->hasManualBones();
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::isAnimationLodFrameSkipped(void) const
+    {
+        if (!isAnimationLodSkippingFrames() ||
+            mAnimationLodEvaluatedFrame == std::numeric_limits<unsigned long>::max())
+            return false;
+
+        // Evaluate on the frames of the phase of this entity, or when overdue
+        unsigned long frameNumber = Root::getSingleton().getNextFrameNumber();
+        unsigned short interval = mAnimationLodLevels[mAnimationLodIndex - 1].updateInterval;
+        return frameNumber - mAnimationLodEvaluatedFrame < interval &&
+            (frameNumber + mAnimationLodPhase) % interval != 0;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::updateAnimationLodPose(void)
+    {
+        if (!isAnimationLodSkippingFrames() ||
+            !mAnimationLodLevels[mAnimationLodIndex - 1].interpolate ||
+            mAnimationLodEvaluatedFrame == std::numeric_limits<unsigned long>::max())
+        {
+            // Start from the next evaluation when interpolating again
+            mAnimationLodPoseFrames[1] = std::numeric_limits<unsigned long>::max();
+            return;
+        }
+
+        if (mAnimationLodPoses.empty())
+        {
+            mAnimationLodPoses.resize(mNumBoneMatrices * 2);
+            mAnimationLodPoseFrames[1] = std::numeric_limits<unsigned long>::max();
+        }
+        AnimationLodBonePose* previous = &mAnimationLodPoses[0];
+        AnimationLodBonePose* last = previous + mNumBoneMatrices;
+
+        if (mAnimationLodPoseFrames[1] != mAnimationLodEvaluatedFrame)
+        {
+            // The bone matrices hold a new evaluation, decompose it once
+            bool first = mAnimationLodPoseFrames[1] == std::numeric_limits<unsigned long>::max();
+            if (!first)
+            {
+                std::copy(last, last + mNumBoneMatrices, previous);
+                mAnimationLodPoseFrames[0] = mAnimationLodPoseFrames[1];
+            }
+            for (unsigned short b = 0; b < mNumBoneMatrices; ++b)
+            {
+                mBoneMatrices[b].decomposition(last[b].position, last[b].scale,
+                    last[b].orientation);
+            }
+            if (first)
+            {
+                std::copy(last, last + mNumBoneMatrices, previous);
+                mAnimationLodPoseFrames[0] = mAnimationLodEvaluatedFrame;
+            }
+            mAnimationLodPoseFrames[1] = mAnimationLodEvaluatedFrame;
+        }
+
+        // Move from the previous evaluation to the last one until the next
+        unsigned long frameNumber = Root::getSingleton().getNextFrameNumber();
+        Real t = 1;
+        if (mAnimationLodPoseFrames[1] != mAnimationLodPoseFrames[0])
+        {
+            t = std::min(Real(1), Real(frameNumber - mAnimationLodPoseFrames[1]) /
+                Real(mAnimationLodPoseFrames[1] - mAnimationLodPoseFrames[0]));
+        }
+        for (unsigned short b = 0; b < mNumBoneMatrices; ++b)
+        {
+            // Blend the decomposed transforms, lerping the matrices would
+            // shrink the rotating bones
+            mBoneMatrices[b].makeTransform(
+                previous[b].position + (last[b].position - previous[b].position) * t,
+                previous[b].scale + (last[b].scale - previous[b].scale) * t,
+                Quaternion::nlerp(t, previous[b].orientation, last[b].orientation, true));
+        }
+    }
+    //-----------------------------------------------------------------------
     void Entity::setDisplaySkeleton(bool display)
     {
         mDisplaySkeleton = display;
@@ -2267,6 +2597,18 @@ namespace Ogre {
             OGRE_DELETE mAnimationState;
 			// using OGRE_FREE since unsigned long is not a destructor
 			OGRE_FREE(mFrameBonesLastUpdated, MEMCATEGORY_ANIMATION);
+			// Reallocated for the number of bones of the shared skeleton
+			OGRE_FREE(mBoneDualQuaternions, MEMCATEGORY_ANIMATION);
+			mBoneDualQuaternions = 0;
+			mAnimationLodPoses.clear();
+			// The animation LOD is ignored while sharing, by both entities
+			mAnimationLodIndex = 0;
+			mAnimationLodFrame = std::numeric_limits<unsigned long>::max();
+			mAnimationLodEvaluatedFrame = std::numeric_limits<unsigned long>::max();
+			entity->mAnimationLodIndex = 0;
+			entity->mAnimationLodFrame = std::numeric_limits<unsigned long>::max();
+			entity->mAnimationLodPoseFrames[1] = std::numeric_limits<unsigned long>::max();
+			entity->mSkeletonInstance->_setDisabledBones(0);
             mSkeletonInstance = entity->mSkeletonInstance;
             mNumBoneMatrices = entity->mNumBoneMatrices;
             mBoneMatrices = entity->mBoneMatrices;
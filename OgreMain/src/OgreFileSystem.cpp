@@ -58,6 +58,7 @@ THE SOFTWARE.
 namespace Ogre {
 
 	bool FileSystemArchive::msIgnoreHidden = true;
+	bool FileSystemArchive::msUseMemoryMapping = false;
 
     //-----------------------------------------------------------------------
     FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly )
@@ -228,6 +229,18 @@ namespace Ogre {
                         "FileSystemArchive::open");
         }
 
+		if (readOnly && msUseMemoryMapping && ret == 0 && MMapDataStream::isSupported())
+		{
+			try
+			{
+				return DataStreamPtr(OGRE_NEW MMapDataStream(filename, full_path));
+			}
+			catch (Exception&)
+			{
+				// Read the file as a stream instead
+			}
+		}
+
 		if (!readOnly)
 		{
 			mode |= std::ios::out;
@@ -41,6 +41,9 @@ THE SOFTWARE.
 #include "OgreHardwareIndexBuffer.h"
 #include "OgreMaterialManager.h"
 #include "OgreRenderSystem.h"
+#include "OgreOptimisedUtil.h"
+
+#include <typeinfo>
 
 namespace Ogre {
 
@@ -261,6 +264,104 @@ namespace Ogre {
         return true;
     }
 
+    //-----------------------------------------------------------------------
+    bool Frustum::isBatchVisibilityExact(void) const
+    {
+        return typeid(*this) == typeid(Frustum);
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::calculateVisibility(const AxisAlignedBox* const* bounds, size_t count,
+        uint32* visibility) const
+    {
+        if (!isBatchVisibilityExact())
+        {
+            // isVisible is overridden, the plane test would not match it
+            memset(visibility, 0, ((count + 31) / 32) * sizeof(uint32));
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (isVisible(*bounds[i]))
+                    visibility[i >> 5] |= 1u << (i & 31);
+            }
+            return;
+        }
+
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        // Skip far plane if infinite view frustum
+        Plane planes[6];
+        size_t numPlanes = 0;
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            if (plane != FRUSTUM_PLANE_FAR || mFarDist != 0)
+                planes[numPlanes++] = mFrustumPlanes[plane];
+        }
+
+        // Boxes are tested in batches of 64, a multiple of 32 so that every
+        // batch fills whole entries of the visibility array
+        const size_t batchSize = 64;
+        OGRE_SIMD_ALIGNED_DECL(Real, centreX[batchSize]);
+        OGRE_SIMD_ALIGNED_DECL(Real, centreY[batchSize]);
+        OGRE_SIMD_ALIGNED_DECL(Real, centreZ[batchSize]);
+        OGRE_SIMD_ALIGNED_DECL(Real, halfSizeX[batchSize]);
+        OGRE_SIMD_ALIGNED_DECL(Real, halfSizeY[batchSize]);
+        OGRE_SIMD_ALIGNED_DECL(Real, halfSizeZ[batchSize]);
+
+        for (size_t first = 0; first < count; first += batchSize)
+        {
+            size_t num = std::min(batchSize, count - first);
+            uint32 nullMask[2] = { 0, 0 };
+            uint32 infiniteMask[2] = { 0, 0 };
+
+            for (size_t i = 0; i < num; ++i)
+            {
+                const AxisAlignedBox& bound = *bounds[first + i];
+                if (bound.isFinite())
+                {
+                    Vector3 centre = bound.getCenter();
+                    Vector3 halfSize = bound.getHalfSize();
+                    centreX[i] = centre.x;
+                    centreY[i] = centre.y;
+                    centreZ[i] = centre.z;
+                    halfSizeX[i] = halfSize.x;
+                    halfSizeY[i] = halfSize.y;
+                    halfSizeZ[i] = halfSize.z;
+                }
+                else
+                {
+                    // Null boxes always invisible, infinite boxes always visible
+                    if (bound.isNull())
+                        nullMask[i >> 5] |= 1u << (i & 31);
+                    else
+                        infiniteMask[i >> 5] |= 1u << (i & 31);
+                    centreX[i] = centreY[i] = centreZ[i] = 0;
+                    halfSizeX[i] = halfSizeY[i] = halfSizeZ[i] = 0;
+                }
+            }
+
+            // Pad to a multiple of 4 boxes
+            size_t padded = (num + 3) & ~size_t(3);
+            for (size_t i = num; i < padded; ++i)
+            {
+                centreX[i] = centreY[i] = centreZ[i] = 0;
+                halfSizeX[i] = halfSizeY[i] = halfSizeZ[i] = 0;
+            }
+
+            uint32* words = visibility + first / 32;
+            OptimisedUtil::getImplementation()->cullAxisAlignedBoxes(
+                planes, numPlanes, centreX, centreY, centreZ,
+                halfSizeX, halfSizeY, halfSizeZ, words, padded);
+
+            size_t numWords = (num + 31) / 32;
+            for (size_t w = 0; w < numWords; ++w)
+            {
+                words[w] = (words[w] & ~nullMask[w]) | infiniteMask[w];
+            }
+            // Clear the bits of the padding
+            if (num & 31)
+                words[numWords - 1] &= (1u << (num & 31)) - 1;
+        }
+    }
     //-----------------------------------------------------------------------
     bool Frustum::isVisible(const Vector3& vert, FrustumPlane* culledBy) const
     {
@@ -551,10 +652,19 @@ namespace Ogre {
 #endif
 
 		RenderSystem* renderSystem = Root::getSingleton().getRenderSystem();
-		// API specific
-		renderSystem->_convertProjectionMatrix(mProjMatrix, mProjMatrixRS);
-		// API specific for Gpu Programs
-		renderSystem->_convertProjectionMatrix(mProjMatrix, mProjMatrixRSDepth, true);
+		if (renderSystem)
+		{
+			// API specific
+			renderSystem->_convertProjectionMatrix(mProjMatrix, mProjMatrixRS);
+			// API specific for Gpu Programs
+			renderSystem->_convertProjectionMatrix(mProjMatrix, mProjMatrixRSDepth, true);
+		}
+		else
+		{
+			// No render system yet, culling only needs mProjMatrix
+			mProjMatrixRS = mProjMatrix;
+			mProjMatrixRSDepth = mProjMatrix;
+		}
 
 
 		// Calculate bounding box (local)
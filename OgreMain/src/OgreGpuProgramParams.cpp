@@ -812,6 +812,7 @@ namespace Ogre
 		mTransposeMatrices = oth.mTransposeMatrices;
 		mIgnoreMissingParams  = oth.mIgnoreMissingParams;
 		mActivePassIterationIndex = oth.mActivePassIterationIndex;
+		_markAllDirty();
 
 		return *this;
 	}
@@ -872,6 +873,7 @@ namespace Ogre
 			mIntConstants.insert(mIntConstants.end(), 
 				namedConstants->intBufferSize - mIntConstants.size(), 0);
 		}
+		_markAllDirty();
 	}
 	//---------------------------------------------------------------------
 	void GpuProgramParameters::_setLogicalIndexes(
@@ -903,6 +905,7 @@ namespace Ogre
 			mIntConstants.insert(mIntConstants.end(), 
 				intIndexMap->bufferSize - mIntConstants.size(), 0);
 		}
+		_markAllDirty();
 
 	}
 	//---------------------------------------------------------------------()
@@ -987,13 +990,8 @@ namespace Ogre
 		assert(!mFloatLogicalToPhysical.isNull() && "GpuProgram hasn't set up the logical -> physical map!");
 
 		size_t physicalIndex = _getFloatConstantPhysicalIndex(index, rawCount, GPV_GLOBAL);
-		assert(physicalIndex + rawCount <= mFloatConstants.size());
-		// Copy manually since cast required
-		for (size_t i = 0; i < rawCount; ++i)
-		{
-			mFloatConstants[physicalIndex + i] = 
-				static_cast<float>(val[i]);
-		}
+		// Copy, the double version casts
+		_writeRawConstants(physicalIndex, val, rawCount);
 
 	}
 	//-----------------------------------------------------------------------------
@@ -1088,22 +1086,41 @@ namespace Ogre
 	void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const double* val, size_t count)
 	{
 		assert(physicalIndex + count <= mFloatConstants.size());
+		bool changed = false;
 		for (size_t i = 0; i < count; ++i)
 		{
-			mFloatConstants[physicalIndex+i] = static_cast<float>(val[i]);
+			float f = static_cast<float>(val[i]);
+			if (mFloatConstants[physicalIndex+i] != f)
+			{
+				mFloatConstants[physicalIndex+i] = f;
+				changed = true;
+			}
 		}
+		if (changed)
+			mFloatDirty.mark(physicalIndex, count);
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const float* val, size_t count)
 	{
 		assert(physicalIndex + count <= mFloatConstants.size());
-		memcpy(&mFloatConstants[physicalIndex], val, sizeof(float) * count);
+		// Only flag values which change, so that they alone need uploading
+		float* dest = &mFloatConstants[physicalIndex];
+		if (memcmp(dest, val, sizeof(float) * count) != 0)
+		{
+			memcpy(dest, val, sizeof(float) * count);
+			mFloatDirty.mark(physicalIndex, count);
+		}
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_writeRawConstants(size_t physicalIndex, const int* val, size_t count)
 	{
 		assert(physicalIndex + count <= mIntConstants.size());
-		memcpy(&mIntConstants[physicalIndex], val, sizeof(int) * count);
+		int* dest = &mIntConstants[physicalIndex];
+		if (memcmp(dest, val, sizeof(int) * count) != 0)
+		{
+			memcpy(dest, val, sizeof(int) * count);
+			mIntDirty.mark(physicalIndex, count);
+		}
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_readRawConstants(size_t physicalIndex, size_t count, float* dest)
@@ -1298,6 +1315,7 @@ namespace Ogre
 
 				// Expand at buffer end
 				mFloatConstants.insert(mFloatConstants.end(), requestedSize, 0.0f);
+				_markAllDirty();
 
 				// Record extended size for future GPU params re-using this information
 				mFloatLogicalToPhysical->bufferSize = mFloatConstants.size();
@@ -1347,6 +1365,7 @@ namespace Ogre
 				FloatConstantList::iterator insertPos = mFloatConstants.begin();
 				std::advance(insertPos, physicalIndex);
 				mFloatConstants.insert(insertPos, insertCount, 0.0f);
+				_markAllDirty();
 				// shift all physical positions after this one
 				for (GpuLogicalIndexUseMap::iterator i = mFloatLogicalToPhysical->map.begin();
 					i != mFloatLogicalToPhysical->map.end(); ++i)
@@ -1513,6 +1532,7 @@ namespace Ogre
 
 				// Expand at buffer end
 				mIntConstants.insert(mIntConstants.end(), requestedSize, 0);
+				_markAllDirty();
 
 				// Record extended size for future GPU params re-using this information
 				mIntLogicalToPhysical->bufferSize = mIntConstants.size();
@@ -1561,6 +1581,7 @@ namespace Ogre
 				IntConstantList::iterator insertPos = mIntConstants.begin();
 				std::advance(insertPos, physicalIndex);
 				mIntConstants.insert(insertPos, insertCount, 0);
+				_markAllDirty();
 				// shift all physical positions after this one
 				for (GpuLogicalIndexUseMap::iterator i = mIntLogicalToPhysical->map.begin();
 					i != mIntLogicalToPhysical->map.end(); ++i)
@@ -2872,6 +2893,7 @@ namespace Ogre
 		mAutoConstants = source.getAutoConstantList();
 		mCombinedVariability = source.mCombinedVariability;
 		copySharedParamSetUsage(source.mSharedParamSets);
+		_markAllDirty();
 	}
 	//---------------------------------------------------------------------
 	void GpuProgramParameters::copyMatchingNamedConstantsFrom(const GpuProgramParameters& source)
@@ -2948,6 +2970,9 @@ namespace Ogre
 					addSharedParameters(usage.getSharedParams());
 				}
 			}
+
+			// Values were copied through pointers
+			_markAllDirty();
 		}
 	}
 	//-----------------------------------------------------------------------
@@ -3001,6 +3026,7 @@ namespace Ogre
 		{
 			// This is a physical index
 			++mFloatConstants[mActivePassIterationIndex];
+			mFloatDirty.mark(mActivePassIterationIndex, 1);
 		}
 	}
 	//---------------------------------------------------------------------
@@ -0,0 +1,556 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#if OGRE_NO_ZIP_ARCHIVE == 0
+
+#include "OgreMappedZip.h"
+
+#include "OgreLogManager.h"
+#include "OgreException.h"
+#include "OgreStringVector.h"
+#include "OgreParallelFor.h"
+
+#include <zlib.h>
+#include <sys/stat.h>
+
+namespace Ogre {
+
+	// Signatures and sizes of the zip records, see the PKWARE APPNOTE
+	static const uint32 ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+	static const uint32 ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+	static const uint32 ZIP_END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
+	static const size_t ZIP_LOCAL_HEADER_SIZE = 30;
+	static const size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+	static const size_t ZIP_END_OF_CENTRAL_DIR_SIZE = 22;
+	static const size_t ZIP_MAX_COMMENT_SIZE = 0xFFFF;
+	static const uint16 ZIP_METHOD_STORED = 0;
+	static const uint16 ZIP_METHOD_DEFLATED = 8;
+	static const uint16 ZIP_FLAG_ENCRYPTED = 0x1;
+	//-----------------------------------------------------------------------
+	/// Reads little endian values whatever the platform and alignment
+	static inline uint16 readZipUInt16(const uchar* p)
+	{
+		return static_cast<uint16>(p[0] | (p[1] << 8));
+	}
+	static inline uint32 readZipUInt32(const uchar* p)
+	{
+		return static_cast<uint32>(p[0]) | (static_cast<uint32>(p[1]) << 8) |
+			(static_cast<uint32>(p[2]) << 16) | (static_cast<uint32>(p[3]) << 24);
+	}
+	//-----------------------------------------------------------------------
+	/** Stream on a stored file, pointing into the archive data.
+	@remarks
+		Holds a reference to the archive data so that the mapping outlives the
+		archive being unloaded while the stream is in use.
+	*/
+	class MappedZipDataStream : public MemoryDataStream
+	{
+	protected:
+		MemoryDataStreamPtr mArchiveData;
+	public:
+		MappedZipDataStream(const String& name, const MemoryDataStreamPtr& archiveData,
+			uchar* data, size_t size)
+			: MemoryDataStream(name, data, size, false, true), mArchiveData(archiveData)
+		{
+		}
+	};
+	//-----------------------------------------------------------------------
+	class MappedZipArchive::OpenTask : public ParallelForTask
+	{
+	public:
+		OpenTask(const MemoryDataStreamPtr& data, const EntryList& entries,
+			const StringVector& names, vector<DataStreamPtr>::type& streams)
+			: mData(data), mEntries(entries), mNames(names), mStreams(streams)
+		{
+		}
+
+		void execute(size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				mStreams[i] = MappedZipArchive::openEntry(mData, mEntries[i], mNames[i]);
+			}
+		}
+
+	protected:
+		const MemoryDataStreamPtr& mData;
+		const EntryList& mEntries;
+		const StringVector& mNames;
+		vector<DataStreamPtr>::type& mStreams;
+	};
+	//-----------------------------------------------------------------------
+	MappedZipArchive::MappedZipArchive(const String& name, const String& archType)
+		: Archive(name, archType)
+	{
+	}
+	//-----------------------------------------------------------------------
+	MappedZipArchive::~MappedZipArchive()
+	{
+		unload();
+	}
+	//-----------------------------------------------------------------------
+	void MappedZipArchive::load()
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		if (mData.isNull())
+		{
+			if (MMapDataStream::isSupported())
+			{
+				mData.bind(OGRE_NEW MMapDataStream(mName, mName));
+			}
+			else
+			{
+				std::ifstream* file = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)();
+				file->open(mName.c_str(), std::ios::in | std::ios::binary);
+				if (file->fail())
+				{
+					OGRE_DELETE_T(file, basic_ifstream, MEMCATEGORY_GENERAL);
+					OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+						"Cannot open file: " + mName, "MappedZipArchive::load");
+				}
+				DataStreamPtr fileStream(OGRE_NEW FileStreamDataStream(mName, file, true));
+				mData.bind(OGRE_NEW MemoryDataStream(fileStream, true, true));
+			}
+
+			try
+			{
+				readCentralDirectory();
+			}
+			catch (...)
+			{
+				unload();
+				throw;
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void MappedZipArchive::unload()
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		// Streams on stored files keep their own reference to the data
+		mData.setNull();
+		mEntries.clear();
+		mFileList.clear();
+		mPathIndex.clear();
+		mNameIndex.clear();
+	}
+	//-----------------------------------------------------------------------
+	void MappedZipArchive::readCentralDirectory(void)
+	{
+		const uchar* data = mData->getPtr();
+		size_t size = mData->size();
+
+		// The end of central directory record is followed by a comment of
+		// up to 64K, search backwards for its signature
+		size_t endPos = 0;
+		bool found = false;
+		if (size >= ZIP_END_OF_CENTRAL_DIR_SIZE)
+		{
+			size_t minPos = size - ZIP_END_OF_CENTRAL_DIR_SIZE > ZIP_MAX_COMMENT_SIZE ?
+				size - ZIP_END_OF_CENTRAL_DIR_SIZE - ZIP_MAX_COMMENT_SIZE : 0;
+			for (size_t pos = size - ZIP_END_OF_CENTRAL_DIR_SIZE + 1; pos-- > minPos; )
+			{
+				if (readZipUInt32(data + pos) == ZIP_END_OF_CENTRAL_DIR_SIGNATURE)
+				{
+					endPos = pos;
+					found = true;
+					break;
+				}
+			}
+		}
+		if (!found)
+		{
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				mName + " - error whilst opening archive: Unable to read zip file.",
+				"MappedZipArchive::readCentralDirectory");
+		}
+
+		size_t numEntries = readZipUInt16(data + endPos + 10);
+		size_t dirSize = readZipUInt32(data + endPos + 12);
+		size_t dirOffset = readZipUInt32(data + endPos + 16);
+		if (numEntries == 0xFFFF || dirOffset == 0xFFFFFFFF)
+		{
+			OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+				mName + " - ZIP64 archives are not supported",
+				"MappedZipArchive::readCentralDirectory");
+		}
+		if (dirOffset > endPos || dirSize > endPos - dirOffset)
+		{
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				mName + " - error whilst opening archive: Corrupted archive.",
+				"MappedZipArchive::readCentralDirectory");
+		}
+
+		mEntries.reserve(numEntries);
+		mFileList.reserve(numEntries);
+		const uchar* p = data + dirOffset;
+		const uchar* dirEnd = p + dirSize;
+		for (size_t i = 0; i < numEntries; ++i)
+		{
+			if (static_cast<size_t>(dirEnd - p) < ZIP_CENTRAL_HEADER_SIZE ||
+				readZipUInt32(p) != ZIP_CENTRAL_HEADER_SIGNATURE)
+			{
+				OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+					mName + " - error whilst opening archive: Corrupted archive.",
+					"MappedZipArchive::readCentralDirectory");
+			}
+			size_t nameLength = readZipUInt16(p + 28);
+			size_t recordSize = ZIP_CENTRAL_HEADER_SIZE + nameLength +
+				readZipUInt16(p + 30) + readZipUInt16(p + 32);
+			if (static_cast<size_t>(dirEnd - p) < recordSize)
+			{
+				OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+					mName + " - error whilst opening archive: Corrupted archive.",
+					"MappedZipArchive::readCentralDirectory");
+			}
+
+			Entry entry;
+			entry.flags = readZipUInt16(p + 8);
+			entry.method = readZipUInt16(p + 10);
+			entry.compressedSize = readZipUInt32(p + 20);
+			entry.uncompressedSize = readZipUInt32(p + 24);
+			entry.headerOffset = readZipUInt32(p + 42);
+			String fullName(reinterpret_cast<const char*>(p + ZIP_CENTRAL_HEADER_SIZE), nameLength);
+			p += recordSize;
+
+			// Same file information as ZipArchive
+			FileInfo info;
+			info.archive = this;
+			StringUtil::splitFilename(fullName, info.basename, info.path);
+			info.filename = fullName;
+			info.compressedSize = entry.compressedSize;
+			info.uncompressedSize = entry.uncompressedSize;
+			if (info.basename.empty())
+			{
+				// Folder
+				info.filename = info.filename.substr(0, info.filename.length() - 1);
+				StringUtil::splitFilename(info.filename, info.basename, info.path);
+				info.compressedSize = size_t(-1);
+			}
+			else
+			{
+				info.filename = info.basename;
+
+				StringUtil::toLowerCase(fullName);
+				mPathIndex[fullName] = mEntries.size();
+				String name = info.basename;
+				StringUtil::toLowerCase(name);
+				std::pair<EntryIndex::iterator, bool> inserted =
+					mNameIndex.insert(EntryIndex::value_type(name, mEntries.size()));
+				if (!inserted.second)
+					inserted.first->second = AMBIGUOUS_NAME;
+			}
+
+			mEntries.push_back(entry);
+			mFileList.push_back(info);
+		}
+	}
+	//-----------------------------------------------------------------------
+	size_t MappedZipArchive::findEntry(const String& filename) const
+	{
+		String key = filename;
+		StringUtil::toLowerCase(key);
+
+		EntryIndex::const_iterator i = mPathIndex.find(key);
+		if (i != mPathIndex.end())
+			return i->second;
+
+		// Like ZipArchive, fall back on the name alone if it is unique
+		i = mNameIndex.find(key);
+		if (i != mNameIndex.end())
+			return i->second;
+
+		return AMBIGUOUS_NAME;
+	}
+	//-----------------------------------------------------------------------
+	DataStreamPtr MappedZipArchive::openEntry(const MemoryDataStreamPtr& data,
+		const Entry& entry, const String& filename)
+	{
+		uchar* archiveData = data->getPtr();
+		size_t archiveSize = data->size();
+
+		// The local header may have a different extra field than the central one
+		size_t pos = entry.headerOffset;
+		if (pos > archiveSize || archiveSize - pos < ZIP_LOCAL_HEADER_SIZE ||
+			readZipUInt32(archiveData + pos) != ZIP_LOCAL_HEADER_SIGNATURE)
+		{
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				data->getName() + " - error whilst opening " + filename + ": Corrupted archive.",
+				"MappedZipArchive::openEntry");
+		}
+		pos += ZIP_LOCAL_HEADER_SIZE + readZipUInt16(archiveData + pos + 26) +
+			readZipUInt16(archiveData + pos + 28);
+		if (pos > archiveSize || archiveSize - pos < entry.compressedSize)
+		{
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				data->getName() + " - error whilst opening " + filename + ": Corrupted archive.",
+				"MappedZipArchive::openEntry");
+		}
+		if (entry.flags & ZIP_FLAG_ENCRYPTED)
+		{
+			OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+				data->getName() + " - error whilst opening " + filename + ": Encrypted files are not supported.",
+				"MappedZipArchive::openEntry");
+		}
+
+		if (entry.method == ZIP_METHOD_STORED)
+		{
+			if (entry.compressedSize != entry.uncompressedSize)
+			{
+				OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+					data->getName() + " - error whilst opening " + filename + ": Corrupted archive.",
+					"MappedZipArchive::openEntry");
+			}
+			return DataStreamPtr(OGRE_NEW MappedZipDataStream(filename, data,
+				archiveData + pos, entry.uncompressedSize));
+		}
+		else if (entry.method != ZIP_METHOD_DEFLATED)
+		{
+			OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+				data->getName() + " - error whilst opening " + filename + ": Unsupported compression format.",
+				"MappedZipArchive::openEntry");
+		}
+
+		if (entry.uncompressedSize == 0)
+			return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, 0, 0, false, true));
+
+		uchar* buffer = OGRE_ALLOC_T(uchar, entry.uncompressedSize, MEMCATEGORY_GENERAL);
+
+		// Raw deflate data, without zlib header
+		z_stream zStream;
+		zStream.zalloc = Z_NULL;
+		zStream.zfree = Z_NULL;
+		zStream.opaque = Z_NULL;
+		zStream.next_in = archiveData + pos;
+		zStream.avail_in = static_cast<uInt>(entry.compressedSize);
+		zStream.next_out = buffer;
+		zStream.avail_out = static_cast<uInt>(entry.uncompressedSize);
+		int ret = inflateInit2(&zStream, -MAX_WBITS);
+		if (ret == Z_OK)
+		{
+			ret = inflate(&zStream, Z_FINISH);
+			inflateEnd(&zStream);
+		}
+		if (ret != Z_STREAM_END || zStream.total_out != entry.uncompressedSize)
+		{
+			OGRE_FREE(buffer, MEMCATEGORY_GENERAL);
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				data->getName() + " - error whilst opening " + filename + ": Corrupted archive.",
+				"MappedZipArchive::openEntry");
+		}
+
+		return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, buffer,
+			entry.uncompressedSize, true, true));
+	}
+	//-----------------------------------------------------------------------
+	DataStreamPtr MappedZipArchive::open(const String& filename, bool readOnly) const
+	{
+		MemoryDataStreamPtr data;
+		Entry entry;
+		{
+			OGRE_LOCK_AUTO_MUTEX;
+			size_t index = findEntry(filename);
+			if (index == AMBIGUOUS_NAME)
+			{
+				LogManager::getSingleton().logMessage(
+					mName + " - Unable to open file " + filename + ", error was 'File not found.'", LML_CRITICAL);
+				return DataStreamPtr();
+			}
+			data = mData;
+			entry = mEntries[index];
+		}
+
+		// Decompress without the lock so that other threads can open files
+		return openEntry(data, entry, filename);
+	}
+	//-----------------------------------------------------------------------
+	void MappedZipArchive::openMultiple(const StringVector& filenames,
+		vector<DataStreamPtr>::type& streams) const
+	{
+		streams.clear();
+		streams.resize(filenames.size());
+
+		MemoryDataStreamPtr data;
+		EntryList entries;
+		StringVector names;
+		vector<size_t>::type positions;
+		{
+			OGRE_LOCK_AUTO_MUTEX;
+			data = mData;
+			entries.reserve(filenames.size());
+			names.reserve(filenames.size());
+			positions.reserve(filenames.size());
+			for (size_t i = 0; i < filenames.size(); ++i)
+			{
+				size_t index = findEntry(filenames[i]);
+				if (index == AMBIGUOUS_NAME)
+				{
+					LogManager::getSingleton().logMessage(
+						mName + " - Unable to open file " + filenames[i] + ", error was 'File not found.'", LML_CRITICAL);
+					continue;
+				}
+				entries.push_back(mEntries[index]);
+				names.push_back(filenames[i]);
+				positions.push_back(i);
+			}
+		}
+
+		vector<DataStreamPtr>::type found(entries.size());
+		OpenTask task(data, entries, names, found);
+		ParallelFor::run(&task, entries.size());
+
+		for (size_t i = 0; i < found.size(); ++i)
+			streams[positions[i]] = found[i];
+	}
+	//---------------------------------------------------------------------
+	DataStreamPtr MappedZipArchive::create(const String& filename) const
+	{
+		OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+			"Modification of zipped archives is not supported",
+			"MappedZipArchive::create");
+	}
+	//---------------------------------------------------------------------
+	void MappedZipArchive::remove(const String& filename) const
+	{
+	}
+	//-----------------------------------------------------------------------
+	StringVectorPtr MappedZipArchive::list(bool recursive, bool dirs)
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+
+		FileInfoList::iterator i, iend;
+		iend = mFileList.end();
+		for (i = mFileList.begin(); i != iend; ++i)
+			if ((dirs == (i->compressedSize == size_t (-1))) &&
+				(recursive || i->path.empty()))
+				ret->push_back(i->filename);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	FileInfoListPtr MappedZipArchive::listFileInfo(bool recursive, bool dirs)
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		FileInfoList* fil = OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)();
+		FileInfoList::const_iterator i, iend;
+		iend = mFileList.end();
+		for (i = mFileList.begin(); i != iend; ++i)
+			if ((dirs == (i->compressedSize == size_t (-1))) &&
+				(recursive || i->path.empty()))
+				fil->push_back(*i);
+
+		return FileInfoListPtr(fil, SPFM_DELETE_T);
+	}
+	//-----------------------------------------------------------------------
+	StringVectorPtr MappedZipArchive::find(const String& pattern, bool recursive, bool dirs)
+	{
+		FileInfoListPtr infos = findFileInfo(pattern, recursive, dirs);
+		StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		ret->reserve(infos->size());
+		for (FileInfoList::const_iterator i = infos->begin(); i != infos->end(); ++i)
+			ret->push_back(i->filename);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	FileInfoListPtr MappedZipArchive::findFileInfo(const String& pattern,
+		bool recursive, bool dirs) const
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		// If pattern contains a directory name, do a full match
+		bool full_match = (pattern.find ('/') != String::npos) ||
+			(pattern.find ('\\') != String::npos);
+		bool wildCard = pattern.find("*") != String::npos;
+
+		// A plain file name is looked up in the index, unless several files
+		// share it
+		if (recursive && !dirs && !full_match && !wildCard)
+		{
+			String key = pattern;
+			StringUtil::toLowerCase(key);
+			EntryIndex::const_iterator i = mNameIndex.find(key);
+			if (i == mNameIndex.end())
+				return ret;
+			if (i->second != AMBIGUOUS_NAME)
+			{
+				ret->push_back(mFileList[i->second]);
+				return ret;
+			}
+		}
+
+		FileInfoList::const_iterator i, iend;
+		iend = mFileList.end();
+		for (i = mFileList.begin(); i != iend; ++i)
+			if ((dirs == (i->compressedSize == size_t (-1))) &&
+				(recursive || full_match || wildCard))
+				// Check name matches pattern (zip is case insensitive)
+				if (StringUtil::match(full_match ? i->filename : i->basename, pattern, false))
+					ret->push_back(*i);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	bool MappedZipArchive::exists(const String& filename)
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		// Like ZipArchive, only the file name is checked
+		String key = filename;
+		String::size_type slash = key.rfind('/');
+		if (slash != String::npos)
+			key = key.substr(slash + 1);
+		StringUtil::toLowerCase(key);
+
+		return mNameIndex.find(key) != mNameIndex.end();
+	}
+	//---------------------------------------------------------------------
+	time_t MappedZipArchive::getModifiedTime(const String& filename)
+	{
+		// Files have DOS timestamps, use the modification time of the archive
+		// like ZipArchive does
+		struct stat tagStat;
+		if (stat(mName.c_str(), &tagStat) == 0)
+			return tagStat.st_mtime;
+		else
+			return 0;
+	}
+	//-----------------------------------------------------------------------
+	//-----------------------------------------------------------------------
+	//  MappedZipArchiveFactory
+	//-----------------------------------------------------------------------
+	//-----------------------------------------------------------------------
+	const String& MappedZipArchiveFactory::getType(void) const
+	{
+		static String name = "MappedZip";
+		return name;
+	}
+}
+
+#endif
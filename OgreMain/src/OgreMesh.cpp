@@ -41,6 +41,7 @@ THE SOFTWARE.
 #include "OgreAnimationState.h"
 #include "OgreAnimationTrack.h"
 #include "OgreOptimisedUtil.h"
+#include "OgreDualQuaternion.h"
 #include "OgreTangentSpaceCalc.h"
 #include "OgreLodStrategyManager.h"
 #include "OgreLodConfig.h"
@@ -232,8 +233,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
 				mName, mGroup, true, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless it already is (e.g. mapped)
+        if (mFreshFromDisk.dynamicCast<MemoryDataStream>().isNull())
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
 
         MeshSerializer serializer;
         serializer.setListener(MeshManager::getSingleton().getListener());
@@ -1600,10 +1602,41 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void Mesh::prepareDualQuaternionsForVertexBlend(const DualQuaternion** blendDualQuaternions,
+        const DualQuaternion* boneDualQuaternions, const IndexMap& indexMap)
+    {
+        assert(indexMap.size() <= 256);
+        IndexMap::const_iterator it, itend;
+        itend = indexMap.end();
+        for (it = indexMap.begin(); it != itend; ++it)
+        {
+            *blendDualQuaternions++ = boneDualQuaternions + *it;
+        }
+    }
+    //---------------------------------------------------------------------
     void Mesh::softwareVertexBlend(const VertexData* sourceVertexData,
         const VertexData* targetVertexData,
         const Matrix4* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
+    {
+        softwareVertexBlendImpl(sourceVertexData, targetVertexData,
+            blendMatrices, 0, blendNormals);
+    }
+    //---------------------------------------------------------------------
+    void Mesh::softwareVertexBlend(const VertexData* sourceVertexData,
+        const VertexData* targetVertexData,
+        const DualQuaternion* const* blendDualQuaternions, size_t numDualQuaternions,
+        bool blendNormals)
+    {
+        softwareVertexBlendImpl(sourceVertexData, targetVertexData,
+            0, blendDualQuaternions, blendNormals);
+    }
+    //---------------------------------------------------------------------
+    void Mesh::softwareVertexBlendImpl(const VertexData* sourceVertexData,
+        const VertexData* targetVertexData,
+        const Matrix4* const* blendMatrices,
+        const DualQuaternion* const* blendDualQuaternions,
+        bool blendNormals)
     {
         float *pSrcPos = 0;
         float *pSrcNorm = 0;
@@ -1713,16 +1746,32 @@ namespace Ogre {
             destElemNorm->baseVertexPointerToElement(pBuffer, &pDestNorm);
         }
 
-        OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
-            pBlendWeight, pBlendIdx,
-            blendMatrices,
-            srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
-            blendWeightStride, blendIdxStride,
-            numWeightsPerVertex,
-            targetVertexData->vertexCount);
+        if (blendDualQuaternions)
+        {
+            OptimisedUtil::getImplementation()->softwareVertexDualQuaternionSkinning(
+                pSrcPos, pDestPos,
+                pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIdx,
+                blendDualQuaternions,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIdxStride,
+                numWeightsPerVertex,
+                targetVertexData->vertexCount);
+        }
+        else
+        {
+            OptimisedUtil::getImplementation()->softwareVertexSkinning(
+                pSrcPos, pDestPos,
+                pSrcNorm, pDestNorm,
+                pBlendWeight, pBlendIdx,
+                blendMatrices,
+                srcPosStride, destPosStride,
+                srcNormStride, destNormStride,
+                blendWeightStride, blendIdxStride,
+                numWeightsPerVertex,
+                targetVertexData->vertexCount);
+        }
 
         // Unlock source buffers
         srcPosBuf->unlock();
@@ -1858,6 +1907,72 @@ namespace Ogre {
 		}
 		destBuf->unlock();
 	}
+	//---------------------------------------------------------------------
+	void Mesh::softwareVertexPoseBlend(const Pose* const* poses,
+		const Real* weights, size_t numPoses, VertexData* targetVertexData)
+	{
+		// Gather the packed offsets of the poses which contribute something
+		vector<Real>::type posWeights, normWeights;
+		vector<const uint32*>::type posIndices, normIndices;
+		vector<const float*>::type posOffsets, normOffsets;
+		vector<size_t>::type posCounts, normCounts;
+		posWeights.reserve(numPoses);
+		posIndices.reserve(numPoses);
+		posOffsets.reserve(numPoses);
+		posCounts.reserve(numPoses);
+		for (size_t p = 0; p < numPoses; ++p)
+		{
+			const vector<uint32>::type& indices = poses[p]->_getPackedIndices();
+			if (weights[p] == 0.0f || indices.empty())
+				continue;
+
+			posWeights.push_back(weights[p]);
+			posIndices.push_back(&indices[0]);
+			posOffsets.push_back(&poses[p]->_getPackedVertexOffsets()[0]);
+			posCounts.push_back(indices.size());
+
+			const vector<float>::type& normals = poses[p]->_getPackedNormals();
+			if (!normals.empty())
+			{
+				normWeights.push_back(weights[p]);
+				normIndices.push_back(&indices[0]);
+				normOffsets.push_back(&normals[0]);
+				normCounts.push_back(indices.size());
+			}
+		}
+		if (posWeights.empty())
+			return;
+
+		const VertexElement* posElem =
+			targetVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
+		const VertexElement* normElem =
+			targetVertexData->vertexDeclaration->findElementBySemantic(VES_NORMAL);
+		assert(posElem);
+		// Support normals if they're in the same buffer as positions and poses include them
+		bool normals = normElem && !normWeights.empty() && posElem->getSource() == normElem->getSource();
+		HardwareVertexBufferSharedPtr destBuf =
+			targetVertexData->vertexBufferBinding->getBuffer(
+			posElem->getSource());
+
+		// Have to lock in normal mode since this is incremental
+		void* pBase = destBuf->lock(HardwareBuffer::HBL_NORMAL);
+
+		float* pPos;
+		posElem->baseVertexPointerToElement(pBase, &pPos);
+		OptimisedUtil::getImplementation()->softwareVertexPoseBlend(
+			&posWeights[0], &posIndices[0], &posOffsets[0], &posCounts[0],
+			posWeights.size(), pPos, destBuf->getVertexSize());
+
+		if (normals)
+		{
+			float* pNorm;
+			normElem->baseVertexPointerToElement(pBase, &pNorm);
+			OptimisedUtil::getImplementation()->softwareVertexPoseBlend(
+				&normWeights[0], &normIndices[0], &normOffsets[0], &normCounts[0],
+				normWeights.size(), pNorm, destBuf->getVertexSize());
+		}
+		destBuf->unlock();
+	}
     //---------------------------------------------------------------------
 	size_t Mesh::calculateSize(void) const
 	{
@@ -51,6 +51,11 @@ namespace Ogre {
 			MESH_VERSION_1_8, "[MeshSerializer_v1.8]", 
 			OGRE_NEW MeshSerializerImpl()));
 
+		// Not an older version, but must not be taken for the latest either
+		mVersionData.push_back(OGRE_NEW MeshVersionData(
+			MESH_VERSION_BAKED, "[MeshSerializer_v1.8_baked]",
+			OGRE_NEW MeshSerializerImpl_Baked()));
+
 		mVersionData.push_back(OGRE_NEW MeshVersionData(
 			MESH_VERSION_1_7, "[MeshSerializer_v1.41]", 
 			OGRE_NEW MeshSerializerImpl_v1_41()));
@@ -169,12 +174,14 @@ namespace Ogre {
 
         // Find the implementation to use
 		MeshSerializerImpl* impl = 0;
+		MeshVersion version = MESH_VERSION_LEGACY;
 		for (MeshVersionDataList::iterator i = mVersionData.begin(); 
 			 i != mVersionData.end(); ++i)
 		{
 			if ((*i)->versionString == ver)
 			{
 				impl = (*i)->impl;
+				version = (*i)->version;
 				break;
 			}
 		}			
@@ -185,7 +192,7 @@ namespace Ogre {
         // Call implementation
         impl->importMesh(stream, pDest, info, mListener);
         // Warn on old version of mesh
-        if (ver != mVersionData[0]->versionString)
+        if (ver != mVersionData[0]->versionString && version != MESH_VERSION_BAKED)
         {
             LogManager::getSingleton().logMessage("WARNING: " + pDest->getName() + 
                 " is an older format (" + ver + "); you should upgrade it as soon as possible" +
@@ -540,6 +540,7 @@ namespace Ogre {
 			// unsigned short* faceVertexIndices ((indexCount)
 			HardwareIndexBufferSharedPtr ibuf = s->indexData->indexBuffer;
 			void* pIdx = ibuf->lock(HardwareBuffer::HBL_READ_ONLY);
+			writeDataPaddingBefore();
 			if (idx32bit)
 			{
 				unsigned int* pIdx32 = static_cast<unsigned int*>(pIdx);
@@ -550,6 +551,7 @@ namespace Ogre {
 				unsigned short* pIdx16 = static_cast<unsigned short*>(pIdx);
 				writeShorts(pIdx16, s->indexData->indexCount);
 			}
+			writeDataPaddingAfter();
 			ibuf->unlock();
 		}
 
@@ -674,7 +676,8 @@ namespace Ogre {
 		for (vbi = bindings.begin(); vbi != vbiend; ++vbi)
 		{
 			const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
-			size += (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbuf->getSizeInBytes();
+			size += (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbuf->getSizeInBytes() +
+				calcDataPaddingSize();
 		}
 
 		// Header
@@ -718,7 +721,8 @@ namespace Ogre {
 		for (vbi = bindings.begin(); vbi != vbiend; ++vbi)
 		{
 			const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
-			size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbuf->getSizeInBytes();
+			size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbuf->getSizeInBytes() +
+				calcDataPaddingSize();
 			writeChunkHeader(M_GEOMETRY_VERTEX_BUFFER,  size);
 			// unsigned short bindIndex;	// Index to bind this buffer to
 			tmp = vbi->first;
@@ -728,9 +732,10 @@ namespace Ogre {
 			writeShorts(&tmp, 1);
 
 			// Data
-			size = MSTREAM_OVERHEAD_SIZE + vbuf->getSizeInBytes();
+			size = MSTREAM_OVERHEAD_SIZE + vbuf->getSizeInBytes() + calcDataPaddingSize();
 			writeChunkHeader(M_GEOMETRY_VERTEX_BUFFER_DATA, size);
 			void* pBuf = vbuf->lock(HardwareBuffer::HBL_READ_ONLY);
+			writeDataPaddingBefore();
 
 			if (mFlipEndian)
 			{
@@ -750,6 +755,7 @@ namespace Ogre {
 			{
 				writeData(pBuf, vbuf->getVertexSize(), vertexData->vertexCount);
 			}
+			writeDataPaddingAfter();
             vbuf->unlock();
 		}
 
@@ -841,6 +847,8 @@ namespace Ogre {
 			size += sizeof(unsigned int) * pSub->indexData->indexCount;
 		else
 			size += sizeof(unsigned short) * pSub->indexData->indexCount;
+		if (pSub->indexData->indexCount > 0)
+			size += calcDataPaddingSize();
         // Geometry
         if (!pSub->useSharedVertices)
         {
@@ -908,6 +916,9 @@ namespace Ogre {
             // Vertex element
             size += VertexElement::getTypeSize(elem.getType()) * vertexData->vertexCount;
         }
+
+        // Padding of the buffer data
+        size += calcDataPaddingSize() * vertexData->vertexBufferBinding->getBufferCount();
         return size;
     }
     //---------------------------------------------------------------------
@@ -1059,6 +1070,7 @@ namespace Ogre {
             	"MeshSerializerImpl::readGeometryVertexBuffer");
 		}
 
+		readDataPaddingBefore(stream);
 		if (dest)
 		{
 			// Create / populate vertex buffer
@@ -1087,6 +1099,7 @@ namespace Ogre {
 			destInfo->vertexBufferInfo[bindIndex].offset = stream->tell();
 			stream->skip(destInfo->vertexCount * vertexSize);
 		}
+		readDataPaddingAfter(stream);
 	}
     //---------------------------------------------------------------------
 	void MeshSerializerImpl::readSubMeshNameTable(DataStreamPtr& stream, Mesh* pMesh)
@@ -1273,6 +1286,7 @@ namespace Ogre {
         readBools(stream, &idx32bit, 1);
         if (indexCount > 0)
         {
+            readDataPaddingBefore(stream);
             if (info)
             {
 				info->submeshes[smIdx].offset = stream->tell();
@@ -1316,6 +1330,7 @@ namespace Ogre {
                     ibuf->unlock();
                 }
             }
+            readDataPaddingAfter(stream);
         }
         sm->indexData->indexBuffer = ibuf;
 
@@ -1602,6 +1617,8 @@ namespace Ogre {
 			    size += static_cast<unsigned long>(
                     sizeof(unsigned short) * indexData->indexCount);
             }
+            if (indexData->indexCount > 0)
+                size += calcDataPaddingSize();
 
 		}
 
@@ -1634,6 +1651,8 @@ namespace Ogre {
 			    size += static_cast<unsigned long>(
                     sizeof(unsigned short) * indexData->indexCount);
             }
+            if (indexData->indexCount > 0)
+                size += calcDataPaddingSize();
 
 			writeChunkHeader(M_MESH_LOD_GENERATED, size);
 			unsigned int idxCount = static_cast<unsigned int>(indexData->indexCount);
@@ -1642,6 +1661,7 @@ namespace Ogre {
 
 			if (idxCount > 0)
 			{
+				writeDataPaddingBefore();
 				if (idx32)
 				{
 					unsigned int* pIdx = static_cast<unsigned int*>(
@@ -1656,6 +1676,7 @@ namespace Ogre {
 					writeShorts(pIdx, indexData->indexCount);
 					ibuf->unlock();
 				}
+				writeDataPaddingAfter();
 			}
 		}
 
@@ -1815,6 +1836,8 @@ namespace Ogre {
             // bool indexes32Bit
             bool idx32Bit;
             readBools(stream, &idx32Bit, 1);
+            if (numIndexes > 0)
+                readDataPaddingBefore(stream);
             if (info)
             {
 				MeshLodInfo& lodInfo = info->lodInfo[i];
@@ -1858,6 +1881,8 @@ namespace Ogre {
 
                 }
             }
+            if (numIndexes > 0)
+                readDataPaddingAfter(stream);
 
 		}
 	}
@@ -2036,89 +2061,93 @@ namespace Ogre {
             writeBools(&isManual, 1);
             if (!isManual)
             {
-                // bool isClosed
-                writeBools(&edgeData->isClosed, 1);
-                // unsigned long  numTriangles
-                uint32 count = static_cast<uint32>(edgeData->triangles.size());
-                writeInts(&count, 1);
-                // unsigned long numEdgeGroups
-                count = static_cast<uint32>(edgeData->edgeGroups.size());
-                writeInts(&count, 1);
-                // Triangle* triangleList
-                // Iterate rather than writing en-masse to allow endian conversion
-                EdgeData::TriangleList::const_iterator t = edgeData->triangles.begin();
-                EdgeData::TriangleFaceNormalList::const_iterator fni = edgeData->triangleFaceNormals.begin();
-                for ( ; t != edgeData->triangles.end(); ++t, ++fni)
-                {
-                    const EdgeData::Triangle& tri = *t;
-                    // unsigned long indexSet;
-                    uint32 tmp[3];
-                    tmp[0] = static_cast<uint32>(tri.indexSet);
-                    writeInts(tmp, 1);
-                    // unsigned long vertexSet;
-                    tmp[0] = static_cast<uint32>(tri.vertexSet);
-                    writeInts(tmp, 1);
-                    // unsigned long vertIndex[3];
-                    tmp[0] = static_cast<uint32>(tri.vertIndex[0]);
-                    tmp[1] = static_cast<uint32>(tri.vertIndex[1]);
-                    tmp[2] = static_cast<uint32>(tri.vertIndex[2]);
-                    writeInts(tmp, 3);
-                    // unsigned long sharedVertIndex[3];
-                    tmp[0] = static_cast<uint32>(tri.sharedVertIndex[0]);
-                    tmp[1] = static_cast<uint32>(tri.sharedVertIndex[1]);
-                    tmp[2] = static_cast<uint32>(tri.sharedVertIndex[2]);
-                    writeInts(tmp, 3);
-                    // float normal[4];
-                    writeFloats(&(fni->x), 4);
-
-                }
-                // Write the groups
-                for (EdgeData::EdgeGroupList::const_iterator gi = edgeData->edgeGroups.begin();
-                    gi != edgeData->edgeGroups.end(); ++gi)
-                {
-                    const EdgeData::EdgeGroup& edgeGroup = *gi;
-                    writeChunkHeader(M_EDGE_GROUP, calcEdgeGroupSize(edgeGroup));
-                    // unsigned long vertexSet
-                    uint32 vertexSet = static_cast<uint32>(edgeGroup.vertexSet);
-                    writeInts(&vertexSet, 1);
-                    // unsigned long triStart
-                    uint32 triStart = static_cast<uint32>(edgeGroup.triStart);
-                    writeInts(&triStart, 1);
-                    // unsigned long triCount
-                    uint32 triCount = static_cast<uint32>(edgeGroup.triCount);
-                    writeInts(&triCount, 1);
-                    // unsigned long numEdges
-                    count = static_cast<uint32>(edgeGroup.edges.size());
-                    writeInts(&count, 1);
-                    // Edge* edgeList
-                    // Iterate rather than writing en-masse to allow endian conversion
-                    for (EdgeData::EdgeList::const_iterator ei = edgeGroup.edges.begin();
-                        ei != edgeGroup.edges.end(); ++ei)
-                    {
-                        const EdgeData::Edge& edge = *ei;
-                        uint32 tmp[2];
-                        // unsigned long  triIndex[2]
-                        tmp[0] = static_cast<uint32>(edge.triIndex[0]);
-                        tmp[1] = static_cast<uint32>(edge.triIndex[1]);
-                        writeInts(tmp, 2);
-                        // unsigned long  vertIndex[2]
-                        tmp[0] = static_cast<uint32>(edge.vertIndex[0]);
-                        tmp[1] = static_cast<uint32>(edge.vertIndex[1]);
-                        writeInts(tmp, 2);
-                        // unsigned long  sharedVertIndex[2]
-                        tmp[0] = static_cast<uint32>(edge.sharedVertIndex[0]);
-                        tmp[1] = static_cast<uint32>(edge.sharedVertIndex[1]);
-                        writeInts(tmp, 2);
-                        // bool degenerate
-                        writeBools(&(edge.degenerate), 1);
-                    }
+                writeEdgeListLodInfo(edgeData);
+            }
 
-                }
+        }
+	}
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeEdgeListLodInfo(const EdgeData* edgeData)
+    {
+        // bool isClosed
+        writeBools(&edgeData->isClosed, 1);
+        // unsigned long  numTriangles
+        uint32 count = static_cast<uint32>(edgeData->triangles.size());
+        writeInts(&count, 1);
+        // unsigned long numEdgeGroups
+        count = static_cast<uint32>(edgeData->edgeGroups.size());
+        writeInts(&count, 1);
+        // Triangle* triangleList
+        // Iterate rather than writing en-masse to allow endian conversion
+        EdgeData::TriangleList::const_iterator t = edgeData->triangles.begin();
+        EdgeData::TriangleFaceNormalList::const_iterator fni = edgeData->triangleFaceNormals.begin();
+        for ( ; t != edgeData->triangles.end(); ++t, ++fni)
+        {
+            const EdgeData::Triangle& tri = *t;
+            // unsigned long indexSet;
+            uint32 tmp[3];
+            tmp[0] = static_cast<uint32>(tri.indexSet);
+            writeInts(tmp, 1);
+            // unsigned long vertexSet;
+            tmp[0] = static_cast<uint32>(tri.vertexSet);
+            writeInts(tmp, 1);
+            // unsigned long vertIndex[3];
+            tmp[0] = static_cast<uint32>(tri.vertIndex[0]);
+            tmp[1] = static_cast<uint32>(tri.vertIndex[1]);
+            tmp[2] = static_cast<uint32>(tri.vertIndex[2]);
+            writeInts(tmp, 3);
+            // unsigned long sharedVertIndex[3];
+            tmp[0] = static_cast<uint32>(tri.sharedVertIndex[0]);
+            tmp[1] = static_cast<uint32>(tri.sharedVertIndex[1]);
+            tmp[2] = static_cast<uint32>(tri.sharedVertIndex[2]);
+            writeInts(tmp, 3);
+            // float normal[4];
+            writeFloats(&(fni->x), 4);
 
+        }
+        // Write the groups
+        for (EdgeData::EdgeGroupList::const_iterator gi = edgeData->edgeGroups.begin();
+            gi != edgeData->edgeGroups.end(); ++gi)
+        {
+            const EdgeData::EdgeGroup& edgeGroup = *gi;
+            writeChunkHeader(M_EDGE_GROUP, calcEdgeGroupSize(edgeGroup));
+            // unsigned long vertexSet
+            uint32 vertexSet = static_cast<uint32>(edgeGroup.vertexSet);
+            writeInts(&vertexSet, 1);
+            // unsigned long triStart
+            uint32 triStart = static_cast<uint32>(edgeGroup.triStart);
+            writeInts(&triStart, 1);
+            // unsigned long triCount
+            uint32 triCount = static_cast<uint32>(edgeGroup.triCount);
+            writeInts(&triCount, 1);
+            // unsigned long numEdges
+            count = static_cast<uint32>(edgeGroup.edges.size());
+            writeInts(&count, 1);
+            // Edge* edgeList
+            // Iterate rather than writing en-masse to allow endian conversion
+            for (EdgeData::EdgeList::const_iterator ei = edgeGroup.edges.begin();
+                ei != edgeGroup.edges.end(); ++ei)
+            {
+                const EdgeData::Edge& edge = *ei;
+                uint32 tmp[2];
+                // unsigned long  triIndex[2]
+                tmp[0] = static_cast<uint32>(edge.triIndex[0]);
+                tmp[1] = static_cast<uint32>(edge.triIndex[1]);
+                writeInts(tmp, 2);
+                // unsigned long  vertIndex[2]
+                tmp[0] = static_cast<uint32>(edge.vertIndex[0]);
+                tmp[1] = static_cast<uint32>(edge.vertIndex[1]);
+                writeInts(tmp, 2);
+                // unsigned long  sharedVertIndex[2]
+                tmp[0] = static_cast<uint32>(edge.sharedVertIndex[0]);
+                tmp[1] = static_cast<uint32>(edge.sharedVertIndex[1]);
+                writeInts(tmp, 2);
+                // bool degenerate
+                writeBools(&(edge.degenerate), 1);
             }
 
         }
-	}
+    }
     //---------------------------------------------------------------------
 	void MeshSerializerImpl::readEdgeList(DataStreamPtr& stream, Mesh* pMesh, MeshSerializeInfo* info)
 	{
@@ -2945,6 +2974,276 @@ namespace Ogre {
 	}
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_Baked::MeshSerializerImpl_Baked()
+        : mDataPadding(0)
+    {
+        // Version number
+        mVersion = "[MeshSerializer_v1.8_baked]";
+    }
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_Baked::~MeshSerializerImpl_Baked()
+    {
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Baked::writeDataPaddingBefore(void)
+    {
+        // unsigned char lead, followed by lead bytes so that the data is aligned
+        size_t dataStart = mStream->tell() + 1;
+        mDataPadding = (DATA_ALIGNMENT - dataStart % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+        uint8 padding[DATA_ALIGNMENT] = { 0 };
+        padding[0] = static_cast<uint8>(mDataPadding);
+        writeData(padding, 1, 1);
+        padding[0] = 0;
+        writeData(padding, 1, mDataPadding);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Baked::writeDataPaddingAfter(void)
+    {
+        uint8 padding[DATA_ALIGNMENT] = { 0 };
+        writeData(padding, 1, DATA_ALIGNMENT - 1 - mDataPadding);
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl_Baked::calcDataPaddingSize(void)
+    {
+        return DATA_ALIGNMENT;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Baked::readDataPaddingBefore(DataStreamPtr& stream)
+    {
+        uint8 lead = 0;
+        stream->read(&lead, 1);
+        if (lead >= DATA_ALIGNMENT)
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+                "Invalid data padding in baked mesh " + stream->getName(),
+                "MeshSerializerImpl_Baked::readDataPaddingBefore");
+        }
+        mDataPadding = lead;
+        stream->skip(mDataPadding);
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Baked::readDataPaddingAfter(DataStreamPtr& stream)
+    {
+        stream->skip(DATA_ALIGNMENT - 1 - mDataPadding);
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl_Baked::calcEdgeListLodSize(const EdgeData* edgeData, bool isManual)
+    {
+        size_t size = MSTREAM_OVERHEAD_SIZE;
+
+        // unsigned short lodIndex
+        size += sizeof(uint16);
+
+        // bool isManual			// If manual, no edge data here, loaded from manual mesh
+        size += sizeof(bool);
+        if (!isManual)
+        {
+            // bool isClosed
+            size += sizeof(bool);
+            // unsigned long numTriangles
+            size += sizeof(uint32);
+            // unsigned long numEdgeGroups
+            size += sizeof(uint32);
+            if (!edgeData->triangles.empty())
+            {
+                // unsigned long triangles[8]
+                size += sizeof(uint32) * 8 * edgeData->triangles.size() + calcDataPaddingSize();
+                // float normals[4]
+                size += sizeof(float) * 4 * edgeData->triangles.size() + calcDataPaddingSize();
+            }
+            for (EdgeData::EdgeGroupList::const_iterator gi = edgeData->edgeGroups.begin();
+                gi != edgeData->edgeGroups.end(); ++gi)
+            {
+                size += calcEdgeGroupSize(*gi);
+            }
+        }
+
+        return size;
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl_Baked::calcEdgeGroupSize(const EdgeData::EdgeGroup& group)
+    {
+        size_t size = MSTREAM_OVERHEAD_SIZE;
+
+        // unsigned long vertexSet, triStart, triCount, numEdges
+        size += sizeof(uint32) * 4;
+        // unsigned long edges[7]
+        if (!group.edges.empty())
+            size += sizeof(uint32) * 7 * group.edges.size() + calcDataPaddingSize();
+
+        return size;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Baked::writeEdgeListLodInfo(const EdgeData* edgeData)
+    {
+        // bool isClosed
+        writeBools(&edgeData->isClosed, 1);
+        // unsigned long numTriangles
+        uint32 count = static_cast<uint32>(edgeData->triangles.size());
+        writeInts(&count, 1);
+        // unsigned long numEdgeGroups
+        count = static_cast<uint32>(edgeData->edgeGroups.size());
+        writeInts(&count, 1);
+
+        size_t numTriangles = edgeData->triangles.size();
+        if (numTriangles > 0)
+        {
+            // unsigned long triangles[8]
+            vector<uint32>::type values(numTriangles * 8);
+            uint32* pValue = &values[0];
+            for (EdgeData::TriangleList::const_iterator t = edgeData->triangles.begin();
+                t != edgeData->triangles.end(); ++t, pValue += 8)
+            {
+                const EdgeData::Triangle& tri = *t;
+                pValue[0] = static_cast<uint32>(tri.indexSet);
+                pValue[1] = static_cast<uint32>(tri.vertexSet);
+                pValue[2] = static_cast<uint32>(tri.vertIndex[0]);
+                pValue[3] = static_cast<uint32>(tri.vertIndex[1]);
+                pValue[4] = static_cast<uint32>(tri.vertIndex[2]);
+                pValue[5] = static_cast<uint32>(tri.sharedVertIndex[0]);
+                pValue[6] = static_cast<uint32>(tri.sharedVertIndex[1]);
+                pValue[7] = static_cast<uint32>(tri.sharedVertIndex[2]);
+            }
+            writeDataPaddingBefore();
+            writeInts(&values[0], values.size());
+            writeDataPaddingAfter();
+
+            // float normals[4]
+            writeDataPaddingBefore();
+            writeFloats(&(edgeData->triangleFaceNormals[0].x), numTriangles * 4);
+            writeDataPaddingAfter();
+        }
+
+        for (EdgeData::EdgeGroupList::const_iterator gi = edgeData->edgeGroups.begin();
+            gi != edgeData->edgeGroups.end(); ++gi)
+        {
+            const EdgeData::EdgeGroup& edgeGroup = *gi;
+            writeChunkHeader(M_EDGE_GROUP, calcEdgeGroupSize(edgeGroup));
+            // unsigned long vertexSet, triStart, triCount, numEdges
+            uint32 header[4];
+            header[0] = static_cast<uint32>(edgeGroup.vertexSet);
+            header[1] = static_cast<uint32>(edgeGroup.triStart);
+            header[2] = static_cast<uint32>(edgeGroup.triCount);
+            header[3] = static_cast<uint32>(edgeGroup.edges.size());
+            writeInts(header, 4);
+
+            if (!edgeGroup.edges.empty())
+            {
+                // unsigned long edges[7]
+                vector<uint32>::type values(edgeGroup.edges.size() * 7);
+                uint32* pValue = &values[0];
+                for (EdgeData::EdgeList::const_iterator ei = edgeGroup.edges.begin();
+                    ei != edgeGroup.edges.end(); ++ei, pValue += 7)
+                {
+                    const EdgeData::Edge& edge = *ei;
+                    pValue[0] = static_cast<uint32>(edge.triIndex[0]);
+                    pValue[1] = static_cast<uint32>(edge.triIndex[1]);
+                    pValue[2] = static_cast<uint32>(edge.vertIndex[0]);
+                    pValue[3] = static_cast<uint32>(edge.vertIndex[1]);
+                    pValue[4] = static_cast<uint32>(edge.sharedVertIndex[0]);
+                    pValue[5] = static_cast<uint32>(edge.sharedVertIndex[1]);
+                    pValue[6] = edge.degenerate ? 1 : 0;
+                }
+                writeDataPaddingBefore();
+                writeInts(&values[0], values.size());
+                writeDataPaddingAfter();
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl_Baked::readEdgeListLodInfo(DataStreamPtr& stream,
+        EdgeData* edgeData)
+    {
+        // bool isClosed
+        readBools(stream, &edgeData->isClosed, 1);
+        // unsigned long numTriangles
+        uint32 numTriangles;
+        readInts(stream, &numTriangles, 1);
+        // Allocate correct amount of memory
+        edgeData->triangles.resize(numTriangles);
+        edgeData->triangleFaceNormals.resize(numTriangles);
+        edgeData->triangleLightFacings.resize(numTriangles);
+        // unsigned long numEdgeGroups
+        uint32 numEdgeGroups;
+        readInts(stream, &numEdgeGroups, 1);
+        // Allocate correct amount of memory
+        edgeData->edgeGroups.resize(numEdgeGroups);
+
+        vector<uint32>::type values;
+        if (numTriangles > 0)
+        {
+            // unsigned long triangles[8]
+            values.resize(numTriangles * 8);
+            readDataPaddingBefore(stream);
+            readInts(stream, &values[0], values.size());
+            readDataPaddingAfter(stream);
+            const uint32* pValue = &values[0];
+            for (EdgeData::TriangleList::iterator t = edgeData->triangles.begin();
+                t != edgeData->triangles.end(); ++t, pValue += 8)
+            {
+                EdgeData::Triangle& tri = *t;
+                tri.indexSet = pValue[0];
+                tri.vertexSet = pValue[1];
+                tri.vertIndex[0] = pValue[2];
+                tri.vertIndex[1] = pValue[3];
+                tri.vertIndex[2] = pValue[4];
+                tri.sharedVertIndex[0] = pValue[5];
+                tri.sharedVertIndex[1] = pValue[6];
+                tri.sharedVertIndex[2] = pValue[7];
+            }
+
+            // float normals[4], straight into the face normals
+            readDataPaddingBefore(stream);
+            readFloats(stream, &(edgeData->triangleFaceNormals[0].x), numTriangles * 4);
+            readDataPaddingAfter(stream);
+        }
+
+        for (EdgeData::EdgeGroupList::iterator gi = edgeData->edgeGroups.begin();
+            gi != edgeData->edgeGroups.end(); ++gi)
+        {
+            unsigned short streamID = readChunk(stream);
+            if (streamID != M_EDGE_GROUP)
+            {
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                    "Missing M_EDGE_GROUP stream",
+                    "MeshSerializerImpl_Baked::readEdgeListLodInfo");
+            }
+            EdgeData::EdgeGroup& edgeGroup = *gi;
+
+            // unsigned long vertexSet, triStart, triCount, numEdges
+            uint32 header[4];
+            readInts(stream, header, 4);
+            edgeGroup.vertexSet = header[0];
+            edgeGroup.triStart = header[1];
+            edgeGroup.triCount = header[2];
+            edgeGroup.edges.resize(header[3]);
+
+            if (!edgeGroup.edges.empty())
+            {
+                // unsigned long edges[7]
+                values.resize(edgeGroup.edges.size() * 7);
+                readDataPaddingBefore(stream);
+                readInts(stream, &values[0], values.size());
+                readDataPaddingAfter(stream);
+                const uint32* pValue = &values[0];
+                for (EdgeData::EdgeList::iterator ei = edgeGroup.edges.begin();
+                    ei != edgeGroup.edges.end(); ++ei, pValue += 7)
+                {
+                    EdgeData::Edge& edge = *ei;
+                    edge.triIndex[0] = pValue[0];
+                    edge.triIndex[1] = pValue[1];
+                    edge.vertIndex[0] = pValue[2];
+                    edge.vertIndex[1] = pValue[3];
+                    edge.sharedVertIndex[0] = pValue[4];
+                    edge.sharedVertIndex[1] = pValue[5];
+                    edge.degenerate = pValue[6] != 0;
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
 	MeshSerializerImpl_v1_41::MeshSerializerImpl_v1_41()
 	{
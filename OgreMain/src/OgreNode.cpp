@@ -49,6 +49,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     Node::Node()
 		:mParent(0),
+		mIndexInParent(0),
+		mChildNameIndex(0),
+		mInParentUpdateList(false),
+		mIndexInParentUpdateList(0),
 		mNeedParentUpdate(false),
 		mNeedChildUpdate(false),
 		mParentNotified(false),
@@ -78,6 +82,10 @@ namespace Ogre {
 	Node::Node(const String& name)
 		:
 		mParent(0),
+		mIndexInParent(0),
+		mChildNameIndex(0),
+		mInParentUpdateList(false),
+		mIndexInParentUpdateList(0),
 		mNeedParentUpdate(false),
 		mNeedChildUpdate(false),
 		mParentNotified(false),
@@ -193,30 +201,95 @@ namespace Ogre {
         {
             if (mNeedChildUpdate || parentHasChanged)
             {
-                ChildNodeMap::iterator it, itend;
+                ChildNodeList::iterator it, itend;
                 itend = mChildren.end();
                 for (it = mChildren.begin(); it != itend; ++it)
                 {
-                    Node* child = it->second;
+                    Node* child = *it;
                     child->_update(true, true);
                 }
             }
             else
             {
-                // Just update selected children
-                ChildUpdateSet::iterator it, itend;
-                itend = mChildrenToUpdate.end();
-                for(it = mChildrenToUpdate.begin(); it != itend; ++it)
+                // Just update selected children, by index as listeners may
+                // request updates of other children meanwhile
+                for (size_t i = 0; i < mChildrenToUpdate.size(); ++i)
                 {
-                    Node* child = *it;
+                    Node* child = mChildrenToUpdate[i];
                     child->_update(true, false);
                 }
 
             }
 
-            mChildrenToUpdate.clear();
+            clearChildrenToUpdate();
             mNeedChildUpdate = false;
         }
+    }
+    //-----------------------------------------------------------------------
+    void Node::_updateAndCollectChildren(bool parentHasChanged, PendingUpdateList& children)
+    {
+        if (_prepareUpdate(parentHasChanged, children))
+        {
+            _updateFromParent();
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool Node::_prepareUpdate(bool parentHasChanged, PendingUpdateList& children)
+    {
+        // always clear information about parent notification
+        mParentNotified = false;
+
+        if (mNeedChildUpdate || parentHasChanged)
+        {
+            ChildNodeList::iterator it, itend;
+            itend = mChildren.end();
+            for (it = mChildren.begin(); it != itend; ++it)
+            {
+                children.push_back(PendingUpdate(*it, true));
+            }
+        }
+        else
+        {
+            ChildUpdateList::iterator it, itend;
+            itend = mChildrenToUpdate.end();
+            for (it = mChildrenToUpdate.begin(); it != itend; ++it)
+            {
+                children.push_back(PendingUpdate(*it, false));
+            }
+        }
+
+        clearChildrenToUpdate();
+        mNeedChildUpdate = false;
+
+        return mNeedParentUpdate || parentHasChanged;
+    }
+    //-----------------------------------------------------------------------
+    void Node::_setDerivedTransform(const Vector3& position, const Quaternion& orientation,
+        const Vector3& scale)
+    {
+        setDerivedTransformImpl(position, orientation, scale);
+
+        if (mListener)
+        {
+            mListener->nodeUpdated(this);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Node::setDerivedTransformImpl(const Vector3& position,
+        const Quaternion& orientation, const Vector3& scale)
+    {
+        mDerivedPosition = position;
+        mDerivedOrientation = orientation;
+        mDerivedScale = scale;
+
+        mCachedTransformOutOfDate = true;
+        mNeedParentUpdate = false;
+    }
+    //-----------------------------------------------------------------------
+    void Node::_clearChildUpdateRequests(void)
+    {
+        mParentNotified = false;
+        clearChildrenToUpdate();
     }
 	//-----------------------------------------------------------------------
 	void Node::_updateFromParent(void) const
@@ -310,7 +383,12 @@ namespace Ogre {
                 "Node::addChild");
         }
 
-        mChildren.insert(ChildNodeMap::value_type(child->getName(), child));
+        child->mIndexInParent = mChildren.size();
+        mChildren.push_back(child);
+        if (mChildNameIndex)
+        {
+            mChildNameIndex->insert(ChildNameIndex::value_type(child->getName(), child));
+        }
         child->setParent(this);
 
     }
@@ -323,11 +401,7 @@ namespace Ogre {
     Node* Node::getChild(unsigned short index) const
     {
         if( index < mChildren.size() )
-        {
-            ChildNodeMap::const_iterator i = mChildren.begin();
-            while (index--) ++i;
-            return i->second;
-        }
+            return mChildren[index];
         else
             return NULL;
     }
@@ -336,13 +410,11 @@ namespace Ogre {
     {
         if (index < mChildren.size())
         {
-            ChildNodeMap::iterator i = mChildren.begin();
-            while (index--) ++i;
-            Node* ret = i->second;
+            Node* ret = mChildren[index];
             // cancel any pending update
             cancelUpdate(ret);
 
-            mChildren.erase(i);
+            eraseChild(ret);
             ret->setParent(NULL);
             return ret;
         }
@@ -358,22 +430,49 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     Node* Node::removeChild(Node* child)
     {
-        if (child)
+        // ensure it's our child
+        if (child && child->mParent == this)
         {
-            ChildNodeMap::iterator i = mChildren.find(child->getName());
-            // ensure it's our child
-            if (i != mChildren.end() && i->second == child)
-            {
-                // cancel any pending update
-                cancelUpdate(child);
+            // cancel any pending update
+            cancelUpdate(child);
 
-                mChildren.erase(i);
-                child->setParent(NULL);
-            }
+            eraseChild(child);
+            child->setParent(NULL);
         }
         return child;
     }
     //-----------------------------------------------------------------------
+    void Node::eraseChild(Node* child)
+    {
+        // Order does not matter, move the last child in its place
+        Node* last = mChildren.back();
+        mChildren[child->mIndexInParent] = last;
+        last->mIndexInParent = child->mIndexInParent;
+        mChildren.pop_back();
+
+        if (mChildNameIndex)
+        {
+            ChildNameIndex::iterator i = mChildNameIndex->find(child->getName());
+            if (i != mChildNameIndex->end() && i->second == child)
+                mChildNameIndex->erase(i);
+        }
+    }
+    //-----------------------------------------------------------------------
+    Node::ChildNameIndex& Node::getChildNameIndex(void) const
+    {
+        if (!mChildNameIndex)
+        {
+            mChildNameIndex = OGRE_NEW_T(ChildNameIndex, MEMCATEGORY_SCENE_CONTROL)();
+            ChildNodeList::const_iterator i, iend;
+            iend = mChildren.end();
+            for (i = mChildren.begin(); i != iend; ++i)
+            {
+                mChildNameIndex->insert(ChildNameIndex::value_type((*i)->getName(), *i));
+            }
+        }
+        return *mChildNameIndex;
+    }
+    //-----------------------------------------------------------------------
     const Quaternion& Node::getOrientation() const
     {
         return mOrientation;
@@ -615,14 +714,16 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Node::removeAllChildren(void)
     {
-		ChildNodeMap::iterator i, iend;
+		ChildNodeList::iterator i, iend;
 		iend = mChildren.end();
 		for (i = mChildren.begin(); i != iend; ++i)
 		{
-			i->second->setParent(0);
+			(*i)->setParent(0);
 		}
         mChildren.clear();
-		mChildrenToUpdate.clear();
+		clearChildrenToUpdate();
+		OGRE_DELETE_T(mChildNameIndex, ChildNameIndex, MEMCATEGORY_SCENE_CONTROL);
+		mChildNameIndex = 0;
     }
     //-----------------------------------------------------------------------
     void Node::setScale(const Vector3& inScale)
@@ -719,9 +820,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     Node* Node::getChild(const String& name) const
     {
-        ChildNodeMap::const_iterator i = mChildren.find(name);
+        const ChildNameIndex& index = getChildNameIndex();
+        ChildNameIndex::const_iterator i = index.find(name);
 
-        if (i == mChildren.end())
+        if (i == index.end())
         {
             OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, "Child node named " + name +
                 " does not exist.", "Node::getChild");
@@ -732,9 +834,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     Node* Node::removeChild(const String& name)
     {
-        ChildNodeMap::iterator i = mChildren.find(name);
+        ChildNameIndex& index = getChildNameIndex();
+        ChildNameIndex::iterator i = index.find(name);
 
-        if (i == mChildren.end())
+        if (i == index.end())
         {
             OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, "Child node named " + name +
                 " does not exist.", "Node::removeChild");
@@ -744,7 +847,7 @@ namespace Ogre {
         // Cancel any pending update
         cancelUpdate(ret);
 
-        mChildren.erase(i);
+        eraseChild(ret);
         ret->setParent(NULL);
 
         return ret;
@@ -785,7 +888,7 @@ namespace Ogre {
         }
 
         // all children will be updated
-        mChildrenToUpdate.clear();
+        clearChildrenToUpdate();
     }
     //-----------------------------------------------------------------------
     void Node::requestUpdate(Node* child, bool forceParentUpdate)
@@ -796,7 +899,14 @@ namespace Ogre {
             return;
         }
 
-        mChildrenToUpdate.insert(child);
+        // A child is listed once, even if it requests again after being
+        // updated directly rather than through this node
+        if (!child->mInParentUpdateList)
+        {
+            child->mInParentUpdateList = true;
+            child->mIndexInParentUpdateList = mChildrenToUpdate.size();
+            mChildrenToUpdate.push_back(child);
+        }
         // Request selective update of me, if we didn't do it before
         if (mParent && (!mParentNotified || forceParentUpdate))
 		{
@@ -808,7 +918,15 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Node::cancelUpdate(Node* child)
     {
-        mChildrenToUpdate.erase(child);
+        if (child->mInParentUpdateList)
+        {
+            // Order does not matter, erase by moving the last one in its place
+            Node* last = mChildrenToUpdate.back();
+            mChildrenToUpdate[child->mIndexInParentUpdateList] = last;
+            last->mIndexInParentUpdateList = child->mIndexInParentUpdateList;
+            mChildrenToUpdate.pop_back();
+            child->mInParentUpdateList = false;
+        }
 
         // Propagate this up if we're done
         if (mChildrenToUpdate.empty() && mParent && !mNeedChildUpdate)
@@ -816,6 +934,17 @@ namespace Ogre {
             mParent->cancelUpdate(this);
 			mParentNotified = false ;
         }
+    }
+    //-----------------------------------------------------------------------
+    void Node::clearChildrenToUpdate(void) const
+    {
+        ChildUpdateList::iterator it, itend;
+        itend = mChildrenToUpdate.end();
+        for (it = mChildrenToUpdate.begin(); it != itend; ++it)
+        {
+            (*it)->mInParentUpdateList = false;
+        }
+        mChildrenToUpdate.clear();
     }
 	//-----------------------------------------------------------------------
 	void Node::queueNeedUpdate(Node* n)
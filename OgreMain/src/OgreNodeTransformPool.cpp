@@ -0,0 +1,234 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreNodeTransformPool.h"
+#include "OgreParallelFor.h"
+
+namespace Ogre {
+
+	/// Number of arrays of mCapacity entries in NodeTransformPool::mBuffer
+	static const size_t NODE_TRANSFORM_POOL_ARRAYS = 22;
+	/// Number of blocks of 4 nodes below which a level is not worth splitting
+	static const size_t NODE_TRANSFORM_POOL_MIN_BLOCKS = 16;
+
+	//-----------------------------------------------------------------------
+	/// Derives one level of nodes on the threads of the WorkQueue
+	class NodeTransformPoolTask : public ParallelForTask
+	{
+	public:
+		NodeTransformPoolTask(NodeTransformPool* pool)
+			: mPool(pool)
+		{
+		}
+
+		void execute(size_t begin, size_t end)
+		{
+			mPool->_processBlocks(begin, end);
+		}
+
+	private:
+		NodeTransformPool* mPool;
+	};
+	//-----------------------------------------------------------------------
+	NodeTransformPool::NodeTransformPool()
+		: mBuffer(0)
+		, mCapacity(0)
+		, mInheritOrientation(0)
+		, mInheritScale(0)
+	{
+		memset(&mParent, 0, sizeof(mParent));
+		memset(&mLocal, 0, sizeof(mLocal));
+	}
+	//-----------------------------------------------------------------------
+	NodeTransformPool::~NodeTransformPool()
+	{
+		if (mBuffer)
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_SCENE_CONTROL);
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformPool::reserve(size_t count)
+	{
+		if (count <= mCapacity)
+			return;
+
+		if (mBuffer)
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_SCENE_CONTROL);
+
+		// Grow geometrically, keeping every array a multiple of 4 entries so
+		// that they all stay aligned
+		mCapacity = std::max(count, mCapacity * 2);
+		mCapacity = (mCapacity + 3) & ~size_t(3);
+		mBuffer = static_cast<Real*>(OGRE_MALLOC_SIMD(
+			sizeof(Real) * mCapacity * NODE_TRANSFORM_POOL_ARRAYS, MEMCATEGORY_SCENE_CONTROL));
+
+		Real* p = mBuffer;
+		Real** arrays[NODE_TRANSFORM_POOL_ARRAYS] = {
+			&mParent.posX, &mParent.posY, &mParent.posZ,
+			&mParent.rotW, &mParent.rotX, &mParent.rotY, &mParent.rotZ,
+			&mParent.scaleX, &mParent.scaleY, &mParent.scaleZ,
+			&mLocal.posX, &mLocal.posY, &mLocal.posZ,
+			&mLocal.rotW, &mLocal.rotX, &mLocal.rotY, &mLocal.rotZ,
+			&mLocal.scaleX, &mLocal.scaleY, &mLocal.scaleZ,
+			&mInheritOrientation, &mInheritScale };
+		for (size_t i = 0; i < NODE_TRANSFORM_POOL_ARRAYS; ++i)
+		{
+			*arrays[i] = p;
+			p += mCapacity;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformPool::update(Node* root, bool parentHasChanged, bool parallel)
+	{
+		mVisitedNodes.clear();
+		mLevelStarts.clear();
+		mPending.clear();
+		mPending.push_back(Node::PendingUpdate(root, parentHasChanged));
+
+		while (!mPending.empty())
+		{
+			mLevelStarts.push_back(mVisitedNodes.size());
+			mNextPending.clear();
+			mBatch.clear();
+
+			Node::PendingUpdateList::iterator i, iend = mPending.end();
+			for (i = mPending.begin(); i != iend; ++i)
+			{
+				Node* node = i->first;
+				mVisitedNodes.push_back(node);
+
+				if (node->_prepareUpdate(i->second, mNextPending))
+				{
+					// Without a parent there is nothing to concatenate with
+					if (node->getParent())
+						mBatch.push_back(node);
+					else
+						node->_setDerivedTransform(node->getPosition(),
+							node->getOrientation(), node->getScale());
+				}
+			}
+
+			if (!mBatch.empty())
+				processBatch(parallel);
+
+			mPending.swap(mNextPending);
+		}
+
+		mLevelStarts.push_back(mVisitedNodes.size());
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformPool::processBatch(bool parallel)
+	{
+		size_t numBlocks = (mBatch.size() + 3) / 4;
+		reserve(numBlocks * 4);
+
+		if (parallel && numBlocks >= NODE_TRANSFORM_POOL_MIN_BLOCKS * 2)
+		{
+			NodeTransformPoolTask task(this);
+			ParallelFor::run(&task, numBlocks, NODE_TRANSFORM_POOL_MIN_BLOCKS);
+		}
+		else
+		{
+			_processBlocks(0, numBlocks);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void NodeTransformPool::_processBlocks(size_t begin, size_t end)
+	{
+		size_t first = begin * 4;
+		size_t last = std::min(end * 4, mBatch.size());
+
+		// Gather
+		for (size_t i = first; i < last; ++i)
+		{
+			const Node* node = mBatch[i];
+			const Node* parent = node->getParent();
+
+			const Vector3& parentPosition = parent->_getDerivedPosition();
+			const Quaternion& parentOrientation = parent->_getDerivedOrientation();
+			const Vector3& parentScale = parent->_getDerivedScale();
+			mParent.posX[i] = parentPosition.x;
+			mParent.posY[i] = parentPosition.y;
+			mParent.posZ[i] = parentPosition.z;
+			mParent.rotW[i] = parentOrientation.w;
+			mParent.rotX[i] = parentOrientation.x;
+			mParent.rotY[i] = parentOrientation.y;
+			mParent.rotZ[i] = parentOrientation.z;
+			mParent.scaleX[i] = parentScale.x;
+			mParent.scaleY[i] = parentScale.y;
+			mParent.scaleZ[i] = parentScale.z;
+
+			const Vector3& position = node->getPosition();
+			const Quaternion& orientation = node->getOrientation();
+			const Vector3& scale = node->getScale();
+			mLocal.posX[i] = position.x;
+			mLocal.posY[i] = position.y;
+			mLocal.posZ[i] = position.z;
+			mLocal.rotW[i] = orientation.w;
+			mLocal.rotX[i] = orientation.x;
+			mLocal.rotY[i] = orientation.y;
+			mLocal.rotZ[i] = orientation.z;
+			mLocal.scaleX[i] = scale.x;
+			mLocal.scaleY[i] = scale.y;
+			mLocal.scaleZ[i] = scale.z;
+
+			mInheritOrientation[i] = node->getInheritOrientation() ? 1 : 0;
+			mInheritScale[i] = node->getInheritScale() ? 1 : 0;
+		}
+
+		// Pad the last block with identity transforms
+		size_t padded = end * 4;
+		for (size_t i = last; i < padded; ++i)
+		{
+			mParent.posX[i] = mParent.posY[i] = mParent.posZ[i] = 0;
+			mParent.rotX[i] = mParent.rotY[i] = mParent.rotZ[i] = 0;
+			mParent.rotW[i] = 1;
+			mParent.scaleX[i] = mParent.scaleY[i] = mParent.scaleZ[i] = 1;
+			mLocal.posX[i] = mLocal.posY[i] = mLocal.posZ[i] = 0;
+			mLocal.rotX[i] = mLocal.rotY[i] = mLocal.rotZ[i] = 0;
+			mLocal.rotW[i] = 1;
+			mLocal.scaleX[i] = mLocal.scaleY[i] = mLocal.scaleZ[i] = 1;
+			mInheritOrientation[i] = mInheritScale[i] = 0;
+		}
+
+		// Derive in place
+		TransformSoA local = mLocal.offset(first);
+		OptimisedUtil::getImplementation()->concatenateNodeTransforms(
+			mParent.offset(first), local,
+			mInheritOrientation + first, mInheritScale + first,
+			local, padded - first);
+
+		// Scatter
+		for (size_t i = first; i < last; ++i)
+		{
+			mBatch[i]->_setDerivedTransform(
+				Vector3(mLocal.posX[i], mLocal.posY[i], mLocal.posZ[i]),
+				Quaternion(mLocal.rotW[i], mLocal.rotX[i], mLocal.rotY[i], mLocal.rotZ[i]),
+				Vector3(mLocal.scaleX[i], mLocal.scaleY[i], mLocal.scaleZ[i]));
+		}
+	}
+}
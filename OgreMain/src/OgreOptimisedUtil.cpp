@@ -43,6 +43,9 @@ namespace Ogre {
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
 #if __OGRE_HAVE_SSE
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
+#if __OGRE_HAVE_AVX2
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+#endif
 #elif __OGRE_HAVE_NEON
     extern OptimisedUtil* _getOptimisedUtilNEON(void);
 //#elif __OGRE_HAVE_VFP
@@ -86,6 +89,9 @@ namespace Ogre {
             IMPL_DEFAULT,
 #if __OGRE_HAVE_SSE
             IMPL_SSE,
+#if __OGRE_HAVE_AVX2
+            IMPL_AVX2,
+#endif
 #elif __OGRE_HAVE_NEON
             IMPL_NEON,
 //#elif __OGRE_HAVE_VFP
@@ -137,6 +143,13 @@ namespace Ogre {
             {
                 mOptimisedUtils.push_back(_getOptimisedUtilSSE());
             }
+#if __OGRE_HAVE_AVX2
+            if ((PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_AVX2) &&
+                (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_FMA))
+            {
+                mOptimisedUtils.push_back(_getOptimisedUtilAVX2());
+            }
+#endif
 //#elif __OGRE_HAVE_VFP
 //            if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_VFP)
 //            {
@@ -348,6 +361,150 @@ namespace Ogre {
             ++index;    // So we can put break point here even if in release build
         }
 
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->concatenateNodeTransforms(
+                parent,
+                local,
+                inheritOrientation,
+                inheritScale,
+                derived,
+                numNodes);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->cullAxisAlignedBoxes(
+                planes,
+                numPlanes,
+                centreX,
+                centreY,
+                centreZ,
+                halfSizeX,
+                halfSizeY,
+                halfSizeZ,
+                visibility,
+                numBoxes);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->softwareVertexPoseBlend(
+                weights,
+                indices,
+                offsets,
+                numOffsets,
+                numPoses,
+                dstPtr,
+                dstStride);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        virtual void softwareVertexDualQuaternionSkinning(
+            const float *pSrcPos,
+            float *pDestPos,
+            const float *pSrcNorm,
+            float *pDestNorm,
+            const float *pBlendWeight,
+            const unsigned char* pBlendIndex,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride,
+            size_t destPosStride,
+            size_t srcNormStride,
+            size_t destNormStride,
+            size_t blendWeightStride,
+            size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->softwareVertexDualQuaternionSkinning(
+                pSrcPos,
+                pDestPos,
+                pSrcNorm,
+                pDestNorm,
+                pBlendWeight,
+                pBlendIndex,
+                blendDualQuaternions,
+                srcPosStride,
+                destPosStride,
+                srcNormStride,
+                destNormStride,
+                blendWeightStride,
+                blendIndexStride,
+                numWeightsPerVertex,
+                numVertices);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
     };
 #endif // __DO_PROFILE__
 
@@ -402,6 +559,16 @@ namespace Ogre {
 #else   // !__DO_PROFILE__
 
 #if __OGRE_HAVE_SSE
+#if __OGRE_HAVE_AVX2
+        // The AVX2 implementation falls back to the SSE one for everything
+        // but skinning, so it requires SSE as well
+        if ((PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_AVX2) &&
+            (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_FMA))
+        {
+            return _getOptimisedUtilAVX2();
+        }
+        else
+#endif
         if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
         {
             return _getOptimisedUtilSSE();
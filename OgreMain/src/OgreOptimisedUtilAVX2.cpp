@@ -0,0 +1,595 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgreOptimisedUtil.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_AVX2
+
+#include "OgreMatrix4.h"
+#include "OgreDualQuaternion.h"
+
+#include <immintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// The AVX2 code is only compiled for the functions below, through target
+// attributes rather than compiler flags, so that the rest of the library
+// (in particular inline functions shared with other translation units) never
+// contains AVX instructions. The implementation is only selected at run time
+// when the CPU and operating system support AVX2 and FMA.
+//
+// Matrix skinning processes two vertices per iteration, one in each 128 bits
+// lane, accumulating the blend matrices with FMA. Dual quaternion skinning
+// needs much more arithmetic per vertex and processes 8 vertices per
+// iteration in structure of arrays form: vertex elements and blend dual
+// quaternions are fetched with gather instructions, so any vertex layout is
+// supported, and the remaining vertices are handled by masking the lanes.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+#   define __OGRE_AVX2_TARGET
+#else
+#   define __OGRE_AVX2_TARGET   __attribute__((target("avx2,fma")))
+#endif
+
+namespace Ogre {
+
+    extern OptimisedUtil* _getOptimisedUtilSSE(void);
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX2 implementation of OptimisedUtil.
+    @remarks
+        Only skinning is implemented with AVX2, the other functions use the
+        SSE implementation.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX2 : public OptimisedUtil
+    {
+    protected:
+        OptimisedUtil* mSSE;
+
+    public:
+        OptimisedUtilAVX2(void) : mSSE(_getOptimisedUtilSSE())
+        {
+        }
+
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        virtual void __OGRE_AVX2_TARGET softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Matrix4* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexDualQuaternionSkinning
+        virtual void __OGRE_AVX2_TARGET softwareVertexDualQuaternionSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        virtual void softwareVertexMorph(
+            Real t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals)
+        {
+            mSSE->softwareVertexMorph(t, srcPos1, srcPos2, dstPos,
+                pos1VSize, pos2VSize, dstVSize, numVertices, morphNormals);
+        }
+
+        /// @copydoc OptimisedUtil::softwareVertexPoseBlend
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride)
+        {
+            mSSE->softwareVertexPoseBlend(weights, indices, offsets, numOffsets,
+                numPoses, dstPtr, dstStride);
+        }
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        virtual void concatenateAffineMatrices(
+            const Matrix4& baseMatrix,
+            const Matrix4* srcMatrices,
+            Matrix4* dstMatrices,
+            size_t numMatrices)
+        {
+            mSSE->concatenateAffineMatrices(baseMatrix, srcMatrices, dstMatrices, numMatrices);
+        }
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        virtual void calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles)
+        {
+            mSSE->calculateFaceNormals(positions, triangles, faceNormals, numTriangles);
+        }
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        virtual void calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces)
+        {
+            mSSE->calculateLightFacing(lightPos, faceNormals, lightFacings, numFaces);
+        }
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        virtual void extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices)
+        {
+            mSSE->extrudeVertices(lightPos, extrudeDist, srcPositions, destPositions, numVertices);
+        }
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes)
+        {
+            mSSE->concatenateNodeTransforms(parent, local, inheritOrientation, inheritScale,
+                derived, numNodes);
+        }
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            mSSE->cullAxisAlignedBoxes(planes, numPlanes, centreX, centreY, centreZ,
+                halfSizeX, halfSizeY, halfSizeZ, visibility, numBoxes);
+        }
+    };
+
+//-------------------------------------------------------------------------
+// Local helpers
+//-------------------------------------------------------------------------
+
+    /** Fetches the elements of the blend transforms of 8 vertices.
+    @remarks
+        The blend transforms are given as an array of pointers indexed by
+        blend index, so the pointers are gathered first, then each element is
+        gathered through them. Lanes whose mask is clear are neither read nor
+        dereferenced and give zero.
+    */
+    struct BlendTransformGather
+    {
+#if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
+        __m256i ptrLo, ptrHi;
+        __m128 maskLo, maskHi;
+
+        __OGRE_AVX2_TARGET void load(const void* const* table, __m256i index, __m256 mask)
+        {
+            // Widen the 32 bits indices and mask to the 64 bits pointers
+            __m256i mask64Lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(_mm256_castps_si256(mask)));
+            __m256i mask64Hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(_mm256_castps_si256(mask), 1));
+            ptrLo = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+                (const long long*)table, _mm256_castsi256_si128(index), mask64Lo, 8);
+            ptrHi = _mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+                (const long long*)table, _mm256_extracti128_si256(index, 1), mask64Hi, 8);
+            maskLo = _mm256_castps256_ps128(mask);
+            maskHi = _mm256_extractf128_ps(mask, 1);
+        }
+
+        /// Gets the float at the given byte offset of each transform
+        __OGRE_AVX2_TARGET __m256 element(int offset) const
+        {
+            __m256i offsets = _mm256_set1_epi64x(offset);
+            __m128 lo = _mm256_mask_i64gather_ps(_mm_setzero_ps(),
+                (const float*)0, _mm256_add_epi64(ptrLo, offsets), maskLo, 1);
+            __m128 hi = _mm256_mask_i64gather_ps(_mm_setzero_ps(),
+                (const float*)0, _mm256_add_epi64(ptrHi, offsets), maskHi, 1);
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+        }
+#else
+        __m256i ptr;
+        __m256 mask;
+
+        __OGRE_AVX2_TARGET void load(const void* const* table, __m256i index, __m256 m)
+        {
+            ptr = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                (const int*)table, index, _mm256_castps_si256(m), 4);
+            mask = m;
+        }
+
+        /// Gets the float at the given byte offset of each transform
+        __OGRE_AVX2_TARGET __m256 element(int offset) const
+        {
+            return _mm256_mask_i32gather_ps(_mm256_setzero_ps(),
+                (const float*)0, _mm256_add_epi32(ptr, _mm256_set1_epi32(offset)), mask, 1);
+        }
+#endif
+    };
+
+    /** Fetches the vertex elements of up to 8 consecutive vertices. */
+    struct VertexGather
+    {
+        /// Byte offset of each lane from the first vertex
+        __m256i offsets;
+        /// Lanes of the vertices which exist
+        __m256 mask;
+
+        __OGRE_AVX2_TARGET VertexGather(size_t stride, size_t count)
+        {
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            offsets = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(static_cast<int>(stride)));
+            mask = _mm256_castsi256_ps(
+                _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)), lanes));
+        }
+
+        /// Gets the float at the given byte offset of each vertex
+        __OGRE_AVX2_TARGET __m256 floats(const void* base, int offset) const
+        {
+            return _mm256_mask_i32gather_ps(_mm256_setzero_ps(),
+                (const float*)((const char*)base + offset), offsets, mask, 1);
+        }
+
+        /// Gets the 4 bytes at the start of each vertex
+        __OGRE_AVX2_TARGET __m256i dwords(const void* base) const
+        {
+            return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                (const int*)base, offsets, _mm256_castps_si256(mask), 1);
+        }
+    };
+
+    /** Writes the x, y and z of up to 8 consecutive vertices. */
+    static __OGRE_AVX2_TARGET void storeVertices(float* dest, size_t stride, size_t count,
+        __m256 x, __m256 y, __m256 z)
+    {
+        OGRE_ALIGNED_DECL(float, tx[8], 32);
+        OGRE_ALIGNED_DECL(float, ty[8], 32);
+        OGRE_ALIGNED_DECL(float, tz[8], 32);
+        _mm256_store_ps(tx, x);
+        _mm256_store_ps(ty, y);
+        _mm256_store_ps(tz, z);
+        for (size_t i = 0; i < count; ++i)
+        {
+            dest[0] = tx[i];
+            dest[1] = ty[i];
+            dest[2] = tz[i];
+            advanceRawPointer(dest, stride);
+        }
+    }
+
+//-------------------------------------------------------------------------
+// AVX2 implementation
+//-------------------------------------------------------------------------
+
+    //---------------------------------------------------------------------
+    /** Loads the x, y, z of a vertex element, with the given w. */
+    static __OGRE_AVX2_TARGET __m128 loadVector(const float* p, __m128 w)
+    {
+        // Not a 4 floats load, which could read past the end of the buffer
+        __m128 xyz = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p), _mm_load_ss(p + 2));
+        return _mm_blend_ps(xyz, w, 0x8);
+    }
+    //---------------------------------------------------------------------
+    /** Stores the x, y, z of a vertex element. */
+    static __OGRE_AVX2_TARGET void storeVector(float* p, __m128 v)
+    {
+        _mm_storel_pi((__m64*)p, v);
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+    //---------------------------------------------------------------------
+    /** Loads the same row of the blend matrices of two vertices, one per lane. */
+    static __OGRE_AVX2_TARGET __m256 loadRows(const Matrix4* a, const Matrix4* b, size_t row)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps((*a)[row])),
+            _mm_loadu_ps((*b)[row]), 1);
+    }
+    //---------------------------------------------------------------------
+    /** Transforms the vector of each lane by the 3 rows of the matrix of the lane. */
+    static __OGRE_AVX2_TARGET __m256 transformVectors(__m256 row0, __m256 row1, __m256 row2, __m256 v)
+    {
+        // Dot products of the rows by the vectors, in x, y, z of each lane
+        __m256 xy = _mm256_hadd_ps(_mm256_mul_ps(row0, v), _mm256_mul_ps(row1, v));
+        __m256 z = _mm256_hadd_ps(_mm256_mul_ps(row2, v), _mm256_setzero_ps());
+        return _mm256_hadd_ps(xy, z);
+    }
+    //---------------------------------------------------------------------
+    __OGRE_AVX2_TARGET void OptimisedUtilAVX2::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Matrix4* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // Two vertices per iteration, one per 128 bits lane: the 3x4 blend
+        // matrices are accumulated with one FMA per row for both vertices,
+        // then the vectors are transformed with horizontal adds. As in the SSE
+        // implementation, the blend indices of zero weights must be valid.
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        for (size_t vertIdx = 0; vertIdx < numVertices; vertIdx += 2)
+        {
+            // The second vertex of an odd count is the first one again, and
+            // not stored
+            bool pair = vertIdx + 1 < numVertices;
+            const float* pWeightB = pair ? rawOffsetPointer(pBlendWeight, blendWeightStride) : pBlendWeight;
+            const unsigned char* pIndexB = pair ? rawOffsetPointer(pBlendIndex, blendIndexStride) : pBlendIndex;
+
+            __m256 row0 = _mm256_setzero_ps();
+            __m256 row1 = _mm256_setzero_ps();
+            __m256 row2 = _mm256_setzero_ps();
+            for (size_t blendIdx = 0; blendIdx < numWeightsPerVertex; ++blendIdx)
+            {
+                __m256 weight = _mm256_insertf128_ps(
+                    _mm256_castps128_ps256(_mm_set1_ps(pBlendWeight[blendIdx])),
+                    _mm_set1_ps(pWeightB[blendIdx]), 1);
+                const Matrix4* matA = blendMatrices[pBlendIndex[blendIdx]];
+                const Matrix4* matB = blendMatrices[pIndexB[blendIdx]];
+                row0 = _mm256_fmadd_ps(weight, loadRows(matA, matB, 0), row0);
+                row1 = _mm256_fmadd_ps(weight, loadRows(matA, matB, 1), row1);
+                row2 = _mm256_fmadd_ps(weight, loadRows(matA, matB, 2), row2);
+            }
+
+            // Blend position, use 3x4 matrix
+            const float* pSrcPosB = pair ? rawOffsetPointer(pSrcPos, srcPosStride) : pSrcPos;
+            __m256 pos = _mm256_insertf128_ps(_mm256_castps128_ps256(loadVector(pSrcPos, one)),
+                loadVector(pSrcPosB, one), 1);
+            pos = transformVectors(row0, row1, row2, pos);
+            storeVector(pDestPos, _mm256_castps256_ps128(pos));
+            if (pair)
+                storeVector(rawOffsetPointer(pDestPos, destPosStride), _mm256_extractf128_ps(pos, 1));
+
+            if (pSrcNorm)
+            {
+                // Blend normal, the 3x3 part is assumed orthogonal as in the
+                // general implementation, then normalise
+                const float* pSrcNormB = pair ? rawOffsetPointer(pSrcNorm, srcNormStride) : pSrcNorm;
+                __m256 norm = _mm256_insertf128_ps(_mm256_castps128_ps256(loadVector(pSrcNorm, zero)),
+                    loadVector(pSrcNormB, zero), 1);
+                norm = transformVectors(row0, row1, row2, norm);
+
+                __m256 lengthSq = _mm256_dp_ps(norm, norm, 0x7F);
+                __m256 nonZero = _mm256_cmp_ps(lengthSq, _mm256_setzero_ps(), _CMP_GT_OQ);
+                __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSq));
+                norm = _mm256_mul_ps(norm, _mm256_blendv_ps(_mm256_set1_ps(1.0f), invLength, nonZero));
+
+                storeVector(pDestNorm, _mm256_castps256_ps128(norm));
+                if (pair)
+                    storeVector(rawOffsetPointer(pDestNorm, destNormStride), _mm256_extractf128_ps(norm, 1));
+                advanceRawPointer(pSrcNorm, srcNormStride * 2);
+                advanceRawPointer(pDestNorm, destNormStride * 2);
+            }
+
+            // Advance pointers
+            advanceRawPointer(pSrcPos, srcPosStride * 2);
+            advanceRawPointer(pDestPos, destPosStride * 2);
+            advanceRawPointer(pBlendWeight, blendWeightStride * 2);
+            advanceRawPointer(pBlendIndex, blendIndexStride * 2);
+        }
+    }
+    //---------------------------------------------------------------------
+    /** Computes q x v + w * v for 8 quaternions and vectors at once. */
+    static __OGRE_AVX2_TARGET void crossPlusScaled(
+        __m256 qx, __m256 qy, __m256 qz, __m256 w,
+        __m256 vx, __m256 vy, __m256 vz,
+        __m256& rx, __m256& ry, __m256& rz)
+    {
+        rx = _mm256_fmadd_ps(w, vx, _mm256_fmsub_ps(qy, vz, _mm256_mul_ps(qz, vy)));
+        ry = _mm256_fmadd_ps(w, vy, _mm256_fmsub_ps(qz, vx, _mm256_mul_ps(qx, vz)));
+        rz = _mm256_fmadd_ps(w, vz, _mm256_fmsub_ps(qx, vy, _mm256_mul_ps(qy, vx)));
+    }
+    //---------------------------------------------------------------------
+    /** Rotates 8 vectors by 8 unit quaternions, v + 2 * q x (q x v + w * v). */
+    static __OGRE_AVX2_TARGET void rotateVectors(
+        __m256 qw, __m256 qx, __m256 qy, __m256 qz,
+        __m256& vx, __m256& vy, __m256& vz)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 two = _mm256_set1_ps(2.0f);
+        __m256 tx, ty, tz, cx, cy, cz;
+        crossPlusScaled(qx, qy, qz, qw, vx, vy, vz, tx, ty, tz);
+        crossPlusScaled(qx, qy, qz, zero, tx, ty, tz, cx, cy, cz);
+        vx = _mm256_fmadd_ps(two, cx, vx);
+        vy = _mm256_fmadd_ps(two, cy, vy);
+        vz = _mm256_fmadd_ps(two, cz, vz);
+    }
+    //---------------------------------------------------------------------
+    __OGRE_AVX2_TARGET void OptimisedUtilAVX2::softwareVertexDualQuaternionSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const DualQuaternion* const* blendDualQuaternions,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        // Byte offsets of w, x, y, z, dw, dx, dy, dz
+        const int stride = static_cast<int>(sizeof(Real));
+
+        for (size_t vertIdx = 0; vertIdx < numVertices; vertIdx += 8)
+        {
+            size_t count = std::min(numVertices - vertIdx, (size_t)8);
+            VertexGather pos(srcPosStride, count);
+            VertexGather norm(srcNormStride, count);
+            VertexGather weights(blendWeightStride, count);
+            VertexGather indices(blendIndexStride, count);
+            __m256i blendIndices = indices.dwords(pBlendIndex);
+
+            // The real part of the first dual quaternion of each vertex
+            // decides the hemisphere of the others
+            __m256 firstW = zero, firstX = zero, firstY = zero, firstZ = zero;
+            __m256 w = zero, x = zero, y = zero, z = zero;
+            __m256 dw = zero, dx = zero, dy = zero, dz = zero;
+            for (size_t blendIdx = 0; blendIdx < numWeightsPerVertex; ++blendIdx)
+            {
+                __m256 weight = weights.floats(pBlendWeight, static_cast<int>(blendIdx * sizeof(float)));
+                // The first one is always read, as the reference
+                __m256 mask = blendIdx == 0 ? weights.mask :
+                    _mm256_and_ps(weights.mask, _mm256_cmp_ps(weight, zero, _CMP_NEQ_UQ));
+                if (_mm256_testz_ps(mask, mask))
+                    continue;
+
+                __m256i index = _mm256_and_si256(
+                    _mm256_srl_epi32(blendIndices, _mm_cvtsi32_si128(static_cast<int>(blendIdx * 8))),
+                    _mm256_set1_epi32(0xFF));
+                BlendTransformGather dq;
+                dq.load((const void* const*)blendDualQuaternions, index, mask);
+
+                __m256 qw = dq.element(0);
+                __m256 qx = dq.element(stride);
+                __m256 qy = dq.element(stride * 2);
+                __m256 qz = dq.element(stride * 3);
+                if (blendIdx == 0)
+                {
+                    firstW = qw;
+                    firstX = qx;
+                    firstY = qy;
+                    firstZ = qz;
+                }
+                else
+                {
+                    // Antipodality, negate the weight if in the other hemisphere
+                    __m256 dot = _mm256_fmadd_ps(qw, firstW, _mm256_fmadd_ps(qx, firstX,
+                        _mm256_fmadd_ps(qy, firstY, _mm256_mul_ps(qz, firstZ))));
+                    weight = _mm256_xor_ps(weight,
+                        _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), signMask));
+                }
+
+                w = _mm256_fmadd_ps(weight, qw, w);
+                x = _mm256_fmadd_ps(weight, qx, x);
+                y = _mm256_fmadd_ps(weight, qy, y);
+                z = _mm256_fmadd_ps(weight, qz, z);
+                dw = _mm256_fmadd_ps(weight, dq.element(stride * 4), dw);
+                dx = _mm256_fmadd_ps(weight, dq.element(stride * 5), dx);
+                dy = _mm256_fmadd_ps(weight, dq.element(stride * 6), dy);
+                dz = _mm256_fmadd_ps(weight, dq.element(stride * 7), dz);
+            }
+
+            // Normalise by the length of the real part; lanes without vertex
+            // are left as they are, they are not stored
+            __m256 lengthSq = _mm256_fmadd_ps(w, w, _mm256_fmadd_ps(x, x,
+                _mm256_fmadd_ps(y, y, _mm256_mul_ps(z, z))));
+            __m256 invLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSq));
+            invLength = _mm256_blendv_ps(zero, invLength, weights.mask);
+            w = _mm256_mul_ps(w, invLength);
+            x = _mm256_mul_ps(x, invLength);
+            y = _mm256_mul_ps(y, invLength);
+            z = _mm256_mul_ps(z, invLength);
+            dw = _mm256_mul_ps(dw, invLength);
+            dx = _mm256_mul_ps(dx, invLength);
+            dy = _mm256_mul_ps(dy, invLength);
+            dz = _mm256_mul_ps(dz, invLength);
+
+            // Rotate the position, then translate by 2 * (w * d - dw * q + q x d)
+            __m256 px = pos.floats(pSrcPos, 0);
+            __m256 py = pos.floats(pSrcPos, 4);
+            __m256 pz = pos.floats(pSrcPos, 8);
+            rotateVectors(w, x, y, z, px, py, pz);
+            __m256 tx, ty, tz;
+            crossPlusScaled(x, y, z, w, dx, dy, dz, tx, ty, tz);
+            const __m256 two = _mm256_set1_ps(2.0f);
+            px = _mm256_fmadd_ps(two, _mm256_fnmadd_ps(dw, x, tx), px);
+            py = _mm256_fmadd_ps(two, _mm256_fnmadd_ps(dw, y, ty), py);
+            pz = _mm256_fmadd_ps(two, _mm256_fnmadd_ps(dw, z, tz), pz);
+            storeVertices(pDestPos, destPosStride, count, px, py, pz);
+
+            if (pSrcNorm)
+            {
+                // Rotation only, which keeps the normal unit length
+                __m256 nx = norm.floats(pSrcNorm, 0);
+                __m256 ny = norm.floats(pSrcNorm, 4);
+                __m256 nz = norm.floats(pSrcNorm, 8);
+                rotateVectors(w, x, y, z, nx, ny, nz);
+                storeVertices(pDestNorm, destNormStride, count, nx, ny, nz);
+                advanceRawPointer(pSrcNorm, srcNormStride * count);
+                advanceRawPointer(pDestNorm, destNormStride * count);
+            }
+
+            // Advance pointers
+            advanceRawPointer(pSrcPos, srcPosStride * count);
+            advanceRawPointer(pDestPos, destPosStride * count);
+            advanceRawPointer(pBlendWeight, blendWeightStride * count);
+            advanceRawPointer(pBlendIndex, blendIndexStride * count);
+        }
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void)
+    {
+        static OptimisedUtilAVX2 msOptimisedUtilAVX2;
+        return &msOptimisedUtilAVX2;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX2
@@ -31,6 +31,9 @@ THE SOFTWARE.
 
 #include "OgreVector3.h"
 #include "OgreMatrix4.h"
+#include "OgrePlane.h"
+#include "OgreQuaternion.h"
+#include "OgreDualQuaternion.h"
 
 namespace Ogre {
 
@@ -94,6 +97,56 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::softwareVertexPoseBlend
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride);
+
+        /// @copydoc OptimisedUtil::softwareVertexDualQuaternionSkinning
+        virtual void softwareVertexDualQuaternionSkinning(
+            const float *pSrcPos,
+            float *pDestPos,
+            const float *pSrcNorm,
+            float *pDestNorm,
+            const float *pBlendWeight,
+            const unsigned char* pBlendIndex,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride,
+            size_t destPosStride,
+            size_t srcNormStride,
+            size_t destNormStride,
+            size_t blendWeightStride,
+            size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -392,6 +445,187 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::concatenateNodeTransforms(
+        const TransformSoA& parent,
+        const TransformSoA& local,
+        const Real* inheritOrientation,
+        const Real* inheritScale,
+        const TransformSoA& derived,
+        size_t numNodes)
+    {
+        for (size_t i = 0; i < numNodes; ++i)
+        {
+            Quaternion parentOrientation(parent.rotW[i], parent.rotX[i], parent.rotY[i], parent.rotZ[i]);
+            Vector3 parentScale(parent.scaleX[i], parent.scaleY[i], parent.scaleZ[i]);
+            Vector3 parentPosition(parent.posX[i], parent.posY[i], parent.posZ[i]);
+            Quaternion orientation(local.rotW[i], local.rotX[i], local.rotY[i], local.rotZ[i]);
+            Vector3 scale(local.scaleX[i], local.scaleY[i], local.scaleZ[i]);
+            Vector3 position(local.posX[i], local.posY[i], local.posZ[i]);
+
+            if (inheritOrientation[i] != 0)
+                orientation = parentOrientation * orientation;
+            if (inheritScale[i] != 0)
+                scale = parentScale * scale;
+            position = parentOrientation * (parentScale * position) + parentPosition;
+
+            derived.posX[i] = position.x;
+            derived.posY[i] = position.y;
+            derived.posZ[i] = position.z;
+            derived.rotW[i] = orientation.w;
+            derived.rotX[i] = orientation.x;
+            derived.rotY[i] = orientation.y;
+            derived.rotZ[i] = orientation.z;
+            derived.scaleX[i] = scale.x;
+            derived.scaleY[i] = scale.y;
+            derived.scaleZ[i] = scale.z;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* centreX,
+        const Real* centreY,
+        const Real* centreZ,
+        const Real* halfSizeX,
+        const Real* halfSizeY,
+        const Real* halfSizeZ,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        memset(visibility, 0, sizeof(uint32) * ((numBoxes + 31) / 32));
+
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            Vector3 centre(centreX[i], centreY[i], centreZ[i]);
+            Vector3 halfSize(halfSizeX[i], halfSizeY[i], halfSizeZ[i]);
+
+            bool visible = true;
+            for (size_t plane = 0; plane < numPlanes; ++plane)
+            {
+                if (planes[plane].getSide(centre, halfSize) == Plane::NEGATIVE_SIDE)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+
+            if (visible)
+                visibility[i >> 5] |= 1u << (i & 31);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::softwareVertexPoseBlend(
+        const Real* weights,
+        const uint32* const* indices,
+        const float* const* offsets,
+        const size_t* numOffsets,
+        size_t numPoses,
+        float* dstPtr,
+        size_t dstStride)
+    {
+        for (size_t pose = 0; pose < numPoses; ++pose)
+        {
+            Real weight = weights[pose];
+            const uint32* pIndex = indices[pose];
+            const float* pOffset = offsets[pose];
+            for (size_t i = 0; i < numOffsets[pose]; ++i, pOffset += 4)
+            {
+                float* pDst = rawOffsetPointer(dstPtr, pIndex[i] * dstStride);
+                pDst[0] += pOffset[0] * weight;
+                pDst[1] += pOffset[1] * weight;
+                pDst[2] += pOffset[2] * weight;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::softwareVertexDualQuaternionSkinning(
+        const float *pSrcPos,
+        float *pDestPos,
+        const float *pSrcNorm,
+        float *pDestNorm,
+        const float *pBlendWeight,
+        const unsigned char* pBlendIndex,
+        const DualQuaternion* const* blendDualQuaternions,
+        size_t srcPosStride,
+        size_t destPosStride,
+        size_t srcNormStride,
+        size_t destNormStride,
+        size_t blendWeightStride,
+        size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // Loop per vertex
+        for (size_t vertIdx = 0; vertIdx < numVertices; ++vertIdx)
+        {
+            // Blend the dual quaternions of the bones, flipping those which
+            // are not in the same hemisphere as the first one, as the
+            // hardware dual quaternion skinning shaders do
+            const DualQuaternion& first = *blendDualQuaternions[pBlendIndex[0]];
+            Real w = 0, x = 0, y = 0, z = 0, dw = 0, dx = 0, dy = 0, dz = 0;
+            for (unsigned short blendIdx = 0; blendIdx < numWeightsPerVertex; ++blendIdx)
+            {
+                Real weight = pBlendWeight[blendIdx];
+                if (weight)
+                {
+                    const DualQuaternion& dq = *blendDualQuaternions[pBlendIndex[blendIdx]];
+                    if (dq.w * first.w + dq.x * first.x + dq.y * first.y + dq.z * first.z < 0)
+                        weight = -weight;
+                    w += dq.w * weight;
+                    x += dq.x * weight;
+                    y += dq.y * weight;
+                    z += dq.z * weight;
+                    dw += dq.dw * weight;
+                    dx += dq.dx * weight;
+                    dy += dq.dy * weight;
+                    dz += dq.dz * weight;
+                }
+            }
+
+            // Normalise by the length of the real part
+            Real invLength = 1 / Math::Sqrt(w * w + x * x + y * y + z * z);
+            w *= invLength;
+            x *= invLength;
+            y *= invLength;
+            z *= invLength;
+            dw *= invLength;
+            dx *= invLength;
+            dy *= invLength;
+            dz *= invLength;
+
+            // Rotate, p + 2 * q x (q x p + w * p), then translate by
+            // 2 * (w * d - dw * q + q x d)
+            const Vector3 q(x, y, z);
+            const Vector3 d(dx, dy, dz);
+            Vector3 pos(pSrcPos[0], pSrcPos[1], pSrcPos[2]);
+            pos += 2 * q.crossProduct(q.crossProduct(pos) + w * pos);
+            pos += 2 * (w * d - dw * q + q.crossProduct(d));
+            pDestPos[0] = pos.x;
+            pDestPos[1] = pos.y;
+            pDestPos[2] = pos.z;
+
+            if (pSrcNorm)
+            {
+                // Rotation only, which keeps the normal unit length
+                Vector3 norm(pSrcNorm[0], pSrcNorm[1], pSrcNorm[2]);
+                norm += 2 * q.crossProduct(q.crossProduct(norm) + w * norm);
+                pDestNorm[0] = norm.x;
+                pDestNorm[1] = norm.y;
+                pDestNorm[2] = norm.z;
+
+                advanceRawPointer(pSrcNorm, srcNormStride);
+                advanceRawPointer(pDestNorm, destNormStride);
+            }
+
+            // Advance pointers
+            advanceRawPointer(pSrcPos, srcPosStride);
+            advanceRawPointer(pDestPos, destPosStride);
+            advanceRawPointer(pBlendWeight, blendWeightStride);
+            advanceRawPointer(pBlendIndex, blendIndexStride);
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void)
@@ -31,9 +31,17 @@ THE SOFTWARE.
 
 #include "OgreVector3.h"
 #include "OgreMatrix4.h"
+#include "OgrePlane.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_NEON
+#include <arm_neon.h>
+#endif
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -94,6 +102,56 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::softwareVertexPoseBlend
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride);
+
+        /// @copydoc OptimisedUtil::softwareVertexDualQuaternionSkinning
+        virtual void softwareVertexDualQuaternionSkinning(
+            const float *pSrcPos,
+            float *pDestPos,
+            const float *pSrcNorm,
+            float *pDestNorm,
+            const float *pBlendWeight,
+            const unsigned char* pBlendIndex,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride,
+            size_t destPosStride,
+            size_t srcNormStride,
+            size_t destNormStride,
+            size_t blendWeightStride,
+            size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -480,6 +538,139 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilNeon::concatenateNodeTransforms(
+        const TransformSoA& parent,
+        const TransformSoA& local,
+        const Real* inheritOrientation,
+        const Real* inheritScale,
+        const TransformSoA& derived,
+        size_t numNodes)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->concatenateNodeTransforms(
+            parent, local, inheritOrientation, inheritScale, derived, numNodes);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilNeon::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* centreX,
+        const Real* centreY,
+        const Real* centreZ,
+        const Real* halfSizeX,
+        const Real* halfSizeY,
+        const Real* halfSizeZ,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        memset(visibility, 0, sizeof(uint32) * ((numBoxes + 31) / 32));
+
+#if __OGRE_HAVE_NEON
+        // Four boxes per iteration, the arrays are padded to a multiple of four.
+        // The operations are ordered as in Plane::getSide so that the results
+        // match Frustum::isVisible.
+        for (size_t i = 0; i < numBoxes; i += 4)
+        {
+            float32x4_t cx = vld1q_f32(centreX + i);
+            float32x4_t cy = vld1q_f32(centreY + i);
+            float32x4_t cz = vld1q_f32(centreZ + i);
+            float32x4_t hx = vld1q_f32(halfSizeX + i);
+            float32x4_t hy = vld1q_f32(halfSizeY + i);
+            float32x4_t hz = vld1q_f32(halfSizeZ + i);
+
+            uint32x4_t culled = vdupq_n_u32(0);
+            for (size_t plane = 0; plane < numPlanes; ++plane)
+            {
+                const Plane& p = planes[plane];
+                float32x4_t nx = vdupq_n_f32(p.normal.x);
+                float32x4_t ny = vdupq_n_f32(p.normal.y);
+                float32x4_t nz = vdupq_n_f32(p.normal.z);
+
+                // Distance between the box centres and the plane
+                float32x4_t dist = vaddq_f32(vaddq_f32(vaddq_f32(
+                    vmulq_f32(nx, cx), vmulq_f32(ny, cy)), vmulq_f32(nz, cz)), vdupq_n_f32(p.d));
+
+                // Maximum absolute distance allowed for each box
+                float32x4_t maxAbsDist = vaddq_f32(vaddq_f32(
+                    vabsq_f32(vmulq_f32(nx, hx)), vabsq_f32(vmulq_f32(ny, hy))),
+                    vabsq_f32(vmulq_f32(nz, hz)));
+
+                culled = vorrq_u32(culled, vcltq_f32(dist, vnegq_f32(maxAbsDist)));
+            }
+
+            uint32 visible =
+                (vgetq_lane_u32(culled, 0) ? 0 : 1) |
+                (vgetq_lane_u32(culled, 1) ? 0 : 2) |
+                (vgetq_lane_u32(culled, 2) ? 0 : 4) |
+                (vgetq_lane_u32(culled, 3) ? 0 : 8);
+            visibility[i >> 5] |= visible << (i & 31);
+        }
+#else
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            Vector3 centre(centreX[i], centreY[i], centreZ[i]);
+            Vector3 halfSize(halfSizeX[i], halfSizeY[i], halfSizeZ[i]);
+
+            bool visible = true;
+            for (size_t plane = 0; plane < numPlanes; ++plane)
+            {
+                if (planes[plane].getSide(centre, halfSize) == Plane::NEGATIVE_SIDE)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+
+            if (visible)
+                visibility[i >> 5] |= 1u << (i & 31);
+        }
+#endif
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilNeon::softwareVertexPoseBlend(
+        const Real* weights,
+        const uint32* const* indices,
+        const float* const* offsets,
+        const size_t* numOffsets,
+        size_t numPoses,
+        float* dstPtr,
+        size_t dstStride)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->softwareVertexPoseBlend(
+            weights, indices, offsets, numOffsets, numPoses, dstPtr, dstStride);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilNeon::softwareVertexDualQuaternionSkinning(
+        const float *pSrcPos,
+        float *pDestPos,
+        const float *pSrcNorm,
+        float *pDestNorm,
+        const float *pBlendWeight,
+        const unsigned char* pBlendIndex,
+        const DualQuaternion* const* blendDualQuaternions,
+        size_t srcPosStride,
+        size_t destPosStride,
+        size_t srcNormStride,
+        size_t destNormStride,
+        size_t blendWeightStride,
+        size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->softwareVertexDualQuaternionSkinning(
+            pSrcPos, pDestPos,
+            pSrcNorm, pDestNorm,
+            pBlendWeight, pBlendIndex,
+            blendDualQuaternions,
+            srcPosStride, destPosStride,
+            srcNormStride, destNormStride,
+            blendWeightStride, blendIndexStride,
+            numWeightsPerVertex,
+            numVertices);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilNEON(void)
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #if __OGRE_HAVE_SSE
 
 #include "OgreMatrix4.h"
+#include "OgrePlane.h"
 
 // Should keep this includes at latest to avoid potential "xmmintrin.h" included by
 // other header file on some platform for some reason.
@@ -65,6 +66,8 @@ THE SOFTWARE.
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -132,6 +135,56 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::softwareVertexPoseBlend
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride);
+
+        /// @copydoc OptimisedUtil::softwareVertexDualQuaternionSkinning
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE softwareVertexDualQuaternionSkinning(
+            const float *pSrcPos,
+            float *pDestPos,
+            const float *pSrcNorm,
+            float *pDestNorm,
+            const float *pBlendWeight,
+            const unsigned char* pBlendIndex,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride,
+            size_t destPosStride,
+            size_t srcNormStride,
+            size_t destNormStride,
+            size_t blendWeightStride,
+            size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -271,6 +324,114 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->concatenateNodeTransforms(
+                parent,
+                local,
+                inheritOrientation,
+                inheritScale,
+                derived,
+                numNodes);
+        }
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->cullAxisAlignedBoxes(
+                planes,
+                numPlanes,
+                centreX,
+                centreY,
+                centreZ,
+                halfSizeX,
+                halfSizeY,
+                halfSizeZ,
+                visibility,
+                numBoxes);
+        }
+
+        /// @copydoc OptimisedUtil::softwareVertexPoseBlend
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->softwareVertexPoseBlend(
+                weights,
+                indices,
+                offsets,
+                numOffsets,
+                numPoses,
+                dstPtr,
+                dstStride);
+        }
+
+        /// @copydoc OptimisedUtil::softwareVertexDualQuaternionSkinning
+        virtual void softwareVertexDualQuaternionSkinning(
+            const float *pSrcPos,
+            float *pDestPos,
+            const float *pSrcNorm,
+            float *pDestNorm,
+            const float *pBlendWeight,
+            const unsigned char* pBlendIndex,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride,
+            size_t destPosStride,
+            size_t srcNormStride,
+            size_t destNormStride,
+            size_t blendWeightStride,
+            size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->softwareVertexDualQuaternionSkinning(
+                pSrcPos,
+                pDestPos,
+                pSrcNorm,
+                pDestNorm,
+                pBlendWeight,
+                pBlendIndex,
+                blendDualQuaternions,
+                srcPosStride,
+                destPosStride,
+                srcNormStride,
+                destNormStride,
+                blendWeightStride,
+                blendIndexStride,
+                numWeightsPerVertex,
+                numVertices);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -2136,6 +2297,240 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilSSE::concatenateNodeTransforms(
+        const TransformSoA& parent,
+        const TransformSoA& local,
+        const Real* inheritOrientation,
+        const Real* inheritScale,
+        const TransformSoA& derived,
+        size_t numNodes)
+    {
+        assert(_isAlignedForSSE(local.posX) && _isAlignedForSSE(parent.posX) &&
+            _isAlignedForSSE(derived.posX));
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 two = _mm_set_ps1(2.0f);
+
+        // Four nodes per iteration, the arrays are padded to a multiple of four.
+        // The operations are ordered as in Quaternion and Vector3 so that the
+        // results match Node::updateFromParentImpl.
+        for (size_t i = 0; i < numNodes; i += 4)
+        {
+            __m128 pw = _mm_load_ps(parent.rotW + i);
+            __m128 px = _mm_load_ps(parent.rotX + i);
+            __m128 py = _mm_load_ps(parent.rotY + i);
+            __m128 pz = _mm_load_ps(parent.rotZ + i);
+            __m128 psx = _mm_load_ps(parent.scaleX + i);
+            __m128 psy = _mm_load_ps(parent.scaleY + i);
+            __m128 psz = _mm_load_ps(parent.scaleZ + i);
+
+            __m128 qw = _mm_load_ps(local.rotW + i);
+            __m128 qx = _mm_load_ps(local.rotX + i);
+            __m128 qy = _mm_load_ps(local.rotY + i);
+            __m128 qz = _mm_load_ps(local.rotZ + i);
+            __m128 sx = _mm_load_ps(local.scaleX + i);
+            __m128 sy = _mm_load_ps(local.scaleY + i);
+            __m128 sz = _mm_load_ps(local.scaleZ + i);
+            __m128 vx = _mm_load_ps(local.posX + i);
+            __m128 vy = _mm_load_ps(local.posY + i);
+            __m128 vz = _mm_load_ps(local.posZ + i);
+
+            __m128 inheritO = _mm_cmpneq_ps(_mm_load_ps(inheritOrientation + i), zero);
+            __m128 inheritS = _mm_cmpneq_ps(_mm_load_ps(inheritScale + i), zero);
+
+            // Orientation: parent * local
+            __m128 rw = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(
+                _mm_mul_ps(pw, qw), _mm_mul_ps(px, qx)), _mm_mul_ps(py, qy)), _mm_mul_ps(pz, qz));
+            __m128 rx = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(pw, qx), _mm_mul_ps(px, qw)), _mm_mul_ps(py, qz)), _mm_mul_ps(pz, qy));
+            __m128 ry = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(pw, qy), _mm_mul_ps(py, qw)), _mm_mul_ps(pz, qx)), _mm_mul_ps(px, qz));
+            __m128 rz = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(pw, qz), _mm_mul_ps(pz, qw)), _mm_mul_ps(px, qy)), _mm_mul_ps(py, qx));
+            rw = __MM_SELECT_MASK_PS(inheritO, rw, qw);
+            rx = __MM_SELECT_MASK_PS(inheritO, rx, qx);
+            ry = __MM_SELECT_MASK_PS(inheritO, ry, qy);
+            rz = __MM_SELECT_MASK_PS(inheritO, rz, qz);
+
+            // Scale: parent * local
+            __m128 rsx = __MM_SELECT_MASK_PS(inheritS, _mm_mul_ps(psx, sx), sx);
+            __m128 rsy = __MM_SELECT_MASK_PS(inheritS, _mm_mul_ps(psy, sy), sy);
+            __m128 rsz = __MM_SELECT_MASK_PS(inheritS, _mm_mul_ps(psz, sz), sz);
+
+            // Position: parent orientation * (parent scale * local) + parent position
+            vx = _mm_mul_ps(psx, vx);
+            vy = _mm_mul_ps(psy, vy);
+            vz = _mm_mul_ps(psz, vz);
+            // uv = qvec x v
+            __m128 uvx = _mm_sub_ps(_mm_mul_ps(py, vz), _mm_mul_ps(pz, vy));
+            __m128 uvy = _mm_sub_ps(_mm_mul_ps(pz, vx), _mm_mul_ps(px, vz));
+            __m128 uvz = _mm_sub_ps(_mm_mul_ps(px, vy), _mm_mul_ps(py, vx));
+            // uuv = qvec x uv
+            __m128 uuvx = _mm_sub_ps(_mm_mul_ps(py, uvz), _mm_mul_ps(pz, uvy));
+            __m128 uuvy = _mm_sub_ps(_mm_mul_ps(pz, uvx), _mm_mul_ps(px, uvz));
+            __m128 uuvz = _mm_sub_ps(_mm_mul_ps(px, uvy), _mm_mul_ps(py, uvx));
+            __m128 w2 = _mm_mul_ps(two, pw);
+            uvx = _mm_mul_ps(uvx, w2);
+            uvy = _mm_mul_ps(uvy, w2);
+            uvz = _mm_mul_ps(uvz, w2);
+            uuvx = _mm_mul_ps(uuvx, two);
+            uuvy = _mm_mul_ps(uuvy, two);
+            uuvz = _mm_mul_ps(uuvz, two);
+            vx = _mm_add_ps(_mm_add_ps(_mm_add_ps(vx, uvx), uuvx), _mm_load_ps(parent.posX + i));
+            vy = _mm_add_ps(_mm_add_ps(_mm_add_ps(vy, uvy), uuvy), _mm_load_ps(parent.posY + i));
+            vz = _mm_add_ps(_mm_add_ps(_mm_add_ps(vz, uvz), uuvz), _mm_load_ps(parent.posZ + i));
+
+            _mm_store_ps(derived.rotW + i, rw);
+            _mm_store_ps(derived.rotX + i, rx);
+            _mm_store_ps(derived.rotY + i, ry);
+            _mm_store_ps(derived.rotZ + i, rz);
+            _mm_store_ps(derived.scaleX + i, rsx);
+            _mm_store_ps(derived.scaleY + i, rsy);
+            _mm_store_ps(derived.scaleZ + i, rsz);
+            _mm_store_ps(derived.posX + i, vx);
+            _mm_store_ps(derived.posY + i, vy);
+            _mm_store_ps(derived.posZ + i, vz);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* centreX,
+        const Real* centreY,
+        const Real* centreZ,
+        const Real* halfSizeX,
+        const Real* halfSizeY,
+        const Real* halfSizeZ,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        assert(_isAlignedForSSE(centreX) && _isAlignedForSSE(centreY) && _isAlignedForSSE(centreZ) &&
+            _isAlignedForSSE(halfSizeX) && _isAlignedForSSE(halfSizeY) && _isAlignedForSSE(halfSizeZ));
+
+        memset(visibility, 0, sizeof(uint32) * ((numBoxes + 31) / 32));
+
+        const __m128 zero = _mm_setzero_ps();
+
+        // Four boxes per iteration, the arrays are padded to a multiple of four.
+        // The operations are ordered as in Plane::getSide so that the results
+        // match Frustum::isVisible.
+        for (size_t i = 0; i < numBoxes; i += 4)
+        {
+            __m128 cx = _mm_load_ps(centreX + i);
+            __m128 cy = _mm_load_ps(centreY + i);
+            __m128 cz = _mm_load_ps(centreZ + i);
+            __m128 hx = _mm_load_ps(halfSizeX + i);
+            __m128 hy = _mm_load_ps(halfSizeY + i);
+            __m128 hz = _mm_load_ps(halfSizeZ + i);
+
+            __m128 culled = zero;
+            for (size_t plane = 0; plane < numPlanes; ++plane)
+            {
+                const Plane& p = planes[plane];
+                __m128 nx = _mm_set_ps1(p.normal.x);
+                __m128 ny = _mm_set_ps1(p.normal.y);
+                __m128 nz = _mm_set_ps1(p.normal.z);
+
+                // Distance between the box centres and the plane
+                __m128 dist = _mm_add_ps(__MM_DOT3x3_PS(nx, ny, nz, cx, cy, cz), _mm_set_ps1(p.d));
+
+                // Maximum absolute distance allowed for each box
+                __m128 ax = _mm_mul_ps(nx, hx);
+                __m128 ay = _mm_mul_ps(ny, hy);
+                __m128 az = _mm_mul_ps(nz, hz);
+                __m128 maxAbsDist = __MM_ACCUM3_PS(
+                    _mm_max_ps(ax, _mm_sub_ps(zero, ax)),
+                    _mm_max_ps(ay, _mm_sub_ps(zero, ay)),
+                    _mm_max_ps(az, _mm_sub_ps(zero, az)));
+
+                culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, _mm_sub_ps(zero, maxAbsDist)));
+            }
+
+            uint32 visible = ~_mm_movemask_ps(culled) & 0xF;
+            visibility[i >> 5] |= visible << (i & 31);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::softwareVertexPoseBlend(
+        const Real* weights,
+        const uint32* const* indices,
+        const float* const* offsets,
+        const size_t* numOffsets,
+        size_t numPoses,
+        float* dstPtr,
+        size_t dstStride)
+    {
+        for (size_t pose = 0; pose < numPoses; ++pose)
+        {
+            const __m128 weight = _mm_set_ps1(weights[pose]);
+            const uint32* pIndex = indices[pose];
+            const float* pOffset = offsets[pose];
+            size_t count = numOffsets[pose];
+
+            // Two vertices per iteration, so that the loads of the second
+            // overlap the arithmetic of the first
+            size_t i = 0;
+            for (; i + 1 < count; i += 2, pOffset += 8)
+            {
+                float* pDst0 = rawOffsetPointer(dstPtr, pIndex[i] * dstStride);
+                float* pDst1 = rawOffsetPointer(dstPtr, pIndex[i + 1] * dstStride);
+
+                // Destination x, y, z into one register, w is zero as in the offsets
+                __m128 dst0 = _mm_movelh_ps(
+                    _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)pDst0), _mm_load_ss(pDst0 + 2));
+                __m128 dst1 = _mm_movelh_ps(
+                    _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)pDst1), _mm_load_ss(pDst1 + 2));
+                dst0 = _mm_add_ps(dst0, _mm_mul_ps(_mm_loadu_ps(pOffset), weight));
+                dst1 = _mm_add_ps(dst1, _mm_mul_ps(_mm_loadu_ps(pOffset + 4), weight));
+
+                _mm_storel_pi((__m64*)pDst0, dst0);
+                _mm_store_ss(pDst0 + 2, _mm_movehl_ps(dst0, dst0));
+                _mm_storel_pi((__m64*)pDst1, dst1);
+                _mm_store_ss(pDst1 + 2, _mm_movehl_ps(dst1, dst1));
+            }
+            if (i < count)
+            {
+                float* pDst = rawOffsetPointer(dstPtr, pIndex[i] * dstStride);
+                __m128 dst = _mm_movelh_ps(
+                    _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)pDst), _mm_load_ss(pDst + 2));
+                dst = _mm_add_ps(dst, _mm_mul_ps(_mm_loadu_ps(pOffset), weight));
+                _mm_storel_pi((__m64*)pDst, dst);
+                _mm_store_ss(pDst + 2, _mm_movehl_ps(dst, dst));
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::softwareVertexDualQuaternionSkinning(
+        const float *pSrcPos,
+        float *pDestPos,
+        const float *pSrcNorm,
+        float *pDestNorm,
+        const float *pBlendWeight,
+        const unsigned char* pBlendIndex,
+        const DualQuaternion* const* blendDualQuaternions,
+        size_t srcPosStride,
+        size_t destPosStride,
+        size_t srcNormStride,
+        size_t destNormStride,
+        size_t blendWeightStride,
+        size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->softwareVertexDualQuaternionSkinning(
+            pSrcPos, pDestPos,
+            pSrcNorm, pDestNorm,
+            pBlendWeight, pBlendIndex,
+            blendDualQuaternions,
+            srcPosStride, destPosStride,
+            srcNormStride, destNormStride,
+            blendWeightStride, blendIndexStride,
+            numWeightsPerVertex,
+            numVertices);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void)
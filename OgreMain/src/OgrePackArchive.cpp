@@ -0,0 +1,470 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgrePackArchive.h"
+
+#include "OgreLogManager.h"
+#include "OgreException.h"
+#include "OgreStringVector.h"
+#include "OgreStringConverter.h"
+
+#include <sys/stat.h>
+
+namespace Ogre {
+
+	static const char PACK_MAGIC[8] = { 'O', 'G', 'R', 'E', 'P', 'A', 'C', 'K' };
+	//-----------------------------------------------------------------------
+	/// Reads little endian values whatever the platform and alignment
+	static inline uint16 readPackUInt16(const uchar* p)
+	{
+		return static_cast<uint16>(p[0] | (p[1] << 8));
+	}
+	static inline uint32 readPackUInt32(const uchar* p)
+	{
+		return static_cast<uint32>(p[0]) | (static_cast<uint32>(p[1]) << 8) |
+			(static_cast<uint32>(p[2]) << 16) | (static_cast<uint32>(p[3]) << 24);
+	}
+	static inline uint64 readPackUInt64(const uchar* p)
+	{
+		return static_cast<uint64>(readPackUInt32(p)) |
+			(static_cast<uint64>(readPackUInt32(p + 4)) << 32);
+	}
+	//-----------------------------------------------------------------------
+	/// Lower case conversion used to sort the index, independent of the locale
+	static inline uchar packToLower(uchar c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<uchar>(c + ('a' - 'A')) : c;
+	}
+	//-----------------------------------------------------------------------
+	/** Stream on a stored file, pointing into the pack data.
+	@remarks
+		Holds a reference to the pack data so that the mapping outlives the
+		archive being unloaded while the stream is in use.
+	*/
+	class PackDataStream : public MemoryDataStream
+	{
+	protected:
+		MemoryDataStreamPtr mPackData;
+	public:
+		PackDataStream(const String& name, const MemoryDataStreamPtr& packData,
+			uchar* data, size_t size)
+			: MemoryDataStream(name, data, size, false, true), mPackData(packData)
+		{
+		}
+	};
+	//-----------------------------------------------------------------------
+	PackArchive::PackArchive(const String& name, const String& archType)
+		: Archive(name, archType), mRecords(0), mNames(0), mNumRecords(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	PackArchive::~PackArchive()
+	{
+		unload();
+	}
+	//-----------------------------------------------------------------------
+	void PackArchive::load()
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		if (!mData.isNull())
+			return;
+
+		if (MMapDataStream::isSupported())
+		{
+			mData.bind(OGRE_NEW MMapDataStream(mName, mName));
+		}
+		else
+		{
+			std::ifstream* file = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)();
+			file->open(mName.c_str(), std::ios::in | std::ios::binary);
+			if (file->fail())
+			{
+				OGRE_DELETE_T(file, basic_ifstream, MEMCATEGORY_GENERAL);
+				OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+					"Cannot open file: " + mName, "PackArchive::load");
+			}
+			DataStreamPtr fileStream(OGRE_NEW FileStreamDataStream(mName, file, true));
+			mData.bind(OGRE_NEW MemoryDataStream(fileStream, true, true));
+		}
+
+		// Check the header and index once, so that open can trust them
+		const uchar* data = mData->getPtr();
+		uint64 size = mData->size();
+		bool valid = size >= HEADER_SIZE && memcmp(data, PACK_MAGIC, sizeof(PACK_MAGIC)) == 0;
+		if (valid && readPackUInt32(data + 8) != PACK_VERSION)
+		{
+			uint32 version = readPackUInt32(data + 8);
+			unload();
+			OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+				mName + " - unsupported pack version " + StringConverter::toString(version),
+				"PackArchive::load");
+		}
+
+		uint64 numRecords = 0, indexSize = 0, indexOffset = 0;
+		if (valid)
+		{
+			numRecords = readPackUInt32(data + 16);
+			indexSize = readPackUInt32(data + 20);
+			indexOffset = readPackUInt64(data + 24);
+			valid = indexOffset <= size && indexSize <= size - indexOffset &&
+				numRecords * RECORD_SIZE <= indexSize;
+		}
+
+		mNumRecords = static_cast<size_t>(numRecords);
+		mRecords = data + indexOffset;
+		mNames = mRecords + mNumRecords * RECORD_SIZE;
+		uint64 namesSize = indexSize - numRecords * RECORD_SIZE;
+
+		set<String>::type dirs;
+		mFileList.reserve(mNumRecords);
+		for (size_t i = 0; valid && i < mNumRecords; ++i)
+		{
+			const uchar* record = getRecord(i);
+			uint64 offset = readPackUInt64(record);
+			uint64 compressedSize = readPackUInt32(record + 8);
+			uint32 nameOffset = readPackUInt32(record + 16);
+			uint16 nameLength = readPackUInt16(record + 20);
+			if (offset > size || compressedSize > size - offset ||
+				nameOffset > namesSize || nameLength > namesSize - nameOffset)
+			{
+				valid = false;
+				break;
+			}
+
+			FileInfo info;
+			info.archive = this;
+			info.filename.assign(reinterpret_cast<const char*>(mNames + nameOffset), nameLength);
+			StringUtil::splitFilename(info.filename, info.basename, info.path);
+			info.compressedSize = static_cast<size_t>(compressedSize);
+			info.uncompressedSize = readPackUInt32(record + 12);
+			mFileList.push_back(info);
+
+			// Folders are not stored, list every parent of the files
+			for (String::size_type slash = info.path.find('/'); slash != String::npos;
+				slash = info.path.find('/', slash + 1))
+			{
+				String dir = info.path.substr(0, slash);
+				if (dirs.insert(dir).second)
+				{
+					FileInfo dirInfo;
+					dirInfo.archive = this;
+					dirInfo.filename = dir;
+					StringUtil::splitFilename(dir, dirInfo.basename, dirInfo.path);
+					dirInfo.compressedSize = 0;
+					dirInfo.uncompressedSize = 0;
+					mDirList.push_back(dirInfo);
+				}
+			}
+		}
+
+		if (!valid)
+		{
+			unload();
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				mName + " - error whilst opening archive: Corrupted pack.",
+				"PackArchive::load");
+		}
+	}
+	//-----------------------------------------------------------------------
+	void PackArchive::unload()
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		// Streams on stored files keep their own reference to the data
+		mData.setNull();
+		mRecords = mNames = 0;
+		mNumRecords = 0;
+		mFileList.clear();
+		mDirList.clear();
+	}
+	//-----------------------------------------------------------------------
+	size_t PackArchive::findRecord(const String& filename) const
+	{
+		String key = filename;
+		for (String::iterator i = key.begin(); i != key.end(); ++i)
+			*i = (*i == '\\') ? '/' : static_cast<char>(packToLower(static_cast<uchar>(*i)));
+
+		// The index is sorted by lower case name
+		size_t first = 0, last = mNumRecords;
+		while (first < last)
+		{
+			size_t middle = first + (last - first) / 2;
+			const uchar* record = getRecord(middle);
+			const uchar* name = mNames + readPackUInt32(record + 16);
+			size_t nameLength = readPackUInt16(record + 20);
+
+			int cmp = 0;
+			size_t length = std::min(nameLength, key.length());
+			for (size_t c = 0; c < length && cmp == 0; ++c)
+				cmp = static_cast<int>(packToLower(name[c])) - static_cast<uchar>(key[c]);
+			if (cmp == 0)
+				cmp = nameLength < key.length() ? -1 : (nameLength > key.length() ? 1 : 0);
+
+			if (cmp == 0)
+				return middle;
+			else if (cmp < 0)
+				first = middle + 1;
+			else
+				last = middle;
+		}
+		return static_cast<size_t>(-1);
+	}
+	//-----------------------------------------------------------------------
+	DataStreamPtr PackArchive::open(const String& filename, bool readOnly) const
+	{
+		MemoryDataStreamPtr data;
+		uint64 offset;
+		size_t compressedSize, uncompressedSize;
+		uchar method;
+		{
+			OGRE_LOCK_AUTO_MUTEX;
+			size_t index = findRecord(filename);
+			if (index == static_cast<size_t>(-1))
+			{
+				LogManager::getSingleton().logMessage(
+					mName + " - Unable to open file " + filename + ", error was 'File not found.'", LML_CRITICAL);
+				return DataStreamPtr();
+			}
+			const uchar* record = getRecord(index);
+			offset = readPackUInt64(record);
+			compressedSize = readPackUInt32(record + 8);
+			uncompressedSize = readPackUInt32(record + 12);
+			method = record[22];
+			data = mData;
+		}
+
+		// Decompress without the lock so that other threads can open files
+		uchar* fileData = data->getPtr() + offset;
+		if (method == PC_STORED)
+		{
+			if (compressedSize != uncompressedSize)
+			{
+				OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+					mName + " - error whilst opening " + filename + ": Corrupted pack.",
+					"PackArchive::open");
+			}
+			return DataStreamPtr(OGRE_NEW PackDataStream(filename, data, fileData, uncompressedSize));
+		}
+		else if (method != PC_LZ4)
+		{
+			OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+				mName + " - error whilst opening " + filename + ": Unsupported compression format.",
+				"PackArchive::open");
+		}
+
+		if (uncompressedSize == 0)
+			return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, 0, 0, false, true));
+
+		uchar* buffer = OGRE_ALLOC_T(uchar, uncompressedSize, MEMCATEGORY_GENERAL);
+		if (!decompressLZ4(fileData, compressedSize, buffer, uncompressedSize))
+		{
+			OGRE_FREE(buffer, MEMCATEGORY_GENERAL);
+			OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+				mName + " - error whilst opening " + filename + ": Corrupted pack.",
+				"PackArchive::open");
+		}
+
+		return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, buffer, uncompressedSize, true, true));
+	}
+	//---------------------------------------------------------------------
+	DataStreamPtr PackArchive::create(const String& filename) const
+	{
+		OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED,
+			"Modification of packs is not supported",
+			"PackArchive::create");
+	}
+	//---------------------------------------------------------------------
+	void PackArchive::remove(const String& filename) const
+	{
+	}
+	//-----------------------------------------------------------------------
+	StringVectorPtr PackArchive::list(bool recursive, bool dirs)
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+
+		const FileInfoList& infos = dirs ? mDirList : mFileList;
+		for (FileInfoList::const_iterator i = infos.begin(); i != infos.end(); ++i)
+			if (recursive || i->path.empty())
+				ret->push_back(i->filename);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	FileInfoListPtr PackArchive::listFileInfo(bool recursive, bool dirs)
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+
+		const FileInfoList& infos = dirs ? mDirList : mFileList;
+		for (FileInfoList::const_iterator i = infos.begin(); i != infos.end(); ++i)
+			if (recursive || i->path.empty())
+				ret->push_back(*i);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	StringVectorPtr PackArchive::find(const String& pattern, bool recursive, bool dirs)
+	{
+		FileInfoListPtr infos = findFileInfo(pattern, recursive, dirs);
+		StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		ret->reserve(infos->size());
+		for (FileInfoList::const_iterator i = infos->begin(); i != infos->end(); ++i)
+			ret->push_back(i->filename);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	FileInfoListPtr PackArchive::findFileInfo(const String& pattern,
+		bool recursive, bool dirs) const
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		// If pattern contains a directory name, do a full match
+		bool fullMatch = (pattern.find('/') != String::npos) ||
+			(pattern.find('\\') != String::npos);
+
+		// A full file name is looked up in the index
+		if (!dirs && fullMatch && pattern.find('*') == String::npos)
+		{
+			size_t index = findRecord(pattern);
+			if (index != static_cast<size_t>(-1))
+				ret->push_back(mFileList[index]);
+			return ret;
+		}
+
+		const FileInfoList& infos = dirs ? mDirList : mFileList;
+		for (FileInfoList::const_iterator i = infos.begin(); i != infos.end(); ++i)
+			if ((recursive || fullMatch || i->path.empty()) &&
+				StringUtil::match(fullMatch ? i->filename : i->basename, pattern, false))
+				ret->push_back(*i);
+
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	bool PackArchive::exists(const String& filename)
+	{
+		OGRE_LOCK_AUTO_MUTEX;
+		return findRecord(filename) != static_cast<size_t>(-1);
+	}
+	//---------------------------------------------------------------------
+	time_t PackArchive::getModifiedTime(const String& filename)
+	{
+		// Files have no time stamp, use the modification time of the pack
+		struct stat tagStat;
+		if (stat(mName.c_str(), &tagStat) == 0)
+			return tagStat.st_mtime;
+		else
+			return 0;
+	}
+	//-----------------------------------------------------------------------
+	bool PackArchive::decompressLZ4(const uchar* src, size_t srcSize, uchar* dest, size_t destSize)
+	{
+		// Sequences of a token, literal length, literals, match offset and
+		// match length; the last sequence only has literals
+		const uchar* ip = src;
+		const uchar* const ipEnd = src + srcSize;
+		uchar* op = dest;
+		uchar* const opEnd = dest + destSize;
+
+		while (ip < ipEnd)
+		{
+			uint token = *ip++;
+
+			size_t literalLength = token >> 4;
+			if (literalLength == 15)
+			{
+				uchar extra;
+				do
+				{
+					if (ip == ipEnd)
+						return false;
+					extra = *ip++;
+					literalLength += extra;
+				} while (extra == 255);
+			}
+			if (literalLength > static_cast<size_t>(ipEnd - ip) ||
+				literalLength > static_cast<size_t>(opEnd - op))
+				return false;
+			memcpy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+
+			if (ip == ipEnd)
+				break;
+
+			if (ipEnd - ip < 2)
+				return false;
+			size_t offset = readPackUInt16(ip);
+			ip += 2;
+			if (offset == 0 || offset > static_cast<size_t>(op - dest))
+				return false;
+
+			size_t matchLength = token & 15;
+			if (matchLength == 15)
+			{
+				uchar extra;
+				do
+				{
+					if (ip == ipEnd)
+						return false;
+					extra = *ip++;
+					matchLength += extra;
+				} while (extra == 255);
+			}
+			matchLength += 4;
+			if (matchLength > static_cast<size_t>(opEnd - op))
+				return false;
+
+			const uchar* match = op - offset;
+			if (offset >= matchLength)
+			{
+				memcpy(op, match, matchLength);
+				op += matchLength;
+			}
+			else
+			{
+				// Overlapping match repeating the last offset bytes
+				for (size_t i = 0; i < matchLength; ++i)
+					*op++ = *match++;
+			}
+		}
+
+		return op == opEnd;
+	}
+	//-----------------------------------------------------------------------
+	//-----------------------------------------------------------------------
+	//  PackArchiveFactory
+	//-----------------------------------------------------------------------
+	//-----------------------------------------------------------------------
+	const String& PackArchiveFactory::getType(void) const
+	{
+		static String name = "Pack";
+		return name;
+	}
+}
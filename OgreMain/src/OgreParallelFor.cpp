@@ -0,0 +1,215 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreParallelFor.h"
+#include "OgreWorkQueue.h"
+#include "OgreRoot.h"
+#include "OgreAtomicScalar.h"
+#include "OgreException.h"
+
+namespace Ogre
+{
+#if OGRE_THREAD_SUPPORT
+	/// State shared by the threads taking part in one ParallelFor::run
+	struct ParallelForState : public UtilityAlloc
+	{
+		ParallelForTask* task;
+		size_t count;
+		size_t chunkSize;
+		size_t numChunks;
+		AtomicScalar<size_t> nextChunk;
+		AtomicScalar<size_t> chunksDone;
+		/// First exception thrown by the task, if any
+		Exception* error;
+		/// Code of the derived type of error, to rethrow the same type
+		Exception::ExceptionCodes errorCode;
+		OGRE_MUTEX(errorMutex);
+
+		ParallelForState(ParallelForTask* t, size_t c, size_t size)
+			: task(t), count(c), chunkSize(size), numChunks((c + size - 1) / size),
+			nextChunk(0), chunksDone(0), error(0), errorCode(Exception::ERR_INTERNAL_ERROR)
+		{
+		}
+
+		~ParallelForState()
+		{
+			if (error)
+				OGRE_DELETE_T(error, Exception, MEMCATEGORY_GENERAL);
+		}
+
+		void setError(const Exception& e, Exception::ExceptionCodes code)
+		{
+			OGRE_LOCK_MUTEX(errorMutex);
+			if (!error)
+			{
+				error = OGRE_NEW_T(Exception, MEMCATEGORY_GENERAL)(e);
+				errorCode = code;
+			}
+		}
+
+		/// Finds the code ExceptionFactory maps to the type of an exception
+		static Exception::ExceptionCodes getExceptionCode(const Exception& e)
+		{
+			if (dynamic_cast<const IOException*>(&e))
+				return Exception::ERR_CANNOT_WRITE_TO_FILE;
+			if (dynamic_cast<const InvalidStateException*>(&e))
+				return Exception::ERR_INVALID_STATE;
+			if (dynamic_cast<const InvalidParametersException*>(&e))
+				return Exception::ERR_INVALIDPARAMS;
+			if (dynamic_cast<const RenderingAPIException*>(&e))
+				return Exception::ERR_RENDERINGAPI_ERROR;
+			if (dynamic_cast<const ItemIdentityException*>(&e))
+				return Exception::ERR_ITEM_NOT_FOUND;
+			if (dynamic_cast<const FileNotFoundException*>(&e))
+				return Exception::ERR_FILE_NOT_FOUND;
+			if (dynamic_cast<const RuntimeAssertionException*>(&e))
+				return Exception::ERR_RT_ASSERTION_FAILED;
+			if (dynamic_cast<const UnimplementedException*>(&e))
+				return Exception::ERR_NOT_IMPLEMENTED;
+			return Exception::ERR_INTERNAL_ERROR;
+		}
+
+		/// Claim and process chunks until there are none left to claim
+		void process()
+		{
+			size_t done = 0;
+			for (size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+			{
+				size_t begin = chunk * chunkSize;
+				size_t end = std::min(count, begin + chunkSize);
+				try
+				{
+					task->execute(begin, end);
+				}
+				catch (Exception& e)
+				{
+					setError(e, getExceptionCode(e));
+				}
+				catch (std::exception& e)
+				{
+					setError(Exception(Exception::ERR_INTERNAL_ERROR, e.what(), "ParallelFor::run"),
+						Exception::ERR_INTERNAL_ERROR);
+				}
+				catch (...)
+				{
+					// The chunk must still count as done or run never returns
+					setError(Exception(Exception::ERR_INTERNAL_ERROR, "Unknown exception", "ParallelFor::run"),
+						Exception::ERR_INTERNAL_ERROR);
+				}
+				++done;
+			}
+			if (done)
+				chunksDone += done;
+		}
+	};
+	typedef SharedPtr<ParallelForState> ParallelForStatePtr;
+
+	/// Request data, keeps the state alive for workers which start late
+	struct ParallelForRequest
+	{
+		ParallelForStatePtr state;
+
+		friend std::ostream& operator<<(std::ostream& o, const ParallelForRequest& r)
+		{ (void)r; return o; }
+	};
+
+	/// Picks up the requests issued by ParallelFor::run on the worker threads
+	class ParallelForRequestHandler : public WorkQueue::RequestHandler
+	{
+	public:
+		WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+		{
+			ParallelForRequest request = any_cast<ParallelForRequest>(req->getData());
+			request.state->process();
+			// ParallelFor::run waits on the state, not on a response: none is
+			// queued, so no request piles up while the main thread is blocked
+			req->abortRequest();
+			return 0;
+		}
+	};
+	static ParallelForRequestHandler gParallelForRequestHandler;
+#endif
+	//---------------------------------------------------------------------
+	size_t ParallelFor::getThreadCount(void)
+	{
+#if OGRE_THREAD_SUPPORT
+		Root* root = Root::getSingletonPtr();
+		if (root)
+		{
+			DefaultWorkQueueBase* queue = dynamic_cast<DefaultWorkQueueBase*>(root->getWorkQueue());
+			if (queue && !queue->isShuttingDown() && !queue->isPaused() && queue->getRequestsAccepted())
+				return queue->getWorkerThreadCount() + 1;
+		}
+#endif
+		return 1;
+	}
+	//---------------------------------------------------------------------
+	void ParallelFor::run(ParallelForTask* task, size_t count, size_t minChunkSize)
+	{
+		if (!count)
+			return;
+
+#if OGRE_THREAD_SUPPORT
+		size_t threads = getThreadCount();
+		if (threads > 1 && count > minChunkSize)
+		{
+			// Several chunks per thread so that uneven items balance out
+			size_t chunkSize = std::max(std::max(minChunkSize, (size_t)1),
+				(count + threads * 4 - 1) / (threads * 4));
+			ParallelForStatePtr state(OGRE_NEW ParallelForState(task, count, chunkSize));
+
+			WorkQueue* queue = Root::getSingleton().getWorkQueue();
+			uint16 channel = queue->getChannel("Ogre/ParallelFor");
+			// Duplicates are ignored, this also covers a work queue replaced through Root
+			queue->addRequestHandler(channel, &gParallelForRequestHandler);
+
+			ParallelForRequest request;
+			request.state = state;
+			size_t numRequests = std::min(threads - 1, state->numChunks - 1);
+			for (size_t i = 0; i < numRequests; ++i)
+				queue->addRequest(channel, 0, Any(request));
+
+			state->process();
+
+			// Everything is claimed, wait for chunks still running on workers
+			while (state->chunksDone.get() < state->numChunks)
+				OGRE_THREAD_YIELD;
+
+			if (state->error)
+			{
+				// Rethrow the derived type the task threw, e.g. FileNotFoundException
+				const Exception& e = *state->error;
+				ExceptionFactory::throwException(state->errorCode, e.getNumber(),
+					e.getDescription(), e.getSource(), e.getFile().c_str(), e.getLine());
+			}
+			return;
+		}
+#endif
+		task->execute(0, count);
+	}
+}
@@ -152,11 +152,20 @@ namespace Ogre {
     }
 
     //---------------------------------------------------------------------
-    // Performs CPUID instruction with 'query', fill the results, and return value of eax.
-    static uint _performCpuid(int query, CpuidResult& result)
+    // Performs CPUID instruction with 'query' (and 'subquery' in ecx, for the
+    // leaves which have sub-leaves), fill the results, and return value of eax.
+    static uint _performCpuid(int query, CpuidResult& result, int subquery = 0)
     {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
-	#if _MSC_VER >= 1400 
+	#if _MSC_VER >= 1500
+		int CPUInfo[4];
+		__cpuidex(CPUInfo, query, subquery);
+		result._eax = CPUInfo[0];
+		result._ebx = CPUInfo[1];
+		result._ecx = CPUInfo[2];
+		result._edx = CPUInfo[3];
+		return result._eax;
+	#elif _MSC_VER >= 1400 
 		int CPUInfo[4];
 		__cpuid(CPUInfo, query);
 		result._eax = CPUInfo[0];
@@ -169,6 +178,7 @@ namespace Ogre {
         {
             mov     edi, result
             mov     eax, query
+            mov     ecx, subquery
             cpuid
             mov     [edi]._eax, eax
             mov     [edi]._ebx, ebx
@@ -181,7 +191,7 @@ namespace Ogre {
         #if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (subquery)
         );
         #else
         __asm__
@@ -191,7 +201,7 @@ namespace Ogre {
             "movl   %%ebx, %%edi    \n\t"
             "popl   %%ebx           \n\t"
             : "=a" (result._eax), "=D" (result._ebx), "=c" (result._ecx), "=d" (result._edx)
-            : "a" (query)
+            : "a" (query), "c" (subquery)
         );
        #endif // OGRE_ARCHITECTURE_64
         return result._eax;
@@ -206,6 +216,25 @@ namespace Ogre {
 #pragma warning(pop)
 #endif
 
+    //---------------------------------------------------------------------
+    // Returns the low 32 bits of the extended control register 0, which tells
+    // which register states the operating system saves on context switches.
+    // Must only be called when CPUID reports OSXSAVE.
+    static uint _performXgetbv(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC && _MSC_VER >= 1600
+        return static_cast<uint>(_xgetbv(0));
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_NACL
+        uint eax, edx;
+        // xgetbv, spelled out for assemblers which do not know it
+        __asm__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+        return eax;
+#else
+        // Cannot tell, assume the AVX state is not saved
+        return 0;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Detect whether or not os support Streaming SIMD Extension.
 #if (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_NACL
@@ -293,6 +322,12 @@ namespace Ogre {
 #define CPUID_STD_HTT               (1<<28)     // EDX[28] - Bit 28 set indicates  Hyper-Threading Technology is supported in hardware.
 
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0] - Bit 0 of standard function 1 indicate SSE3 supported
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - Bit 12 of standard function 1 indicate FMA3 supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate XGETBV is enabled by the OS
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+#define CPUID_STD7_AVX2             (1<<5)      // EBX[5] - Bit 5 of standard function 7 indicate AVX2 supported
+
+#define XCR0_SSE_AVX_STATE          0x6         // Bits 1 and 2 of XCR0, the OS saves the XMM and YMM registers
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -383,6 +418,25 @@ namespace Ogre {
                             features |= PlatformInformation::CPU_FEATURE_MMXEXT;
                     }
                 }
+
+                // AVX, AVX2 and FMA are detected the same way for all vendors.
+                // Their registers are only usable if the OS saves them.
+                uint maxQuery = _performCpuid(0, result);
+                _performCpuid(1, result);
+                if ((result._ecx & CPUID_STD_OSXSAVE) && (result._ecx & CPUID_STD_AVX) &&
+                    (_performXgetbv() & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE)
+                {
+                    features |= PlatformInformation::CPU_FEATURE_AVX;
+                    if (result._ecx & CPUID_STD_FMA)
+                        features |= PlatformInformation::CPU_FEATURE_FMA;
+
+                    if (maxQuery >= 7)
+                    {
+                        _performCpuid(7, result, 0);
+                        if (result._ebx & CPUID_STD7_AVX2)
+                            features |= PlatformInformation::CPU_FEATURE_AVX2;
+                    }
+                }
             }
         }
 
@@ -394,7 +448,9 @@ namespace Ogre {
         uint features = queryCpuFeatures();
 
         const uint sse_features = PlatformInformation::CPU_FEATURE_SSE |
-            PlatformInformation::CPU_FEATURE_SSE2 | PlatformInformation::CPU_FEATURE_SSE3;
+            PlatformInformation::CPU_FEATURE_SSE2 | PlatformInformation::CPU_FEATURE_SSE3 |
+            PlatformInformation::CPU_FEATURE_AVX | PlatformInformation::CPU_FEATURE_AVX2 |
+            PlatformInformation::CPU_FEATURE_FMA;
         if ((features & sse_features) && !_checkOperatingSystemSupportSSE())
         {
             features &= ~sse_features;
@@ -654,6 +710,12 @@ namespace Ogre {
 				" *     SSE2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE2), true));
 			pLog->logMessage(
 				" *     SSE3: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE3), true));
+			pLog->logMessage(
+				" *      AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+			pLog->logMessage(
+				" *     AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+			pLog->logMessage(
+				" *      FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
 			pLog->logMessage(
 				" *      MMX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_MMX), true));
 			pLog->logMessage(
@@ -32,7 +32,7 @@ THE SOFTWARE.
 namespace Ogre {
 	//---------------------------------------------------------------------
 	Pose::Pose(ushort target, const String& name)
-		: mTarget(target), mName(name)
+		: mTarget(target), mName(name), mPackedDirty(true)
 	{
 	}
 	//---------------------------------------------------------------------
@@ -54,6 +54,7 @@ namespace Ogre {
 
         mVertexOffsetMap[index] = offset;
 		mBuffer.setNull();
+		mPackedDirty = true;
 	}
 	//---------------------------------------------------------------------
 	void Pose::addVertex(size_t index, const Vector3& offset, const Vector3& normal)
@@ -71,6 +72,7 @@ namespace Ogre {
         mVertexOffsetMap[index] = offset;
 		mNormalsMap[index] = normal;
 		mBuffer.setNull();
+		mPackedDirty = true;
 	}
 	//---------------------------------------------------------------------
 	void Pose::removeVertex(size_t index)
@@ -80,6 +82,7 @@ namespace Ogre {
 		{
 			mVertexOffsetMap.erase(i);
 			mBuffer.setNull();
+			mPackedDirty = true;
 		}
 		NormalsMap::iterator j = mNormalsMap.find(index);
 		if (j != mNormalsMap.end())
@@ -93,6 +96,7 @@ namespace Ogre {
 		mVertexOffsetMap.clear();
 		mNormalsMap.clear();
 		mBuffer.setNull();
+		mPackedDirty = true;
 	}
 	//---------------------------------------------------------------------
 	Pose::ConstVertexOffsetIterator 
@@ -104,6 +108,8 @@ namespace Ogre {
 	Pose::VertexOffsetIterator 
 		Pose::getVertexOffsetIterator(void)
 	{
+		// The offsets may be modified through the iterator
+		mPackedDirty = true;
 		return VertexOffsetIterator(mVertexOffsetMap.begin(), mVertexOffsetMap.end());
 	}
 	//---------------------------------------------------------------------
@@ -114,6 +120,7 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	Pose::NormalsIterator Pose::getNormalsIterator(void)
 	{
+		mPackedDirty = true;
 		return NormalsIterator(mNormalsMap.begin(), mNormalsMap.end());
 	}
 	//---------------------------------------------------------------------
@@ -191,6 +198,60 @@ namespace Ogre {
 		return mBuffer;
 	}
 	//---------------------------------------------------------------------
+	const vector<uint32>::type& Pose::_getPackedIndices(void) const
+	{
+		updatePackedData();
+		return mPackedIndices;
+	}
+	//---------------------------------------------------------------------
+	const vector<float>::type& Pose::_getPackedVertexOffsets(void) const
+	{
+		updatePackedData();
+		return mPackedVertexOffsets;
+	}
+	//---------------------------------------------------------------------
+	const vector<float>::type& Pose::_getPackedNormals(void) const
+	{
+		updatePackedData();
+		return mPackedNormals;
+	}
+	//---------------------------------------------------------------------
+	void Pose::updatePackedData(void) const
+	{
+		if (!mPackedDirty)
+			return;
+
+		mPackedIndices.clear();
+		mPackedVertexOffsets.clear();
+		mPackedNormals.clear();
+		mPackedIndices.reserve(mVertexOffsetMap.size());
+		mPackedVertexOffsets.reserve(mVertexOffsetMap.size() * 4);
+		for (VertexOffsetMap::const_iterator i = mVertexOffsetMap.begin();
+			i != mVertexOffsetMap.end(); ++i)
+		{
+			mPackedIndices.push_back(static_cast<uint32>(i->first));
+			mPackedVertexOffsets.push_back(i->second.x);
+			mPackedVertexOffsets.push_back(i->second.y);
+			mPackedVertexOffsets.push_back(i->second.z);
+			mPackedVertexOffsets.push_back(0.0f);
+		}
+
+		// Normals are always added along with offsets, so the maps share keys
+		if (!mNormalsMap.empty())
+		{
+			mPackedNormals.reserve(mNormalsMap.size() * 4);
+			for (NormalsMap::const_iterator i = mNormalsMap.begin();
+				i != mNormalsMap.end(); ++i)
+			{
+				mPackedNormals.push_back(i->second.x);
+				mPackedNormals.push_back(i->second.y);
+				mPackedNormals.push_back(i->second.z);
+				mPackedNormals.push_back(0.0f);
+			}
+		}
+		mPackedDirty = false;
+	}
+	//---------------------------------------------------------------------
 	Pose* Pose::clone(void) const
 	{
 		Pose* newPose = OGRE_NEW Pose(mTarget, mName);
@@ -315,8 +315,9 @@ namespace Ogre {
             i->second->clear();
         }
 
-		// Clear sorted list
+		// Clear sorted lists
 		mSortedDescending.clear();
+		mSortKeyed.clear();
 	}
     //-----------------------------------------------------------------------
 	void QueuedRenderableCollection::removePassGroup(Pass* p)
@@ -386,9 +387,102 @@ namespace Ogre {
 			}
 		}
 
+		if ((mOrganisationMode & OM_SORT_KEY) && !mSortKeyed.empty())
+		{
+			SuppressCameraUpdate suppressCameraUpdate(const_cast<Camera*>(cam));
+			sortByKey(cam);
+		}
+
 		// Nothing needs to be done for pass groups, they auto-organise
 
     }
+    //-----------------------------------------------------------------------
+	void QueuedRenderableCollection::sortByKey(const Camera* cam)
+	{
+		size_t count = mSortKeyed.size();
+		SortKeyEntryList::iterator i, iend = mSortKeyed.end();
+
+		// Rank the distinct passes in hash order, pointer breaking ties, so
+		// that the key holds a compact pass id instead of the hash and the
+		// pointer. Consecutive items usually share their pass.
+		mSortKeyPasses.clear();
+		mSortKeyPassRanks.clear();
+		const Pass* lastPass = 0;
+		for (i = mSortKeyed.begin(); i != iend; ++i)
+		{
+			if (i->pass != lastPass)
+			{
+				lastPass = i->pass;
+				if (mSortKeyPassRanks.insert(PassRankMap::value_type(lastPass, 0)).second)
+					mSortKeyPasses.push_back(i->pass);
+			}
+		}
+		std::sort(mSortKeyPasses.begin(), mSortKeyPasses.end(), PassGroupLess());
+		size_t numPasses = mSortKeyPasses.size();
+		for (size_t r = 0; r < numPasses; ++r)
+			mSortKeyPassRanks[mSortKeyPasses[r]] = static_cast<uint32>(r);
+
+		// Bytes sorted on, least significant first: the 4 of the depth, then
+		// only those of the rank which can be non zero
+		int numBytes = 5;
+		while (numBytes < 8 && (numPasses - 1) >> ((numBytes - 4) * 8))
+			++numBytes;
+
+		// Build the keys and the histograms of their bytes in the same loop
+		size_t counters[8][256];
+		memset(counters, 0, sizeof(counters));
+		lastPass = 0;
+		uint64 rank = 0;
+		for (i = mSortKeyed.begin(); i != iend; ++i)
+		{
+			if (i->pass != lastPass)
+			{
+				lastPass = i->pass;
+				rank = static_cast<uint64>(mSortKeyPassRanks[lastPass]) << 32;
+			}
+
+			// The bits of a positive float order the same way as its value
+			union { float f; uint32 u; } depth;
+			depth.f = static_cast<float>(i->renderable->getSquaredViewDepth(cam));
+			if (!(depth.f > 0))
+				depth.f = 0;
+
+			uint64 key = rank | depth.u;
+			i->key = key;
+			for (int b = 0; b < numBytes; ++b)
+				++counters[b][(key >> (b * 8)) & 0xFF];
+		}
+
+		// Least significant byte first, this is stable so items with the 
+		// same key keep the order in which they were added
+		mSortKeyedScratch.resize(count, SortKeyEntry(0, 0, 0));
+		SortKeyEntryList* src = &mSortKeyed;
+		SortKeyEntryList* dest = &mSortKeyedScratch;
+		for (int b = 0; b < numBytes; ++b)
+		{
+			int shift = b * 8;
+			const size_t* counter = counters[b];
+
+			// Bytes shared by all the keys don't change the order
+			if (counter[(src->front().key >> shift) & 0xFF] == count)
+				continue;
+
+			size_t offsets[256];
+			offsets[0] = 0;
+			for (int d = 1; d < 256; ++d)
+				offsets[d] = offsets[d - 1] + counter[d - 1];
+
+			SortKeyEntryList::const_iterator s, send = src->end();
+			for (s = src->begin(); s != send; ++s)
+				(*dest)[offsets[(s->key >> shift) & 0xFF]++] = *s;
+
+			std::swap(src, dest);
+		}
+
+		// Leave the result in mSortKeyed, swapping only exchanges the storage
+		if (src != &mSortKeyed)
+			mSortKeyed.swap(mSortKeyedScratch);
+	}
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::addRenderable(Pass* pass, Renderable* rend)
 	{
@@ -398,6 +492,12 @@ namespace Ogre {
 			mSortedDescending.push_back(RenderablePass(rend, pass));
 		}
 
+		if (mOrganisationMode & OM_SORT_KEY)
+		{
+			// The key is only built once all the passes are known, see sortByKey
+			mSortKeyed.push_back(SortKeyEntry(0, rend, pass));
+		}
+
 		if (mOrganisationMode & OM_PASS_GROUP)
 		{
             PassGroupRenderableMap::iterator i = mGrouped.find(pass);
@@ -430,6 +530,8 @@ namespace Ogre {
 			// try to fall back
 			if (OM_PASS_GROUP & mOrganisationMode)
 				om = OM_PASS_GROUP;
+			else if (OM_SORT_KEY & mOrganisationMode)
+				om = OM_SORT_KEY;
 			else if (OM_SORT_ASCENDING & mOrganisationMode)
 				om = OM_SORT_ASCENDING;
 			else if (OM_SORT_DESCENDING & mOrganisationMode)
@@ -452,6 +554,9 @@ namespace Ogre {
 		case OM_SORT_ASCENDING:
 			acceptVisitorAscending(visitor);
 			break;
+		case OM_SORT_KEY:
+			acceptVisitorSortKey(visitor);
+			break;
 		}
 		
 	}
@@ -508,10 +613,33 @@ namespace Ogre {
 		}
 
 	}
+    //-----------------------------------------------------------------------
+	void QueuedRenderableCollection::acceptVisitorSortKey(
+		QueuedRenderableVisitor* visitor) const
+	{
+		// Items are ordered by pass, present them grouped by it
+		const Pass* currentPass = 0;
+		bool skip = false;
+		SortKeyEntryList::const_iterator i, iend;
+		iend = mSortKeyed.end();
+		for (i = mSortKeyed.begin(); i != iend; ++i)
+		{
+			if (i->pass != currentPass)
+			{
+				currentPass = i->pass;
+				// Visit Pass - allow skip
+				skip = !visitor->visit(currentPass);
+			}
+
+			if (!skip)
+				visitor->visit(i->renderable);
+		}
+	}
     //-----------------------------------------------------------------------
 	void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
 	{
 		mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
+		mSortKeyed.insert( mSortKeyed.end(), rhs.mSortKeyed.begin(), rhs.mSortKeyed.end() );
 
 		PassGroupRenderableMap::const_iterator srcGroup;
 		for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
@@ -0,0 +1,369 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreRenderStateCache.h"
+#include "OgreRenderSystem.h"
+#include "OgreTextureUnitState.h"
+
+namespace Ogre {
+
+	//-----------------------------------------------------------------------
+	RenderStateCache::RenderStateCache()
+		: mRenderSystem(0)
+		, mEnabled(false)
+		, mValidStates(0)
+		, mIssuedCount(0)
+		, mFilteredCount(0)
+		, mShininess(0)
+		, mTracking(TVC_NONE)
+		, mLightingEnabled(false)
+		, mFogMode(FOG_NONE)
+		, mFogDensity(0)
+		, mFogStart(0)
+		, mFogEnd(0)
+		, mSeparateBlending(false)
+		, mSourceBlendFactor(SBF_ONE)
+		, mDestBlendFactor(SBF_ZERO)
+		, mSourceBlendFactorAlpha(SBF_ONE)
+		, mDestBlendFactorAlpha(SBF_ZERO)
+		, mBlendOperation(SBO_ADD)
+		, mAlphaBlendOperation(SBO_ADD)
+		, mPointSize(0)
+		, mPointAttenuationEnabled(false)
+		, mPointAttenuationConstant(0)
+		, mPointAttenuationLinear(0)
+		, mPointAttenuationQuadratic(0)
+		, mPointMinSize(0)
+		, mPointMaxSize(0)
+		, mPointSpritesEnabled(false)
+		, mDisabledTextureUnitsFrom(OGRE_MAX_TEXTURE_LAYERS)
+		, mDepthFunction(CMPF_LESS_EQUAL)
+		, mDepthCheckEnabled(false)
+		, mDepthWriteEnabled(false)
+		, mDepthBiasConstant(0)
+		, mDepthBiasSlopeScale(0)
+		, mAlphaRejectFunction(CMPF_ALWAYS_PASS)
+		, mAlphaRejectValue(0)
+		, mAlphaToCoverage(false)
+		, mCullingMode(CULL_CLOCKWISE)
+		, mShadingType(SO_GOURAUD)
+		, mPolygonMode(PM_SOLID)
+	{
+		mColourWrite[0] = mColourWrite[1] = mColourWrite[2] = mColourWrite[3] = true;
+		invalidate();
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setRenderSystem(RenderSystem* rs)
+	{
+		mRenderSystem = rs;
+		invalidate();
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setEnabled(bool enabled)
+	{
+		mEnabled = enabled;
+		invalidate();
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::invalidate(uint32 states)
+	{
+		mValidStates &= ~states;
+
+		// Texture units are tracked one by one, a null entry is unknown
+		if (states & CS_TEXTURE_UNITS)
+		{
+			for (size_t i = 0; i < OGRE_MAX_TEXTURE_LAYERS; ++i)
+			{
+				mTextureUnits[i] = 0;
+				mTextures[i] = 0;
+			}
+			mDisabledTextureUnitsFrom = OGRE_MAX_TEXTURE_LAYERS;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::invalidateTextureUnit(size_t texUnit)
+	{
+		if (texUnit < OGRE_MAX_TEXTURE_LAYERS)
+		{
+			mTextureUnits[texUnit] = 0;
+			mTextures[texUnit] = 0;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::resetStatistics(void)
+	{
+		mIssuedCount = 0;
+		mFilteredCount = 0;
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setSurfaceParams(const ColourValue& ambient,
+		const ColourValue& diffuse, const ColourValue& specular,
+		const ColourValue& emissive, Real shininess,
+		TrackVertexColourType tracking)
+	{
+		if (!mustIssue(CS_SURFACE, ambient == mAmbient && diffuse == mDiffuse &&
+			specular == mSpecular && emissive == mEmissive &&
+			shininess == mShininess && tracking == mTracking))
+			return;
+
+		mAmbient = ambient;
+		mDiffuse = diffuse;
+		mSpecular = specular;
+		mEmissive = emissive;
+		mShininess = shininess;
+		mTracking = tracking;
+		mRenderSystem->_setSurfaceParams(ambient, diffuse, specular, emissive, shininess, tracking);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setLightingEnabled(bool enabled)
+	{
+		if (!mustIssue(CS_LIGHTING, enabled == mLightingEnabled))
+			return;
+
+		mLightingEnabled = enabled;
+		mRenderSystem->setLightingEnabled(enabled);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setFog(FogMode mode, const ColourValue& colour, Real expDensity,
+		Real linearStart, Real linearEnd)
+	{
+		if (!mustIssue(CS_FOG, mode == mFogMode && colour == mFogColour &&
+			expDensity == mFogDensity && linearStart == mFogStart && linearEnd == mFogEnd))
+			return;
+
+		mFogMode = mode;
+		mFogColour = colour;
+		mFogDensity = expDensity;
+		mFogStart = linearStart;
+		mFogEnd = linearEnd;
+		mRenderSystem->_setFog(mode, colour, expDensity, linearStart, linearEnd);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setSceneBlending(SceneBlendFactor sourceFactor,
+		SceneBlendFactor destFactor, SceneBlendOperation op)
+	{
+		if (!mustIssue(CS_BLENDING, !mSeparateBlending &&
+			sourceFactor == mSourceBlendFactor && destFactor == mDestBlendFactor &&
+			op == mBlendOperation))
+			return;
+
+		mSeparateBlending = false;
+		mSourceBlendFactor = mSourceBlendFactorAlpha = sourceFactor;
+		mDestBlendFactor = mDestBlendFactorAlpha = destFactor;
+		mBlendOperation = mAlphaBlendOperation = op;
+		mRenderSystem->_setSceneBlending(sourceFactor, destFactor, op);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setSeparateSceneBlending(SceneBlendFactor sourceFactor,
+		SceneBlendFactor destFactor, SceneBlendFactor sourceFactorAlpha,
+		SceneBlendFactor destFactorAlpha, SceneBlendOperation op, SceneBlendOperation alphaOp)
+	{
+		if (!mustIssue(CS_BLENDING, mSeparateBlending &&
+			sourceFactor == mSourceBlendFactor && destFactor == mDestBlendFactor &&
+			sourceFactorAlpha == mSourceBlendFactorAlpha && destFactorAlpha == mDestBlendFactorAlpha &&
+			op == mBlendOperation && alphaOp == mAlphaBlendOperation))
+			return;
+
+		mSeparateBlending = true;
+		mSourceBlendFactor = sourceFactor;
+		mDestBlendFactor = destFactor;
+		mSourceBlendFactorAlpha = sourceFactorAlpha;
+		mDestBlendFactorAlpha = destFactorAlpha;
+		mBlendOperation = op;
+		mAlphaBlendOperation = alphaOp;
+		mRenderSystem->_setSeparateSceneBlending(sourceFactor, destFactor,
+			sourceFactorAlpha, destFactorAlpha, op, alphaOp);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setPointParameters(Real size, bool attenuationEnabled,
+		Real constant, Real linear, Real quadratic, Real minSize, Real maxSize)
+	{
+		if (!mustIssue(CS_POINT_PARAMETERS, size == mPointSize &&
+			attenuationEnabled == mPointAttenuationEnabled &&
+			constant == mPointAttenuationConstant && linear == mPointAttenuationLinear &&
+			quadratic == mPointAttenuationQuadratic &&
+			minSize == mPointMinSize && maxSize == mPointMaxSize))
+			return;
+
+		mPointSize = size;
+		mPointAttenuationEnabled = attenuationEnabled;
+		mPointAttenuationConstant = constant;
+		mPointAttenuationLinear = linear;
+		mPointAttenuationQuadratic = quadratic;
+		mPointMinSize = minSize;
+		mPointMaxSize = maxSize;
+		mRenderSystem->_setPointParameters(size, attenuationEnabled,
+			constant, linear, quadratic, minSize, maxSize);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setPointSpritesEnabled(bool enabled)
+	{
+		if (!mustIssue(CS_POINT_SPRITES, enabled == mPointSpritesEnabled))
+			return;
+
+		mPointSpritesEnabled = enabled;
+		mRenderSystem->_setPointSpritesEnabled(enabled);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setTextureUnitSettings(size_t texUnit, TextureUnitState& tl)
+	{
+		const Texture* tex = tl._getTexturePtr().get();
+		bool unchanged = texUnit < OGRE_MAX_TEXTURE_LAYERS &&
+			mTextureUnits[texUnit] == &tl && mTextures[texUnit] == tex;
+		if (!mustIssue(0, unchanged))
+			return;
+
+		if (texUnit < OGRE_MAX_TEXTURE_LAYERS)
+		{
+			mTextureUnits[texUnit] = &tl;
+			mTextures[texUnit] = tex;
+			if (texUnit >= mDisabledTextureUnitsFrom)
+				mDisabledTextureUnitsFrom = texUnit + 1;
+		}
+		mRenderSystem->_setTextureUnitSettings(texUnit, tl);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::disableTextureUnitsFrom(size_t texUnit)
+	{
+		if (!mustIssue(0, texUnit >= mDisabledTextureUnitsFrom))
+			return;
+
+		for (size_t i = texUnit; i < OGRE_MAX_TEXTURE_LAYERS; ++i)
+		{
+			mTextureUnits[i] = 0;
+			mTextures[i] = 0;
+		}
+		mDisabledTextureUnitsFrom = texUnit;
+		mRenderSystem->_disableTextureUnitsFrom(texUnit);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setDepthBufferParams(bool depthTest, bool depthWrite,
+		CompareFunction depthFunction)
+	{
+		if (!mustIssue(CS_DEPTH_CHECK | CS_DEPTH_WRITE | CS_DEPTH_FUNCTION,
+			depthTest == mDepthCheckEnabled && depthWrite == mDepthWriteEnabled &&
+			depthFunction == mDepthFunction))
+			return;
+
+		mDepthCheckEnabled = depthTest;
+		mDepthWriteEnabled = depthWrite;
+		mDepthFunction = depthFunction;
+		mRenderSystem->_setDepthBufferParams(depthTest, depthWrite, depthFunction);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setDepthBufferFunction(CompareFunction func)
+	{
+		if (!mustIssue(CS_DEPTH_FUNCTION, func == mDepthFunction))
+			return;
+
+		mDepthFunction = func;
+		mRenderSystem->_setDepthBufferFunction(func);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setDepthBufferCheckEnabled(bool enabled)
+	{
+		if (!mustIssue(CS_DEPTH_CHECK, enabled == mDepthCheckEnabled))
+			return;
+
+		mDepthCheckEnabled = enabled;
+		mRenderSystem->_setDepthBufferCheckEnabled(enabled);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setDepthBufferWriteEnabled(bool enabled)
+	{
+		if (!mustIssue(CS_DEPTH_WRITE, enabled == mDepthWriteEnabled))
+			return;
+
+		mDepthWriteEnabled = enabled;
+		mRenderSystem->_setDepthBufferWriteEnabled(enabled);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setDepthBias(float constantBias, float slopeScaleBias)
+	{
+		if (!mustIssue(CS_DEPTH_BIAS, constantBias == mDepthBiasConstant &&
+			slopeScaleBias == mDepthBiasSlopeScale))
+			return;
+
+		mDepthBiasConstant = constantBias;
+		mDepthBiasSlopeScale = slopeScaleBias;
+		mRenderSystem->_setDepthBias(constantBias, slopeScaleBias);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setAlphaRejectSettings(CompareFunction func,
+		unsigned char value, bool alphaToCoverage)
+	{
+		if (!mustIssue(CS_ALPHA_REJECT, func == mAlphaRejectFunction &&
+			value == mAlphaRejectValue && alphaToCoverage == mAlphaToCoverage))
+			return;
+
+		mAlphaRejectFunction = func;
+		mAlphaRejectValue = value;
+		mAlphaToCoverage = alphaToCoverage;
+		mRenderSystem->_setAlphaRejectSettings(func, value, alphaToCoverage);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
+	{
+		if (!mustIssue(CS_COLOUR_WRITE, red == mColourWrite[0] && green == mColourWrite[1] &&
+			blue == mColourWrite[2] && alpha == mColourWrite[3]))
+			return;
+
+		mColourWrite[0] = red;
+		mColourWrite[1] = green;
+		mColourWrite[2] = blue;
+		mColourWrite[3] = alpha;
+		mRenderSystem->_setColourBufferWriteEnabled(red, green, blue, alpha);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setCullingMode(CullingMode mode)
+	{
+		if (!mustIssue(CS_CULLING, mode == mCullingMode))
+			return;
+
+		mCullingMode = mode;
+		mRenderSystem->_setCullingMode(mode);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setShadingType(ShadeOptions so)
+	{
+		if (!mustIssue(CS_SHADING, so == mShadingType))
+			return;
+
+		mShadingType = so;
+		mRenderSystem->setShadingType(so);
+	}
+	//-----------------------------------------------------------------------
+	void RenderStateCache::setPolygonMode(PolygonMode mode)
+	{
+		if (!mustIssue(CS_POLYGON_MODE, mode == mPolygonMode))
+			return;
+
+		mPolygonMode = mode;
+		mRenderSystem->_setPolygonMode(mode);
+	}
+}
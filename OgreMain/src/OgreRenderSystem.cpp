@@ -62,6 +62,8 @@ namespace Ogre {
         , mBatchCount(0)
         , mFaceCount(0)
         , mVertexCount(0)
+        , mGpuProgramParameterBytes(0)
+        , mLastFrameGpuProgramParameterBytes(0)
         , mInvertVertexWinding(false)
         , mDisabledTexUnitsFrom(0)
         , mCurrentPassIterationCount(0)
@@ -125,7 +127,63 @@ namespace Ogre {
 			if( itarg->second->isActive() && itarg->second->isAutoUpdated())
 				itarg->second->update(swapBuffers);
 		}
+
+		// A frame is complete
+		mLastFrameGpuProgramParameterBytes = mGpuProgramParameterBytes;
+		mGpuProgramParameterBytes = 0;
     }
+    //-----------------------------------------------------------------------
+	size_t RenderSystem::calculateGpuProgramParameterBytes(const GpuProgramParametersSharedPtr& params,
+		uint16 variabilityMask, bool onlyChanged) const
+	{
+		size_t bytes = 0;
+
+		if (params->hasNamedParameters())
+		{
+			const GpuNamedConstants& defs = params->getConstantDefinitions();
+			for (GpuConstantDefinitionMap::const_iterator i = defs.map.begin();
+				i != defs.map.end(); ++i)
+			{
+				const GpuConstantDefinition& def = i->second;
+				bool upload = onlyChanged ? params->_isUploadRequired(def, variabilityMask) :
+					(def.variability & variabilityMask) != 0;
+				if (upload)
+					bytes += def.elementSize * def.arraySize *
+						(def.isFloat() ? sizeof(float) : def.isDouble() ? sizeof(double) : sizeof(int));
+			}
+		}
+		else
+		{
+			const GpuLogicalBufferStructPtr& floatStruct = params->getFloatLogicalBufferStruct();
+			if (!floatStruct.isNull())
+			{
+				OGRE_LOCK_MUTEX(floatStruct->mutex);
+				for (GpuLogicalIndexUseMap::const_iterator i = floatStruct->map.begin();
+					i != floatStruct->map.end(); ++i)
+				{
+					bool upload = onlyChanged ? params->_isFloatUploadRequired(i->second, variabilityMask) :
+						(i->second.variability & variabilityMask) != 0;
+					if (upload)
+						bytes += i->second.currentSize * sizeof(float);
+				}
+			}
+			const GpuLogicalBufferStructPtr& intStruct = params->getIntLogicalBufferStruct();
+			if (!intStruct.isNull())
+			{
+				OGRE_LOCK_MUTEX(intStruct->mutex);
+				for (GpuLogicalIndexUseMap::const_iterator i = intStruct->map.begin();
+					i != intStruct->map.end(); ++i)
+				{
+					bool upload = onlyChanged ? params->_isIntUploadRequired(i->second, variabilityMask) :
+						(i->second.variability & variabilityMask) != 0;
+					if (upload)
+						bytes += i->second.currentSize * sizeof(int);
+				}
+			}
+		}
+
+		return bytes;
+	}
     //-----------------------------------------------------------------------
     void RenderSystem::_swapAllRenderTargetBuffers()
     {
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreScriptLoader.h"
 #include "OgreSceneManager.h"
+#include "OgreParallelFor.h"
 
 namespace Ogre {
 
@@ -53,9 +54,50 @@ namespace Ogre {
 	// RGM has one (this one) and RM has 2 (by name and by handle)
 	size_t ResourceGroupManager::RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS = 3;
     //-----------------------------------------------------------------------
+	/// Prepares a list of resources on the threads of the WorkQueue
+	class ResourcePrepareTask : public ParallelForTask
+	{
+	public:
+		typedef vector<ResourcePtr>::type ResourceList;
+
+		ResourcePrepareTask(const ResourceList& resources)
+			: mResources(resources)
+		{
+		}
+
+		void execute(size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				try
+				{
+					mResources[i]->prepare(true);
+				}
+				// Left unloaded, the error will be raised again when loading it
+				catch (Exception& e)
+				{
+					logFailure(mResources[i], e.getDescription());
+				}
+				catch (std::exception& e)
+				{
+					logFailure(mResources[i], e.what());
+				}
+			}
+		}
+
+	private:
+		const ResourceList& mResources;
+
+		static void logFailure(const ResourcePtr& resource, const String& description)
+		{
+			LogManager::getSingleton().stream()
+				<< "Failed to prepare resource " << resource->getName()
+				<< " concurrently: " << description;
+		}
+	};
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), OGRE_THREAD_POINTER_INIT(mCurrentContext)
+        : mLoadingListener(0), mParallelPrepare(false), OGRE_THREAD_POINTER_INIT(mCurrentContext)
     {
 		OGRE_THREAD_POINTER_SET(mCurrentContext, OGRE_NEW ThreadContext());
 
@@ -290,6 +332,14 @@ namespace Ogre {
     void ResourceGroupManager::loadResourceGroup(const String& name, 
 		bool loadMainResources, bool loadWorldGeom)
     {
+		// Done before locking anything, the preparing threads need the locks
+		if (loadMainResources && mParallelPrepare)
+		{
+			StringVector names;
+			names.push_back(name);
+			prepareResourceGroupsParallel(names);
+		}
+
 		// Can only bulk-load one group at a time (reasonable limitation I think)
         OGRE_LOCK_AUTO_MUTEX;
 
@@ -386,6 +436,48 @@ namespace Ogre {
 		
 		LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
+    //-----------------------------------------------------------------------
+	void ResourceGroupManager::prepareResourceGroupsParallel(const StringVector& names)
+	{
+		ResourcePrepareTask::ResourceList resources;
+		{
+			OGRE_LOCK_AUTO_MUTEX;
+			for (StringVector::const_iterator n = names.begin(); n != names.end(); ++n)
+			{
+				ResourceGroupPtr grp = getResourceGroup(*n);
+				if (grp.isNull())
+				{
+					OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+						"Cannot find a group named " + *n, 
+						"ResourceGroupManager::prepareResourceGroupsParallel");
+				}
+
+				OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+				for (ResourceGroup::LoadResourceOrderMap::iterator oi = grp->loadResourceOrderMap.begin(); 
+					oi != grp->loadResourceOrderMap.end(); ++oi)
+				{
+					for (LoadUnloadResourceList::iterator l = oi->second->begin();
+						l != oi->second->end(); ++l)
+					{
+						const ResourcePtr& res = *l;
+						if (!res->isManuallyLoaded() &&
+							res->getLoadingState() == Resource::LOADSTATE_UNLOADED)
+						{
+							resources.push_back(res);
+						}
+					}
+				}
+			}
+		}
+
+		LogManager::getSingleton().stream()
+			<< "Preparing " << resources.size() << " resources on "
+			<< ParallelFor::getThreadCount() << " threads";
+
+		// Unlocked, the resources open their files through this manager
+		ResourcePrepareTask task(resources);
+		ParallelFor::run(&task, resources.size());
+	}
     //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
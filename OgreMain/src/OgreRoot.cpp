@@ -52,6 +52,7 @@ THE SOFTWARE.
 #include "OgreArchiveManager.h"
 #include "OgrePlugin.h"
 #include "OgreFileSystem.h"
+#include "OgrePackArchive.h"
 #include "OgreShadowVolumeExtrudeProgram.h"
 #include "OgreResourceBackgroundQueue.h"
 #include "OgreEntity.h"
@@ -74,6 +75,7 @@ THE SOFTWARE.
 #endif
 #if OGRE_NO_ZIP_ARCHIVE == 0
 #include "OgreZip.h"
+#include "OgreMappedZip.h"
 #endif
 
 #include "OgreHardwareBufferManager.h"
@@ -221,11 +223,15 @@ namespace Ogre {
 
         mFileSystemArchiveFactory = OGRE_NEW FileSystemArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mFileSystemArchiveFactory );
+        mPackArchiveFactory = OGRE_NEW PackArchiveFactory();
+        ArchiveManager::getSingleton().addArchiveFactory( mPackArchiveFactory );
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         mZipArchiveFactory = OGRE_NEW ZipArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory );
         mEmbeddedZipArchiveFactory = OGRE_NEW EmbeddedZipArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mEmbeddedZipArchiveFactory );
+        mMappedZipArchiveFactory = OGRE_NEW MappedZipArchiveFactory();
+        ArchiveManager::getSingleton().addArchiveFactory( mMappedZipArchiveFactory );
 #   endif
 
 #if OGRE_NO_DDS_CODEC == 0
@@ -320,8 +326,10 @@ namespace Ogre {
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         OGRE_DELETE mZipArchiveFactory;
         OGRE_DELETE mEmbeddedZipArchiveFactory;
+        OGRE_DELETE mMappedZipArchiveFactory;
 #   endif
         OGRE_DELETE mFileSystemArchiveFactory;
+        OGRE_DELETE mPackArchiveFactory;
 
         OGRE_DELETE mSkeletonManager;
         OGRE_DELETE mMeshManager;
@@ -224,6 +224,10 @@ namespace Ogre {
 #define __MM_MADD_PS(a, b, c)                                                       \
     _mm_add_ps(_mm_mul_ps(a, b), c)
 
+/// Per component select: a where the mask bits are set, b elsewhere
+#define __MM_SELECT_MASK_PS(mask, a, b)                                             \
+    _mm_or_ps(_mm_and_ps((mask), (a)), _mm_andnot_ps((mask), (b)))
+
 /// Linear interpolation
 #define __MM_LERP_PS(t, a, b)                                                       \
     __MM_MADD_PS(_mm_sub_ps(b, a), t, a)
@@ -71,9 +71,14 @@ THE SOFTWARE.
 #include "OgreCompositorChain.h"
 #include "OgreInstanceBatch.h"
 #include "OgreInstancedEntity.h"
+#include "OgreParallelFor.h"
+#include "OgreNodeTransformPool.h"
+#include "OgreSoftwareVertexBlendBatch.h"
+#include "OgreSkeletonPoseBatch.h"
 // This class implements the most basic scene manager
 
 #include <cstdio>
+#include <typeinfo>
 
 namespace Ogre {
 
@@ -151,6 +156,18 @@ mShadowTextureCustomCasterPass(0),
 mShadowTextureCustomReceiverPass(0),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mParallelSceneGraphUpdate(false),
+mBatchedSceneGraphUpdate(false),
+mNodeTransformPool(0),
+mIncrementalSceneGraphUpdate(false),
+mDirtySceneNodesComplete(false),
+mParallelFrustumCulling(false),
+mFrustumCullingSplitDepth(1),
+mBatchedSoftwareSkinning(false),
+mCollectingSoftwareSkinning(false),
+mSoftwareVertexBlendBatch(0),
+mBatchedSkeletonAnimation(false),
+mParallelAnimationUpdate(false),
 mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
@@ -218,6 +235,119 @@ SceneManager::~SceneManager()
     OGRE_DELETE mShadowCasterAABBQuery;
     OGRE_DELETE mRenderQueue;
 	OGRE_DELETE mAutoParamDataSource;
+	OGRE_DELETE mNodeTransformPool;
+	OGRE_DELETE mSoftwareVertexBlendBatch;
+	for (SkeletonPoseBatchList::iterator i = mSkeletonPoseBatches.begin();
+		i != mSkeletonPoseBatches.end(); ++i)
+	{
+		OGRE_DELETE *i;
+	}
+}
+//-----------------------------------------------------------------------
+SoftwareVertexBlendBatch* SceneManager::_getSoftwareVertexBlendBatch(void)
+{
+	if (!mCollectingSoftwareSkinning)
+		return 0;
+
+	if (!mSoftwareVertexBlendBatch)
+		mSoftwareVertexBlendBatch = OGRE_NEW SoftwareVertexBlendBatch();
+	return mSoftwareVertexBlendBatch;
+}
+//-----------------------------------------------------------------------
+/// Evaluates the skeletons of a range of entities
+class SkeletonUpdateTask : public ParallelForTask
+{
+public:
+	SkeletonUpdateTask(Entity* const* entities)
+		: mEntities(entities)
+	{
+	}
+
+	void execute(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			mEntities[i]->_evaluateBoneMatrices();
+		}
+	}
+
+private:
+	Entity* const* mEntities;
+};
+//-----------------------------------------------------------------------
+void SceneManager::updateSkeletonPoses(void)
+{
+	// Group the entities by skeleton, the batches of previous frames are
+	// reset rather than kept per skeleton since skeletons may be reloaded
+	typedef map<Skeleton*, SkeletonPoseBatch*>::type SkeletonPoseBatchMap;
+	SkeletonPoseBatchMap batches;
+	size_t numUsed = 0;
+	// Skeleton instances already collected, which may be shared by entities
+	set<SkeletonInstance*>::type instances;
+	// Animations played by the collected entities
+	set<Animation*>::type animations;
+	mSkeletonUpdateEntities.clear();
+
+	MovableObjectIterator it = getMovableObjectIterator(EntityFactory::FACTORY_TYPE_NAME);
+	while (it.hasMoreElements())
+	{
+		Entity* ent = static_cast<Entity*>(it.getNext());
+		if (!mBatchedSkeletonAnimation || !ent->_isSkeletonPoseBatchable())
+		{
+			if (mParallelAnimationUpdate && ent->_isBoneMatricesUpdatePending() &&
+				instances.insert(ent->getSkeleton()).second)
+			{
+				mSkeletonUpdateEntities.push_back(ent);
+
+				ConstEnabledAnimationStateIterator stateIt =
+					ent->getAllAnimationStates()->getEnabledAnimationStateIterator();
+				while (stateIt.hasMoreElements())
+				{
+					Animation* anim = ent->getSkeleton()->_getAnimationImpl(
+						stateIt.getNext()->getAnimationName());
+					if (anim)
+						animations.insert(anim);
+				}
+			}
+			continue;
+		}
+
+		Skeleton* skeleton = ent->getMesh()->getSkeleton().get();
+		SkeletonPoseBatchMap::iterator b = batches.find(skeleton);
+		if (b == batches.end())
+		{
+			if (numUsed == mSkeletonPoseBatches.size())
+				mSkeletonPoseBatches.push_back(OGRE_NEW SkeletonPoseBatch());
+			SkeletonPoseBatch* batch = mSkeletonPoseBatches[numUsed++];
+			batch->reset(skeleton);
+			b = batches.insert(SkeletonPoseBatchMap::value_type(skeleton, batch)).first;
+		}
+		ent->_addToSkeletonPoseBatch(b->second,
+			mSkeletonPoseCache.getEnabled() ? &mSkeletonPoseCache : 0);
+	}
+
+	try
+	{
+		for (size_t i = 0; i < numUsed; ++i)
+			mSkeletonPoseBatches[i]->evaluate(mParallelAnimationUpdate);
+	}
+	catch (...)
+	{
+		// The cache may hold poses the batches did not fill in
+		mSkeletonPoseCache.clear();
+		throw;
+	}
+
+	if (!mSkeletonUpdateEntities.empty())
+	{
+		// Build on this thread what the animations would build on demand
+		set<Animation*>::type::iterator a, aend = animations.end();
+		for (a = animations.begin(); a != aend; ++a)
+			(*a)->_prepareNodeTracks();
+
+		SkeletonUpdateTask task(&mSkeletonUpdateEntities[0]);
+		ParallelFor::run(&task, mSkeletonUpdateEntities.size());
+	}
 }
 //-----------------------------------------------------------------------
 RenderQueue* SceneManager::getRenderQueue(void)
@@ -1036,7 +1166,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			// Set surface reflectance properties, only valid if lighting is enabled
 			if (pass->getLightingEnabled())
 			{
-				mDestRenderSystem->_setSurfaceParams( 
+				mRenderStateCache.setSurfaceParams( 
 					pass->getAmbient(), 
 					pass->getDiffuse(), 
 					pass->getSpecular(), 
@@ -1046,7 +1176,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			}
 
 			// Dynamic lighting enabled?
-			mDestRenderSystem->setLightingEnabled(pass->getLightingEnabled());
+			mRenderStateCache.setLightingEnabled(pass->getLightingEnabled());
 		}
 
 		// Using a fragment program?
@@ -1099,7 +1229,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			fragment program, and in other ways, them maybe access by gpu program via
 			"state.fog.XXX".
 			*/
-	        mDestRenderSystem->_setFog(
+	        mRenderStateCache.setFog(
 		        newFogMode, newFogColour, newFogDensity, newFogStart, newFogEnd);
 		}
         // Tell params about ORIGINAL fog
@@ -1113,7 +1243,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 		// Set scene blending
 		if ( pass->hasSeparateSceneBlending( ) )
 		{
-			mDestRenderSystem->_setSeparateSceneBlending(
+			mRenderStateCache.setSeparateSceneBlending(
 				pass->getSourceBlendFactor(), pass->getDestBlendFactor(),
 				pass->getSourceBlendFactorAlpha(), pass->getDestBlendFactorAlpha(),
 				pass->getSceneBlendingOperation(), 
@@ -1123,14 +1253,14 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 		{
 			if(pass->hasSeparateSceneBlendingOperations( ) )
 			{
-				mDestRenderSystem->_setSeparateSceneBlending(
+				mRenderStateCache.setSeparateSceneBlending(
 					pass->getSourceBlendFactor(), pass->getDestBlendFactor(),
 					pass->getSourceBlendFactor(), pass->getDestBlendFactor(),
 					pass->getSceneBlendingOperation(), pass->getSceneBlendingOperationAlpha() );
 			}
 			else
 			{
-				mDestRenderSystem->_setSceneBlending(
+				mRenderStateCache.setSceneBlending(
 					pass->getSourceBlendFactor(), pass->getDestBlendFactor(), pass->getSceneBlendingOperation() );
 			}
 		}
@@ -1138,7 +1268,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 		// Set point parameters
 		if (mDestRenderSystem->getFixedPipelineEnabled())
 		{
-			mDestRenderSystem->_setPointParameters(
+			mRenderStateCache.setPointParameters(
 				pass->getPointSize(),
 				pass->isPointAttenuationEnabled(), 
 				pass->getPointAttenuationConstant(), 
@@ -1149,7 +1279,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 		}
 
 		if (mDestRenderSystem->getCapabilities()->hasCapability(RSC_POINT_SPRITES))
-			mDestRenderSystem->_setPointSpritesEnabled(pass->getPointSpritesEnabled());
+			mRenderStateCache.setPointSpritesEnabled(pass->getPointSpritesEnabled());
 
 		// Texture unit settings
 
@@ -1242,26 +1372,26 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 				}
 				pTex->_setTexturePtr(refTex);
 			}
-			mDestRenderSystem->_setTextureUnitSettings(unit, *pTex);
+			mRenderStateCache.setTextureUnitSettings(unit, *pTex);
 			++unit;
 		}
 		// Disable remaining texture units
-		mDestRenderSystem->_disableTextureUnitsFrom(pass->getNumTextureUnitStates());
+		mRenderStateCache.disableTextureUnitsFrom(pass->getNumTextureUnitStates());
 
 		// Set up non-texture related material settings
 		// Depth buffer settings
-		mDestRenderSystem->_setDepthBufferFunction(pass->getDepthFunction());
-		mDestRenderSystem->_setDepthBufferCheckEnabled(pass->getDepthCheckEnabled());
-		mDestRenderSystem->_setDepthBufferWriteEnabled(pass->getDepthWriteEnabled());
-		mDestRenderSystem->_setDepthBias(pass->getDepthBiasConstant(), 
+		mRenderStateCache.setDepthBufferFunction(pass->getDepthFunction());
+		mRenderStateCache.setDepthBufferCheckEnabled(pass->getDepthCheckEnabled());
+		mRenderStateCache.setDepthBufferWriteEnabled(pass->getDepthWriteEnabled());
+		mRenderStateCache.setDepthBias(pass->getDepthBiasConstant(), 
 			pass->getDepthBiasSlopeScale());
 		// Alpha-reject settings
-		mDestRenderSystem->_setAlphaRejectSettings(
+		mRenderStateCache.setAlphaRejectSettings(
 			pass->getAlphaRejectFunction(), pass->getAlphaRejectValue(), pass->isAlphaToCoverageEnabled());
 		// Set colour write mode
 		// Right now we only use on/off, not per-channel
 		bool colWrite = pass->getColourWriteEnabled();
-		mDestRenderSystem->_setColourBufferWriteEnabled(colWrite, colWrite, colWrite, colWrite);
+		mRenderStateCache.setColourBufferWriteEnabled(colWrite, colWrite, colWrite, colWrite);
 		// Culling mode
 		if (isShadowTechniqueTextureBased() 
 			&& mIlluminationStage == IRS_RENDER_TO_TEXTURE
@@ -1275,12 +1405,12 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 		{
 			mPassCullingMode = pass->getCullingMode();
 		}
-		mDestRenderSystem->_setCullingMode(mPassCullingMode);
+		mRenderStateCache.setCullingMode(mPassCullingMode);
 		
 		// Shading
-		mDestRenderSystem->setShadingType(pass->getShadingMode());
+		mRenderStateCache.setShadingType(pass->getShadingMode());
 		// Polygon mode
-		mDestRenderSystem->_setPolygonMode(pass->getPolygonMode());
+		mRenderStateCache.setPolygonMode(pass->getPolygonMode());
 
 		// set pass number
     	mAutoParamDataSource->setPassNumber( pass->getIndex() );
@@ -1400,7 +1530,8 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
     // Update the scene, only do this once per frame
     unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
-    if (thisFrameNumber != mLastFrameNumber)
+    bool firstRenderOfFrame = thisFrameNumber != mLastFrameNumber;
+    if (firstRenderOfFrame)
     {
         // Update animations
         _applySceneAnimations();
@@ -1428,6 +1559,13 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 			camera->_autoTrack();
 		}
 
+		// Evaluate skeletons once the nodes they are attached to are up to date
+		if (firstRenderOfFrame && (mBatchedSkeletonAnimation || mParallelAnimationUpdate))
+		{
+			OgreProfileGroup("updateSkeletonPoses", OGREPROF_GENERAL);
+			updateSkeletonPoses();
+		}
+
 		if (mIlluminationStage != IRS_RENDER_TO_TEXTURE && mFindVisibleObjects)
 		{
 			// Locate any lights which could be affecting the frustum
@@ -1520,8 +1658,27 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
 			// Parse the scene and tag visibles
 			firePreFindVisibleObjects(vp);
-			_findVisibleObjects(camera, &(camVisObjIt->second),
-				mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+			mCollectingSoftwareSkinning = mBatchedSoftwareSkinning;
+			try
+			{
+				_findVisibleObjects(camera, &(camVisObjIt->second),
+					mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+			}
+			catch (...)
+			{
+				// Don't leave entities queueing blends nobody will execute
+				mCollectingSoftwareSkinning = false;
+				if (mSoftwareVertexBlendBatch)
+					mSoftwareVertexBlendBatch->clear();
+				throw;
+			}
+			mCollectingSoftwareSkinning = false;
+			// Skin what was found visible before anyone reads the vertices
+			if (mSoftwareVertexBlendBatch && !mSoftwareVertexBlendBatch->empty())
+			{
+				OgreProfileGroup("softwareSkinning", OGREPROF_GENERAL);
+				mSoftwareVertexBlendBatch->execute(true);
+			}
 			firePostFindVisibleObjects(vp);
 
 			mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -1544,9 +1701,11 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 	}        
     // Begin the frame
     mDestRenderSystem->_beginFrame();
+	// Anything may have changed the render state since the last frame
+	mRenderStateCache.invalidate();
 
     // Set rasterisation mode
-    mDestRenderSystem->_setPolygonMode(camera->getPolygonMode());
+    mRenderStateCache.setPolygonMode(camera->getPolygonMode());
 
 	// Set initial camera state
 	mDestRenderSystem->_setProjectionMatrix(mCameraInProgress->getProjectionMatrixRS());
@@ -1571,6 +1730,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
     // End frame
     mDestRenderSystem->_endFrame();
+	mRenderStateCache.invalidate();
 
     // Notify camera of vis faces
     camera->_notifyRenderedFaces(mDestRenderSystem->_getFaceCount());
@@ -1587,6 +1747,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 void SceneManager::_setDestinationRenderSystem(RenderSystem* sys)
 {
     mDestRenderSystem = sys;
+	mRenderStateCache.setRenderSystem(sys);
 
 }
 
@@ -2242,20 +2403,361 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // In this implementation, just update from the root
     // Smarter SceneManager subclasses may choose to update only
     //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+	if (mIncrementalSceneGraphUpdate && isIncrementalSceneGraphUpdateSupported())
+	{
+		updateSceneGraphIncremental();
+	}
+	else if (mBatchedSceneGraphUpdate && isBatchedSceneGraphUpdateSupported())
+	{
+		updateSceneGraphBatched();
+	}
+	else if (mParallelSceneGraphUpdate && isParallelSceneGraphUpdateSupported() &&
+		ParallelFor::getThreadCount() > 1)
+	{
+		updateSceneGraphParallel();
+	}
+	else
+	{
+		getRootSceneNode()->_update(true, false);
+	}
 
 	firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+/// Updates a range of independent scene graph subtrees
+class SceneGraphUpdateTask : public ParallelForTask
+{
+public:
+	SceneGraphUpdateTask(const Node::PendingUpdate* subtrees)
+		: mSubtrees(subtrees)
+	{
+	}
+
+	void execute(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			mSubtrees[i].first->_update(true, mSubtrees[i].second);
+		}
+	}
+
+private:
+	const Node::PendingUpdate* mSubtrees;
+};
+//-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphParallel(void)
+{
+	// Expand the top of the hierarchy breadth first on this thread until
+	// there are enough independent subtrees to keep every thread busy
+	const size_t targetSubtrees = ParallelFor::getThreadCount() * 8;
+
+	mSceneGraphUpdateSplitNodes.clear();
+	mSceneGraphUpdateSubtrees.clear();
+	mSceneGraphUpdateSubtrees.push_back(Node::PendingUpdate(getRootSceneNode(), false));
+
+	size_t firstSubtree = 0;
+	while (firstSubtree < mSceneGraphUpdateSubtrees.size() &&
+		mSceneGraphUpdateSubtrees.size() - firstSubtree < targetSubtrees)
+	{
+		Node::PendingUpdate pending = mSceneGraphUpdateSubtrees[firstSubtree++];
+		pending.first->_updateAndCollectChildren(pending.second, mSceneGraphUpdateSubtrees);
+		mSceneGraphUpdateSplitNodes.push_back(static_cast<SceneNode*>(pending.first));
+	}
+
+	size_t numSubtrees = mSceneGraphUpdateSubtrees.size() - firstSubtree;
+	if (numSubtrees)
+	{
+		SceneGraphUpdateTask task(&mSceneGraphUpdateSubtrees[firstSubtree]);
+		ParallelFor::run(&task, numSubtrees);
+	}
+
+	// Bounds of the expanded nodes include their children, so go deepest first
+	vector<SceneNode*>::type::reverse_iterator i, iend;
+	iend = mSceneGraphUpdateSplitNodes.rend();
+	for (i = mSceneGraphUpdateSplitNodes.rbegin(); i != iend; ++i)
+	{
+		(*i)->_updateBounds();
+	}
+}
+//-----------------------------------------------------------------------
+/// Updates the bounds of a range of nodes of the same depth
+class SceneNodeBoundsTask : public ParallelForTask
+{
+public:
+	SceneNodeBoundsTask(Node* const* nodes)
+		: mNodes(nodes)
+	{
+	}
+
+	void execute(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			static_cast<SceneNode*>(mNodes[i])->_updateBounds();
+		}
+	}
+
+private:
+	Node* const* mNodes;
+};
+//-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphBatched(void)
+{
+	bool parallel = mParallelSceneGraphUpdate && isParallelSceneGraphUpdateSupported() &&
+		ParallelFor::getThreadCount() > 1;
+
+	if (!mNodeTransformPool)
+		mNodeTransformPool = OGRE_NEW NodeTransformPool();
+
+	mNodeTransformPool->update(getRootSceneNode(), false, parallel);
+
+	// Bounds include those of the children, so go deepest level first
+	const vector<Node*>::type& nodes = mNodeTransformPool->getVisitedNodes();
+	for (size_t level = mNodeTransformPool->getNumLevels(); level-- > 0; )
+	{
+		size_t begin = mNodeTransformPool->getLevelBegin(level);
+		size_t end = mNodeTransformPool->getLevelEnd(level);
+
+		SceneNodeBoundsTask task(&nodes[begin]);
+		if (parallel)
+			ParallelFor::run(&task, end - begin, 64);
+		else
+			task.execute(0, end - begin);
+	}
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphIncremental(void)
+{
+	if (!mDirtySceneNodesComplete)
+	{
+		// Nodes changed before the list was kept, update everything once
+		getRootSceneNode()->_update(true, false);
+		for (vector<SceneNode*>::type::iterator i = mDirtySceneNodes.begin();
+			i != mDirtySceneNodes.end(); ++i)
+		{
+			(*i)->_setInDirtyList(false);
+		}
+		mDirtySceneNodes.clear();
+		mDirtySceneNodesComplete = true;
+		return;
+	}
+
+	// Parents must be updated before their children, so go shallowest first
+	mDepthSortedSceneNodes.clear();
+	for (vector<SceneNode*>::type::iterator i = mDirtySceneNodes.begin();
+		i != mDirtySceneNodes.end(); ++i)
+	{
+		SceneNode* node = *i;
+		node->_setInDirtyList(false);
+		// Nodes outside the scene graph are marked dirty again when attached
+		if (!node->isInSceneGraph())
+			continue;
+
+		size_t depth = 0;
+		for (Node* parent = node->getParent(); parent; parent = parent->getParent())
+			++depth;
+		mDepthSortedSceneNodes.push_back(DepthSceneNode(depth, node));
+	}
+	mDirtySceneNodes.clear();
+	std::sort(mDepthSortedSceneNodes.begin(), mDepthSortedSceneNodes.end());
+
+	size_t numDirty = mDepthSortedSceneNodes.size();
+	for (size_t i = 0; i < numDirty; ++i)
+	{
+		SceneNode* node = mDepthSortedSceneNodes[i].second;
+		// Nodes below another dirty node have been updated along with it
+		if (!node->_isUpdatePending())
+			continue;
+
+		node->_update(true, false);
+
+		// The ancestors have not moved, but their bounds include this node.
+		// Those without pending requests were collected for a previous node.
+		size_t depth = mDepthSortedSceneNodes[i].first;
+		for (Node* parent = node->getParent(); parent && parent->_isUpdatePending();
+			parent = parent->getParent())
+		{
+			// Still go through Node::_update as the walk from the root does, so
+			// listeners are notified the same way, but skip its children and
+			// leave the bounds for below
+			parent->Node::_update(false, false);
+			parent->_clearChildUpdateRequests();
+			mDepthSortedSceneNodes.push_back(
+				DepthSceneNode(--depth, static_cast<SceneNode*>(parent)));
+		}
+	}
+
+	// Bounds include those of the children, so go deepest first
+	std::sort(mDepthSortedSceneNodes.begin() + numDirty, mDepthSortedSceneNodes.end());
+	for (size_t i = mDepthSortedSceneNodes.size(); i-- > numDirty; )
+	{
+		mDepthSortedSceneNodes[i].second->_updateBounds();
+	}
+}
+//-----------------------------------------------------------------------
+void SceneManager::setIncrementalSceneGraphUpdate(bool incremental)
+{
+	mIncrementalSceneGraphUpdate = incremental;
+	mDirtySceneNodesComplete = false;
+}
+//-----------------------------------------------------------------------
+void SceneManager::_notifySceneNodeDirty(SceneNode* node)
+{
+	node->_setInDirtyList(true, mDirtySceneNodes.size());
+	mDirtySceneNodes.push_back(node);
+}
+//-----------------------------------------------------------------------
+void SceneManager::_notifySceneNodeClean(SceneNode* node)
+{
+	if (node->_isInDirtyList())
+	{
+		// Order does not matter, erase by moving the last one in its place
+		size_t index = node->_getIndexInDirtyList();
+		assert(index < mDirtySceneNodes.size() && mDirtySceneNodes[index] == node);
+		SceneNode* last = mDirtySceneNodes.back();
+		mDirtySceneNodes[index] = last;
+		last->_setInDirtyList(true, index);
+		mDirtySceneNodes.pop_back();
+		node->_setInDirtyList(false);
+	}
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
 	Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+	// A root node of a derived type may override _findVisibleObjects
+	if (mParallelFrustumCulling && ParallelFor::getThreadCount() > 1 &&
+		typeid(*getRootSceneNode()) == typeid(SceneNode))
+	{
+		findVisibleObjectsParallel(cam, visibleBounds, onlyShadowCasters);
+		return;
+	}
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
 
 }
 //-----------------------------------------------------------------------
+/// Culls a range of independent scene graph subtrees
+class FrustumCullingTask : public ParallelForTask
+{
+public:
+	FrustumCullingTask(const Camera* cam, SceneNode* const* subtrees,
+		SceneNode::VisibleObjectEntryList* entries)
+		: mCamera(cam), mSubtrees(subtrees), mEntries(entries)
+	{
+	}
+
+	void execute(size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			mSubtrees[i]->_findVisibleObjectEntries(mCamera, mEntries[i]);
+		}
+	}
+
+private:
+	const Camera* mCamera;
+	SceneNode* const* mSubtrees;
+	SceneNode::VisibleObjectEntryList* mEntries;
+};
+//-----------------------------------------------------------------------
+void SceneManager::splitFrustumCulling(SceneNode* node, const Camera* cam, size_t depth)
+{
+	// Same traversal as SceneNode::_findVisibleObjectEntries, except that the
+	// children below the split depth are left for the worker threads
+	if (!cam->isVisible(node->_getWorldAABB()))
+		return;
+
+	SceneNode::ObjectIterator objIt = node->getAttachedObjectIterator();
+	while (objIt.hasMoreElements())
+	{
+		mFrustumCullingEntries.push_back(
+			SceneNode::VisibleObjectEntry(node, objIt.getNext()));
+	}
+
+	Node::ChildNodeIterator childIt = node->getChildIterator();
+	while (childIt.hasMoreElements())
+	{
+		SceneNode* child = static_cast<SceneNode*>(childIt.getNext());
+		if (typeid(*child) != typeid(SceneNode))
+		{
+			mFrustumCullingEntries.push_back(SceneNode::VisibleObjectEntry(child, 0, true));
+		}
+		else if (depth < mFrustumCullingSplitDepth)
+		{
+			splitFrustumCulling(child, cam, depth + 1);
+		}
+		else
+		{
+			mFrustumCullingSubtrees.push_back(child);
+			mFrustumCullingSubtreePositions.push_back(mFrustumCullingEntries.size());
+		}
+	}
+
+	mFrustumCullingEntries.push_back(SceneNode::VisibleObjectEntry(node, 0));
+}
+//-----------------------------------------------------------------------
+void SceneManager::findVisibleObjectsParallel(Camera* cam,
+	VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+	// Make the lazy update of the frustum planes here, so that the worker
+	// threads only ever read them
+	cam->getFrustumPlanes();
+	if (cam->getCullingFrustum())
+		cam->getCullingFrustum()->getFrustumPlanes();
+
+	mFrustumCullingEntries.clear();
+	mFrustumCullingSubtrees.clear();
+	mFrustumCullingSubtreePositions.clear();
+	splitFrustumCulling(getRootSceneNode(), cam, 1);
+
+	size_t numSubtrees = mFrustumCullingSubtrees.size();
+	if (mFrustumCullingSubtreeEntries.size() < numSubtrees)
+		mFrustumCullingSubtreeEntries.resize(numSubtrees);
+	for (size_t i = 0; i < numSubtrees; ++i)
+		mFrustumCullingSubtreeEntries[i].clear();
+
+	if (numSubtrees)
+	{
+		FrustumCullingTask task(cam, &mFrustumCullingSubtrees[0], &mFrustumCullingSubtreeEntries[0]);
+		ParallelFor::run(&task, numSubtrees);
+	}
+
+	// Merge in traversal order, so that the queue is filled exactly as by
+	// SceneNode::_findVisibleObjects
+	RenderQueue* queue = getRenderQueue();
+	size_t subtree = 0;
+	size_t numEntries = mFrustumCullingEntries.size();
+	for (size_t i = 0; i <= numEntries; ++i)
+	{
+		for (; subtree < numSubtrees && mFrustumCullingSubtreePositions[subtree] == i; ++subtree)
+		{
+			const SceneNode::VisibleObjectEntryList& entries = mFrustumCullingSubtreeEntries[subtree];
+			SceneNode::VisibleObjectEntryList::const_iterator e, eend = entries.end();
+			for (e = entries.begin(); e != eend; ++e)
+			{
+				SceneNode::_addVisibleObjectEntryToQueue(*e, cam, queue, visibleBounds,
+					mDisplayNodes, onlyShadowCasters);
+			}
+		}
+
+		if (i < numEntries)
+		{
+			SceneNode::_addVisibleObjectEntryToQueue(mFrustumCullingEntries[i], cam, queue,
+				visibleBounds, mDisplayNodes, onlyShadowCasters);
+		}
+	}
+
+	// Adapt the split so that there are a few subtrees per thread next time
+	size_t targetSubtrees = ParallelFor::getThreadCount() * 4;
+	if (numSubtrees < targetSubtrees && mFrustumCullingSplitDepth < 8)
+		++mFrustumCullingSplitDepth;
+	else if (numSubtrees > targetSubtrees * 16 && mFrustumCullingSplitDepth > 1)
+		--mFrustumCullingSplitDepth;
+}
+//-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
 	RenderQueueInvocationSequence* invocationSequence = 
@@ -2440,7 +2942,7 @@ void SceneManager::renderAdditiveStencilShadowedQueueGroupObjects(
             // Reset stencil params
             mDestRenderSystem->setStencilBufferParams();
             mDestRenderSystem->setStencilCheckEnabled(false);
-            mDestRenderSystem->_setDepthBufferParams();
+            mRenderStateCache.setDepthBufferParams();
 
 			if (scissored == CLIPPED_SOME)
 				resetScissor();
@@ -2524,7 +3026,7 @@ void SceneManager::renderModulativeStencilShadowedQueueGroupObjects(
             // Reset stencil params
             mDestRenderSystem->setStencilBufferParams();
             mDestRenderSystem->setStencilCheckEnabled(false);
-            mDestRenderSystem->_setDepthBufferParams();
+            mRenderStateCache.setDepthBufferParams();
         }
 
     }// for each light
@@ -3204,7 +3706,9 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
             TextureUnitState* pTex = texIter.getNext();
             if (pTex->hasViewRelativeTextureCoordinateGeneration())
             {
-                mDestRenderSystem->_setTextureUnitSettings(unit, *pTex);
+                // The cache doesn't know the settings depend on the camera
+                mRenderStateCache.invalidateTextureUnit(unit);
+                mRenderStateCache.setTextureUnitSettings(unit, *pTex);
             }
             ++unit;
         }
@@ -3242,7 +3746,7 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
 			// this also copes with returning from negative scale in previous render op
 			// for same pass
 			if (cullMode != mDestRenderSystem->_getCullingMode())
-				mDestRenderSystem->_setCullingMode(cullMode);
+				mRenderStateCache.setCullingMode(cullMode);
 		}
 
 		// Set up the solid / wireframe override
@@ -3259,7 +3763,7 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
 				reqMode = camPolyMode;
 			}
 		}
-		mDestRenderSystem->_setPolygonMode(reqMode);
+		mRenderStateCache.setPolygonMode(reqMode);
 
 		if (doLightIteration)
 		{
@@ -3355,8 +3859,10 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
 								++numShadowTextureLights;
 								++shadowTexIndex;
 								// Have to set TU on rendersystem right now, although
-								// autoparams will be set later
-								mDestRenderSystem->_setTextureUnitSettings(tuindex, *tu);
+								// autoparams will be set later. The projector changed
+								// without the cache knowing, so always issue it
+								mRenderStateCache.invalidateTextureUnit(tuindex);
+								mRenderStateCache.setTextureUnitSettings(tuindex, *tu);
 							}
 						}
 
@@ -3474,12 +3980,14 @@ void SceneManager::renderSingleObject(Renderable* rend, const Pass* pass,
 					// because of Pass state grouping. So set it always
 
 					// Set modified depth bias right away
-					mDestRenderSystem->_setDepthBias(depthBiasBase, pass->getDepthBiasSlopeScale());
+					mRenderStateCache.setDepthBias(depthBiasBase, pass->getDepthBiasSlopeScale());
 
 					// Set to increment internally too if rendersystem iterates
 					mDestRenderSystem->setDeriveDepthBias(true, 
 						depthBiasBase, pass->getIterationDepthBias(), 
 						pass->getDepthBiasSlopeScale());
+					// Which happens without going through the cache
+					mRenderStateCache.invalidate(RenderStateCache::CS_DEPTH_BIAS);
 				}
 				else
 				{
@@ -3859,6 +4367,8 @@ void SceneManager::manualRender(RenderOperation* rend,
 	setViewMatrix(viewMatrix);
 	mDestRenderSystem->_setProjectionMatrix(projMatrix);
 
+	// Manual rendering may happen outside of a frame of this SceneManager
+	mRenderStateCache.invalidate();
 	_setPass(pass);
 	// Do we need to update GPU program parameters?
 	if (pass->isProgrammable())
@@ -3897,6 +4407,8 @@ void SceneManager::manualRender(Renderable* rend, const Pass* pass, Viewport* vp
 	setViewMatrix(viewMatrix);
 	mDestRenderSystem->_setProjectionMatrix(projMatrix);
 
+	// Manual rendering may happen outside of a frame of this SceneManager
+	mRenderStateCache.invalidate();
 	_setPass(pass);
 	Camera dummyCam(StringUtil::BLANK, 0);
 	dummyCam.setCustomViewMatrix(true, viewMatrix);
@@ -4083,6 +4595,9 @@ void SceneManager::firePreRenderQueues()
 	{
 		(*i)->preRenderQueues();
 	}
+	// Listeners may have changed the render state
+	if (!mRenderQueueListeners.empty())
+		mRenderStateCache.invalidate();
 }
 //---------------------------------------------------------------------
 void SceneManager::firePostRenderQueues()
@@ -4092,6 +4607,9 @@ void SceneManager::firePostRenderQueues()
 	{
 		(*i)->postRenderQueues();
 	}
+	// Listeners may have changed the render state
+	if (!mRenderQueueListeners.empty())
+		mRenderStateCache.invalidate();
 }
 //---------------------------------------------------------------------
 bool SceneManager::fireRenderQueueStarted(uint8 id, const String& invocation)
@@ -4104,6 +4622,9 @@ bool SceneManager::fireRenderQueueStarted(uint8 id, const String& invocation)
     {
         (*i)->renderQueueStarted(id, invocation, skip);
     }
+	// Listeners may have changed the render state
+	if (!mRenderQueueListeners.empty())
+		mRenderStateCache.invalidate();
     return skip;
 }
 //---------------------------------------------------------------------
@@ -4117,6 +4638,9 @@ bool SceneManager::fireRenderQueueEnded(uint8 id, const String& invocation)
     {
         (*i)->renderQueueEnded(id, invocation, repeat);
     }
+	// Listeners may have changed the render state
+	if (!mRenderQueueListeners.empty())
+		mRenderStateCache.invalidate();
     return repeat;
 }
 //---------------------------------------------------------------------
@@ -4131,6 +4655,9 @@ void SceneManager::fireRenderSingleObject(Renderable* rend, const Pass* pass,
 	{
 		(*i)->notifyRenderSingleObject(rend, pass, source, pLightList, suppressRenderStateChanges);
 	}
+	// Listeners may have changed the render state
+	if (!mRenderObjectListeners.empty())
+		mRenderStateCache.invalidate();
 }
 //---------------------------------------------------------------------
 void SceneManager::fireShadowTexturesUpdated(size_t numberOfShadowTextures)
@@ -5588,9 +6115,9 @@ void SceneManager::renderShadowVolumesToStencil(const Light* light,
     }
 
     // Turn off colour writing and depth writing
-    mDestRenderSystem->_setColourBufferWriteEnabled(false, false, false, false);
-	mDestRenderSystem->_disableTextureUnitsFrom(0);
-    mDestRenderSystem->_setDepthBufferParams(true, false, CMPF_LESS);
+    mRenderStateCache.setColourBufferWriteEnabled(false, false, false, false);
+	mRenderStateCache.disableTextureUnitsFrom(0);
+    mRenderStateCache.setDepthBufferParams(true, false, CMPF_LESS);
     mDestRenderSystem->setStencilCheckEnabled(true);
 
     // Calculate extrusion distance
@@ -5703,15 +6230,15 @@ void SceneManager::renderShadowVolumesToStencil(const Light* light,
             _setPass(mShadowDebugPass);
             renderShadowVolumeObjects(iShadowRenderables, mShadowDebugPass, &lightList, flags,
                 true, false, false);
-            mDestRenderSystem->_setColourBufferWriteEnabled(false, false, false, false);
-            mDestRenderSystem->_setDepthBufferFunction(CMPF_LESS);
+            mRenderStateCache.setColourBufferWriteEnabled(false, false, false, false);
+            mRenderStateCache.setDepthBufferFunction(CMPF_LESS);
         }
     }
 
     // revert colour write state
-    mDestRenderSystem->_setColourBufferWriteEnabled(true, true, true, true);
+    mRenderStateCache.setColourBufferWriteEnabled(true, true, true, true);
     // revert depth state
-    mDestRenderSystem->_setDepthBufferParams();
+    mRenderStateCache.setDepthBufferParams();
 
     mDestRenderSystem->setStencilCheckEnabled(false);
 
@@ -5771,22 +6298,22 @@ void SceneManager::renderShadowVolumeObjects(ShadowCaster::ShadowRenderableListI
                 if (twosided)
                 {
                     // select back facing light caps to render
-                    mDestRenderSystem->_setCullingMode(CULL_ANTICLOCKWISE);
+                    mRenderStateCache.setCullingMode(CULL_ANTICLOCKWISE);
 					mPassCullingMode = CULL_ANTICLOCKWISE;
                     // use normal depth function for back facing light caps
                     renderSingleObject(lightCap, pass, false, false, manualLightList);
 
                     // select front facing light caps to render
-                    mDestRenderSystem->_setCullingMode(CULL_CLOCKWISE);
+                    mRenderStateCache.setCullingMode(CULL_CLOCKWISE);
 					mPassCullingMode = CULL_CLOCKWISE;
                     // must always fail depth check for front facing light caps
-                    mDestRenderSystem->_setDepthBufferFunction(CMPF_ALWAYS_FAIL);
+                    mRenderStateCache.setDepthBufferFunction(CMPF_ALWAYS_FAIL);
                     renderSingleObject(lightCap, pass, false, false, manualLightList);
 
                     // reset depth function
-                    mDestRenderSystem->_setDepthBufferFunction(CMPF_LESS);
+                    mRenderStateCache.setDepthBufferFunction(CMPF_LESS);
                     // reset culling mode
-                    mDestRenderSystem->_setCullingMode(CULL_NONE);
+                    mRenderStateCache.setCullingMode(CULL_NONE);
 					mPassCullingMode = CULL_NONE;
                 }
                 else if ((secondpass || zfail) && !(secondpass && zfail))
@@ -5797,11 +6324,11 @@ void SceneManager::renderShadowVolumeObjects(ShadowCaster::ShadowRenderableListI
                 else
                 {
                     // must always fail depth check for front facing light caps
-                    mDestRenderSystem->_setDepthBufferFunction(CMPF_ALWAYS_FAIL);
+                    mRenderStateCache.setDepthBufferFunction(CMPF_ALWAYS_FAIL);
                     renderSingleObject(lightCap, pass, false, false, manualLightList);
 
                     // reset depth function
-                    mDestRenderSystem->_setDepthBufferFunction(CMPF_LESS);
+                    mRenderStateCache.setDepthBufferFunction(CMPF_LESS);
                 }
             }
         }
@@ -5858,7 +6385,7 @@ void SceneManager::setShadowVolumeStencilState(bool secondpass, bool zfail, bool
             twosided
             );
     }
-	mDestRenderSystem->_setCullingMode(mPassCullingMode);
+	mRenderStateCache.setCullingMode(mPassCullingMode);
 
 }
 //---------------------------------------------------------------------
@@ -6477,9 +7004,10 @@ void SceneManager::_resumeRendering(SceneManager::RenderContext* context)
 	}
 	mCameraInProgress = context->camera;
 	mDestRenderSystem->_resumeFrame(context->rsContext);
+	mRenderStateCache.invalidate();
 
 	// Set rasterisation mode
-    mDestRenderSystem->_setPolygonMode(mCameraInProgress->getPolygonMode());
+    mRenderStateCache.setPolygonMode(mCameraInProgress->getPolygonMode());
 
 	// Set initial camera state
 	mDestRenderSystem->_setProjectionMatrix(mCameraInProgress->getProjectionMatrixRS());
@@ -37,6 +37,8 @@ THE SOFTWARE.
 #include "OgreMovableObject.h"
 #include "OgreWireBoundingBox.h"
 
+#include <typeinfo>
+
 namespace Ogre {
     //-----------------------------------------------------------------------
     SceneNode::SceneNode(SceneManager* creator)
@@ -48,6 +50,8 @@ namespace Ogre {
         , mYawFixed(false)
         , mAutoTrackTarget(0)
         , mIsInSceneGraph(false)
+        , mInDirtyList(false)
+        , mIndexInDirtyList(0)
     {
         needUpdate();
     }
@@ -61,6 +65,8 @@ namespace Ogre {
         , mYawFixed(false)
         , mAutoTrackTarget(0)
         , mIsInSceneGraph(false)
+        , mInDirtyList(false)
+        , mIndexInDirtyList(0)
     {
         needUpdate();
     }
@@ -80,6 +86,9 @@ namespace Ogre {
         if (mWireBoundingBox) {
 			OGRE_DELETE mWireBoundingBox;
 		}
+
+        if (mInDirtyList)
+            mCreator->_notifySceneNodeClean(this);
     }
     //-----------------------------------------------------------------------
     void SceneNode::_update(bool updateChildren, bool parentHasChanged)
@@ -87,6 +96,14 @@ namespace Ogre {
         Node::_update(updateChildren, parentHasChanged);
         _updateBounds();
     }
+    //-----------------------------------------------------------------------
+    void SceneNode::needUpdate(bool forceParentUpdate)
+    {
+        Node::needUpdate(forceParentUpdate);
+
+        if (!mInDirtyList && mCreator && mCreator->getIncrementalSceneGraphUpdate())
+            mCreator->_notifySceneNodeDirty(this);
+    }
     //-----------------------------------------------------------------------
 	void SceneNode::setParent(Node* parent)
 	{
@@ -109,10 +126,10 @@ namespace Ogre {
 		{
 			mIsInSceneGraph = inGraph;
 			// Tell children
-	        ChildNodeMap::iterator child;
+	        ChildNodeList::iterator child;
     	    for (child = mChildren.begin(); child != mChildren.end(); ++child)
         	{
-            	SceneNode* sceneChild = static_cast<SceneNode*>(child->second);
+            	SceneNode* sceneChild = static_cast<SceneNode*>(*child);
 				sceneChild->setInSceneGraph(inGraph);
 			}
 		}
@@ -265,10 +282,10 @@ namespace Ogre {
         }
 
         // Merge with children
-        ChildNodeMap::iterator child;
+        ChildNodeList::iterator child;
         for (child = mChildren.begin(); child != mChildren.end(); ++child)
         {
-            SceneNode* sceneChild = static_cast<SceneNode*>(child->second);
+            SceneNode* sceneChild = static_cast<SceneNode*>(*child);
             mWorldAABB.merge(sceneChild->mWorldAABB);
         }
 
@@ -282,6 +299,14 @@ namespace Ogre {
         if (!cam->isVisible(mWorldAABB))
             return;
 
+        findVisibleObjectsImpl(cam, queue, visibleBounds, includeChildren,
+            displayNodes, onlyShadowCasters);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::findVisibleObjectsImpl(Camera* cam, RenderQueue* queue, 
+		VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren, 
+		bool displayNodes, bool onlyShadowCasters)
+    {
         // Add all entities
         ObjectMap::iterator iobj;
         ObjectMap::iterator iobjend = mObjectsByName.end();
@@ -294,16 +319,106 @@ namespace Ogre {
 
         if (includeChildren)
         {
-            ChildNodeMap::iterator child, childend;
-            childend = mChildren.end();
-            for (child = mChildren.begin(); child != childend; ++child)
+            SceneNode* children[CHILD_CULLING_BATCH];
+            ChildNodeList::iterator child = mChildren.begin();
+            while (child != mChildren.end())
+            {
+                uint32 visibility;
+                size_t numChildren = cullChildren(cam, child, children, visibility);
+                for (size_t i = 0; i < numChildren; ++i)
+                {
+                    SceneNode* sceneChild = children[i];
+                    if (typeid(*sceneChild) != typeid(SceneNode))
+                    {
+                        // Subclasses may override _findVisibleObjects
+                        sceneChild->_findVisibleObjects(cam, queue, visibleBounds,
+                            includeChildren, displayNodes, onlyShadowCasters);
+                    }
+                    else if (visibility & (1u << i))
+                    {
+                        sceneChild->findVisibleObjectsImpl(cam, queue, visibleBounds,
+                            includeChildren, displayNodes, onlyShadowCasters);
+                    }
+                }
+            }
+        }
+
+        _addDebugRenderablesToQueue(queue, displayNodes);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_findVisibleObjectEntries(const Camera* cam, VisibleObjectEntryList& entries)
+    {
+        // Check self visible
+        if (!cam->isVisible(mWorldAABB))
+            return;
+
+        findVisibleObjectEntriesImpl(cam, entries);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::findVisibleObjectEntriesImpl(const Camera* cam, VisibleObjectEntryList& entries)
+    {
+        ObjectMap::iterator iobj;
+        ObjectMap::iterator iobjend = mObjectsByName.end();
+        for (iobj = mObjectsByName.begin(); iobj != iobjend; ++iobj)
+        {
+            entries.push_back(VisibleObjectEntry(this, iobj->second));
+        }
+
+        SceneNode* children[CHILD_CULLING_BATCH];
+        ChildNodeList::iterator child = mChildren.begin();
+        while (child != mChildren.end())
+        {
+            uint32 visibility;
+            size_t numChildren = cullChildren(cam, child, children, visibility);
+            for (size_t i = 0; i < numChildren; ++i)
             {
-                SceneNode* sceneChild = static_cast<SceneNode*>(child->second);
-                sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
-					displayNodes, onlyShadowCasters);
+                SceneNode* sceneChild = children[i];
+                if (typeid(*sceneChild) != typeid(SceneNode))
+                {
+                    // Left for the thread filling the queue, as in findVisibleObjectsImpl
+                    entries.push_back(VisibleObjectEntry(sceneChild, 0, true));
+                }
+                else if (visibility & (1u << i))
+                {
+                    sceneChild->findVisibleObjectEntriesImpl(cam, entries);
+                }
             }
         }
 
+        entries.push_back(VisibleObjectEntry(this, 0));
+    }
+    //-----------------------------------------------------------------------
+    size_t SceneNode::cullChildren(const Camera* cam, ChildNodeList::iterator& child,
+        SceneNode** children, uint32& visibility)
+    {
+        const AxisAlignedBox* bounds[CHILD_CULLING_BATCH];
+        size_t numChildren = 0;
+        ChildNodeList::iterator childend = mChildren.end();
+        for (; child != childend && numChildren < CHILD_CULLING_BATCH; ++child, ++numChildren)
+        {
+            children[numChildren] = static_cast<SceneNode*>(*child);
+            bounds[numChildren] = &children[numChildren]->mWorldAABB;
+        }
+
+        cam->calculateVisibility(bounds, numChildren, &visibility);
+        return numChildren;
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_addVisibleObjectEntryToQueue(const VisibleObjectEntry& entry,
+        Camera* cam, RenderQueue* queue, VisibleObjectsBoundsInfo* visibleBounds,
+        bool displayNodes, bool onlyShadowCasters)
+    {
+        if (entry.deferred)
+            entry.node->_findVisibleObjects(cam, queue, visibleBounds, true,
+                displayNodes, onlyShadowCasters);
+        else if (entry.object)
+            queue->processVisibleObject(entry.object, cam, onlyShadowCasters, visibleBounds);
+        else
+            entry.node->_addDebugRenderablesToQueue(queue, displayNodes);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::_addDebugRenderablesToQueue(RenderQueue* queue, bool displayNodes)
+    {
         if (displayNodes)
         {
             // Include self in the render queue
@@ -317,8 +432,6 @@ namespace Ogre {
 		{ 
 			_addBoundingBoxToQueue(queue);
 		}
-
-
     }
 
 	Node::DebugRenderable* SceneNode::getDebugRenderable()
@@ -366,6 +479,20 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void SceneNode::setDerivedTransformImpl(const Vector3& position,
+        const Quaternion& orientation, const Vector3& scale)
+    {
+        Node::setDerivedTransformImpl(position, orientation, scale);
+
+        // Notify objects that it has been moved
+        ObjectMap::const_iterator i;
+        for (i = mObjectsByName.begin(); i != mObjectsByName.end(); ++i)
+        {
+            MovableObject* object = i->second;
+            object->_notifyMoved();
+        }
+    }
+    //-----------------------------------------------------------------------
     Node* SceneNode::createChildImpl(void)
     {
         assert(mCreator);
@@ -414,14 +541,11 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void SceneNode::removeAndDestroyAllChildren(void)
     {
-        ChildNodeMap::iterator i, iend;
-        iend = mChildren.end();
-        for (i = mChildren.begin(); i != iend;)
+        // Go backwards, SceneManager::destroySceneNode removes the node from
+        // its parent, which moves the last child in its place
+        for (size_t i = mChildren.size(); i-- > 0; )
         {
-            SceneNode* sn = static_cast<SceneNode*>(i->second);
-			// increment iterator before destroying (iterator invalidated by 
-			// SceneManager::destroySceneNode because it causes removal from parent)
-			++i;
+            SceneNode* sn = static_cast<SceneNode*>(mChildren[i]);
             sn->removeAndDestroyAllChildren();
             sn->getCreator()->destroySceneNode(sn->getName());
         }
@@ -638,11 +762,11 @@ namespace Ogre {
 
         if (cascade)
         {
-            ChildNodeMap::iterator i, iend;
+            ChildNodeList::iterator i, iend;
             iend = mChildren.end();
             for (i = mChildren.begin(); i != iend; ++i)
             {
-                static_cast<SceneNode*>(i->second)->setVisible(visible, cascade);
+                static_cast<SceneNode*>(*i)->setVisible(visible, cascade);
             }
         }
     }
@@ -658,11 +782,11 @@ namespace Ogre {
 
 		if (cascade)
 		{
-			ChildNodeMap::iterator i, iend;
+			ChildNodeList::iterator i, iend;
 			iend = mChildren.end();
 			for (i = mChildren.begin(); i != iend; ++i)
 			{
-				static_cast<SceneNode*>(i->second)->setDebugDisplayEnabled(enabled, cascade);
+				static_cast<SceneNode*>(*i)->setDebugDisplayEnabled(enabled, cascade);
 			}
 		}
 	}
@@ -678,11 +802,11 @@ namespace Ogre {
 
         if (cascade)
         {
-            ChildNodeMap::iterator i, iend;
+            ChildNodeList::iterator i, iend;
             iend = mChildren.end();
             for (i = mChildren.begin(); i != iend; ++i)
             {
-                static_cast<SceneNode*>(i->second)->flipVisibility(cascade);
+                static_cast<SceneNode*>(*i)->flipVisibility(cascade);
             }
         }
     }
@@ -46,14 +46,15 @@ namespace Ogre {
 		: Resource(),
         mBlendState(ANIMBLEND_AVERAGE),
 		mNextAutoHandle(0),
-		mManualBonesDirty(false)
+		mManualBonesDirty(false),
+		mDisabledBones(0)
 	{
 	}
 	//---------------------------------------------------------------------
     Skeleton::Skeleton(ResourceManager* creator, const String& name, ResourceHandle handle,
         const String& group, bool isManual, ManualResourceLoader* loader) 
         : Resource(creator, name, handle, group, isManual, loader), 
-        mBlendState(ANIMBLEND_AVERAGE), mNextAutoHandle(0)
+        mBlendState(ANIMBLEND_AVERAGE), mNextAutoHandle(0), mDisabledBones(0)
         // set animation blending to weighted, not cumulative
     {
         if (createParamDictionary("Skeleton"))
@@ -688,6 +689,21 @@ namespace Ogre {
 			ai->second->optimise(false);
 		}
 	}
+    //---------------------------------------------------------------------
+	void Skeleton::compressAllAnimations(const CompressedNodeAnimationTrack::Tolerances& tolerances)
+	{
+        AnimationList::iterator ai, aiend;
+        aiend = mAnimationsList.end();
+
+        for (ai = mAnimationsList.begin(); ai != aiend; ++ai)
+        {
+			ai->second->_applyBaseKeyFrame();
+        }
+        for (ai = mAnimationsList.begin(); ai != aiend; ++ai)
+        {
+			ai->second->compressNodeTracks(tolerances);
+        }
+	}
 	//---------------------------------------------------------------------
 	void Skeleton::addLinkedSkeletonAnimationSource(const String& skelName, 
 		Real scale)
@@ -944,7 +960,25 @@ namespace Ogre {
                 const DeltaTransform& deltaTransform = deltaTransforms[handle];
                 ushort dstHandle = boneHandleMap[handle];
 
-                if (srcAnimation->hasNodeTrack(handle))
+                if (srcAnimation->hasCompressedNodeTrack(handle))
+                {
+                    // Decompress the track, then adjust its keyframes in place
+                    NodeAnimationTrack* dstTrack = dstAnimation->createNodeTrack(dstHandle, this->getBone(dstHandle));
+                    srcAnimation->getCompressedNodeTrack(handle)->decompress(dstTrack);
+
+                    if (!deltaTransform.isIdentity)
+                    {
+                        ushort numKeyFrames = dstTrack->getNumKeyFrames();
+                        for (ushort k = 0; k < numKeyFrames; ++k)
+                        {
+                            TransformKeyFrame* dstKeyFrame = dstTrack->getNodeKeyFrame(k);
+                            dstKeyFrame->setTranslate(deltaTransform.translate + dstKeyFrame->getTranslate());
+                            dstKeyFrame->setRotation(deltaTransform.rotate * dstKeyFrame->getRotation());
+                            dstKeyFrame->setScale(deltaTransform.scale * dstKeyFrame->getScale());
+                        }
+                    }
+                }
+                else if (srcAnimation->hasNodeTrack(handle))
                 {
                     // Clone track from source animation
 
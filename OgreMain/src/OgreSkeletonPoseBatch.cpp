@@ -0,0 +1,435 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreSkeletonPoseBatch.h"
+#include "OgreSkeleton.h"
+#include "OgreBone.h"
+#include "OgreCompressedNodeAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreParallelFor.h"
+
+namespace Ogre {
+
+	/// Number of transform arrays of numBones * mStride entries in mBuffer
+	static const size_t SKELETON_POSE_BATCH_ARRAYS = 20;
+	/// Number of blocks of 4 instances below which a batch is not worth splitting
+	static const size_t SKELETON_POSE_BATCH_MIN_BLOCKS = 4;
+
+	//-----------------------------------------------------------------------
+	/// Evaluates blocks of instances on the threads of the WorkQueue
+	class SkeletonPoseBatchTask : public ParallelForTask
+	{
+	public:
+		SkeletonPoseBatchTask(SkeletonPoseBatch* batch)
+			: mBatch(batch)
+		{
+		}
+
+		void execute(size_t begin, size_t end)
+		{
+			mBatch->_evaluateBlocks(begin, end);
+		}
+
+	private:
+		SkeletonPoseBatch* mBatch;
+	};
+	//-----------------------------------------------------------------------
+	SkeletonPoseBatch::SkeletonPoseBatch()
+		: mSkeleton(0)
+		, mBuffer(0)
+		, mStride(0)
+		, mInheritOrientation(0)
+		, mInheritScale(0)
+	{
+		memset(&mLocal, 0, sizeof(mLocal));
+		memset(&mModel, 0, sizeof(mModel));
+	}
+	//-----------------------------------------------------------------------
+	SkeletonPoseBatch::~SkeletonPoseBatch()
+	{
+		if (mBuffer)
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_ANIMATION);
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::reset(Skeleton* skeleton)
+	{
+		clear();
+		mSkeleton = skeleton;
+		unsigned short numBones = skeleton ? skeleton->getNumBones() : 0;
+
+		// The buffers depend on the number of bones
+		if (mBuffer && numBones != mBones.size())
+		{
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_ANIMATION);
+			mBuffer = 0;
+			mStride = 0;
+		}
+
+		mBones.clear();
+		mBoneOrder.clear();
+		if (!skeleton)
+			return;
+
+		mBones.resize(numBones);
+		for (unsigned short h = 0; h < numBones; ++h)
+		{
+			const Bone* bone = skeleton->getBone(h);
+			BoneInfo& info = mBones[h];
+			const Node* parent = bone->getParent();
+			info.parent = parent ? static_cast<const Bone*>(parent)->getHandle() : NO_PARENT;
+			info.initialPosition = bone->getInitialPosition();
+			info.initialOrientation = bone->getInitialOrientation();
+			info.initialScale = bone->getInitialScale();
+			info.bindDerivedInversePosition = bone->_getBindingPoseInversePosition();
+			info.bindDerivedInverseOrientation = bone->_getBindingPoseInverseOrientation();
+			info.bindDerivedInverseScale = bone->_getBindingPoseInverseScale();
+		}
+
+		// Order the bones breadth first so that parents come before children
+		for (unsigned short h = 0; h < numBones; ++h)
+		{
+			if (mBones[h].parent == NO_PARENT)
+				mBoneOrder.push_back(h);
+		}
+		for (size_t i = 0; i < mBoneOrder.size(); ++i)
+		{
+			const Bone* bone = skeleton->getBone(mBoneOrder[i]);
+			Node::ConstChildNodeIterator it = bone->getChildIterator();
+			while (it.hasMoreElements())
+				mBoneOrder.push_back(static_cast<const Bone*>(it.getNext())->getHandle());
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::add(const Skeleton* instance, const AnimationStateSet* animSet,
+		Matrix4* boneMatrices)
+	{
+		assert(mSkeleton && instance->getNumBones() == mBones.size() &&
+			"The instance does not match the skeleton of the batch");
+
+		Instance inst;
+		inst.skeleton = instance;
+		inst.animSet = animSet;
+		inst.boneMatrices = boneMatrices;
+		inst.firstSample = 0;
+		inst.numSamples = 0;
+		mInstances.push_back(inst);
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::addCopy(const Matrix4* source, Matrix4* dest)
+	{
+		mCopies.push_back(std::make_pair(source, dest));
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::clear(void)
+	{
+		mInstances.clear();
+		mSamples.clear();
+		mCopies.clear();
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::evaluate(bool parallel)
+	{
+		if (!mInstances.empty())
+		{
+			prepare();
+
+			size_t numBlocks = (mInstances.size() + 3) / 4;
+			reserve(numBlocks * 4);
+
+			if (parallel && numBlocks >= SKELETON_POSE_BATCH_MIN_BLOCKS * 2)
+			{
+				SkeletonPoseBatchTask task(this);
+				ParallelFor::run(&task, numBlocks, SKELETON_POSE_BATCH_MIN_BLOCKS);
+			}
+			else
+			{
+				_evaluateBlocks(0, numBlocks);
+			}
+		}
+
+		size_t size = sizeof(Matrix4) * mBones.size();
+		vector<std::pair<const Matrix4*, Matrix4*> >::type::const_iterator c, cend = mCopies.end();
+		for (c = mCopies.begin(); c != cend; ++c)
+			memcpy(c->second, c->first, size);
+
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::prepare(void)
+	{
+		// Everything which may be built lazily by the animations is built here,
+		// on the calling thread, so that the evaluation only reads shared data
+		set<Animation*>::type prepared;
+
+		mSamples.clear();
+		InstanceList::iterator i, iend = mInstances.end();
+		for (i = mInstances.begin(); i != iend; ++i)
+		{
+			i->firstSample = mSamples.size();
+
+			// Same weights as Skeleton::setAnimationState
+			Real weightFactor = 1.0f;
+			if (i->skeleton->getBlendMode() == ANIMBLEND_AVERAGE)
+			{
+				Real totalWeights = 0.0f;
+				ConstEnabledAnimationStateIterator stateIt =
+					i->animSet->getEnabledAnimationStateIterator();
+				while (stateIt.hasMoreElements())
+				{
+					const AnimationState* animState = stateIt.getNext();
+					if (i->skeleton->_getAnimationImpl(animState->getAnimationName()))
+						totalWeights += animState->getWeight();
+				}
+				if (totalWeights > 1.0f)
+					weightFactor = 1.0f / totalWeights;
+			}
+
+			ConstEnabledAnimationStateIterator stateIt =
+				i->animSet->getEnabledAnimationStateIterator();
+			while (stateIt.hasMoreElements())
+			{
+				const AnimationState* animState = stateIt.getNext();
+				const LinkedSkeletonAnimationSource* linked = 0;
+				Animation* anim = i->skeleton->_getAnimationImpl(
+					animState->getAnimationName(), &linked);
+				if (!anim)
+					continue;
+
+				if (prepared.insert(anim).second)
+					anim->_prepareNodeTracks();
+
+				mSamples.push_back(Sample(anim, anim->_getTimeIndex(animState->getTimePosition()),
+					animState->getWeight() * weightFactor, linked ? linked->scale : 1.0f,
+					animState->hasBlendMask() ? animState->getBlendMask() : 0));
+			}
+
+			i->numSamples = mSamples.size() - i->firstSample;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::reserve(size_t stride)
+	{
+		if (stride <= mStride && mBuffer)
+			return;
+
+		if (mBuffer)
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_ANIMATION);
+
+		// Grow geometrically, keeping every row a multiple of 4 entries so
+		// that they all stay aligned
+		mStride = std::max(stride, mStride * 2);
+		mStride = (mStride + 3) & ~size_t(3);
+		size_t arraySize = mStride * mBones.size();
+		mBuffer = static_cast<Real*>(OGRE_MALLOC_SIMD(
+			sizeof(Real) * arraySize * (SKELETON_POSE_BATCH_ARRAYS + 2),
+			MEMCATEGORY_ANIMATION));
+
+		Real* p = mBuffer;
+		Real** arrays[SKELETON_POSE_BATCH_ARRAYS] = {
+			&mLocal.posX, &mLocal.posY, &mLocal.posZ,
+			&mLocal.rotW, &mLocal.rotX, &mLocal.rotY, &mLocal.rotZ,
+			&mLocal.scaleX, &mLocal.scaleY, &mLocal.scaleZ,
+			&mModel.posX, &mModel.posY, &mModel.posZ,
+			&mModel.rotW, &mModel.rotX, &mModel.rotY, &mModel.rotZ,
+			&mModel.scaleX, &mModel.scaleY, &mModel.scaleZ };
+		for (size_t i = 0; i < SKELETON_POSE_BATCH_ARRAYS; ++i)
+		{
+			*arrays[i] = p;
+			p += arraySize;
+		}
+
+		mInheritOrientation = p;
+		mInheritScale = p + arraySize;
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::accumulate(size_t index, const Vector3& translate,
+		Quaternion rotate, Vector3 scale, Real weight, Real scl,
+		Animation::RotationInterpolationMode rim, bool shortestPath)
+	{
+		// Node::translate in parent space
+		Real factor = weight * scl;
+		mLocal.posX[index] += translate.x * factor;
+		mLocal.posY[index] += translate.y * factor;
+		mLocal.posZ[index] += translate.z * factor;
+
+		// Node::rotate in local space, which normalises the rotation
+		if (rim == Animation::RIM_LINEAR)
+			rotate = Quaternion::nlerp(weight, Quaternion::IDENTITY, rotate, shortestPath);
+		else
+			rotate = Quaternion::Slerp(weight, Quaternion::IDENTITY, rotate, shortestPath);
+		rotate.normalise();
+		Quaternion orientation = Quaternion(mLocal.rotW[index], mLocal.rotX[index],
+			mLocal.rotY[index], mLocal.rotZ[index]) * rotate;
+		mLocal.rotW[index] = orientation.w;
+		mLocal.rotX[index] = orientation.x;
+		mLocal.rotY[index] = orientation.y;
+		mLocal.rotZ[index] = orientation.z;
+
+		// Node::scale
+		if (scale != Vector3::UNIT_SCALE)
+		{
+			if (scl != 1.0f)
+				scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * scl;
+			else if (weight != 1.0f)
+				scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * weight;
+			mLocal.scaleX[index] *= scale.x;
+			mLocal.scaleY[index] *= scale.y;
+			mLocal.scaleZ[index] *= scale.z;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseBatch::_evaluateBlocks(size_t begin, size_t end)
+	{
+		size_t first = begin * 4;
+		size_t last = std::min(end * 4, mInstances.size());
+		size_t padded = end * 4;
+		size_t numBones = mBones.size();
+
+		// Reset to the initial state, padding included
+		for (size_t b = 0; b < numBones; ++b)
+		{
+			const BoneInfo& info = mBones[b];
+			size_t row = b * mStride;
+			for (size_t i = first; i < padded; ++i)
+			{
+				// Instances do not copy these flags from the skeleton
+				const Bone* bone = i < last ? mInstances[i].skeleton->getBone(
+					static_cast<unsigned short>(b)) : 0;
+				mInheritOrientation[row + i] = !bone || bone->getInheritOrientation() ? 1.0f : 0.0f;
+				mInheritScale[row + i] = !bone || bone->getInheritScale() ? 1.0f : 0.0f;
+			}
+			for (size_t i = row + first; i < row + padded; ++i)
+			{
+				mLocal.posX[i] = info.initialPosition.x;
+				mLocal.posY[i] = info.initialPosition.y;
+				mLocal.posZ[i] = info.initialPosition.z;
+				mLocal.rotW[i] = info.initialOrientation.w;
+				mLocal.rotX[i] = info.initialOrientation.x;
+				mLocal.rotY[i] = info.initialOrientation.y;
+				mLocal.rotZ[i] = info.initialOrientation.z;
+				mLocal.scaleX[i] = info.initialScale.x;
+				mLocal.scaleY[i] = info.initialScale.y;
+				mLocal.scaleZ[i] = info.initialScale.z;
+			}
+		}
+
+		// Sample and blend the animations into the local transforms
+		TransformKeyFrame kf(0, 0);
+		for (size_t i = first; i < last; ++i)
+		{
+			const Instance& inst = mInstances[i];
+			const Skeleton* instance = inst.skeleton;
+			for (size_t s = inst.firstSample; s < inst.firstSample + inst.numSamples; ++s)
+			{
+				const Sample& sample = mSamples[s];
+				Animation::RotationInterpolationMode rim =
+					sample.animation->getRotationInterpolationMode();
+
+				const Animation::NodeTrackList& tracks = sample.animation->_getNodeTrackList();
+				Animation::NodeTrackList::const_iterator t, tend = tracks.end();
+				for (t = tracks.begin(); t != tend; ++t)
+				{
+					unsigned short handle = t->first;
+					const NodeAnimationTrack* track = t->second;
+					Real weight = sample.blendMask ?
+						(*sample.blendMask)[handle] * sample.weight : sample.weight;
+					if (handle >= numBones || !weight || !track->getNumKeyFrames() ||
+						instance->_isBoneDisabled(handle))
+						continue;
+
+					track->getInterpolatedKeyFrame(sample.timeIndex, &kf);
+					accumulate(handle * mStride + i, kf.getTranslate(), kf.getRotation(),
+						kf.getScale(), weight, sample.scale, rim,
+						track->getUseShortestRotationPath());
+				}
+
+				const Animation::CompressedNodeTrackList& compressed =
+					sample.animation->_getCompressedNodeTrackList();
+				Animation::CompressedNodeTrackList::const_iterator c, cend = compressed.end();
+				for (c = compressed.begin(); c != cend; ++c)
+				{
+					unsigned short handle = c->first;
+					Real weight = sample.blendMask ?
+						(*sample.blendMask)[handle] * sample.weight : sample.weight;
+					if (handle >= numBones || !weight || instance->_isBoneDisabled(handle))
+						continue;
+
+					Vector3 translate, scale;
+					Quaternion rotate;
+					c->second->getTransform(sample.timeIndex, translate, rotate, scale);
+					accumulate(handle * mStride + i, translate, rotate, scale, weight,
+						sample.scale, rim, true);
+				}
+			}
+		}
+
+		// Derive the model space transforms, parents first
+		OptimisedUtil* util = OptimisedUtil::getImplementation();
+		size_t count = padded - first;
+		vector<unsigned short>::type::const_iterator o, oend = mBoneOrder.end();
+		for (o = mBoneOrder.begin(); o != oend; ++o)
+		{
+			const BoneInfo& info = mBones[*o];
+			size_t row = *o * mStride + first;
+			if (info.parent == NO_PARENT)
+			{
+				Real* const* src = &mLocal.posX;
+				Real* const* dest = &mModel.posX;
+				for (size_t a = 0; a < 10; ++a)
+					memcpy(dest[a] + row, src[a] + row, sizeof(Real) * count);
+			}
+			else
+			{
+				util->concatenateNodeTransforms(
+					mModel.offset(info.parent * mStride + first), mLocal.offset(row),
+					mInheritOrientation + row, mInheritScale + row,
+					mModel.offset(row), count);
+			}
+		}
+
+		// Build the offset matrices, as Bone::_getOffsetTransform does
+		for (size_t i = first; i < last; ++i)
+		{
+			Matrix4* matrices = mInstances[i].boneMatrices;
+			for (size_t b = 0; b < numBones; ++b)
+			{
+				const BoneInfo& info = mBones[b];
+				size_t e = b * mStride + i;
+
+				Vector3 locScale = Vector3(mModel.scaleX[e], mModel.scaleY[e], mModel.scaleZ[e]) *
+					info.bindDerivedInverseScale;
+				Quaternion locRotate = Quaternion(mModel.rotW[e], mModel.rotX[e],
+					mModel.rotY[e], mModel.rotZ[e]) * info.bindDerivedInverseOrientation;
+				Vector3 locTranslate = Vector3(mModel.posX[e], mModel.posY[e], mModel.posZ[e]) +
+					locRotate * (locScale * info.bindDerivedInversePosition);
+
+				matrices[b].makeTransform(locTranslate, locScale, locRotate);
+			}
+		}
+	}
+}
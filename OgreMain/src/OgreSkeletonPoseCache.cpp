@@ -0,0 +1,180 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreSkeletonPoseCache.h"
+#include "OgreAnimationState.h"
+#include "OgreRoot.h"
+
+namespace Ogre {
+
+	//-----------------------------------------------------------------------
+	bool SkeletonPoseCache::PoseKey::operator<(const PoseKey& rhs) const
+	{
+		if (skeleton != rhs.skeleton)
+			return skeleton < rhs.skeleton;
+		if (blendMode != rhs.blendMode)
+			return blendMode < rhs.blendMode;
+		if (disabledBones != rhs.disabledBones)
+			return disabledBones < rhs.disabledBones;
+		if (states.size() != rhs.states.size())
+			return states.size() < rhs.states.size();
+
+		for (size_t i = 0; i < states.size(); ++i)
+		{
+			const StateKey& a = states[i];
+			const StateKey& b = rhs.states[i];
+			if (a.animation != b.animation)
+				return a.animation < b.animation;
+			if (a.time != b.time)
+				return a.time < b.time;
+			if (a.weight != b.weight)
+				return a.weight < b.weight;
+			if (a.scale != b.scale)
+				return a.scale < b.scale;
+		}
+		return false;
+	}
+	//-----------------------------------------------------------------------
+	SkeletonPoseCache::SkeletonPoseCache()
+		: mEnabled(false)
+		, mTimeQuantum(0)
+		, mFrameNumber(0)
+		, mHitCount(0)
+		, mMissCount(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	SkeletonPoseCache::~SkeletonPoseCache()
+	{
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseCache::setEnabled(bool enabled)
+	{
+		mEnabled = enabled;
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseCache::setTimeQuantum(Real quantum)
+	{
+		mTimeQuantum = quantum;
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseCache::clear(void)
+	{
+		PoseMap::iterator i, iend = mPoses.end();
+		for (i = mPoses.begin(); i != iend; ++i)
+			OGRE_FREE(i->second, MEMCATEGORY_ANIMATION);
+		mPoses.clear();
+	}
+	//-----------------------------------------------------------------------
+	Real SkeletonPoseCache::getHitRate(void) const
+	{
+		size_t total = mHitCount + mMissCount;
+		return total ? (Real)mHitCount / (Real)total : 0;
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseCache::resetStatistics(void)
+	{
+		mHitCount = 0;
+		mMissCount = 0;
+	}
+	//-----------------------------------------------------------------------
+	bool SkeletonPoseCache::_acquirePose(const Skeleton* skeleton, const Skeleton* instance,
+		const AnimationStateSet& animSet, Matrix4*& matrices)
+	{
+		matrices = 0;
+
+		// Poses are only shared within a frame
+		unsigned long frameNumber = Root::getSingleton().getNextFrameNumber();
+		if (frameNumber != mFrameNumber)
+		{
+			clear();
+			mFrameNumber = frameNumber;
+		}
+
+		mKey.skeleton = skeleton;
+		mKey.blendMode = instance->getBlendMode();
+		if (instance->_getDisabledBones())
+			mKey.disabledBones = *instance->_getDisabledBones();
+		else
+			mKey.disabledBones.clear();
+		mKey.states.clear();
+
+		ConstEnabledAnimationStateIterator stateIt = animSet.getEnabledAnimationStateIterator();
+		while (stateIt.hasMoreElements())
+		{
+			const AnimationState* animState = stateIt.getNext();
+			const LinkedSkeletonAnimationSource* linked = 0;
+			const Animation* anim = instance->_getAnimationImpl(
+				animState->getAnimationName(), &linked);
+			// Ignored by Skeleton::setAnimationState too
+			if (!anim)
+				continue;
+			if (animState->hasBlendMask())
+				return false;
+
+			StateKey state;
+			state.animation = anim;
+			state.time = animState->getTimePosition();
+			if (mTimeQuantum > 0)
+				state.time = Math::Floor(state.time / mTimeQuantum + 0.5f) * mTimeQuantum;
+			state.weight = animState->getWeight();
+			state.scale = linked ? linked->scale : 1.0f;
+			mKey.states.push_back(state);
+		}
+
+		PoseMap::iterator i = mPoses.find(mKey);
+		if (i != mPoses.end())
+		{
+			++mHitCount;
+			matrices = i->second;
+			return true;
+		}
+
+		++mMissCount;
+		matrices = OGRE_ALLOC_T(Matrix4, skeleton->getNumBones(), MEMCATEGORY_ANIMATION);
+		mPoses.insert(PoseMap::value_type(mKey, matrices));
+		return false;
+	}
+	//-----------------------------------------------------------------------
+	void SkeletonPoseCache::_discardPose(Matrix4* matrices)
+	{
+		PoseMap::iterator i, iend = mPoses.end();
+		for (i = mPoses.begin(); i != iend; ++i)
+		{
+			if (i->second == matrices)
+			{
+				OGRE_FREE(i->second, MEMCATEGORY_ANIMATION);
+				mPoses.erase(i);
+				return;
+			}
+		}
+	}
+}
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreKeyFrame.h"
 #include "OgreBone.h"
 #include "OgreString.h"
+#include "OgreStringConverter.h"
 #include "OgreDataStream.h"
 #include "OgreLogManager.h"
 
@@ -73,6 +74,20 @@ namespace Ogre {
     void SkeletonSerializer::exportSkeleton(const Skeleton* pSkeleton, 
 		DataStreamPtr stream, SkeletonVersion ver, Endian endianMode)
     {
+		if (ver == SKELETON_VERSION_LATEST)
+		{
+			// Compressed tracks are the only 1.90 addition, without them
+			// write a file which older versions can read
+			ver = SKELETON_VERSION_1_8;
+			for (unsigned short i = 0; i < pSkeleton->getNumAnimations(); ++i)
+			{
+				if (pSkeleton->getAnimation(i)->getNumCompressedNodeTracks() > 0)
+				{
+					ver = SKELETON_VERSION_1_9;
+					break;
+				}
+			}
+		}
 		setWorkingVersion(ver);
 		// Decide on endian mode
 		determineEndianness(endianMode);
@@ -169,7 +184,9 @@ namespace Ogre {
 	{
 		if (ver == SKELETON_VERSION_1_0)
 			mVersion = "[Serializer_v1.10]";
-		else mVersion = "[Serializer_v1.80]";
+		else if (ver == SKELETON_VERSION_1_8)
+			mVersion = "[Serializer_v1.80]";
+		else mVersion = "[Serializer_v1.90]";
 	}
 	//---------------------------------------------------------------------
     void SkeletonSerializer::writeSkeleton(const Skeleton* pSkel, SkeletonVersion ver)
@@ -274,6 +291,20 @@ namespace Ogre {
             writeAnimationTrack(pSkel, trackIt.getNext());
         }
 
+		if (anim->getNumCompressedNodeTracks() > 0 &&
+			(int)ver < (int)SKELETON_VERSION_1_9)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Animation " + anim->getName() + " has compressed tracks, which "
+				"require skeleton version 1.9 or later",
+				"SkeletonSerializer::writeAnimation");
+		}
+        Animation::CompressedNodeTrackIterator compressedIt = anim->getCompressedNodeTrackIterator();
+        while(compressedIt.hasMoreElements())
+        {
+            writeCompressedAnimationTrack(pSkel, compressedIt.getNext());
+        }
+
     }
     //---------------------------------------------------------------------
     void SkeletonSerializer::writeAnimationTrack(const Skeleton* pSkel, 
@@ -294,6 +325,39 @@ namespace Ogre {
 
     }
     //---------------------------------------------------------------------
+    void SkeletonSerializer::writeCompressedAnimationTrack(const Skeleton* pSkel, 
+        const CompressedNodeAnimationTrack* track)
+    {
+        writeChunkHeader(SKELETON_ANIMATION_COMPRESSED_TRACK,
+            calcCompressedAnimationTrackSize(pSkel, track));
+
+        // unsigned short boneIndex     : Index of bone to apply to
+        unsigned short boneid = track->getHandle();
+        writeShorts(&boneid, 1);
+
+        for (int c = 0; c < CompressedNodeAnimationTrack::CI_COUNT; ++c)
+        {
+            const CompressedNodeAnimationTrack::Channel& channel =
+                track->_getChannel(static_cast<CompressedNodeAnimationTrack::ChannelIndex>(c));
+            // unsigned short type
+            writeShorts(&channel.type, 1);
+            // float base[4]
+            writeFloats(channel.base, 4);
+            // float step[3]
+            writeFloats(channel.step, 3);
+            // unsigned int numKeys
+            uint32 numKeys = static_cast<uint32>(channel.times.size());
+            writeInts(&numKeys, 1);
+            if (numKeys)
+            {
+                // float times[numKeys]
+                writeFloats(&channel.times[0], channel.times.size());
+                // unsigned short keys[numKeys * 3]
+                writeShorts(&channel.keys[0], channel.keys.size());
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     void SkeletonSerializer::writeKeyFrame(const Skeleton* pSkel, 
         const TransformKeyFrame* key)
     {
@@ -384,6 +448,11 @@ namespace Ogre {
 		{
             size += calcAnimationTrackSize(pSkel, trackIt.getNext());
         }
+		Animation::CompressedNodeTrackIterator compressedIt = pAnim->getCompressedNodeTrackIterator();
+		while(compressedIt.hasMoreElements())
+		{
+            size += calcCompressedAnimationTrackSize(pSkel, compressedIt.getNext());
+        }
 
         return size;
     }
@@ -405,6 +474,28 @@ namespace Ogre {
         return size;
     }
     //---------------------------------------------------------------------
+    size_t SkeletonSerializer::calcCompressedAnimationTrackSize(const Skeleton* pSkel, 
+        const CompressedNodeAnimationTrack* pTrack)
+    {
+        size_t size = SSTREAM_OVERHEAD_SIZE;
+
+        // unsigned short boneIndex     : Index of bone to apply to
+        size += sizeof(unsigned short);
+
+        for (int c = 0; c < CompressedNodeAnimationTrack::CI_COUNT; ++c)
+        {
+            const CompressedNodeAnimationTrack::Channel& channel =
+                pTrack->_getChannel(static_cast<CompressedNodeAnimationTrack::ChannelIndex>(c));
+            // type, base, step, numKeys
+            size += sizeof(unsigned short) + sizeof(float) * 7 + sizeof(uint32);
+            // times, keys
+            size += sizeof(float) * channel.times.size();
+            size += sizeof(unsigned short) * channel.keys.size();
+        }
+
+        return size;
+    }
+    //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcKeyFrameSize(const Skeleton* pSkel, 
         const TransformKeyFrame* pKey)
     {
@@ -452,7 +543,8 @@ namespace Ogre {
 			// Read version
 			String ver = readString(stream);
 			if ((ver != "[Serializer_v1.10]") &&
-				(ver != "[Serializer_v1.80]"))
+				(ver != "[Serializer_v1.80]") &&
+				(ver != "[Serializer_v1.90]"))
 			{
 				OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 					"Invalid file: version incompatible, file reports " + String(ver),
@@ -548,9 +640,13 @@ namespace Ogre {
                 }
 			}
 			
-            while(streamID == SKELETON_ANIMATION_TRACK && !stream->eof())
+            while((streamID == SKELETON_ANIMATION_TRACK ||
+                streamID == SKELETON_ANIMATION_COMPRESSED_TRACK) && !stream->eof())
             {
-                readAnimationTrack(stream, pAnim, pSkel);
+                if (streamID == SKELETON_ANIMATION_TRACK)
+                    readAnimationTrack(stream, pAnim, pSkel);
+                else
+                    readCompressedAnimationTrack(stream, pAnim, pSkel);
 
                 if (!stream->eof())
                 {
@@ -606,6 +702,75 @@ namespace Ogre {
         }
 
 
+    }
+    //---------------------------------------------------------------------
+    void SkeletonSerializer::readCompressedAnimationTrack(DataStreamPtr& stream, Animation* anim, 
+        Skeleton* pSkel)
+    {
+        // unsigned short boneIndex     : Index of bone to apply to
+        unsigned short boneHandle;
+        readShorts(stream, &boneHandle, 1);
+
+        CompressedNodeAnimationTrack* pTrack =
+            anim->createCompressedNodeTrack(boneHandle, pSkel->getBone(boneHandle));
+
+        // Bytes of the chunk still to read, to check the key counts against
+        const size_t trackHeaderSize = SSTREAM_OVERHEAD_SIZE + sizeof(unsigned short);
+        size_t bytesLeft = mCurrentstreamLen > trackHeaderSize ? mCurrentstreamLen - trackHeaderSize : 0;
+        const size_t channelHeaderSize = sizeof(uint16) + sizeof(float) * 7 + sizeof(uint32);
+        const size_t keySize = sizeof(float) + sizeof(uint16) * 3;
+        for (int c = 0; c < CompressedNodeAnimationTrack::CI_COUNT; ++c)
+        {
+            CompressedNodeAnimationTrack::Channel& channel =
+                pTrack->_getChannel(static_cast<CompressedNodeAnimationTrack::ChannelIndex>(c));
+            if (bytesLeft < channelHeaderSize)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                    "Invalid compressed track: chunk too short",
+                    "SkeletonSerializer::readCompressedAnimationTrack");
+            }
+            bytesLeft -= channelHeaderSize;
+            // unsigned short type
+            readShorts(stream, &channel.type, 1);
+            if (channel.type != CompressedNodeAnimationTrack::CT_CONSTANT &&
+                channel.type != CompressedNodeAnimationTrack::CT_ANIMATED)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                    "Invalid compressed track: unknown channel type " +
+                    StringConverter::toString(channel.type),
+                    "SkeletonSerializer::readCompressedAnimationTrack");
+            }
+            // float base[4]
+            readFloats(stream, channel.base, 4);
+            // float step[3]
+            readFloats(stream, channel.step, 3);
+            // unsigned int numKeys
+            uint32 numKeys;
+            readInts(stream, &numKeys, 1);
+            if (numKeys > bytesLeft / keySize)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                    "Invalid compressed track: more keys than the chunk holds",
+                    "SkeletonSerializer::readCompressedAnimationTrack");
+            }
+            bytesLeft -= numKeys * keySize;
+            channel.times.resize(numKeys);
+            channel.keys.resize(numKeys * 3);
+            if (numKeys)
+            {
+                // float times[numKeys]
+                readFloats(stream, &channel.times[0], channel.times.size());
+                // unsigned short keys[numKeys * 3]
+                readShorts(stream, &channel.keys[0], channel.keys.size());
+            }
+
+            if (channel.type == CompressedNodeAnimationTrack::CT_ANIMATED && !numKeys)
+            {
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                    "Invalid compressed track: animated channel without keys",
+                    "SkeletonSerializer::readCompressedAnimationTrack");
+            }
+        }
     }
     //---------------------------------------------------------------------
     void SkeletonSerializer::readKeyFrame(DataStreamPtr& stream, NodeAnimationTrack* track, 
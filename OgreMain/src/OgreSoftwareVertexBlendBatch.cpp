@@ -0,0 +1,255 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreSoftwareVertexBlendBatch.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreParallelFor.h"
+
+namespace Ogre {
+
+	//-----------------------------------------------------------------------
+	/// Performs the blends of a batch on the threads of the WorkQueue
+	class SoftwareVertexBlendTask : public ParallelForTask
+	{
+	public:
+		SoftwareVertexBlendTask(SoftwareVertexBlendBatch* batch)
+			: mBatch(batch)
+		{
+		}
+
+		void execute(size_t begin, size_t end)
+		{
+			mBatch->_blend(begin, end);
+		}
+
+	private:
+		SoftwareVertexBlendBatch* mBatch;
+	};
+	//-----------------------------------------------------------------------
+	SoftwareVertexBlendBatch::SoftwareVertexBlendBatch()
+	{
+	}
+	//-----------------------------------------------------------------------
+	SoftwareVertexBlendBatch::~SoftwareVertexBlendBatch()
+	{
+		unlockBuffers();
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::add(const VertexData* sourceVertexData,
+		const VertexData* targetVertexData,
+		const Matrix4* const* blendMatrices, size_t numMatrices, bool blendNormals)
+	{
+		Blend blend;
+		memset(&blend, 0, sizeof(Blend));
+		blend.source = sourceVertexData;
+		blend.target = targetVertexData;
+		blend.firstMatrix = mBlendMatrices.size();
+		blend.blendNormals = blendNormals;
+		mBlends.push_back(blend);
+		mBlendMatrices.insert(mBlendMatrices.end(), blendMatrices, blendMatrices + numMatrices);
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::add(const VertexData* sourceVertexData,
+		const VertexData* targetVertexData,
+		const DualQuaternion* const* blendDualQuaternions, size_t numDualQuaternions,
+		bool blendNormals)
+	{
+		Blend blend;
+		memset(&blend, 0, sizeof(Blend));
+		blend.source = sourceVertexData;
+		blend.target = targetVertexData;
+		blend.firstMatrix = mBlendDualQuaternions.size();
+		blend.dualQuaternion = true;
+		blend.blendNormals = blendNormals;
+		mBlends.push_back(blend);
+		mBlendDualQuaternions.insert(mBlendDualQuaternions.end(),
+			blendDualQuaternions, blendDualQuaternions + numDualQuaternions);
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::execute(bool parallel)
+	{
+		if (mBlends.empty())
+			return;
+
+		try
+		{
+			BlendList::iterator i, iend = mBlends.end();
+			for (i = mBlends.begin(); i != iend; ++i)
+				lock(*i);
+
+			if (parallel && mBlends.size() > 1)
+			{
+				SoftwareVertexBlendTask task(this);
+				ParallelFor::run(&task, mBlends.size());
+			}
+			else
+			{
+				_blend(0, mBlends.size());
+			}
+		}
+		catch (...)
+		{
+			unlockBuffers();
+			clear();
+			throw;
+		}
+
+		unlockBuffers();
+		clear();
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::clear(void)
+	{
+		mBlends.clear();
+		mBlendMatrices.clear();
+		mBlendDualQuaternions.clear();
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::_blend(size_t begin, size_t end)
+	{
+		OptimisedUtil* util = OptimisedUtil::getImplementation();
+		for (size_t i = begin; i < end; ++i)
+		{
+			const Blend& b = mBlends[i];
+			if (b.dualQuaternion)
+			{
+				util->softwareVertexDualQuaternionSkinning(
+					b.srcPos, b.destPos,
+					b.srcNorm, b.destNorm,
+					b.blendWeight, b.blendIdx,
+					&mBlendDualQuaternions[b.firstMatrix],
+					b.srcPosStride, b.destPosStride,
+					b.srcNormStride, b.destNormStride,
+					b.blendWeightStride, b.blendIdxStride,
+					b.numWeightsPerVertex,
+					b.target->vertexCount);
+			}
+			else
+			{
+				util->softwareVertexSkinning(
+					b.srcPos, b.destPos,
+					b.srcNorm, b.destNorm,
+					b.blendWeight, b.blendIdx,
+					&mBlendMatrices[b.firstMatrix],
+					b.srcPosStride, b.destPosStride,
+					b.srcNormStride, b.destNormStride,
+					b.blendWeightStride, b.blendIdxStride,
+					b.numWeightsPerVertex,
+					b.target->vertexCount);
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::lock(Blend& blend)
+	{
+		// Same as Mesh::softwareVertexBlend
+		const VertexDeclaration* srcDecl = blend.source->vertexDeclaration;
+		const VertexBufferBinding* srcBinding = blend.source->vertexBufferBinding;
+		const VertexElement* srcElemPos = srcDecl->findElementBySemantic(VES_POSITION);
+		const VertexElement* srcElemNorm = srcDecl->findElementBySemantic(VES_NORMAL);
+		const VertexElement* srcElemBlendIndices = srcDecl->findElementBySemantic(VES_BLEND_INDICES);
+		const VertexElement* srcElemBlendWeights = srcDecl->findElementBySemantic(VES_BLEND_WEIGHTS);
+		assert (srcElemPos && srcElemBlendIndices && srcElemBlendWeights &&
+			"You must supply at least positions, blend indices and blend weights");
+		assert(srcElemBlendIndices->getType() == VET_UBYTE4 &&
+			"Blend indices must be VET_UBYTE4");
+
+		const VertexDeclaration* destDecl = blend.target->vertexDeclaration;
+		const VertexBufferBinding* destBinding = blend.target->vertexBufferBinding;
+		const VertexElement* destElemPos = destDecl->findElementBySemantic(VES_POSITION);
+		const VertexElement* destElemNorm = destDecl->findElementBySemantic(VES_NORMAL);
+
+		bool includeNormals = blend.blendNormals && srcElemNorm && destElemNorm;
+
+		// Source buffers are only read, several blends may share them
+		HardwareVertexBufferSharedPtr buf = srcBinding->getBuffer(srcElemPos->getSource());
+		blend.srcPosStride = buf->getVertexSize();
+		srcElemPos->baseVertexPointerToElement(
+			lockBuffer(buf, HardwareBuffer::HBL_READ_ONLY), &blend.srcPos);
+		if (includeNormals)
+		{
+			buf = srcBinding->getBuffer(srcElemNorm->getSource());
+			blend.srcNormStride = buf->getVertexSize();
+			srcElemNorm->baseVertexPointerToElement(
+				lockBuffer(buf, HardwareBuffer::HBL_READ_ONLY), &blend.srcNorm);
+		}
+		buf = srcBinding->getBuffer(srcElemBlendIndices->getSource());
+		blend.blendIdxStride = buf->getVertexSize();
+		srcElemBlendIndices->baseVertexPointerToElement(
+			lockBuffer(buf, HardwareBuffer::HBL_READ_ONLY), &blend.blendIdx);
+		buf = srcBinding->getBuffer(srcElemBlendWeights->getSource());
+		blend.blendWeightStride = buf->getVertexSize();
+		srcElemBlendWeights->baseVertexPointerToElement(
+			lockBuffer(buf, HardwareBuffer::HBL_READ_ONLY), &blend.blendWeight);
+		blend.numWeightsPerVertex =
+			VertexElement::getTypeCount(srcElemBlendWeights->getType());
+
+		// Destination buffers are discarded when entirely overwritten
+		HardwareVertexBufferSharedPtr destPosBuf = destBinding->getBuffer(destElemPos->getSource());
+		HardwareVertexBufferSharedPtr destNormBuf;
+		if (includeNormals)
+			destNormBuf = destBinding->getBuffer(destElemNorm->getSource());
+		blend.destPosStride = destPosBuf->getVertexSize();
+		size_t posSize = destElemPos->getSize();
+		if (includeNormals && destNormBuf == destPosBuf)
+			posSize += destElemNorm->getSize();
+		destElemPos->baseVertexPointerToElement(
+			lockBuffer(destPosBuf, blend.destPosStride == posSize ?
+				HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL),
+			&blend.destPos);
+		if (includeNormals)
+		{
+			blend.destNormStride = destNormBuf->getVertexSize();
+			destElemNorm->baseVertexPointerToElement(
+				lockBuffer(destNormBuf, blend.destNormStride == destElemNorm->getSize() ?
+					HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL),
+				&blend.destNorm);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void* SoftwareVertexBlendBatch::lockBuffer(const HardwareVertexBufferSharedPtr& buf,
+		HardwareBuffer::LockOptions options)
+	{
+		LockedBufferMap::iterator i = mLockedBuffers.find(buf.get());
+		if (i != mLockedBuffers.end())
+			return i->second;
+
+		void* data = buf->lock(options);
+		mLockedBuffers[buf.get()] = data;
+		return data;
+	}
+	//-----------------------------------------------------------------------
+	void SoftwareVertexBlendBatch::unlockBuffers(void)
+	{
+		LockedBufferMap::iterator i, iend = mLockedBuffers.end();
+		for (i = mLockedBuffers.begin(); i != iend; ++i)
+			i->first->unlock();
+		mLockedBuffers.clear();
+	}
+
+}
@@ -564,10 +564,14 @@ namespace Ogre {
 		else
 		{
 			// no response, delete request
-			LogManager::getSingleton().stream() << 
-				"DefaultWorkQueueBase('" << mName << "') warning: no handler processed request "
-				<< r->getID() << ", channel " << r->getChannel()
-				<< ", type " << r->getType();
+			// (aborted requests do not expect one, see RequestHandler::handleRequest)
+			if (!r->getAborted())
+			{
+				LogManager::getSingleton().stream() << 
+					"DefaultWorkQueueBase('" << mName << "') warning: no handler processed request "
+					<< r->getID() << ", channel " << r->getChannel()
+					<< ", type " << r->getType();
+			}
 			OGRE_DELETE r;
 		}
 
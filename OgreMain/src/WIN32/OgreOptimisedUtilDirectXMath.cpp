@@ -99,6 +99,8 @@ namespace DirectX
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -159,6 +161,56 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformSoA& parent,
+            const TransformSoA& local,
+            const Real* inheritOrientation,
+            const Real* inheritScale,
+            const TransformSoA& derived,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::cullAxisAlignedBoxes
+        virtual void cullAxisAlignedBoxes(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* centreX,
+            const Real* centreY,
+            const Real* centreZ,
+            const Real* halfSizeX,
+            const Real* halfSizeY,
+            const Real* halfSizeZ,
+            uint32* visibility,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::softwareVertexPoseBlend
+        virtual void softwareVertexPoseBlend(
+            const Real* weights,
+            const uint32* const* indices,
+            const float* const* offsets,
+            const size_t* numOffsets,
+            size_t numPoses,
+            float* dstPtr,
+            size_t dstStride);
+
+        /// @copydoc OptimisedUtil::softwareVertexDualQuaternionSkinning
+        virtual void softwareVertexDualQuaternionSkinning(
+            const float *pSrcPos,
+            float *pDestPos,
+            const float *pSrcNorm,
+            float *pDestNorm,
+            const float *pBlendWeight,
+            const unsigned char* pBlendIndex,
+            const DualQuaternion* const* blendDualQuaternions,
+            size_t srcPosStride,
+            size_t destPosStride,
+            size_t srcNormStride,
+            size_t destNormStride,
+            size_t blendWeightStride,
+            size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
     };
 
 //---------------------------------------------------------------------
@@ -2032,6 +2084,80 @@ static FORCEINLINE bool _isAlignedForDirectXMath(const void *p)
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilDirectXMath::concatenateNodeTransforms(
+        const TransformSoA& parent,
+        const TransformSoA& local,
+        const Real* inheritOrientation,
+        const Real* inheritScale,
+        const TransformSoA& derived,
+        size_t numNodes)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->concatenateNodeTransforms(
+            parent, local, inheritOrientation, inheritScale, derived, numNodes);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilDirectXMath::cullAxisAlignedBoxes(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* centreX,
+        const Real* centreY,
+        const Real* centreZ,
+        const Real* halfSizeX,
+        const Real* halfSizeY,
+        const Real* halfSizeZ,
+        uint32* visibility,
+        size_t numBoxes)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->cullAxisAlignedBoxes(
+            planes, numPlanes, centreX, centreY, centreZ, halfSizeX, halfSizeY, halfSizeZ, visibility, numBoxes);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilDirectXMath::softwareVertexPoseBlend(
+        const Real* weights,
+        const uint32* const* indices,
+        const float* const* offsets,
+        const size_t* numOffsets,
+        size_t numPoses,
+        float* dstPtr,
+        size_t dstStride)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->softwareVertexPoseBlend(
+            weights, indices, offsets, numOffsets, numPoses, dstPtr, dstStride);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilDirectXMath::softwareVertexDualQuaternionSkinning(
+        const float *pSrcPos,
+        float *pDestPos,
+        const float *pSrcNorm,
+        float *pDestNorm,
+        const float *pBlendWeight,
+        const unsigned char* pBlendIndex,
+        const DualQuaternion* const* blendDualQuaternions,
+        size_t srcPosStride,
+        size_t destPosStride,
+        size_t srcNormStride,
+        size_t destNormStride,
+        size_t blendWeightStride,
+        size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // No vectorised version yet, the general implementation is used
+        _getOptimisedUtilGeneral()->softwareVertexDualQuaternionSkinning(
+            pSrcPos, pDestPos,
+            pSrcNorm, pDestNorm,
+            pBlendWeight, pBlendIndex,
+            blendDualQuaternions,
+            srcPosStride, destPosStride,
+            srcNormStride, destNormStride,
+            blendWeightStride, blendIndexStride,
+            numWeightsPerVertex,
+            numVertices);
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilDirectXMath(void)
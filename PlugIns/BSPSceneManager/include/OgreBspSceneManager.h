@@ -157,6 +157,12 @@ namespace Ogre {
 
         /** Internal method for tagging BspNodes with objects which intersect them. */
         void _notifyObjectMoved(const MovableObject* mov, const Vector3& pos);
+        /** Nodes tag the level with their objects while being updated */
+        bool isParallelSceneGraphUpdateSupported(void) const { return false; }
+        /** BspSceneNode customises _update */
+        bool isBatchedSceneGraphUpdateSupported(void) const { return false; }
+        /** BspSceneNode customises _update */
+        bool isIncrementalSceneGraphUpdateSupported(void) const { return false; }
 		/** Internal method for notifying the level that an object has been detached from a node */
 		void _notifyObjectDetached(const MovableObject* mov);
 
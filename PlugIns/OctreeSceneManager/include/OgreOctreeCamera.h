@@ -81,6 +81,10 @@ public:
     */
     OctreeCamera::Visibility getVisibility( const AxisAlignedBox &bound );
 
+protected:
+    /// Keeps the batched culling of Camera, isVisible is not overridden
+    bool isBatchVisibilityExact( void ) const;
+
 };
 
 }
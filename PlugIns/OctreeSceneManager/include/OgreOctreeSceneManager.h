@@ -104,6 +104,10 @@ public:
 
     /** Does nothing more */
     virtual void _updateSceneGraph( Camera * cam );
+    /** Nodes relocate themselves in the octree while updating their bounds */
+    virtual bool isParallelSceneGraphUpdateSupported( void ) const { return false; }
+    /** Nodes relocate themselves in the octree while updating their bounds */
+    virtual bool isIncrementalSceneGraphUpdateSupported( void ) const { return false; }
     /** Recurses through the octree determining which nodes are visible. */
     virtual void _findVisibleObjects ( Camera * cam, 
 		VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
@@ -123,6 +127,16 @@ public:
 		VisibleObjectsBoundsInfo* visibleBounds, bool foundvisible, 
 		bool onlyShadowCasters);
 
+    /** Walks through the octree like walkOctree, but only records the nodes
+        of the visible octants in mCullingCandidates, to be tested on the
+        worker threads.
+    */
+    void collectOctreeCandidates( OctreeCamera *, Octree *, bool foundvisible );
+
+    /** Adds a node found visible by walkOctree to the render queue. */
+    void addVisibleOctreeNode( OctreeNode *, OctreeCamera *, RenderQueue *,
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
+
     /** Checks the given OctreeNode, and determines if it needs to be moved
     * to a different octant.
     */
@@ -208,6 +222,12 @@ protected:
     /// Number of rendered objs
     int mNumObjects;
 
+    /// Nodes of the visible octants, with whether they must be tested against the camera
+    typedef vector< std::pair< OctreeNode*, bool > >::type CullingCandidateList;
+    CullingCandidateList mCullingCandidates;
+    /// Result of the test of each of mCullingCandidates
+    vector< char >::type mCullingResults;
+
     /// Max depth for the tree
     int mMaxDepth;
     /// Size of the octree
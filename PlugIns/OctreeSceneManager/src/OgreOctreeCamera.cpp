@@ -39,6 +39,8 @@ email                : janders@users.sf.net
 
 #include <OgreOctreeCamera.h>
 
+#include <typeinfo>
+
 namespace Ogre
 {
 OctreeCamera::OctreeCamera( const String& name, SceneManager* sm ) : Camera( name, sm )
@@ -50,6 +52,11 @@ OctreeCamera::~OctreeCamera()
 {
 }
 
+bool OctreeCamera::isBatchVisibilityExact( void ) const
+{
+    return typeid( *this ) == typeid( OctreeCamera );
+}
+
 OctreeCamera::Visibility OctreeCamera::getVisibility( const AxisAlignedBox &bound )
 {
 
@@ -65,10 +65,10 @@ void OctreeNode::_removeNodeAndChildren( )
 {
     static_cast< OctreeSceneManager * > ( mCreator ) -> _removeOctreeNode( this ); 
     //remove all the children nodes as well from the octree.
-    ChildNodeMap::iterator it = mChildren.begin();
+    ChildNodeList::iterator it = mChildren.begin();
     while( it != mChildren.end() )
     {
-        static_cast<OctreeNode *>( it->second ) -> _removeNodeAndChildren();
+        static_cast<OctreeNode *>( *it ) -> _removeNodeAndChildren();
         ++it;
     }
 }
@@ -86,17 +86,14 @@ Node * OctreeNode::removeChild( Node* child )
 }
 void OctreeNode::removeAllChildren()
 {
-	ChildNodeMap::iterator i, iend;
+	ChildNodeList::iterator i, iend;
 	iend = mChildren.end();
 	for (i = mChildren.begin(); i != iend; ++i)
 	{
-		OctreeNode* on = static_cast<OctreeNode*>(i->second);
-		on->setParent(0);
-		on->_removeNodeAndChildren();
+		static_cast<OctreeNode*>(*i)->_removeNodeAndChildren();
 	}
-	mChildren.clear();
-	mChildrenToUpdate.clear();
-	
+	SceneNode::removeAllChildren();
+
 }
     
 Node * OctreeNode::removeChild( const String & name )
@@ -39,6 +39,7 @@ email                : janders@users.sf.net
 #include <OgreOctreeNode.h>
 #include <OgreOctreeCamera.h>
 #include <OgreRenderSystem.h>
+#include <OgreParallelFor.h>
 
 
 extern "C"
@@ -563,6 +564,54 @@ void OctreeSceneManager::_alertVisibleObjects( void )
 //    }
 }
 
+/// Number of nodes tested against the camera at once
+static const size_t CULLING_BATCH = 32;
+
+/// Tests the candidates of a parallel octree walk against the camera
+class OctreeCullingTask : public ParallelForTask
+{
+public:
+    OctreeCullingTask( const OctreeCamera* camera,
+        const std::pair< OctreeNode*, bool >* candidates, char* results )
+        : mCamera( camera ), mCandidates( candidates ), mResults( results )
+    {
+    }
+
+    void execute( size_t begin, size_t end )
+    {
+        // Test the candidates which need it a batch at a time
+        size_t indices[ CULLING_BATCH ];
+        const AxisAlignedBox * bounds[ CULLING_BATCH ];
+        size_t i = begin;
+        while ( i < end )
+        {
+            size_t numTests = 0;
+            for ( ; i < end && numTests < CULLING_BATCH; ++i )
+            {
+                if ( mCandidates[ i ].second )
+                {
+                    indices[ numTests ] = i;
+                    bounds[ numTests++ ] = &mCandidates[ i ].first -> _getWorldAABB();
+                }
+                else
+                {
+                    mResults[ i ] = true;
+                }
+            }
+
+            uint32 visibility;
+            mCamera -> calculateVisibility( bounds, numTests, &visibility );
+            for ( size_t t = 0; t < numTests; ++t )
+                mResults[ indices[ t ] ] = ( visibility & ( 1u << t ) ) != 0;
+        }
+    }
+
+private:
+    const OctreeCamera* mCamera;
+    const std::pair< OctreeNode*, bool >* mCandidates;
+    char* mResults;
+};
+
 void OctreeSceneManager::_findVisibleObjects(Camera * cam, 
 	VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters )
 {
@@ -573,9 +622,40 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
 
     mNumObjects = 0;
 
-    //walk the octree, adding all visible Octreenodes nodes to the render queue.
-    walkOctree( static_cast < OctreeCamera * > ( cam ), getRenderQueue(), mOctree, 
-				visibleBounds, false, onlyShadowCasters );
+    if ( mParallelFrustumCulling && ParallelFor::getThreadCount() > 1 )
+    {
+        // Find the candidates, test them on the worker threads, then add the
+        // visible ones in the order walkOctree would have
+        OctreeCamera* camera = static_cast < OctreeCamera * > ( cam );
+        // Make the lazy update of the frustum planes before the threads read them
+        camera -> getFrustumPlanes();
+        if ( camera -> getCullingFrustum() )
+            camera -> getCullingFrustum() -> getFrustumPlanes();
+        mCullingCandidates.clear();
+        collectOctreeCandidates( camera, mOctree, false );
+
+        size_t numCandidates = mCullingCandidates.size();
+        mCullingResults.resize( numCandidates );
+        if ( numCandidates )
+        {
+            OctreeCullingTask task( camera, &mCullingCandidates[ 0 ], &mCullingResults[ 0 ] );
+            ParallelFor::run( &task, numCandidates, 64 );
+        }
+
+        RenderQueue* queue = getRenderQueue();
+        for ( size_t i = 0; i < numCandidates; ++i )
+        {
+            if ( mCullingResults[ i ] )
+                addVisibleOctreeNode( mCullingCandidates[ i ].first, camera, queue,
+                    visibleBounds, onlyShadowCasters );
+        }
+    }
+    else
+    {
+        //walk the octree, adding all visible Octreenodes nodes to the render queue.
+        walkOctree( static_cast < OctreeCamera * > ( cam ), getRenderQueue(), mOctree, 
+                    visibleBounds, false, onlyShadowCasters );
+    }
 
     // Show the octree boxes & cull camera if required
     if ( mShowBoxes )
@@ -587,6 +667,22 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
     }
 }
 
+void OctreeSceneManager::addVisibleOctreeNode( OctreeNode *sn, OctreeCamera *camera,
+    RenderQueue *queue, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters )
+{
+    mNumObjects++;
+    sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
+
+    mVisible.push_back( sn );
+
+    if ( mDisplayNodes )
+        queue -> addRenderable( sn->getDebugRenderable() );
+
+    // check if the scene manager or this node wants the bounding box shown.
+    if (sn->getShowBoundingBox() || mShowBoundingBoxes)
+        sn->_addBoundingBoxToQueue(queue);
+}
+
 void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue, 
 	Octree *octant, VisibleObjectsBoundsInfo* visibleBounds, 
 	bool foundvisible, bool onlyShadowCasters )
@@ -628,35 +724,28 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
             mBoxes.push_back( octant->getWireBoundingBox() );
         }
 
-        bool vis = true;
-
         while ( it != octant -> mNodes.end() )
         {
-            OctreeNode * sn = *it;
-
             // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
+            // scene nodes attached directly to this level, a batch at a time.
+            OctreeNode * nodes[ CULLING_BATCH ];
+            const AxisAlignedBox * bounds[ CULLING_BATCH ];
+            size_t numNodes = 0;
+            for ( ; it != octant -> mNodes.end() && numNodes < CULLING_BATCH; ++it, ++numNodes )
+            {
+                nodes[ numNodes ] = *it;
+                bounds[ numNodes ] = &( *it ) -> _getWorldAABB();
+            }
 
+            uint32 visibility = 0xFFFFFFFF;
             if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
+                camera -> calculateVisibility( bounds, numNodes, &visibility );
 
-            if ( vis )
+            for ( size_t i = 0; i < numNodes; ++i )
             {
-
-                mNumObjects++;
-                sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
-
-                mVisible.push_back( sn );
-
-                if ( mDisplayNodes )
-                    queue -> addRenderable( sn->getDebugRenderable() );
-
-                // check if the scene manager or this node wants the bounding box shown.
-                if (sn->getShowBoundingBox() || mShowBoundingBoxes)
-                    sn->_addBoundingBoxToQueue(queue);
+                if ( visibility & ( 1u << i ) )
+                    addVisibleOctreeNode( nodes[ i ], camera, queue, visibleBounds, onlyShadowCasters );
             }
-
-            ++it;
         }
 
         Octree* child;
@@ -689,6 +778,56 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
 
 }
 
+void OctreeSceneManager::collectOctreeCandidates( OctreeCamera *camera, Octree *octant,
+    bool foundvisible )
+{
+    if ( octant -> numNodes() == 0 )
+        return ;
+
+    OctreeCamera::Visibility v = OctreeCamera::NONE;
+
+    if ( foundvisible )
+    {
+        v = OctreeCamera::FULL;
+    }
+    else if ( octant == mOctree )
+    {
+        v = OctreeCamera::PARTIAL;
+    }
+    else
+    {
+        AxisAlignedBox box;
+        octant -> _getCullBounds( &box );
+        v = camera -> getVisibility( box );
+    }
+
+    if ( v != OctreeCamera::NONE )
+    {
+        if ( mShowBoxes )
+        {
+            mBoxes.push_back( octant->getWireBoundingBox() );
+        }
+
+        // Nodes of partially visible octants are tested individually later
+        bool partial = ( v == OctreeCamera::PARTIAL );
+        Octree::NodeList::iterator it, itend = octant -> mNodes.end();
+        for ( it = octant -> mNodes.begin(); it != itend; ++it )
+        {
+            mCullingCandidates.push_back( std::make_pair( *it, partial ) );
+        }
+
+        bool childfoundvisible = ( v == OctreeCamera::FULL );
+        for ( int z = 0; z < 2; ++z )
+            for ( int y = 0; y < 2; ++y )
+                for ( int x = 0; x < 2; ++x )
+                {
+                    Octree* child = octant -> mChildren[ x ][ y ][ z ];
+                    if ( child )
+                        collectOctreeCandidates( camera, child, childfoundvisible );
+                }
+    }
+}
+
 // --- non template versions
 void _findNodes( const AxisAlignedBox &t, list< SceneNode * >::type &list, SceneNode *exclude, bool full, Octree *octant )
 {
@@ -155,6 +155,12 @@ namespace Ogre
 
         /** Update Scene Graph (does several things now) */
         virtual void _updateSceneGraph( Camera * cam );
+        /** Nodes update their zones while being updated */
+        virtual bool isParallelSceneGraphUpdateSupported( void ) const { return false; }
+        /** PCZSceneNode customises _update and updateFromParentImpl */
+        virtual bool isBatchedSceneGraphUpdateSupported( void ) const { return false; }
+        /** PCZSceneNode customises _update and updateFromParentImpl */
+        virtual bool isIncrementalSceneGraphUpdateSupported( void ) const { return false; }
 
         /** Recurses through the PCZTree determining which nodes are visible. */
         virtual void _findVisibleObjects ( Camera * cam, 
@@ -3692,6 +3692,9 @@ namespace Ogre
 		}
 
 		HRESULT hr;
+		// Constants unchanged since the last upload are skipped, unless the
+		// program was just bound (see GpuProgramParameters::_isFloatUploadRequired)
+		size_t uploadedBytes = 0;
 		GpuLogicalBufferStructPtr floatLogical = params->getFloatLogicalBufferStruct();
 		GpuLogicalBufferStructPtr intLogical = params->getIntLogicalBufferStruct();
 
@@ -3705,11 +3708,12 @@ namespace Ogre
 					for (GpuLogicalIndexUseMap::const_iterator i = floatLogical->map.begin();
 						i != floatLogical->map.end(); ++i)
 					{
-						if (i->second.variability & variability)
+						if (params->_isFloatUploadRequired(i->second, variability))
 						{
 							size_t logicalIndex = i->first;
 							const float* pFloat = params->getFloatPointer(i->second.physicalIndex);
 							size_t slotCount = i->second.currentSize / 4;
+							uploadedBytes += i->second.currentSize * sizeof(float);
 							assert (i->second.currentSize % 4 == 0 && "Should not have any "
 								"elements less than 4 wide for D3D9");
 
@@ -3732,11 +3736,12 @@ namespace Ogre
 					for (GpuLogicalIndexUseMap::const_iterator i = intLogical->map.begin();
 						i != intLogical->map.end(); ++i)
 					{
-						if (i->second.variability & variability)
+						if (params->_isIntUploadRequired(i->second, variability))
 						{
 							size_t logicalIndex = i->first;
 							const int* pInt = params->getIntPointer(i->second.physicalIndex);
 							size_t slotCount = i->second.currentSize / 4;
+							uploadedBytes += i->second.currentSize * sizeof(int);
 							assert (i->second.currentSize % 4 == 0 && "Should not have any "
 								"elements less than 4 wide for D3D9");
 
@@ -3761,11 +3766,12 @@ namespace Ogre
 					for (GpuLogicalIndexUseMap::const_iterator i = floatLogical->map.begin();
 						i != floatLogical->map.end(); ++i)
 					{
-						if (i->second.variability & variability)
+						if (params->_isFloatUploadRequired(i->second, variability))
 						{
 							size_t logicalIndex = i->first;
 							const float* pFloat = params->getFloatPointer(i->second.physicalIndex);
 							size_t slotCount = i->second.currentSize / 4;
+							uploadedBytes += i->second.currentSize * sizeof(float);
 							assert (i->second.currentSize % 4 == 0 && "Should not have any "
 								"elements less than 4 wide for D3D9");
 
@@ -3787,11 +3793,12 @@ namespace Ogre
 					for (GpuLogicalIndexUseMap::const_iterator i = intLogical->map.begin();
 						i != intLogical->map.end(); ++i)
 					{
-						if (i->second.variability & variability)
+						if (params->_isIntUploadRequired(i->second, variability))
 						{
 							size_t logicalIndex = i->first;
 							const int* pInt = params->getIntPointer(i->second.physicalIndex);
 							size_t slotCount = i->second.currentSize / 4;
+							uploadedBytes += i->second.currentSize * sizeof(int);
 							assert (i->second.currentSize % 4 == 0 && "Should not have any "
 								"elements less than 4 wide for D3D9");
 
@@ -3809,6 +3816,9 @@ namespace Ogre
 			}
 			break;
 		};
+
+		params->_clearDirtyRanges();
+		addGpuProgramParameterBytes(uploadedBytes);
 	}
 	//---------------------------------------------------------------------
 	void D3D9RenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
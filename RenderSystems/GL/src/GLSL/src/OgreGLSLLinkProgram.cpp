@@ -283,7 +283,7 @@ namespace Ogre {
 			if (fromProgType == currentUniform->mSourceProgType)
 			{
 				const GpuConstantDefinition* def = currentUniform->mConstantDef;
-				if (def->variability & mask)
+				if (params->_isUploadRequired(*def, mask))
 				{
 
 					GLsizei glArraySize = (GLsizei)def->arraySize;
@@ -196,7 +196,8 @@ void GLArbGpuProgram::bindProgramParameters(GpuProgramParametersSharedPtr params
 	for (GpuLogicalIndexUseMap::const_iterator i = floatStruct->map.begin();
 		i != floatStruct->map.end(); ++i)
 	{
-		if (i->second.variability & mask)
+		// Skip the constants the program already holds
+		if (params->_isFloatUploadRequired(i->second, mask))
 		{
 			GLuint logicalIndex = static_cast<GLuint>(i->first);
 			const float* pFloat = params->getFloatPointer(i->second.physicalIndex);
@@ -3138,6 +3138,9 @@ GL_RGB_SCALE : GL_ALPHA_SCALE, 1);
 			params->_copySharedParams();
 		}
 
+		// Counted before the upload clears the changed ranges
+		size_t bytes = calculateGpuProgramParameterBytes(params, mask);
+
 		switch (gptype)
 		{
 		case GPT_VERTEX_PROGRAM:
@@ -3157,6 +3160,10 @@ GL_RGB_SCALE : GL_ALPHA_SCALE, 1);
         case GPT_HULL_PROGRAM:
             break;
 		}
+
+		// The program now holds every value
+		params->_clearDirtyRanges();
+		addGpuProgramParameterBytes(bytes);
 	}
 	//---------------------------------------------------------------------
 	void GLRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
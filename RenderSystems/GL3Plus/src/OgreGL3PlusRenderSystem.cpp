@@ -2505,6 +2505,9 @@ namespace Ogre {
                     break;
             }
 //        }
+
+        // GLSL uploads every constant matching the mask, changed or not
+        addGpuProgramParameterBytes(calculateGpuProgramParameterBytes(params, mask, false));
     }
 
     void GL3PlusRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
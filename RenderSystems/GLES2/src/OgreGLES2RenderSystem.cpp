@@ -2268,6 +2268,10 @@ namespace Ogre {
             default:
                 break;
 		}
+
+        // Counts every constant matching the mask handed to the program, the
+        // uniform cache may still skip the values which did not change
+        addGpuProgramParameterBytes(calculateGpuProgramParameterBytes(params, mask, false));
     }
 
     void GLES2RenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
@@ -0,0 +1,79 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwarePixelBuffer_H__
+#define __NullHardwarePixelBuffer_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreHardwarePixelBuffer.h"
+
+namespace Ogre {
+
+	/** Pixel buffer backed by system memory.
+	@remarks
+		Storage is only allocated the first time the buffer is locked or
+		blitted to, so textures that are merely bound during rendering
+		cost nothing but the object itself.
+	*/
+	class _OgreNullExport NullHardwarePixelBuffer : public HardwarePixelBuffer
+	{
+	protected:
+		/// Lock a box
+		PixelBox lockImpl(const Image::Box lockBox, LockOptions options);
+		/// Unlock a box
+		void unlockImpl(void);
+
+		/// Allocate storage on demand
+		void allocateBuffer();
+
+		/// System memory copy of the pixels, allocated on demand
+		PixelBox mBuffer;
+
+		typedef vector<RenderTexture*>::type SliceRTT;
+		SliceRTT mSliceRTT;
+
+	public:
+		/** Constructor.
+		@param baseName Name used to derive render target names when
+			usage includes TU_RENDERTARGET
+		*/
+		NullHardwarePixelBuffer(const String& baseName, uint32 width, uint32 height, uint32 depth,
+			PixelFormat format, HardwareBuffer::Usage usage);
+		~NullHardwarePixelBuffer();
+
+		/// @copydoc HardwarePixelBuffer::blitFromMemory
+		void blitFromMemory(const PixelBox &src, const Image::Box &dstBox);
+		/// @copydoc HardwarePixelBuffer::blitToMemory
+		void blitToMemory(const Image::Box &srcBox, const PixelBox &dst);
+		/// @copydoc HardwarePixelBuffer::getRenderTarget
+		RenderTexture* getRenderTarget(size_t slice);
+		/// Notify buffer of destruction of render target
+		void _clearSliceRTT(size_t zoffset);
+	};
+}
+
+#endif
@@ -0,0 +1,254 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystem_H__
+#define __NullRenderSystem_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderSystem.h"
+#include "OgreHardwareBufferManager.h"
+
+namespace Ogre {
+
+	/** Render system which never talks to a graphics API.
+	@remarks
+		Every call coming down from the SceneManager is accepted and
+		counted but nothing is drawn. Hardware buffers are emulated in
+		system memory through DefaultHardwareBufferManager, textures are
+		never decoded and GPU programs are never compiled. This lets the
+		CPU side of Root::renderOneFrame (culling, render queue building
+		and sorting, pass setup, auto parameter updates) be profiled on
+		machines without a GPU, in isolation from any driver.
+	@par
+		Statistics are gathered per frame, where a frame is one call of
+		_updateAllRenderTargets (i.e. one Root::renderOneFrame). The counts
+		of the last complete frame are available from getLastFrameStats.
+	*/
+	class _OgreNullExport NullRenderSystem : public RenderSystem
+	{
+	public:
+		/// Counters gathered by the Null render system
+		struct FrameStats
+		{
+			/// Number of _render calls
+			size_t drawCalls;
+			/// Number of primitives submitted by those calls
+			size_t primitives;
+			/// Number of fixed function, blending, depth, stencil and sampler state changes
+			size_t stateChanges;
+			/// Number of textures bound to a unit
+			size_t textureBinds;
+			/// Number of GPU programs bound
+			size_t programBinds;
+			/// Number of bindGpuProgramParameters and pass iteration parameter calls
+			size_t parameterUploads;
+			/// Number of bytes those uploads would have transferred, only
+			/// counting the constants changed since they were last uploaded
+			size_t parameterBytes;
+			/// Number of viewports rendered (_beginFrame calls)
+			size_t viewports;
+
+			FrameStats() { reset(); }
+			void reset()
+			{
+				drawCalls = primitives = stateChanges = textureBinds = programBinds =
+					parameterUploads = parameterBytes = viewports = 0;
+			}
+			FrameStats& operator+=(const FrameStats& rhs)
+			{
+				drawCalls += rhs.drawCalls;
+				primitives += rhs.primitives;
+				stateChanges += rhs.stateChanges;
+				textureBinds += rhs.textureBinds;
+				programBinds += rhs.programBinds;
+				parameterUploads += rhs.parameterUploads;
+				parameterBytes += rhs.parameterBytes;
+				viewports += rhs.viewports;
+				return *this;
+			}
+		};
+
+	protected:
+		ConfigOptionMap mOptions;
+		HardwareBufferManager* mHardwareBufferManager;
+		NullGpuProgramManager* mGpuProgramManager;
+
+		/// Counters for the frame currently being rendered
+		FrameStats mCurrentFrameStats;
+		/// Counters of the last complete frame
+		FrameStats mLastFrameStats;
+		/// Counters accumulated since the last resetStatistics
+		FrameStats mTotalStats;
+		/// Number of complete frames since the last resetStatistics
+		size_t mFrameCount;
+
+		void initConfigOptions(void);
+		/// @copydoc RenderSystem::setClipPlanesImpl
+		void setClipPlanesImpl(const PlaneList& clipPlanes);
+
+	public:
+		NullRenderSystem();
+		~NullRenderSystem();
+
+		// ----------------------------------
+		// Overridden RenderSystem functions
+		// ----------------------------------
+		const String& getName(void) const;
+		ConfigOptionMap& getConfigOptions(void);
+		void setConfigOption(const String &name, const String &value);
+		String validateConfigOptions(void);
+		RenderWindow* _initialise(bool autoCreateWindow, const String& windowTitle = "OGRE Render Window");
+		RenderSystemCapabilities* createRenderSystemCapabilities() const;
+		void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary);
+		void reinitialise(void);
+		void shutdown(void);
+		void setAmbientLight(float r, float g, float b);
+		void setShadingType(ShadeOptions so);
+		void setLightingEnabled(bool enabled);
+		RenderWindow* _createRenderWindow(const String &name, unsigned int width, unsigned int height,
+			bool fullScreen, const NameValuePairList *miscParams = 0);
+		bool _createRenderWindows(const RenderWindowDescriptionList& renderWindowDescriptions,
+			RenderWindowList& createdWindows);
+		DepthBuffer* _createDepthBufferFor(RenderTarget *renderTarget);
+		MultiRenderTarget* createMultiRenderTarget(const String & name);
+		String getErrorDescription(long errorNumber) const;
+		VertexElementType getColourVertexElementType(void) const;
+		void setNormaliseNormals(bool normalise);
+		HardwareOcclusionQuery* createHardwareOcclusionQuery(void);
+
+		// -----------------------------
+		// Low-level overridden members
+		// -----------------------------
+		void _useLights(const LightList& lights, unsigned short limit);
+		bool areFixedFunctionLightsInViewSpace() const { return true; }
+		void _setWorldMatrix(const Matrix4 &m);
+		void _setViewMatrix(const Matrix4 &m);
+		void _setProjectionMatrix(const Matrix4 &m);
+		void _setSurfaceParams(const ColourValue &ambient,
+			const ColourValue &diffuse, const ColourValue &specular,
+			const ColourValue &emissive, Real shininess,
+			TrackVertexColourType tracking);
+		void _setPointParameters(Real size, bool attenuationEnabled,
+			Real constant, Real linear, Real quadratic, Real minSize, Real maxSize);
+		void _setPointSpritesEnabled(bool enabled);
+		void _setTexture(size_t unit, bool enabled, const TexturePtr &tex);
+		void _setTextureCoordSet(size_t unit, size_t index);
+		void _setTextureCoordCalculation(size_t unit, TexCoordCalcMethod m,
+			const Frustum* frustum = 0);
+		void _setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm);
+		void _setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter);
+		void _setTextureUnitCompareEnabled(size_t unit, bool compare);
+		void _setTextureUnitCompareFunction(size_t unit, CompareFunction function);
+		void _setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy);
+		void _setTextureAddressingMode(size_t unit, const TextureUnitState::UVWAddressingMode& uvw);
+		void _setTextureBorderColour(size_t unit, const ColourValue& colour);
+		void _setTextureMipmapBias(size_t unit, float bias);
+		void _setTextureMatrix(size_t unit, const Matrix4& xform);
+		void _setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor, SceneBlendOperation op = SBO_ADD);
+		void _setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor, SceneBlendFactor sourceFactorAlpha,
+			SceneBlendFactor destFactorAlpha, SceneBlendOperation op = SBO_ADD, SceneBlendOperation alphaOp = SBO_ADD);
+		void _setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage);
+		void _beginFrame(void);
+		void _endFrame(void);
+		void _setViewport(Viewport *vp);
+		void _setCullingMode(CullingMode mode);
+		void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true, CompareFunction depthFunction = CMPF_LESS_EQUAL);
+		void _setDepthBufferCheckEnabled(bool enabled = true);
+		void _setDepthBufferWriteEnabled(bool enabled = true);
+		void _setDepthBufferFunction(CompareFunction func = CMPF_LESS_EQUAL);
+		void _setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha);
+		void _setDepthBias(float constantBias, float slopeScaleBias = 0.0f);
+		void _setFog(FogMode mode = FOG_NONE, const ColourValue& colour = ColourValue::White,
+			Real expDensity = 1.0, Real linearStart = 0.0, Real linearEnd = 1.0);
+		void _convertProjectionMatrix(const Matrix4& matrix,
+			Matrix4& dest, bool forGpuProgram = false);
+		void _makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+			Matrix4& dest, bool forGpuProgram = false);
+		void _makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+			Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram = false);
+		void _makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+			Matrix4& dest, bool forGpuProgram = false);
+		void _applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane,
+			bool forGpuProgram);
+		void _setPolygonMode(PolygonMode level);
+		void setStencilCheckEnabled(bool enabled);
+		void setStencilBufferParams(CompareFunction func = CMPF_ALWAYS_PASS,
+			uint32 refValue = 0, uint32 compareMask = 0xFFFFFFFF, uint32 writeMask = 0xFFFFFFFF,
+			StencilOperation stencilFailOp = SOP_KEEP,
+			StencilOperation depthFailOp = SOP_KEEP,
+			StencilOperation passOp = SOP_KEEP,
+			bool twoSidedOperation = false);
+		void setVertexDeclaration(VertexDeclaration* decl);
+		void setVertexBufferBinding(VertexBufferBinding* binding);
+		void _render(const RenderOperation& op);
+		void bindGpuProgram(GpuProgram* prg);
+		void unbindGpuProgram(GpuProgramType gptype);
+		void bindGpuProgramParameters(GpuProgramType gptype,
+			GpuProgramParametersSharedPtr params, uint16 variabilityMask);
+		void bindGpuProgramPassIterationParameters(GpuProgramType gptype);
+		void setScissorTest(bool enabled, size_t left = 0, size_t top = 0,
+			size_t right = 800, size_t bottom = 600);
+		void clearFrameBuffer(unsigned int buffers,
+			const ColourValue& colour = ColourValue::Black,
+			Real depth = 1.0f, unsigned short stencil = 0);
+		Real getHorizontalTexelOffset(void);
+		Real getVerticalTexelOffset(void);
+		Real getMinimumDepthInputValue(void);
+		Real getMaximumDepthInputValue(void);
+		void _setRenderTarget(RenderTarget *target);
+		void registerThread() {}
+		void unregisterThread() {}
+		void preExtraThreadsStarted() {}
+		void postExtraThreadsStarted() {}
+		unsigned int getDisplayMonitorCount() const { return 1; }
+		void beginProfileEvent(const String &eventName) {}
+		void endProfileEvent(void) {}
+		void markProfileEvent(const String &event) {}
+		bool hasAnisotropicMipMapFilter() const { return true; }
+
+		/// @copydoc RenderSystem::_updateAllRenderTargets
+		void _updateAllRenderTargets(bool swapBuffers = true);
+
+		// ----------------------------------
+		// NullRenderSystem specific members
+		// ----------------------------------
+		/// Counters of the last completed frame
+		const FrameStats& getLastFrameStats(void) const { return mLastFrameStats; }
+		/// Counters of the frame in progress
+		const FrameStats& getCurrentFrameStats(void) const { return mCurrentFrameStats; }
+		/// Counters accumulated over all frames since the last resetStatistics
+		const FrameStats& getTotalStats(void) const { return mTotalStats; }
+		/// Number of frames completed since the last resetStatistics
+		size_t getFrameCount(void) const { return mFrameCount; }
+		/// Reset all counters
+		void resetStatistics(void);
+		/// Write the per frame averages to the default log
+		void logStatistics(void) const;
+	};
+}
+
+#endif
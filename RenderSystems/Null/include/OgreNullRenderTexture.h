@@ -0,0 +1,65 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderTexture_H__
+#define __NullRenderTexture_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderTexture.h"
+
+namespace Ogre {
+
+	/** RenderTexture for the Null render system; renders nothing. */
+	class _OgreNullExport NullRenderTexture : public RenderTexture
+	{
+	public:
+		NullRenderTexture(const String& name, HardwarePixelBuffer* buffer, uint32 zoffset);
+
+		/// @copydoc RenderTarget::requiresTextureFlipping
+		bool requiresTextureFlipping() const { return false; }
+	};
+
+	/** MultiRenderTarget for the Null render system; binding only keeps
+		track of the surfaces.
+	*/
+	class _OgreNullExport NullMultiRenderTarget : public MultiRenderTarget
+	{
+	public:
+		NullMultiRenderTarget(const String& name);
+
+		/// @copydoc RenderTarget::requiresTextureFlipping
+		bool requiresTextureFlipping() const { return false; }
+
+	protected:
+		/// @copydoc MultiRenderTarget::bindSurfaceImpl
+		void bindSurfaceImpl(size_t attachment, RenderTexture *target);
+		/// @copydoc MultiRenderTarget::unbindSurfaceImpl
+		void unbindSurfaceImpl(size_t attachment);
+	};
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderWindow_H__
+#define __NullRenderWindow_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderWindow.h"
+
+namespace Ogre {
+
+	/** A window that never appears on screen.
+	@remarks
+		Rendering to a NullRenderWindow goes through the whole CPU side of the
+		frame (culling, queueing, pass setup, auto parameter updates) but no
+		pixels are ever produced. The window is always 'active' so Root keeps
+		updating it regardless of any desktop focus.
+	*/
+	class _OgreNullExport NullRenderWindow : public RenderWindow
+	{
+	public:
+		NullRenderWindow();
+		~NullRenderWindow();
+
+		/// @copydoc RenderWindow::create
+		void create(const String& name, unsigned int width, unsigned int height,
+			bool fullScreen, const NameValuePairList *miscParams);
+		/// @copydoc RenderWindow::setFullscreen
+		void setFullscreen(bool fullScreen, unsigned int width, unsigned int height);
+		/// @copydoc RenderWindow::destroy
+		void destroy(void);
+		/// @copydoc RenderWindow::resize
+		void resize(unsigned int width, unsigned int height);
+		/// @copydoc RenderWindow::reposition
+		void reposition(int left, int top);
+		/// @copydoc RenderWindow::isClosed
+		bool isClosed(void) const { return mClosed; }
+		/// @copydoc RenderTarget::copyContentsToMemory
+		void copyContentsToMemory(const PixelBox &dst, FrameBuffer buffer);
+		/// @copydoc RenderTarget::requiresTextureFlipping
+		bool requiresTextureFlipping() const { return false; }
+		/// @copydoc RenderTarget::getCustomAttribute
+		void getCustomAttribute(const String& name, void* pData);
+
+	protected:
+		bool mClosed;
+	};
+}
+
+#endif
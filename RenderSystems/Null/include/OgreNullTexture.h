@@ -0,0 +1,69 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullTexture_H__
+#define __NullTexture_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreTexture.h"
+#include "OgreHardwarePixelBuffer.h"
+
+namespace Ogre {
+
+	/** Texture for the Null render system.
+	@remarks
+		Image files are never decoded; a texture loaded from a file keeps
+		whatever size and format were requested (512x512 A8R8G8B8 unless
+		specified) so binding it costs the same as on a real API without
+		requiring any image codec on the build machine. Surfaces are backed
+		by NullHardwarePixelBuffer, so manual and render target textures
+		behave as usual.
+	*/
+	class _OgreNullExport NullTexture : public Texture
+	{
+	public:
+		NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+			const String& group, bool isManual, ManualResourceLoader* loader);
+		virtual ~NullTexture();
+
+		/// @copydoc Texture::getBuffer
+		HardwarePixelBufferSharedPtr getBuffer(size_t face, size_t mipmap);
+
+	protected:
+		/// @copydoc Texture::createInternalResourcesImpl
+		void createInternalResourcesImpl(void);
+		/// @copydoc Texture::freeInternalResourcesImpl
+		void freeInternalResourcesImpl(void);
+		/// @copydoc Resource::loadImpl
+		void loadImpl(void);
+
+		typedef vector<HardwarePixelBufferSharedPtr>::type SurfaceList;
+		SurfaceList mSurfaceList;
+	};
+}
+
+#endif
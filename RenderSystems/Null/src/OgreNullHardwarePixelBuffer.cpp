@@ -0,0 +1,144 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullHardwarePixelBuffer.h"
+#include "OgreNullRenderTexture.h"
+#include "OgreException.h"
+#include "OgreRoot.h"
+#include "OgreRenderSystem.h"
+#include "OgreStringConverter.h"
+#include "OgreTexture.h"
+
+namespace Ogre {
+	//-----------------------------------------------------------------------------
+	NullHardwarePixelBuffer::NullHardwarePixelBuffer(const String& baseName,
+		uint32 width, uint32 height, uint32 depth,
+		PixelFormat format, HardwareBuffer::Usage usage)
+		: HardwarePixelBuffer(width, height, depth, format, usage, true, false),
+		mBuffer(width, height, depth, format)
+	{
+		if (mUsage & TU_RENDERTARGET)
+		{
+			// Create render target for each slice
+			mSliceRTT.reserve(mDepth);
+			for (uint32 zoffset = 0; zoffset < mDepth; ++zoffset)
+			{
+				String name = "rtt/" + StringConverter::toString((size_t)this) + "/" + baseName;
+				RenderTexture* rtt = OGRE_NEW NullRenderTexture(name, this, zoffset);
+				mSliceRTT.push_back(rtt);
+				Root::getSingleton().getRenderSystem()->attachRenderTarget(*rtt);
+			}
+		}
+	}
+	//-----------------------------------------------------------------------------
+	NullHardwarePixelBuffer::~NullHardwarePixelBuffer()
+	{
+		// Delete all render targets that were not deleted by the user
+		for (SliceRTT::const_iterator it = mSliceRTT.begin(); it != mSliceRTT.end(); ++it)
+		{
+			if (*it)
+				Root::getSingleton().getRenderSystem()->destroyRenderTarget((*it)->getName());
+		}
+
+		OGRE_FREE(mBuffer.data, MEMCATEGORY_RENDERSYS);
+	}
+	//-----------------------------------------------------------------------------
+	void NullHardwarePixelBuffer::allocateBuffer()
+	{
+		if (mBuffer.data)
+			return;
+
+		mBuffer.data = OGRE_MALLOC(mSizeInBytes, MEMCATEGORY_RENDERSYS);
+		memset(mBuffer.data, 0, mSizeInBytes);
+	}
+	//-----------------------------------------------------------------------------
+	PixelBox NullHardwarePixelBuffer::lockImpl(const Image::Box lockBox, LockOptions options)
+	{
+		allocateBuffer();
+		return mBuffer.getSubVolume(lockBox);
+	}
+	//-----------------------------------------------------------------------------
+	void NullHardwarePixelBuffer::unlockImpl(void)
+	{
+		// Contents stay in system memory
+	}
+	//-----------------------------------------------------------------------------
+	void NullHardwarePixelBuffer::blitFromMemory(const PixelBox &src, const Image::Box &dstBox)
+	{
+		if (!mBuffer.contains(dstBox))
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "destination box out of range",
+				"NullHardwarePixelBuffer::blitFromMemory");
+
+		allocateBuffer();
+		PixelBox dst = mBuffer.getSubVolume(dstBox);
+		if (src.getWidth() != dstBox.getWidth() ||
+			src.getHeight() != dstBox.getHeight() ||
+			src.getDepth() != dstBox.getDepth())
+		{
+			// Scale to destination size, also converts the format
+			Image::scale(src, dst, Image::FILTER_BILINEAR);
+		}
+		else
+		{
+			PixelUtil::bulkPixelConversion(src, dst);
+		}
+	}
+	//-----------------------------------------------------------------------------
+	void NullHardwarePixelBuffer::blitToMemory(const Image::Box &srcBox, const PixelBox &dst)
+	{
+		if (!mBuffer.contains(srcBox))
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "source box out of range",
+				"NullHardwarePixelBuffer::blitToMemory");
+
+		allocateBuffer();
+		PixelBox src = mBuffer.getSubVolume(srcBox);
+		if (srcBox.getWidth() != dst.getWidth() ||
+			srcBox.getHeight() != dst.getHeight() ||
+			srcBox.getDepth() != dst.getDepth())
+		{
+			Image::scale(src, dst, Image::FILTER_BILINEAR);
+		}
+		else
+		{
+			PixelUtil::bulkPixelConversion(src, dst);
+		}
+	}
+	//-----------------------------------------------------------------------------
+	RenderTexture* NullHardwarePixelBuffer::getRenderTarget(size_t zoffset)
+	{
+		assert(mUsage & TU_RENDERTARGET);
+		assert(zoffset < mDepth);
+		return mSliceRTT[zoffset];
+	}
+	//-----------------------------------------------------------------------------
+	void NullHardwarePixelBuffer::_clearSliceRTT(size_t zoffset)
+	{
+		if (zoffset < mSliceRTT.size())
+			mSliceRTT[zoffset] = 0;
+	}
+}
@@ -0,0 +1,845 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullRenderSystem.h"
+#include "OgreNullRenderWindow.h"
+#include "OgreNullRenderTexture.h"
+#include "OgreNullTextureManager.h"
+#include "OgreNullGpuProgramManager.h"
+#include "OgreNullHardwareOcclusionQuery.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreDepthBuffer.h"
+#include "OgreGpuProgramParams.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgreException.h"
+#include "OgreFrustum.h"
+#include "OgreVector4.h"
+
+namespace Ogre {
+	//---------------------------------------------------------------------
+	NullRenderSystem::NullRenderSystem()
+		: mHardwareBufferManager(0),
+		mGpuProgramManager(0),
+		mFrameCount(0)
+	{
+		LogManager::getSingleton().logMessage(getName() + " created.");
+
+		initConfigOptions();
+	}
+	//---------------------------------------------------------------------
+	NullRenderSystem::~NullRenderSystem()
+	{
+		shutdown();
+	}
+	//---------------------------------------------------------------------
+	const String& NullRenderSystem::getName(void) const
+	{
+		static String strName("Null Rendering Subsystem");
+		return strName;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::initConfigOptions(void)
+	{
+		ConfigOption optFullScreen;
+		optFullScreen.name = "Full Screen";
+		optFullScreen.possibleValues.push_back("No");
+		optFullScreen.possibleValues.push_back("Yes");
+		optFullScreen.currentValue = "No";
+		optFullScreen.immutable = false;
+		mOptions[optFullScreen.name] = optFullScreen;
+
+		ConfigOption optVideoMode;
+		optVideoMode.name = "Video Mode";
+		optVideoMode.possibleValues.push_back("640 x 480");
+		optVideoMode.possibleValues.push_back("800 x 600");
+		optVideoMode.possibleValues.push_back("1024 x 768");
+		optVideoMode.possibleValues.push_back("1280 x 720");
+		optVideoMode.possibleValues.push_back("1920 x 1080");
+		optVideoMode.currentValue = "800 x 600";
+		optVideoMode.immutable = false;
+		mOptions[optVideoMode.name] = optVideoMode;
+
+		ConfigOption optLogStats;
+		optLogStats.name = "Log Statistics On Shutdown";
+		optLogStats.possibleValues.push_back("No");
+		optLogStats.possibleValues.push_back("Yes");
+		optLogStats.currentValue = "Yes";
+		optLogStats.immutable = false;
+		mOptions[optLogStats.name] = optLogStats;
+	}
+	//---------------------------------------------------------------------
+	ConfigOptionMap& NullRenderSystem::getConfigOptions(void)
+	{
+		return mOptions;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setConfigOption(const String &name, const String &value)
+	{
+		ConfigOptionMap::iterator it = mOptions.find(name);
+		if (it == mOptions.end())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Option named '" + name + "' does not exist.",
+				"NullRenderSystem::setConfigOption");
+		}
+		it->second.currentValue = value;
+	}
+	//---------------------------------------------------------------------
+	String NullRenderSystem::validateConfigOptions(void)
+	{
+		return StringUtil::BLANK;
+	}
+	//---------------------------------------------------------------------
+	RenderWindow* NullRenderSystem::_initialise(bool autoCreateWindow, const String& windowTitle)
+	{
+		// There is no context to wait for, so everything that depends on
+		// the capabilities is set up right away. This allows meshes and
+		// materials to be loaded without ever creating a window.
+		mTextureManager = OGRE_NEW NullTextureManager();
+
+		mRealCapabilities = createRenderSystemCapabilities();
+		if (!mUseCustomCapabilities)
+			mCurrentCapabilities = mRealCapabilities;
+
+		fireEvent("RenderSystemCapabilitiesCreated");
+
+		initialiseFromRenderSystemCapabilities(mCurrentCapabilities, 0);
+
+		RenderWindow* autoWindow = 0;
+		if (autoCreateWindow)
+		{
+			unsigned int width = 800, height = 600;
+			StringVector tokens = StringUtil::split(mOptions["Video Mode"].currentValue, " x");
+			if (tokens.size() >= 2)
+			{
+				width = StringConverter::parseUnsignedInt(tokens[0], width);
+				height = StringConverter::parseUnsignedInt(tokens[1], height);
+			}
+			bool fullScreen = mOptions["Full Screen"].currentValue == "Yes";
+
+			autoWindow = _createRenderWindow(windowTitle, width, height, fullScreen);
+		}
+
+		RenderSystem::_initialise(autoCreateWindow, windowTitle);
+
+		return autoWindow;
+	}
+	//---------------------------------------------------------------------
+	RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+	{
+		RenderSystemCapabilities* rsc = OGRE_NEW RenderSystemCapabilities();
+
+		rsc->setRenderSystemName(getName());
+		rsc->setDeviceName("Null Device");
+		rsc->setVendor(GPU_UNKNOWN);
+		DriverVersion version;
+		version.major = OGRE_VERSION_MAJOR;
+		version.minor = OGRE_VERSION_MINOR;
+		version.release = OGRE_VERSION_PATCH;
+		version.build = 0;
+		rsc->setDriverVersion(version);
+
+		rsc->setCapability(RSC_FIXED_FUNCTION);
+		rsc->setCapability(RSC_AUTOMIPMAP);
+		rsc->setCapability(RSC_BLENDING);
+		rsc->setCapability(RSC_ANISOTROPY);
+		rsc->setCapability(RSC_DOT3);
+		rsc->setCapability(RSC_CUBEMAPPING);
+		rsc->setCapability(RSC_HWSTENCIL);
+		rsc->setCapability(RSC_VBO);
+		rsc->setCapability(RSC_32BIT_INDEX);
+		rsc->setCapability(RSC_SCISSOR_TEST);
+		rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+		rsc->setCapability(RSC_STENCIL_WRAP);
+		rsc->setCapability(RSC_HWOCCLUSION);
+		rsc->setCapability(RSC_USER_CLIP_PLANES);
+		rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+		rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+		rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+		rsc->setCapability(RSC_TEXTURE_FLOAT);
+		rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+		rsc->setCapability(RSC_TEXTURE_1D);
+		rsc->setCapability(RSC_TEXTURE_3D);
+		rsc->setCapability(RSC_POINT_SPRITES);
+		rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+		rsc->setCapability(RSC_MIPMAP_LOD_BIAS);
+		rsc->setCapability(RSC_ALPHA_TO_COVERAGE);
+		rsc->setCapability(RSC_ADVANCED_BLEND_OPERATIONS);
+		rsc->setCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA);
+		rsc->setCapability(RSC_RTT_SEPARATE_DEPTHBUFFER);
+		rsc->setCapability(RSC_RTT_MAIN_DEPTHBUFFER_ATTACHABLE);
+		rsc->setCapability(RSC_TEXTURE_COMPRESSION);
+		rsc->setCapability(RSC_TEXTURE_COMPRESSION_DXT);
+
+		rsc->setNumTextureUnits(16);
+		rsc->setNumVertexTextureUnits(4);
+		rsc->setVertexTextureUnitsShared(true);
+		rsc->setCapability(RSC_VERTEX_TEXTURE_FETCH);
+		rsc->setNumWorldMatrices(0);
+		rsc->setNumVertexBlendMatrices(0);
+		rsc->setNumMultiRenderTargets(4);
+		rsc->setStencilBufferBitDepth(8);
+		rsc->setMaxPointSize(256);
+		rsc->setMaxSupportedAnisotropy(16);
+
+		// Accept the common assembler profiles so that low level programs
+		// referenced by materials are loaded and their parameters bound
+		rsc->setCapability(RSC_VERTEX_PROGRAM);
+		rsc->addShaderProfile("arbvp1");
+		rsc->addShaderProfile("vs_1_1");
+		rsc->addShaderProfile("vs_2_0");
+		rsc->addShaderProfile("vs_3_0");
+		rsc->setVertexProgramConstantFloatCount(256);
+		rsc->setVertexProgramConstantIntCount(16);
+		rsc->setVertexProgramConstantBoolCount(16);
+
+		rsc->setCapability(RSC_FRAGMENT_PROGRAM);
+		rsc->addShaderProfile("arbfp1");
+		rsc->addShaderProfile("ps_2_0");
+		rsc->addShaderProfile("ps_3_0");
+		rsc->setFragmentProgramConstantFloatCount(224);
+		rsc->setFragmentProgramConstantIntCount(16);
+		rsc->setFragmentProgramConstantBoolCount(16);
+
+		return rsc;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary)
+	{
+		if (caps->getRenderSystemName() != getName())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Trying to initialize NullRenderSystem from RenderSystemCapabilities that do not support Null",
+				"NullRenderSystem::initialiseFromRenderSystemCapabilities");
+		}
+
+		mHardwareBufferManager = OGRE_NEW DefaultHardwareBufferManager();
+		mGpuProgramManager = OGRE_NEW NullGpuProgramManager();
+
+		Log* defaultLog = LogManager::getSingleton().getDefaultLog();
+		if (defaultLog)
+		{
+			caps->log(defaultLog);
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::reinitialise(void)
+	{
+		this->shutdown();
+		this->_initialise(true);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::shutdown(void)
+	{
+		// Root::shutdown and the destructor both get here, only log once
+		if (mFrameCount && mOptions["Log Statistics On Shutdown"].currentValue == "Yes")
+		{
+			logStatistics();
+			resetStatistics();
+		}
+
+		RenderSystem::shutdown();
+
+		OGRE_DELETE mGpuProgramManager;
+		mGpuProgramManager = 0;
+
+		OGRE_DELETE mHardwareBufferManager;
+		mHardwareBufferManager = 0;
+
+		OGRE_DELETE mTextureManager;
+		mTextureManager = 0;
+	}
+	//---------------------------------------------------------------------
+	RenderWindow* NullRenderSystem::_createRenderWindow(const String &name,
+		unsigned int width, unsigned int height, bool fullScreen,
+		const NameValuePairList *miscParams)
+	{
+		if (mRenderTargets.find(name) != mRenderTargets.end())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Window with name '" + name + "' already exists",
+				"NullRenderSystem::_createRenderWindow");
+		}
+
+		NullRenderWindow* win = OGRE_NEW NullRenderWindow();
+		win->create(name, width, height, fullScreen, miscParams);
+
+		attachRenderTarget(*win);
+
+		if (win->getDepthBufferPool() != DepthBuffer::POOL_NO_DEPTH)
+		{
+			DepthBuffer* depthBuffer = OGRE_NEW DepthBuffer(DepthBuffer::POOL_DEFAULT, 24,
+				win->getWidth(), win->getHeight(), win->getFSAA(), win->getFSAAHint(), true);
+
+			mDepthBufferPool[depthBuffer->getPoolId()].push_back(depthBuffer);
+
+			win->attachDepthBuffer(depthBuffer);
+		}
+
+		return win;
+	}
+	//---------------------------------------------------------------------
+	bool NullRenderSystem::_createRenderWindows(const RenderWindowDescriptionList& renderWindowDescriptions,
+		RenderWindowList& createdWindows)
+	{
+		// Call base render system method.
+		if (false == RenderSystem::_createRenderWindows(renderWindowDescriptions, createdWindows))
+			return false;
+
+		for (size_t i = 0; i < renderWindowDescriptions.size(); ++i)
+		{
+			const RenderWindowDescription& curDesc = renderWindowDescriptions[i];
+			RenderWindow* curWindow = _createRenderWindow(curDesc.name,
+				curDesc.width, curDesc.height, curDesc.useFullScreen, &curDesc.miscParams);
+
+			createdWindows.push_back(curWindow);
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	DepthBuffer* NullRenderSystem::_createDepthBufferFor(RenderTarget *renderTarget)
+	{
+		return OGRE_NEW DepthBuffer(DepthBuffer::POOL_DEFAULT, 24,
+			renderTarget->getWidth(), renderTarget->getHeight(),
+			renderTarget->getFSAA(), renderTarget->getFSAAHint(), false);
+	}
+	//---------------------------------------------------------------------
+	MultiRenderTarget* NullRenderSystem::createMultiRenderTarget(const String & name)
+	{
+		MultiRenderTarget* retval = OGRE_NEW NullMultiRenderTarget(name);
+		attachRenderTarget(*retval);
+		return retval;
+	}
+	//---------------------------------------------------------------------
+	String NullRenderSystem::getErrorDescription(long errorNumber) const
+	{
+		return StringUtil::BLANK;
+	}
+	//---------------------------------------------------------------------
+	VertexElementType NullRenderSystem::getColourVertexElementType(void) const
+	{
+		return VET_COLOUR_ABGR;
+	}
+	//---------------------------------------------------------------------
+	HardwareOcclusionQuery* NullRenderSystem::createHardwareOcclusionQuery(void)
+	{
+		NullHardwareOcclusionQuery* ret = OGRE_NEW NullHardwareOcclusionQuery();
+		mHwOcclusionQueries.push_back(ret);
+		return ret;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setAmbientLight(float r, float g, float b)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setShadingType(ShadeOptions so)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setLightingEnabled(bool enabled)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setNormaliseNormals(bool normalise)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_useLights(const LightList& lights, unsigned short limit)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setWorldMatrix(const Matrix4 &m)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setViewMatrix(const Matrix4 &m)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setProjectionMatrix(const Matrix4 &m)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setSurfaceParams(const ColourValue &ambient,
+		const ColourValue &diffuse, const ColourValue &specular,
+		const ColourValue &emissive, Real shininess,
+		TrackVertexColourType tracking)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setPointParameters(Real size, bool attenuationEnabled,
+		Real constant, Real linear, Real quadratic, Real minSize, Real maxSize)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setPointSpritesEnabled(bool enabled)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTexture(size_t unit, bool enabled, const TexturePtr &tex)
+	{
+		if (enabled && !tex.isNull())
+		{
+			// Make sure the texture is loaded, as a real API would
+			tex->touch();
+			++mCurrentFrameStats.textureBinds;
+		}
+		else
+		{
+			++mCurrentFrameStats.stateChanges;
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureCoordSet(size_t unit, size_t index)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureCoordCalculation(size_t unit, TexCoordCalcMethod m,
+		const Frustum* frustum)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureUnitCompareEnabled(size_t unit, bool compare)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureUnitCompareFunction(size_t unit, CompareFunction function)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureAddressingMode(size_t unit, const TextureUnitState::UVWAddressingMode& uvw)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureBorderColour(size_t unit, const ColourValue& colour)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureMipmapBias(size_t unit, float bias)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureMatrix(size_t unit, const Matrix4& xform)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setSceneBlending(SceneBlendFactor sourceFactor,
+		SceneBlendFactor destFactor, SceneBlendOperation op)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setSeparateSceneBlending(SceneBlendFactor sourceFactor,
+		SceneBlendFactor destFactor, SceneBlendFactor sourceFactorAlpha,
+		SceneBlendFactor destFactorAlpha, SceneBlendOperation op, SceneBlendOperation alphaOp)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_beginFrame(void)
+	{
+		++mCurrentFrameStats.viewports;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_endFrame(void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setViewport(Viewport *vp)
+	{
+		if (vp != mActiveViewport || vp->_isUpdated())
+		{
+			mActiveViewport = vp;
+			if (vp)
+			{
+				_setRenderTarget(vp->getTarget());
+				vp->_clearUpdatedFlag();
+			}
+			++mCurrentFrameStats.stateChanges;
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setCullingMode(CullingMode mode)
+	{
+		mCullingMode = mode;
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferParams(bool depthTest, bool depthWrite, CompareFunction depthFunction)
+	{
+		_setDepthBufferCheckEnabled(depthTest);
+		_setDepthBufferWriteEnabled(depthWrite);
+		_setDepthBufferFunction(depthFunction);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferCheckEnabled(bool enabled)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferWriteEnabled(bool enabled)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferFunction(CompareFunction func)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBias(float constantBias, float slopeScaleBias)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setFog(FogMode mode, const ColourValue& colour, Real expDensity,
+		Real linearStart, Real linearEnd)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_convertProjectionMatrix(const Matrix4& matrix,
+		Matrix4& dest, bool forGpuProgram)
+	{
+		// Same conventions as OpenGL, no conversion needed
+		dest = matrix;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane,
+		Real farPlane, Matrix4& dest, bool forGpuProgram)
+	{
+		Radian thetaY(fovy / 2.0f);
+		Real tanThetaY = Math::Tan(thetaY);
+
+		// Calc matrix elements
+		Real w = (1.0f / tanThetaY) / aspect;
+		Real h = 1.0f / tanThetaY;
+		Real q, qn;
+		if (farPlane == 0)
+		{
+			// Infinite far plane
+			q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+			qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+		}
+		else
+		{
+			q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+			qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+		}
+
+		dest = Matrix4::ZERO;
+		dest[0][0] = w;
+		dest[1][1] = h;
+		dest[2][2] = q;
+		dest[2][3] = qn;
+		dest[3][2] = -1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_makeProjectionMatrix(Real left, Real right,
+		Real bottom, Real top, Real nearPlane, Real farPlane, Matrix4& dest,
+		bool forGpuProgram)
+	{
+		Real width = right - left;
+		Real height = top - bottom;
+		Real q, qn;
+		if (farPlane == 0)
+		{
+			// Infinite far plane
+			q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+			qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+		}
+		else
+		{
+			q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+			qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+		}
+		dest = Matrix4::ZERO;
+		dest[0][0] = 2 * nearPlane / width;
+		dest[0][2] = (right+left) / width;
+		dest[1][1] = 2 * nearPlane / height;
+		dest[1][2] = (top+bottom) / height;
+		dest[2][2] = q;
+		dest[2][3] = qn;
+		dest[3][2] = -1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane,
+		Real farPlane, Matrix4& dest, bool forGpuProgram)
+	{
+		Radian thetaY(fovy / 2.0f);
+		Real tanThetaY = Math::Tan(thetaY);
+
+		Real tanThetaX = tanThetaY * aspect;
+		Real half_w = tanThetaX * nearPlane;
+		Real half_h = tanThetaY * nearPlane;
+		Real iw = 1.0f / half_w;
+		Real ih = 1.0f / half_h;
+		Real q;
+		if (farPlane == 0)
+		{
+			q = 0;
+		}
+		else
+		{
+			q = 2.0f / (farPlane - nearPlane);
+		}
+		dest = Matrix4::ZERO;
+		dest[0][0] = iw;
+		dest[1][1] = ih;
+		dest[2][2] = -q;
+		dest[2][3] = - (farPlane + nearPlane)/(farPlane - nearPlane);
+		dest[3][3] = 1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane,
+		bool forGpuProgram)
+	{
+		// Calculate the clip-space corner point opposite the clipping plane
+		// and transform it into camera space, as in the GL render system
+		Vector4 q;
+		q.x = (Math::Sign(plane.normal.x) + matrix[0][2]) / matrix[0][0];
+		q.y = (Math::Sign(plane.normal.y) + matrix[1][2]) / matrix[1][1];
+		q.z = -1.0F;
+		q.w = (1.0F + matrix[2][2]) / matrix[2][3];
+
+		// Calculate the scaled plane vector
+		Vector4 clipPlane4d(plane.normal.x, plane.normal.y, plane.normal.z, plane.d);
+		Vector4 c = clipPlane4d * (2.0F / (clipPlane4d.dotProduct(q)));
+
+		// Replace the third row of the projection matrix
+		matrix[2][0] = c.x;
+		matrix[2][1] = c.y;
+		matrix[2][2] = c.z + 1.0F;
+		matrix[2][3] = c.w;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setPolygonMode(PolygonMode level)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setStencilCheckEnabled(bool enabled)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setStencilBufferParams(CompareFunction func,
+		uint32 refValue, uint32 compareMask, uint32 writeMask,
+		StencilOperation stencilFailOp, StencilOperation depthFailOp,
+		StencilOperation passOp, bool twoSidedOperation)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setVertexDeclaration(VertexDeclaration* decl)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setVertexBufferBinding(VertexBufferBinding* binding)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setClipPlanesImpl(const PlaneList& clipPlanes)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_render(const RenderOperation& op)
+	{
+		size_t faceCount = mFaceCount;
+
+		// Call super class, updates the geometry statistics
+		RenderSystem::_render(op);
+
+		++mCurrentFrameStats.drawCalls;
+		mCurrentFrameStats.primitives += mFaceCount - faceCount;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::bindGpuProgram(GpuProgram* prg)
+	{
+		RenderSystem::bindGpuProgram(prg);
+		++mCurrentFrameStats.programBinds;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::unbindGpuProgram(GpuProgramType gptype)
+	{
+		RenderSystem::unbindGpuProgram(gptype);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::bindGpuProgramParameters(GpuProgramType gptype,
+		GpuProgramParametersSharedPtr params, uint16 variabilityMask)
+	{
+		if (variabilityMask & (uint16)GPV_GLOBAL)
+		{
+			// Shared parameter sets are copied in like any real render system
+			params->_copySharedParams();
+		}
+
+		// Only the constants which changed since the last upload are counted
+		size_t bytes = calculateGpuProgramParameterBytes(params, variabilityMask);
+		params->_clearDirtyRanges();
+
+		++mCurrentFrameStats.parameterUploads;
+		mCurrentFrameStats.parameterBytes += bytes;
+		addGpuProgramParameterBytes(bytes);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
+	{
+		++mCurrentFrameStats.parameterUploads;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setScissorTest(bool enabled, size_t left, size_t top,
+		size_t right, size_t bottom)
+	{
+		++mCurrentFrameStats.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::clearFrameBuffer(unsigned int buffers,
+		const ColourValue& colour, Real depth, unsigned short stencil)
+	{
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getHorizontalTexelOffset(void)
+	{
+		return 0.0f;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getVerticalTexelOffset(void)
+	{
+		return 0.0f;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getMinimumDepthInputValue(void)
+	{
+		// Range [-1.0f, 1.0f]
+		return -1.0f;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getMaximumDepthInputValue(void)
+	{
+		// Range [-1.0f, 1.0f]
+		return 1.0f;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setRenderTarget(RenderTarget *target)
+	{
+		mActiveRenderTarget = target;
+		if (target)
+		{
+			// Attach a depth buffer as a real render system would
+			if (target->getDepthBufferPool() != DepthBuffer::POOL_NO_DEPTH &&
+				!target->getDepthBuffer())
+			{
+				setDepthBufferFor(target);
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_updateAllRenderTargets(bool swapBuffers)
+	{
+		mCurrentFrameStats.reset();
+
+		RenderSystem::_updateAllRenderTargets(swapBuffers);
+
+		mLastFrameStats = mCurrentFrameStats;
+		mTotalStats += mCurrentFrameStats;
+		++mFrameCount;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::resetStatistics(void)
+	{
+		mCurrentFrameStats.reset();
+		mLastFrameStats.reset();
+		mTotalStats.reset();
+		mFrameCount = 0;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::logStatistics(void) const
+	{
+		size_t frames = std::max<size_t>(mFrameCount, 1);
+
+		StringStream str;
+		str << "NullRenderSystem: " << mFrameCount << " frames, per frame averages:"
+			<< " draw calls " << mTotalStats.drawCalls / frames
+			<< ", primitives " << mTotalStats.primitives / frames
+			<< ", state changes " << mTotalStats.stateChanges / frames
+			<< ", texture binds " << mTotalStats.textureBinds / frames
+			<< ", program binds " << mTotalStats.programBinds / frames
+			<< ", parameter uploads " << mTotalStats.parameterUploads / frames
+			<< " (" << mTotalStats.parameterBytes / frames << " bytes)"
+			<< ", viewports " << mTotalStats.viewports / frames;
+		LogManager::getSingleton().logMessage(str.str());
+	}
+}
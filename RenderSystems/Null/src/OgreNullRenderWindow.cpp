@@ -0,0 +1,136 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullRenderWindow.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgrePixelFormat.h"
+#include "OgreViewport.h"
+
+namespace Ogre {
+	//---------------------------------------------------------------------
+	NullRenderWindow::NullRenderWindow()
+		: mClosed(false)
+	{
+		mActive = false;
+	}
+	//---------------------------------------------------------------------
+	NullRenderWindow::~NullRenderWindow()
+	{
+		destroy();
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::create(const String& name, unsigned int width, unsigned int height,
+		bool fullScreen, const NameValuePairList *miscParams)
+	{
+		mName = name;
+		mWidth = width;
+		mHeight = height;
+		mIsFullScreen = fullScreen;
+		mColourDepth = 32;
+		mLeft = 0;
+		mTop = 0;
+		mFSAA = 0;
+
+		if (miscParams)
+		{
+			NameValuePairList::const_iterator opt;
+			opt = miscParams->find("left");
+			if (opt != miscParams->end())
+				mLeft = StringConverter::parseInt(opt->second);
+			opt = miscParams->find("top");
+			if (opt != miscParams->end())
+				mTop = StringConverter::parseInt(opt->second);
+			opt = miscParams->find("colourDepth");
+			if (opt != miscParams->end())
+				mColourDepth = StringConverter::parseUnsignedInt(opt->second);
+		}
+
+		mActive = true;
+		mClosed = false;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::setFullscreen(bool fullScreen, unsigned int width, unsigned int height)
+	{
+		mIsFullScreen = fullScreen;
+		resize(width, height);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::destroy(void)
+	{
+		mActive = false;
+		mClosed = true;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::resize(unsigned int width, unsigned int height)
+	{
+		if (width == mWidth && height == mHeight)
+			return;
+
+		mWidth = width;
+		mHeight = height;
+
+		// Notify viewports of resize
+		for (ViewportList::iterator it = mViewportList.begin(); it != mViewportList.end(); ++it)
+			it->second->_updateDimensions();
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::reposition(int left, int top)
+	{
+		mLeft = left;
+		mTop = top;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::copyContentsToMemory(const PixelBox &dst, FrameBuffer buffer)
+	{
+		// Nothing was ever drawn, so hand back a cleared frame
+		size_t rowBytes = PixelUtil::getMemorySize(dst.getWidth(), 1, 1, dst.format);
+		size_t rowPitchBytes = PixelUtil::getMemorySize(dst.rowPitch, 1, 1, dst.format);
+		size_t slicePitchBytes = PixelUtil::getMemorySize(dst.slicePitch, 1, 1, dst.format);
+		uint8* data = static_cast<uint8*>(dst.getTopLeftFrontPixelPtr());
+		for (size_t z = 0; z < dst.getDepth(); ++z)
+		{
+			uint8* row = data + z * slicePitchBytes;
+			for (size_t y = 0; y < dst.getHeight(); ++y)
+			{
+				memset(row, 0, rowBytes);
+				row += rowPitchBytes;
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::getCustomAttribute(const String& name, void* pData)
+	{
+		if (name == "WINDOW")
+		{
+			*static_cast<size_t*>(pData) = 0;
+			return;
+		}
+		RenderWindow::getCustomAttribute(name, pData);
+	}
+}
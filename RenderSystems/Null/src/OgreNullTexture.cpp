@@ -0,0 +1,130 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullTexture.h"
+#include "OgreNullHardwarePixelBuffer.h"
+#include "OgreTextureManager.h"
+#include "OgreException.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+	//---------------------------------------------------------------------
+	NullTexture::NullTexture(ResourceManager* creator, const String& name, ResourceHandle handle,
+		const String& group, bool isManual, ManualResourceLoader* loader)
+		: Texture(creator, name, handle, group, isManual, loader)
+	{
+	}
+	//---------------------------------------------------------------------
+	NullTexture::~NullTexture()
+	{
+		// have to call this here rather than in Resource destructor
+		// since calling virtual methods in base destructors causes crash
+		if (isLoaded())
+		{
+			unload();
+		}
+		else
+		{
+			freeInternalResources();
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::loadImpl(void)
+	{
+		// Image data is never decoded, only the surfaces are created
+		if (mFormat == PF_UNKNOWN)
+			mFormat = PF_A8R8G8B8;
+		mSrcWidth = mWidth;
+		mSrcHeight = mHeight;
+		mSrcDepth = mDepth;
+		mSrcFormat = mFormat;
+
+		createInternalResources();
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::createInternalResourcesImpl(void)
+	{
+		if (mFormat == PF_UNKNOWN)
+			mFormat = PF_A8R8G8B8;
+		mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
+
+		// Check requested number of mipmaps
+		uint32 maxMips = 0;
+		uint32 width = mWidth, height = mHeight, depth = mDepth;
+		while (width > 1 || height > 1 || depth > 1)
+		{
+			if (width > 1) width = width / 2;
+			if (height > 1) height = height / 2;
+			if (depth > 1 && mTextureType != TEX_TYPE_2D_ARRAY) depth = depth / 2;
+			++maxMips;
+		}
+		mNumMipmaps = mNumRequestedMipmaps;
+		if (mNumMipmaps > maxMips)
+			mNumMipmaps = maxMips;
+		mMipmapsHardwareGenerated = true;
+
+		mSurfaceList.clear();
+		for (size_t face = 0; face < getNumFaces(); ++face)
+		{
+			width = mWidth;
+			height = mHeight;
+			depth = mDepth;
+			for (uint8 mip = 0; mip <= mNumMipmaps; ++mip)
+			{
+				// Only the top level can be rendered to
+				int usage = mip == 0 ? mUsage : (mUsage & ~TU_RENDERTARGET);
+				HardwarePixelBuffer* buf = OGRE_NEW NullHardwarePixelBuffer(mName,
+					width, height, mTextureType == TEX_TYPE_2D_ARRAY ? mDepth : depth,
+					mFormat, static_cast<HardwareBuffer::Usage>(usage));
+				mSurfaceList.push_back(HardwarePixelBufferSharedPtr(buf));
+
+				if (width > 1) width = width / 2;
+				if (height > 1) height = height / 2;
+				if (depth > 1) depth = depth / 2;
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::freeInternalResourcesImpl(void)
+	{
+		mSurfaceList.clear();
+	}
+	//---------------------------------------------------------------------
+	HardwarePixelBufferSharedPtr NullTexture::getBuffer(size_t face, size_t mipmap)
+	{
+		if (face >= getNumFaces())
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Face index out of range",
+				"NullTexture::getBuffer");
+		if (mipmap > mNumMipmaps)
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Mipmap index out of range",
+				"NullTexture::getBuffer");
+		size_t idx = face * (mNumMipmaps + 1) + mipmap;
+		assert(idx < mSurfaceList.size());
+		return mSurfaceList[idx];
+	}
+}
@@ -0,0 +1,66 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreNullTextureManager.h"
+#include "OgreNullTexture.h"
+#include "OgreResourceGroupManager.h"
+
+namespace Ogre {
+	//---------------------------------------------------------------------
+	NullTextureManager::NullTextureManager()
+		: TextureManager()
+	{
+		// register with group manager
+		ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+	}
+	//---------------------------------------------------------------------
+	NullTextureManager::~NullTextureManager()
+	{
+		// unregister with group manager
+		ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+	}
+	//---------------------------------------------------------------------
+	Resource* NullTextureManager::createImpl(const String& name, ResourceHandle handle,
+		const String& group, bool isManual, ManualResourceLoader* loader,
+		const NameValuePairList* createParams)
+	{
+		return OGRE_NEW NullTexture(this, name, handle, group, isManual, loader);
+	}
+	//---------------------------------------------------------------------
+	PixelFormat NullTextureManager::getNativeFormat(TextureType ttype, PixelFormat format, int usage)
+	{
+		// Everything lives in system memory, so any format will do
+		return format;
+	}
+	//---------------------------------------------------------------------
+	bool NullTextureManager::isHardwareFilteringSupported(TextureType ttype, PixelFormat format,
+		int usage, bool preciseFormatOnly)
+	{
+		return format != PF_UNKNOWN;
+	}
+}
@@ -0,0 +1,69 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __CompressedAnimationTests_H__
+#define __CompressedAnimationTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreSkeleton.h"
+
+/** Checks that compressed node tracks rebuild the source keys within the
+	tolerances, keep their key times, and survive a .skeleton round trip.
+*/
+class CompressedAnimationTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(CompressedAnimationTests);
+	CPPUNIT_TEST(testErrorBounds);
+	CPPUNIT_TEST(testDecompress);
+	CPPUNIT_TEST(testKeyTimes);
+	CPPUNIT_TEST(testSerializerRoundTrip);
+	CPPUNIT_TEST(testSerializerVersion);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Skeleton* mSkeleton;
+	Ogre::Animation* mAnimation;
+	/// Copy of the animated track, kept uncompressed
+	Ogre::Animation* mSource;
+
+	/// Exports the skeleton and imports it back into a new one
+	Ogre::Skeleton* exportAndImport(Ogre::String& version);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testErrorBounds();
+	void testDecompress();
+	void testKeyTimes();
+	void testSerializerRoundTrip();
+	void testSerializerVersion();
+};
+
+#endif
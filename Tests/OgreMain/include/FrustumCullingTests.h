@@ -0,0 +1,71 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __FrustumCullingTests_H__
+#define __FrustumCullingTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreHardwareBufferManager.h"
+
+/** Checks that the boxes tested in batches by Frustum::calculateVisibility
+	and by the scene graph give the results of the per box isVisible test,
+	including when a subclass overrides it.
+*/
+class FrustumCullingTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(FrustumCullingTests);
+	CPPUNIT_TEST(testBatchMatchesIsVisible);
+	CPPUNIT_TEST(testOverriddenIsVisible);
+	CPPUNIT_TEST(testOverriddenCullingFrustum);
+	CPPUNIT_TEST(testDerivedSceneNode);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	/// Cameras need one, there is no RenderSystem
+	Ogre::HardwareBufferManager* mBufMgr;
+	Ogre::SceneManager* mSceneMgr;
+	Ogre::Camera* mCamera;
+	Ogre::vector<Ogre::AxisAlignedBox>::type mBoxes;
+
+	/// Checks calculateVisibility against isVisible for mBoxes
+	void checkVisibility(const Ogre::Frustum* frustum);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testBatchMatchesIsVisible();
+	void testOverriddenIsVisible();
+	void testOverriddenCullingFrustum();
+	void testDerivedSceneNode();
+};
+
+#endif
@@ -0,0 +1,78 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NodeChildrenTests_H__
+#define __NodeChildrenTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+
+/** Checks that the children of a Node stay reachable by index, by iterator
+	and by name as children are added and removed in any way.
+*/
+class NodeChildrenTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(NodeChildrenTests);
+	CPPUNIT_TEST(testRemoveChildByIndex);
+	CPPUNIT_TEST(testRemoveChildByPointer);
+	CPPUNIT_TEST(testRemoveChildByName);
+	CPPUNIT_TEST(testGetChildAfterRemovals);
+	CPPUNIT_TEST(testNamelessChildren);
+	CPPUNIT_TEST(testDuplicateName);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	Ogre::SceneManager* mSceneMgr;
+	Ogre::SceneNode* mParent;
+	/// The children mParent should have, in any order
+	Ogre::set<Ogre::Node*>::type mChildren;
+	/// Number of children created by createChildren, to number their names
+	size_t mNumCreated;
+
+	/// Creates named children of mParent
+	void createChildren(size_t count);
+	/// Checks that mParent has exactly mChildren and finds them by index and name
+	void checkChildren(void);
+	/// Detaches a child which should be in mChildren
+	void checkRemoved(Ogre::Node* child);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testRemoveChildByIndex();
+	void testRemoveChildByPointer();
+	void testRemoveChildByName();
+	void testGetChildAfterRemovals();
+	void testNamelessChildren();
+	void testDuplicateName();
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ParallelAnimationUpdateTests_H__
+#define __ParallelAnimationUpdateTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreSkeleton.h"
+#include "OgreMesh.h"
+
+/** Checks that the bone matrices evaluated by the parallel animation update
+	of SceneManager match those evaluated when the entities are rendered,
+	including for entities sharing a skeleton instance.
+*/
+class ParallelAnimationUpdateTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(ParallelAnimationUpdateTests);
+	CPPUNIT_TEST(testSharedSkeletons);
+	CPPUNIT_TEST(testHiddenEntities);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	typedef Ogre::vector<Ogre::Matrix4>::type MatrixList;
+
+	Ogre::Root* mRoot;
+	Ogre::HardwareBufferManager* mBufMgr;
+	Ogre::SceneManager* mSceneMgr;
+	Ogre::SkeletonPtr mSkeleton;
+	Ogre::MeshPtr mMesh;
+	Ogre::vector<Ogre::Entity*>::type mEntities;
+
+	/// Poses the entities for a time, then updates them as in a frame
+	void updateFrame(Ogre::Real time, bool parallel);
+	/// Gets the bone matrices of all the entities, one after the other
+	void getBoneMatrices(MatrixList& matrices) const;
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testSharedSkeletons();
+	void testHiddenEntities();
+};
+
+#endif
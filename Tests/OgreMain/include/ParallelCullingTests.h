@@ -0,0 +1,72 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ParallelCullingTests_H__
+#define __ParallelCullingTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreHardwareBufferManager.h"
+
+/** Checks that searching for visible objects on the WorkQueue threads fills
+	the render queue as the serial search does, including with scene nodes
+	overriding _findVisibleObjects.
+*/
+class ParallelCullingTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(ParallelCullingTests);
+	CPPUNIT_TEST(testParallelMatchesSerial);
+	CPPUNIT_TEST(testDerivedSceneNodes);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	/// Cameras need one, there is no RenderSystem
+	Ogre::HardwareBufferManager* mBufMgr;
+	Ogre::SceneManager* mSceneMgr;
+	Ogre::Camera* mCamera;
+	Ogre::vector<Ogre::MovableObject*>::type mObjects;
+	Ogre::vector<Ogre::SceneNode*>::type mDerivedNodes;
+	/// Names of the objects and derived nodes, in the order they were reached
+	Ogre::StringVector mLog;
+
+	/// Creates a random tree of nodes with objects, some of a derived type
+	void createTree(size_t numNodes, bool derivedNodes);
+	/// Searches serially then in parallel and compares the results
+	void checkSearch(void);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testParallelMatchesSerial();
+	void testDerivedSceneNodes();
+};
+
+#endif
@@ -0,0 +1,77 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __RenderQueueSortKeyTests_H__
+#define __RenderQueueSortKeyTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreRenderQueueSortingGrouping.h"
+
+class SortKeyTestRenderable;
+
+/** Checks that a QueuedRenderableCollection set up for OM_SORT_KEY visits
+	every pass once in hash order, including passes sharing a hash, and the
+	renderables of each pass front to back.
+*/
+class RenderQueueSortKeyTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(RenderQueueSortKeyTests);
+	CPPUNIT_TEST(testPassesSharingHashes);
+	CPPUNIT_TEST(testManyPasses);
+	CPPUNIT_TEST(testPassGroupRequest);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	Ogre::HardwareBufferManager* mBufferManager;
+	Ogre::Camera* mCamera;
+	Ogre::Technique* mTechnique;
+	Ogre::vector<SortKeyTestRenderable*>::type mRenderables;
+
+	/// Creates passes up to numPasses and queues renderables on them at random
+	void queueRenderables(Ogre::QueuedRenderableCollection& collection,
+		size_t numPasses, size_t numRenderables);
+	/// Sorts the collection and checks the order it is visited in
+	void checkVisit(Ogre::QueuedRenderableCollection& collection, size_t numPasses,
+		Ogre::QueuedRenderableCollection::OrganisationMode om);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testPassesSharingHashes();
+	/// More passes than a byte of the sort key can rank
+	void testManyPasses();
+	/// OM_PASS_GROUP is served in the sort key order
+	void testPassGroupRequest();
+};
+
+#endif
@@ -0,0 +1,70 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SceneGraphUpdateTests_H__
+#define __SceneGraphUpdateTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+
+/** Checks that the scene graph updated incrementally from the dirty nodes
+	ends up as after the full walk from the root, and that nodes updated
+	outside of the walk can be destroyed safely.
+*/
+class SceneGraphUpdateTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(SceneGraphUpdateTests);
+	CPPUNIT_TEST(testIncrementalMatchesFull);
+	CPPUNIT_TEST(testDestroyAutoTrackingNode);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	typedef Ogre::vector<Ogre::SceneNode*>::type SceneNodeList;
+
+	Ogre::Root* mRoot;
+	/// Updated by walking the whole scene graph
+	Ogre::SceneManager* mFullSceneMgr;
+	/// Updated from its dirty nodes
+	Ogre::SceneManager* mIncrementalSceneMgr;
+	Ogre::vector<Ogre::MovableObject*>::type mObjects;
+
+	/// Creates the same random tree in a scene manager
+	void createTree(Ogre::SceneManager* sceneMgr, SceneNodeList& nodes);
+	/// Checks that the derived transforms and bounds of two trees are equal
+	void checkTrees(const SceneNodeList& full, const SceneNodeList& incremental);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testIncrementalMatchesFull();
+	void testDestroyAutoTrackingNode();
+};
+
+#endif
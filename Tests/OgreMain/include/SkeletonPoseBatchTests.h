@@ -0,0 +1,83 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SkeletonPoseBatchTests_H__
+#define __SkeletonPoseBatchTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreSkeletonInstance.h"
+
+/** Checks that SkeletonPoseBatch gives the bone matrices
+	SkeletonInstance::_getBoneMatrices gives after
+	Skeleton::setAnimationState, for every way of blending animations.
+*/
+class SkeletonPoseBatchTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(SkeletonPoseBatchTests);
+	CPPUNIT_TEST(testBlendModes);
+	CPPUNIT_TEST(testRotationInterpolation);
+	CPPUNIT_TEST(testBlendMasks);
+	CPPUNIT_TEST(testDisabledBones);
+	CPPUNIT_TEST(testNonInheritingBones);
+	CPPUNIT_TEST(testLinkedSkeletonScale);
+	CPPUNIT_TEST(testCompressedTracks);
+	CPPUNIT_TEST(testParallel);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	Ogre::SkeletonPtr mSkeleton;
+	Ogre::SkeletonPtr mLinkedSkeleton;
+	Ogre::vector<Ogre::SkeletonInstance*>::type mInstances;
+	Ogre::vector<Ogre::AnimationStateSet*>::type mAnimationStates;
+
+	/// Creates an animation moving every bone of mSkeleton
+	void createAnimation(Ogre::Skeleton* skeleton, const Ogre::String& name);
+	/// Enables an animation on every instance, at times and weights varying with the instance
+	void enableAnimation(const Ogre::String& name, Ogre::Real weight);
+	/// Evaluates every instance with a batch and on its own, and compares the matrices
+	void checkInstances(bool parallel);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testBlendModes();
+	void testRotationInterpolation();
+	void testBlendMasks();
+	void testDisabledBones();
+	void testNonInheritingBones();
+	void testLinkedSkeletonScale();
+	void testCompressedTracks();
+	/// Everything above at once, distributed across the threads
+	void testParallel();
+};
+
+#endif
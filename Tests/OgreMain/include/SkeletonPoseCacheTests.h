@@ -0,0 +1,71 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SkeletonPoseCacheTests_H__
+#define __SkeletonPoseCacheTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreSkeletonPoseCache.h"
+
+/** Checks which poses SkeletonPoseCache shares: the same states within a
+	frame, times within the quantum, but not other weights, animations or
+	disabled bones.
+*/
+class SkeletonPoseCacheTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(SkeletonPoseCacheTests);
+	CPPUNIT_TEST(testHitsAndMisses);
+	CPPUNIT_TEST(testTimeQuantum);
+	CPPUNIT_TEST(testDifferentStates);
+	CPPUNIT_TEST(testNextFrame);
+	CPPUNIT_TEST(testDiscardPose);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	Ogre::Skeleton* mSkeleton;
+	Ogre::AnimationStateSet* mAnimationStates;
+	Ogre::SkeletonPoseCache* mCache;
+
+	/// Looks up the pose of mSkeleton, checking the matrices are given
+	bool acquire(Ogre::Matrix4*& matrices);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testHitsAndMisses();
+	void testTimeQuantum();
+	void testDifferentStates();
+	void testNextFrame();
+	void testDiscardPose();
+};
+
+#endif
@@ -0,0 +1,78 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SoftwareSkinningTests_H__
+#define __SoftwareSkinningTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreMatrix4.h"
+#include "OgreDualQuaternion.h"
+
+/** Checks the software skinning of the OptimisedUtil implementation selected
+	for this CPU against a plain per vertex blend.
+*/
+class SoftwareSkinningTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(SoftwareSkinningTests);
+	CPPUNIT_TEST(testMatrixSkinning);
+	CPPUNIT_TEST(testDualQuaternionSkinning);
+	CPPUNIT_TEST(testRigidSkinning);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	/// Interleaved position, normal, blend weights and blend indices
+	struct Vertex
+	{
+		float position[3];
+		float normal[3];
+		float weights[4];
+		unsigned char indices[4];
+	};
+
+	Ogre::vector<Vertex>::type mVertices;
+	Ogre::vector<Ogre::Matrix4>::type mMatrices;
+	Ogre::vector<Ogre::DualQuaternion>::type mDualQuaternions;
+	Ogre::vector<const Ogre::Matrix4*>::type mBlendMatrices;
+	Ogre::vector<const Ogre::DualQuaternion*>::type mBlendDualQuaternions;
+
+	/// Skins mVertices into positions and normals, 3 floats each
+	void skinMatrices(float* positions, float* normals);
+	void skinDualQuaternions(float* positions, float* normals);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testMatrixSkinning();
+	void testDualQuaternionSkinning();
+	/// Dual quaternions and matrices must agree on vertices with a single bone
+	void testRigidSkinning();
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __SoftwareVertexBlendBatchTests_H__
+#define __SoftwareVertexBlendBatchTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreRoot.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreDualQuaternion.h"
+
+/** Checks that the blends of a SoftwareVertexBlendBatch give the same
+	vertices as Mesh::softwareVertexBlend, serially and in parallel.
+*/
+class SoftwareVertexBlendBatchTests : public CppUnit::TestFixture
+{
+	// CppUnit macros for setting up the test suite
+	CPPUNIT_TEST_SUITE(SoftwareVertexBlendBatchTests);
+	CPPUNIT_TEST(testSerialMatchesImmediate);
+	CPPUNIT_TEST(testParallelMatchesImmediate);
+	CPPUNIT_TEST(testClear);
+	CPPUNIT_TEST_SUITE_END();
+
+protected:
+	Ogre::Root* mRoot;
+	Ogre::HardwareBufferManager* mBufferManager;
+	/// Skinned source data, the first two shared by two targets each
+	Ogre::vector<Ogre::VertexData*>::type mSources;
+	/// Targets blended immediately and by the batch, in pairs
+	Ogre::vector<Ogre::VertexData*>::type mTargets;
+	Ogre::vector<Ogre::Matrix4>::type mMatrices;
+	Ogre::vector<Ogre::DualQuaternion>::type mDualQuaternions;
+	Ogre::vector<const Ogre::Matrix4*>::type mBlendMatrices;
+	Ogre::vector<const Ogre::DualQuaternion*>::type mBlendDualQuaternions;
+
+	/// Blends every source immediately into even targets, with the batch into odd ones
+	void checkBatch(bool parallel);
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testSerialMatchesImmediate();
+	void testParallelMatchesImmediate();
+	void testClear();
+};
+
+#endif
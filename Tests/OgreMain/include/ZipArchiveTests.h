@@ -47,6 +47,10 @@ class ZipArchiveTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testFindFileInfoRecursive);
     CPPUNIT_TEST(testFileRead);
     CPPUNIT_TEST(testReadInterleave);
+    CPPUNIT_TEST(testMappedList);
+    CPPUNIT_TEST(testMappedFindFileInfo);
+    CPPUNIT_TEST(testMappedReadInterleave);
+    CPPUNIT_TEST(testMappedOpenMultiple);
     CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -66,6 +70,10 @@ public:
     void testFindFileInfoRecursive();
     void testFileRead();
     void testReadInterleave();
+    void testMappedList();
+    void testMappedFindFileInfo();
+    void testMappedReadInterleave();
+    void testMappedOpenMultiple();
 };
 
 #endif
@@ -0,0 +1,121 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "AnimationLodTests.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationState.h"
+#include "OgreAnimationTrack.h"
+#include "OgreBone.h"
+#include "OgreKeyFrame.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(AnimationLodTests);
+
+//--------------------------------------------------------------------------
+void AnimationLodTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// A root bone and a child, both moved by an animation
+	mSkeleton = OGRE_NEW Skeleton(0, "AnimationLod", 0, "General");
+	mRoot = mSkeleton->createBone("Root");
+	mChild = mSkeleton->createBone("Child");
+	mRoot->addChild(mChild);
+	mChild->setPosition(Vector3::UNIT_Y);
+	mSkeleton->setBindingPose();
+
+	Animation* anim = mSkeleton->createAnimation("Move", 1);
+	NodeAnimationTrack* track = anim->createNodeTrack(mRoot->getHandle(), mRoot);
+	track->createNodeKeyFrame(0);
+	track->createNodeKeyFrame(1)->setTranslate(Vector3::UNIT_X);
+	track = anim->createNodeTrack(mChild->getHandle(), mChild);
+	track->createNodeKeyFrame(0);
+	track->createNodeKeyFrame(1)->setTranslate(Vector3::UNIT_Z);
+
+	mAnimationStates = OGRE_NEW AnimationStateSet();
+	mSkeleton->_initAnimationState(mAnimationStates);
+	AnimationState* state = mAnimationStates->getAnimationState("Move");
+	state->setEnabled(true);
+	state->setLoop(false);
+	state->setTimePosition(1);
+}
+//--------------------------------------------------------------------------
+void AnimationLodTests::tearDown()
+{
+	OGRE_DELETE mAnimationStates;
+	OGRE_DELETE mSkeleton;
+}
+//--------------------------------------------------------------------------
+void AnimationLodTests::testAllBones()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	mSkeleton->setAnimationState(*mAnimationStates);
+	CPPUNIT_ASSERT(mRoot->getPosition().positionEquals(Vector3::UNIT_X));
+	CPPUNIT_ASSERT(mChild->getPosition().positionEquals(Vector3(0, 1, 1)));
+}
+//--------------------------------------------------------------------------
+void AnimationLodTests::testDisabledBones()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	Skeleton::BoneMask disabled(mSkeleton->getNumBones(), false);
+	disabled[mChild->getHandle()] = true;
+	mSkeleton->_setDisabledBones(&disabled);
+	mSkeleton->setAnimationState(*mAnimationStates);
+
+	// The child follows its parent in its binding pose
+	CPPUNIT_ASSERT(mRoot->getPosition().positionEquals(Vector3::UNIT_X));
+	CPPUNIT_ASSERT(mChild->getPosition().positionEquals(Vector3::UNIT_Y));
+	CPPUNIT_ASSERT(mChild->_getDerivedPosition().positionEquals(Vector3(1, 1, 0)));
+
+	// And is animated again once enabled
+	mSkeleton->_setDisabledBones(0);
+	mSkeleton->setAnimationState(*mAnimationStates);
+	CPPUNIT_ASSERT(mChild->getPosition().positionEquals(Vector3(0, 1, 1)));
+}
+//--------------------------------------------------------------------------
+void AnimationLodTests::testBlendMask()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Disabled bones are skipped by the blend mask version too
+	AnimationState* state = mAnimationStates->getAnimationState("Move");
+	state->createBlendMask(mSkeleton->getNumBones(), 1);
+	Skeleton::BoneMask disabled(mSkeleton->getNumBones(), false);
+	disabled[mRoot->getHandle()] = true;
+	mSkeleton->_setDisabledBones(&disabled);
+	mSkeleton->setAnimationState(*mAnimationStates);
+
+	CPPUNIT_ASSERT(mRoot->getPosition().positionEquals(Vector3::ZERO));
+	CPPUNIT_ASSERT(mChild->getPosition().positionEquals(Vector3(0, 1, 1)));
+	mSkeleton->_setDisabledBones(0);
+}
@@ -0,0 +1,310 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "CompressedAnimationTests.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreBone.h"
+#include "OgreCompressedNodeAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreSkeletonSerializer.h"
+
+#include "UnitTestSuite.h"
+
+#include <fstream>
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(CompressedAnimationTests);
+
+/// Length of the animation
+static const Real LENGTH = 2;
+/// Number of keys of the animated track
+static const size_t NUM_KEYS = 241;
+
+//--------------------------------------------------------------------------
+/// Angle between two rotations
+static Real angleBetween(const Quaternion& a, const Quaternion& b)
+{
+	Real cosHalfAngle = std::min(Math::Abs(a.Dot(b)), Real(1));
+	return 2 * Math::ACos(cosHalfAngle).valueRadians();
+}
+//--------------------------------------------------------------------------
+/// Fills a track with 120Hz keys of a smooth motion, not evenly spaced
+static void fillTrack(NodeAnimationTrack* track)
+{
+	for (size_t i = 0; i < NUM_KEYS; ++i)
+	{
+		Real t = std::min(LENGTH, (i + (i % 3) * 0.1f) / 120.0f);
+		TransformKeyFrame* kf = track->createNodeKeyFrame(t);
+		kf->setTranslate(Vector3(4 * Math::Sin(3 * t), 2 * Math::Cos(2 * t), t));
+		Vector3 axis(1, Math::Cos(t), 0.5f);
+		axis.normalise();
+		kf->setRotation(Quaternion(Radian(2 * Math::Sin(2 * t)), axis));
+		kf->setScale(Vector3(1 + 0.2f * Math::Sin(5 * t), 1, 1));
+	}
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	mSkeleton = OGRE_NEW Skeleton(0, "CompressedAnimation", 0, "General");
+	Bone* bone = mSkeleton->createBone("Root");
+	mSkeleton->setBindingPose();
+
+	mAnimation = mSkeleton->createAnimation("Walk", LENGTH);
+	fillTrack(mAnimation->createNodeTrack(bone->getHandle(), bone));
+	mSource = OGRE_NEW Animation("Source", LENGTH);
+	fillTrack(mSource->createNodeTrack(bone->getHandle()));
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::tearDown()
+{
+	OGRE_DELETE mSource;
+	OGRE_DELETE mSkeleton;
+}
+//--------------------------------------------------------------------------
+Skeleton* CompressedAnimationTests::exportAndImport(String& version)
+{
+	String fileName = "CompressedAnimationTests.skeleton";
+	SkeletonSerializer serializer;
+	serializer.exportSkeleton(mSkeleton, fileName);
+
+	// The version string follows the header chunk id
+	{
+		std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+		std::string content((std::istreambuf_iterator<char>(file)),
+			std::istreambuf_iterator<char>());
+		size_t start = content.find("[Serializer_v");
+		version = start != std::string::npos ?
+			content.substr(start, content.find(']', start) + 1 - start) : StringUtil::BLANK;
+	}
+
+	std::ifstream* file = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)(
+		fileName.c_str(), std::ios::in | std::ios::binary);
+	DataStreamPtr stream(OGRE_NEW FileStreamDataStream(file));
+	Skeleton* imported = OGRE_NEW Skeleton(0, "CompressedAnimationImported", 0, "General");
+	serializer.importSkeleton(stream, imported);
+	stream->close();
+	remove(fileName.c_str());
+	return imported;
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::testErrorBounds()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	CompressedNodeAnimationTrack::Tolerances tolerances;
+	mAnimation->compressNodeTracks(tolerances);
+	CPPUNIT_ASSERT_EQUAL((unsigned short)0, mAnimation->getNumNodeTracks());
+	CompressedNodeAnimationTrack* compressed = mAnimation->getCompressedNodeTrack(0);
+	NodeAnimationTrack* source = mSource->getNodeTrack(0);
+
+	// Some keys are dropped
+	CPPUNIT_ASSERT(compressed->_getChannel(CompressedNodeAnimationTrack::CI_TRANSLATE).times.size() < NUM_KEYS);
+	CPPUNIT_ASSERT(compressed->_getChannel(CompressedNodeAnimationTrack::CI_SCALE).times.size() < NUM_KEYS);
+
+	// All keys are rebuilt within the tolerances
+	for (unsigned short i = 0; i < source->getNumKeyFrames(); ++i)
+	{
+		const TransformKeyFrame* kf = source->getNodeKeyFrame(i);
+		Vector3 translate, scale;
+		Quaternion rotate;
+		compressed->getTransform(TimeIndex(kf->getTime()), translate, rotate, scale);
+
+		CPPUNIT_ASSERT(translate.distance(kf->getTranslate()) <= tolerances.translation);
+		CPPUNIT_ASSERT(angleBetween(rotate, kf->getRotation()) <= tolerances.rotation.valueRadians());
+		CPPUNIT_ASSERT(scale.distance(kf->getScale()) <= tolerances.scale);
+	}
+
+	// So are the positions between them, which move linearly between keys
+	for (size_t i = 0; i <= 1000; ++i)
+	{
+		Real t = LENGTH * i / 1000;
+		TransformKeyFrame kf(0, t);
+		source->getInterpolatedKeyFrame(TimeIndex(t), &kf);
+		Vector3 translate, scale;
+		Quaternion rotate;
+		compressed->getTransform(TimeIndex(t), translate, rotate, scale);
+
+		CPPUNIT_ASSERT(translate.distance(kf.getTranslate()) <= tolerances.translation);
+		CPPUNIT_ASSERT(scale.distance(kf.getScale()) <= tolerances.scale);
+	}
+
+	// A translation over 1000 units has quantisation steps larger than
+	// the default tolerance, the track is kept uncompressed
+	Animation* large = mSkeleton->createAnimation("Run", LENGTH);
+	NodeAnimationTrack* largeTrack = large->createNodeTrack(0, mSkeleton->getBone(0));
+	for (size_t i = 0; i < NUM_KEYS; ++i)
+	{
+		Real t = LENGTH * i / (NUM_KEYS - 1);
+		TransformKeyFrame* kf = largeTrack->createNodeKeyFrame(t);
+		kf->setTranslate(Vector3(500 * t, Math::Sin(10 * t), 0));
+	}
+	large->compressNodeTracks(tolerances);
+	CPPUNIT_ASSERT(large->hasNodeTrack(0));
+	CPPUNIT_ASSERT(!large->hasCompressedNodeTrack(0));
+	CPPUNIT_ASSERT_EQUAL((unsigned short)NUM_KEYS, largeTrack->getNumKeyFrames());
+
+	// It fits in a tolerance of 0.1, and is rebuilt within it
+	CompressedNodeAnimationTrack coarse(large, 0);
+	tolerances.translation = 0.1f;
+	CPPUNIT_ASSERT(coarse.compress(largeTrack, tolerances));
+	for (unsigned short i = 0; i < largeTrack->getNumKeyFrames(); ++i)
+	{
+		const TransformKeyFrame* kf = largeTrack->getNodeKeyFrame(i);
+		Vector3 translate, scale;
+		Quaternion rotate;
+		coarse.getTransform(TimeIndex(kf->getTime()), translate, rotate, scale);
+		CPPUNIT_ASSERT(translate.distance(kf->getTranslate()) <= tolerances.translation);
+	}
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::testDecompress()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	CompressedNodeAnimationTrack::Tolerances tolerances;
+	mAnimation->compressNodeTracks(tolerances);
+	NodeAnimationTrack* source = mSource->getNodeTrack(0);
+
+	Animation decompressedAnim("Decompressed", LENGTH);
+	NodeAnimationTrack* decompressed = decompressedAnim.createNodeTrack(0);
+	mAnimation->getCompressedNodeTrack(0)->decompress(decompressed);
+
+	CPPUNIT_ASSERT(decompressed->getNumKeyFrames() > 1);
+	CPPUNIT_ASSERT(decompressed->getNumKeyFrames() <= source->getNumKeyFrames());
+	CPPUNIT_ASSERT_EQUAL(source->getKeyFrame(0)->getTime(),
+		decompressed->getKeyFrame(0)->getTime());
+	CPPUNIT_ASSERT_EQUAL(source->getKeyFrame(source->getNumKeyFrames() - 1)->getTime(),
+		decompressed->getKeyFrame(decompressed->getNumKeyFrames() - 1)->getTime());
+
+	unsigned short s = 0;
+	for (unsigned short i = 0; i < decompressed->getNumKeyFrames(); ++i)
+	{
+		// Each key is at the exact time of a source key
+		const TransformKeyFrame* kf = decompressed->getNodeKeyFrame(i);
+		while (s < source->getNumKeyFrames() && source->getKeyFrame(s)->getTime() < kf->getTime())
+			++s;
+		CPPUNIT_ASSERT(s < source->getNumKeyFrames());
+		const TransformKeyFrame* sourceKf = source->getNodeKeyFrame(s);
+		CPPUNIT_ASSERT_EQUAL(sourceKf->getTime(), kf->getTime());
+
+		CPPUNIT_ASSERT(kf->getTranslate().distance(sourceKf->getTranslate()) <= tolerances.translation);
+		CPPUNIT_ASSERT(angleBetween(kf->getRotation(), sourceKf->getRotation()) <=
+			tolerances.rotation.valueRadians());
+		CPPUNIT_ASSERT(kf->getScale().distance(sourceKf->getScale()) <= tolerances.scale);
+	}
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::testKeyTimes()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Keys closer than 1/65535 of a long clip
+	Real length = 600;
+	Animation anim("KeyTimes", length);
+	NodeAnimationTrack* source = anim.createNodeTrack(0);
+	for (size_t i = 0; i < 20; ++i)
+	{
+		TransformKeyFrame* kf = source->createNodeKeyFrame(i * 0.004f);
+		kf->setTranslate(Vector3((Real)(i % 2), 0, 0));
+	}
+	source->createNodeKeyFrame(length);
+
+	CompressedNodeAnimationTrack compressed(&anim, 1);
+	compressed.compress(source);
+	const CompressedNodeAnimationTrack::Channel& channel =
+		compressed._getChannel(CompressedNodeAnimationTrack::CI_TRANSLATE);
+	CPPUNIT_ASSERT_EQUAL((size_t)source->getNumKeyFrames(), channel.times.size());
+
+	for (unsigned short i = 0; i < source->getNumKeyFrames(); ++i)
+	{
+		const TransformKeyFrame* kf = source->getNodeKeyFrame(i);
+		CPPUNIT_ASSERT_EQUAL((float)kf->getTime(), channel.times[i]);
+
+		Vector3 translate, scale;
+		Quaternion rotate;
+		compressed.getTransform(TimeIndex(kf->getTime()), translate, rotate, scale);
+		CPPUNIT_ASSERT(translate.positionEquals(kf->getTranslate(), 1e-3f));
+	}
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::testSerializerRoundTrip()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	mAnimation->compressNodeTracks();
+	String version;
+	Skeleton* imported = exportAndImport(version);
+	CPPUNIT_ASSERT_EQUAL(String("[Serializer_v1.90]"), version);
+
+	Animation* anim = imported->getAnimation("Walk");
+	CPPUNIT_ASSERT_EQUAL((unsigned short)0, anim->getNumNodeTracks());
+	CPPUNIT_ASSERT_EQUAL((unsigned short)1, anim->getNumCompressedNodeTracks());
+	const CompressedNodeAnimationTrack* original = mAnimation->getCompressedNodeTrack(0);
+	const CompressedNodeAnimationTrack* loaded = anim->getCompressedNodeTrack(0);
+	CPPUNIT_ASSERT(loaded->getAssociatedNode() == imported->getBone(0));
+
+	// Same data, so exactly the same transforms
+	for (size_t c = 0; c < CompressedNodeAnimationTrack::CI_COUNT; ++c)
+	{
+		CompressedNodeAnimationTrack::ChannelIndex index =
+			static_cast<CompressedNodeAnimationTrack::ChannelIndex>(c);
+		CPPUNIT_ASSERT(original->_getChannel(index).times == loaded->_getChannel(index).times);
+		CPPUNIT_ASSERT(original->_getChannel(index).keys == loaded->_getChannel(index).keys);
+	}
+	for (size_t i = 0; i <= 100; ++i)
+	{
+		TimeIndex timeIndex(LENGTH * i / 100);
+		Vector3 translate1, translate2, scale1, scale2;
+		Quaternion rotate1, rotate2;
+		original->getTransform(timeIndex, translate1, rotate1, scale1);
+		loaded->getTransform(timeIndex, translate2, rotate2, scale2);
+		CPPUNIT_ASSERT(translate1 == translate2);
+		CPPUNIT_ASSERT(rotate1 == rotate2);
+		CPPUNIT_ASSERT(scale1 == scale2);
+	}
+
+	OGRE_DELETE imported;
+}
+//--------------------------------------------------------------------------
+void CompressedAnimationTests::testSerializerVersion()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Without compressed tracks, older versions can read the file
+	String version;
+	Skeleton* imported = exportAndImport(version);
+	CPPUNIT_ASSERT_EQUAL(String("[Serializer_v1.80]"), version);
+	CPPUNIT_ASSERT_EQUAL((unsigned short)NUM_KEYS,
+		imported->getAnimation("Walk")->getNodeTrack(0)->getNumKeyFrames());
+
+	OGRE_DELETE imported;
+}
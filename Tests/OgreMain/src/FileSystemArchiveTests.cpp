@@ -327,6 +327,33 @@ void FileSystemArchiveTests::testReadInterleave()
     CPPUNIT_ASSERT(stream2->eof());
 }
 //--------------------------------------------------------------------------
+void FileSystemArchiveTests::testFileReadMapped()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    FileSystemArchive::setUseMemoryMapping(true);
+    FileSystemArchive arch(mTestPath, "FileSystem", true);
+    arch.load();
+
+    DataStreamPtr stream = arch.open("rootfile.txt");
+    FileSystemArchive::setUseMemoryMapping(false);
+    if (MMapDataStream::isSupported())
+    {
+        CPPUNIT_ASSERT(!stream.dynamicCast<MMapDataStream>().isNull());
+    }
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), stream->getLine());
+    stream->seek(0);
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+    stream->skipLine();
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 4 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 5 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(StringUtil::BLANK, stream->getLine()); // blank at end of file
+    CPPUNIT_ASSERT(stream->eof());
+    stream->close();
+}
+//--------------------------------------------------------------------------
 void FileSystemArchiveTests::testCreateAndRemoveFile()
 {
     UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
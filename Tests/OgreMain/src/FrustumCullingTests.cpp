@@ -0,0 +1,185 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "FrustumCullingTests.h"
+#include "OgreCamera.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(FrustumCullingTests);
+
+/// Culling frustum which sees everything, as in the ShaderSystem sample
+class InfiniteFrustum : public Frustum
+{
+public:
+	bool isVisible(const AxisAlignedBox& bound, FrustumPlane* culledBy = 0) const
+	{
+		return true;
+	}
+};
+
+/// Scene node counting the calls to its _findVisibleObjects
+class CountingSceneNode : public SceneNode
+{
+public:
+	CountingSceneNode(SceneManager* creator, const AxisAlignedBox& bounds)
+		: SceneNode(creator), mBounds(bounds), mCalls(0)
+	{
+	}
+
+	void _updateBounds(void)
+	{
+		mWorldAABB = mBounds;
+	}
+
+	void _findVisibleObjects(Camera* cam, RenderQueue* queue,
+		VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren = true,
+		bool displayNodes = false, bool onlyShadowCasters = false)
+	{
+		++mCalls;
+	}
+
+	AxisAlignedBox mBounds;
+	size_t mCalls;
+};
+
+//--------------------------------------------------------------------------
+void FrustumCullingTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+	mSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+
+	// Looking down -Z from the origin, not registered with the SceneManager
+	// which would need a RenderSystem to destroy it
+	mCamera = OGRE_NEW Camera("Camera", mSceneMgr);
+	mCamera->setNearClipDistance(1);
+	mCamera->setFarClipDistance(100);
+
+	// A grid of boxes in front of, across and behind the camera, more than
+	// a batch of 64, with a null and an infinite box
+	for (int z = -120; z <= 20; z += 20)
+	{
+		for (int x = -100; x <= 100; x += 25)
+		{
+			Vector3 centre((Real)x, (Real)(x / 2), (Real)z);
+			mBoxes.push_back(AxisAlignedBox(centre - Vector3(5, 5, 5), centre + Vector3(5, 5, 5)));
+		}
+	}
+	mBoxes.push_back(AxisAlignedBox(AxisAlignedBox::EXTENT_NULL));
+	mBoxes.push_back(AxisAlignedBox(AxisAlignedBox::EXTENT_INFINITE));
+}
+//--------------------------------------------------------------------------
+void FrustumCullingTests::tearDown()
+{
+	mBoxes.clear();
+	OGRE_DELETE mCamera;
+	OGRE_DELETE mRoot;
+	OGRE_DELETE mBufMgr;
+}
+//--------------------------------------------------------------------------
+void FrustumCullingTests::checkVisibility(const Frustum* frustum)
+{
+	size_t count = mBoxes.size();
+	vector<const AxisAlignedBox*>::type bounds(count);
+	for (size_t i = 0; i < count; ++i)
+		bounds[i] = &mBoxes[i];
+
+	vector<uint32>::type visibility((count + 31) / 32);
+	frustum->calculateVisibility(&bounds[0], count, &visibility[0]);
+	for (size_t i = 0; i < count; ++i)
+	{
+		bool visible = (visibility[i / 32] & (1u << (i % 32))) != 0;
+		CPPUNIT_ASSERT_EQUAL(frustum->isVisible(mBoxes[i]), visible);
+	}
+}
+//--------------------------------------------------------------------------
+void FrustumCullingTests::testBatchMatchesIsVisible()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	checkVisibility(mCamera);
+	CPPUNIT_ASSERT(!mCamera->isVisible(mBoxes[0]));
+	CPPUNIT_ASSERT(mCamera->isVisible(mBoxes.back()));
+
+	Frustum frustum;
+	frustum.setNearClipDistance(1);
+	frustum.setFarClipDistance(100);
+	checkVisibility(&frustum);
+}
+//--------------------------------------------------------------------------
+void FrustumCullingTests::testOverriddenIsVisible()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// The boxes behind the camera are visible to the subclass
+	InfiniteFrustum frustum;
+	checkVisibility(&frustum);
+}
+//--------------------------------------------------------------------------
+void FrustumCullingTests::testOverriddenCullingFrustum()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	InfiniteFrustum frustum;
+	mCamera->setCullingFrustum(&frustum);
+	checkVisibility(mCamera);
+	CPPUNIT_ASSERT(mCamera->isVisible(mBoxes[0]));
+	mCamera->setCullingFrustum(0);
+}
+//--------------------------------------------------------------------------
+void FrustumCullingTests::testDerivedSceneNode()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// One node in front of the camera, one behind
+	SceneNode* parent = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+	CountingSceneNode* front = OGRE_NEW CountingSceneNode(mSceneMgr,
+		AxisAlignedBox(Vector3(-1, -1, -11), Vector3(1, 1, -9)));
+	CountingSceneNode* behind = OGRE_NEW CountingSceneNode(mSceneMgr,
+		AxisAlignedBox(Vector3(-1, -1, 9), Vector3(1, 1, 11)));
+	parent->addChild(front);
+	parent->addChild(behind);
+	mSceneMgr->getRootSceneNode()->_update(true, false);
+
+	// The subclass decides of its own visibility, whatever the batch test says
+	mSceneMgr->getRootSceneNode()->_findVisibleObjects(mCamera, mSceneMgr->getRenderQueue(), 0);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, front->mCalls);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, behind->mCalls);
+
+	parent->removeAllChildren();
+	OGRE_DELETE front;
+	OGRE_DELETE behind;
+}
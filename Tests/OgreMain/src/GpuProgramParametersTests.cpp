@@ -0,0 +1,215 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "GpuProgramParametersTests.h"
+#include "OgreVector4.h"
+#include "OgreMatrix4.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(GpuProgramParametersTests);
+
+//--------------------------------------------------------------------------
+/// Adds a named constant after those already defined
+static void addConstant(GpuNamedConstants* constants, const String& name,
+	GpuConstantType type, size_t arraySize, uint16 variability)
+{
+	GpuConstantDefinition def;
+	def.constType = type;
+	def.elementSize = GpuConstantDefinition::getElementSize(type, false);
+	def.arraySize = arraySize;
+	def.variability = variability;
+	size_t& bufferSize = def.isFloat() ? constants->floatBufferSize : constants->intBufferSize;
+	def.physicalIndex = bufferSize;
+	def.logicalIndex = bufferSize;
+	bufferSize += def.elementSize * arraySize;
+	constants->map[name] = def;
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// A vector, a matrix, a large array, a vector and a double vector, then
+	// 2 int vectors
+	GpuNamedConstants* constants = OGRE_NEW GpuNamedConstants();
+	addConstant(constants, "colour", GCT_FLOAT4, 1, GPV_PER_OBJECT);
+	addConstant(constants, "world", GCT_MATRIX_4X4, 1, GPV_PER_OBJECT);
+	addConstant(constants, "bones", GCT_FLOAT4, 64, GPV_PER_OBJECT);
+	addConstant(constants, "light", GCT_FLOAT4, 1, GPV_LIGHTS);
+	addConstant(constants, "precise", GCT_DOUBLE4, 1, GPV_PER_OBJECT);
+	addConstant(constants, "flags", GCT_INT4, 1, GPV_PER_OBJECT);
+	addConstant(constants, "counts", GCT_INT4, 1, GPV_GLOBAL);
+
+	mParams.bind(OGRE_NEW GpuProgramParameters());
+	mParams->_setNamedConstants(GpuNamedConstantsPtr(constants));
+	mParams->_clearDirtyRanges();
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::tearDown()
+{
+	mParams.setNull();
+}
+//--------------------------------------------------------------------------
+const GpuConstantDefinition& GpuProgramParametersTests::getDef(const String& name) const
+{
+	return mParams->getConstantDefinition(name);
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::testUnchangedValues()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// The constants start at zero, writing zero again changes nothing
+	mParams->setNamedConstant("colour", Vector4::ZERO);
+	mParams->setNamedConstant("world", Matrix4::ZERO);
+	int zeros[4] = { 0, 0, 0, 0 };
+	mParams->setNamedConstant("flags", zeros, 1);
+	CPPUNIT_ASSERT(!mParams->hasDirtyConstants());
+
+	// Writing the same value twice only flags it once
+	mParams->setNamedConstant("colour", Vector4(1, 2, 3, 4));
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(getDef("colour").physicalIndex, 4));
+	mParams->_clearDirtyRanges();
+	mParams->setNamedConstant("colour", Vector4(1, 2, 3, 4));
+	CPPUNIT_ASSERT(!mParams->hasDirtyConstants());
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::testSeparateWrites()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Changes at both ends of the buffer do not flag what lies between
+	mParams->setNamedConstant("colour", Vector4(1, 2, 3, 4));
+	mParams->setNamedConstant("light", Vector4(5, 6, 7, 8));
+	const GpuConstantDefinition& colour = getDef("colour");
+	const GpuConstantDefinition& world = getDef("world");
+	const GpuConstantDefinition& bones = getDef("bones");
+	const GpuConstantDefinition& light = getDef("light");
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(colour.physicalIndex, 4));
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(light.physicalIndex, 4));
+	CPPUNIT_ASSERT(!mParams->isFloatRangeDirty(world.physicalIndex, 16));
+	CPPUNIT_ASSERT(!mParams->isFloatRangeDirty(bones.physicalIndex, 4 * 64));
+
+	// Down to single values, and whatever word boundaries they cross
+	Real value = 9;
+	size_t index = bones.physicalIndex + 31;
+	mParams->_writeRawConstants(index, &value, 1);
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(index, 1));
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(index - 4, 5));
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(index, 2));
+	CPPUNIT_ASSERT(!mParams->isFloatRangeDirty(index - 4, 4));
+	CPPUNIT_ASSERT(!mParams->isFloatRangeDirty(index + 1, 4));
+
+	// Ints are tracked apart from floats
+	CPPUNIT_ASSERT(!mParams->isIntRangeDirty(0, 8));
+	int flags[4] = { 1, 0, 0, 0 };
+	mParams->setNamedConstant("flags", flags, 1);
+	CPPUNIT_ASSERT(mParams->isIntRangeDirty(getDef("flags").physicalIndex, 4));
+	CPPUNIT_ASSERT(!mParams->isIntRangeDirty(getDef("counts").physicalIndex, 4));
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::testClearDirtyRanges()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	mParams->setNamedConstant("world", Matrix4::IDENTITY);
+	int counts[4] = { 1, 2, 3, 4 };
+	mParams->setNamedConstant("counts", counts, 1);
+	CPPUNIT_ASSERT(mParams->hasDirtyConstants());
+
+	mParams->_clearDirtyRanges();
+	CPPUNIT_ASSERT(!mParams->hasDirtyConstants());
+	CPPUNIT_ASSERT(!mParams->isFloatRangeDirty(0, mParams->getFloatConstantList().size()));
+	CPPUNIT_ASSERT(!mParams->isIntRangeDirty(0, mParams->getIntConstantList().size()));
+
+	// Changes after a clear are flagged again, and only them
+	mParams->setNamedConstant("colour", Vector4(1, 0, 0, 0));
+	CPPUNIT_ASSERT(mParams->isFloatRangeDirty(getDef("colour").physicalIndex, 4));
+	CPPUNIT_ASSERT(!mParams->isFloatRangeDirty(getDef("world").physicalIndex, 16));
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::testMarkAllDirty()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	mParams->_markAllDirty();
+	size_t numFloats = mParams->getFloatConstantList().size();
+	for (size_t i = 0; i < numFloats; ++i)
+		CPPUNIT_ASSERT(mParams->isFloatRangeDirty(i, 1));
+	CPPUNIT_ASSERT(mParams->isIntRangeDirty(mParams->getIntConstantList().size() - 1, 1));
+
+	// So does a copy, which may be bound to another program
+	mParams->_clearDirtyRanges();
+	GpuProgramParameters copy(*mParams);
+	CPPUNIT_ASSERT(copy.isFloatRangeDirty(numFloats - 1, 1));
+	CPPUNIT_ASSERT(!mParams->hasDirtyConstants());
+}
+//--------------------------------------------------------------------------
+void GpuProgramParametersTests::testUploadRequired()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	const GpuConstantDefinition& world = getDef("world");
+	const GpuConstantDefinition& light = getDef("light");
+	const GpuConstantDefinition& flags = getDef("flags");
+	uint16 perObject = GPV_PER_OBJECT;
+	uint16 all = GPV_ALL;
+
+	// Unchanged constants are only uploaded when the program is bound
+	CPPUNIT_ASSERT(!mParams->_isUploadRequired(world, perObject));
+	CPPUNIT_ASSERT(mParams->_isUploadRequired(world, all));
+	// Constants of other variabilities never
+	CPPUNIT_ASSERT(!mParams->_isUploadRequired(light, perObject));
+	// Double constants always, their changes are not tracked
+	CPPUNIT_ASSERT(mParams->_isUploadRequired(getDef("precise"), perObject));
+
+	mParams->setNamedConstant("world", Matrix4::IDENTITY);
+	int ones[4] = { 1, 1, 1, 1 };
+	mParams->setNamedConstant("flags", ones, 1);
+	CPPUNIT_ASSERT(mParams->_isUploadRequired(world, perObject));
+	CPPUNIT_ASSERT(mParams->_isUploadRequired(flags, perObject));
+	CPPUNIT_ASSERT(!mParams->_isUploadRequired(light, perObject));
+	CPPUNIT_ASSERT(!mParams->_isUploadRequired(getDef("bones"), perObject));
+
+	// Same through the logical index uses of low level programs
+	GpuLogicalIndexUse worldUse(world.physicalIndex, 16, GPV_PER_OBJECT);
+	GpuLogicalIndexUse colourUse(getDef("colour").physicalIndex, 4, GPV_PER_OBJECT);
+	GpuLogicalIndexUse flagsUse(flags.physicalIndex, 4, GPV_PER_OBJECT);
+	CPPUNIT_ASSERT(mParams->_isFloatUploadRequired(worldUse, perObject));
+	CPPUNIT_ASSERT(!mParams->_isFloatUploadRequired(colourUse, perObject));
+	CPPUNIT_ASSERT(mParams->_isFloatUploadRequired(colourUse, all));
+	CPPUNIT_ASSERT(mParams->_isIntUploadRequired(flagsUse, perObject));
+
+	mParams->_clearDirtyRanges();
+	CPPUNIT_ASSERT(!mParams->_isUploadRequired(world, perObject));
+	CPPUNIT_ASSERT(!mParams->_isFloatUploadRequired(worldUse, perObject));
+	CPPUNIT_ASSERT(!mParams->_isIntUploadRequired(flagsUse, perObject));
+}
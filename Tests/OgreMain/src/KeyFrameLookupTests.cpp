@@ -0,0 +1,127 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "KeyFrameLookupTests.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreMath.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(KeyFrameLookupTests);
+
+/// Number of keys of the track, a long motion capture clip
+static const size_t NUM_KEYS = 20000;
+/// Number of samples per key
+static const size_t SAMPLES_PER_KEY = 4;
+
+//--------------------------------------------------------------------------
+void KeyFrameLookupTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same keys and lookups on every run, so that failures reproduce
+	srand(0);
+
+	// 120Hz keys with some jitter, so that they are not evenly spaced
+	Real length = NUM_KEYS / 120.0f;
+	mAnimation = OGRE_NEW Animation("KeyFrameLookup", length);
+	mTrack = mAnimation->createNodeTrack(0);
+	mTimes.clear();
+	for (size_t i = 0; i < NUM_KEYS; ++i)
+	{
+		Real time = (i + Math::UnitRandom() * 0.5f) / 120.0f;
+		if (i == 0)
+			time = 0;
+		mTrack->createNodeKeyFrame(time);
+		mTimes.push_back(time);
+	}
+}
+//--------------------------------------------------------------------------
+void KeyFrameLookupTests::tearDown()
+{
+	OGRE_DELETE mAnimation;
+}
+//--------------------------------------------------------------------------
+void KeyFrameLookupTests::lookup(const vector<Real>::type& times)
+{
+	// Check every result against a plain binary search
+	for (size_t i = 0; i < times.size(); ++i)
+	{
+		Real time = times[i];
+		size_t bound = std::lower_bound(mTimes.begin(), mTimes.end(), time) - mTimes.begin();
+		size_t expected = bound;
+		if (bound == mTimes.size() || (bound != 0 && time < mTimes[bound]))
+			--expected;
+
+		KeyFrame *kf1, *kf2;
+		unsigned short index;
+		mTrack->getKeyFramesAtTime(TimeIndex(time), &kf1, &kf2, &index);
+		CPPUNIT_ASSERT_EQUAL(expected, (size_t)index);
+		mTrack->getKeyFramesAtTime(mAnimation->_getTimeIndex(time), &kf1, &kf2, &index);
+		CPPUNIT_ASSERT_EQUAL(expected, (size_t)index);
+	}
+
+}
+//--------------------------------------------------------------------------
+void KeyFrameLookupTests::testForward()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	vector<Real>::type times;
+	Real step = mAnimation->getLength() / (NUM_KEYS * SAMPLES_PER_KEY);
+	for (size_t i = 0; i < NUM_KEYS * SAMPLES_PER_KEY; ++i)
+		times.push_back(i * step);
+
+	lookup(times);
+}
+//--------------------------------------------------------------------------
+void KeyFrameLookupTests::testReverse()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	vector<Real>::type times;
+	Real step = mAnimation->getLength() / (NUM_KEYS * SAMPLES_PER_KEY);
+	for (size_t i = NUM_KEYS * SAMPLES_PER_KEY; i > 0; --i)
+		times.push_back((i - 1) * step);
+
+	lookup(times);
+}
+//--------------------------------------------------------------------------
+void KeyFrameLookupTests::testRandom()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	vector<Real>::type times;
+	for (size_t i = 0; i < NUM_KEYS * SAMPLES_PER_KEY; ++i)
+		times.push_back(Math::UnitRandom() * mAnimation->getLength());
+
+	lookup(times);
+}
@@ -0,0 +1,190 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <stdio.h>
+#include "Ogre.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreLodStrategyManager.h"
+#include "OgreMeshSerializerImpl.h"
+#include "MeshSerializerTests.h"
+
+#include "UnitTestSuite.h"
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(MeshSerializerTests);
+
+//--------------------------------------------------------------------------
+void MeshSerializerTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    OGRE_NEW ResourceGroupManager();
+    OGRE_NEW LodStrategyManager();
+    mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+    mMeshMgr = OGRE_NEW MeshManager();
+
+    MaterialManager* matMgr = OGRE_NEW MaterialManager();
+    matMgr->initialise();
+}
+//--------------------------------------------------------------------------
+void MeshSerializerTests::tearDown()
+{
+    OGRE_DELETE MaterialManager::getSingletonPtr();
+    OGRE_DELETE mMeshMgr;
+    OGRE_DELETE mBufMgr;
+    OGRE_DELETE LodStrategyManager::getSingletonPtr();
+    OGRE_DELETE ResourceGroupManager::getSingletonPtr();
+}
+//--------------------------------------------------------------------------
+MeshPtr MeshSerializerTests::createPyramid(const String& name)
+{
+    ManualObject* pyramid = OGRE_NEW ManualObject("pyramid");
+    pyramid->begin("BaseWhiteNoLighting", RenderOperation::OT_TRIANGLE_LIST);
+    pyramid->position(0, 0, 0);
+    pyramid->textureCoord(0, 0);
+    pyramid->position(50, 0, 0);
+    pyramid->textureCoord(1, 0);
+    pyramid->position(0, 100, 0);
+    pyramid->textureCoord(0, 1);
+    pyramid->position(0, 0, -50);
+    pyramid->textureCoord(1, 1);
+    pyramid->triangle(0, 1, 2);
+    pyramid->triangle(0, 2, 3);
+    pyramid->triangle(1, 3, 2);
+    pyramid->triangle(0, 3, 1);
+    pyramid->end();
+    MeshPtr mesh = pyramid->convertToMesh(name);
+    OGRE_DELETE pyramid;
+
+    mesh->buildEdgeList();
+    return mesh;
+}
+//--------------------------------------------------------------------------
+MeshPtr MeshSerializerTests::exportAndImport(const MeshPtr& mesh, MeshVersion version,
+    MeshSerializeInfo& info)
+{
+    String fileName = mesh->getName() + ".export.mesh";
+    MeshSerializer serializer;
+    serializer.exportMesh(mesh.get(), fileName, version);
+
+    std::ifstream* file = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL)(
+        fileName.c_str(), std::ios::in | std::ios::binary);
+    DataStreamPtr fileStream(OGRE_NEW FileStreamDataStream(file));
+    DataStreamPtr stream(OGRE_NEW MemoryDataStream(fileStream));
+    fileStream->close();
+    remove(fileName.c_str());
+
+    MeshPtr imported = mMeshMgr->createManual(mesh->getName() + ".imported",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    serializer.importMesh(stream, imported.get(), &info);
+    serializer.importMeshVertexData(stream, imported.get(), &info);
+    return imported;
+}
+//--------------------------------------------------------------------------
+void MeshSerializerTests::testBakedMesh()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    MeshPtr mesh = createPyramid("testBakedMesh");
+    MeshSerializeInfo info;
+    MeshPtr baked = exportAndImport(mesh, MESH_VERSION_BAKED, info);
+
+    CPPUNIT_ASSERT_EQUAL(String("[MeshSerializer_v1.8_baked]"), info.meshVersionString);
+    // Imported bounds are padded
+    CPPUNIT_ASSERT(baked->getBounds().contains(mesh->getBounds()));
+    CPPUNIT_ASSERT_EQUAL(mesh->getNumSubMeshes(), baked->getNumSubMeshes());
+
+    // Buffer data starts on aligned offsets of the file
+    SubMeshInfo& smInfo = info.submeshes[0];
+    CPPUNIT_ASSERT(smInfo.offset % MeshSerializerImpl_Baked::DATA_ALIGNMENT == 0);
+    CPPUNIT_ASSERT(!smInfo.vertexDataInfo->vertexBufferInfo.empty());
+    for (MeshVertexDataInfo::BufferInfoMap::iterator i = smInfo.vertexDataInfo->vertexBufferInfo.begin();
+        i != smInfo.vertexDataInfo->vertexBufferInfo.end(); ++i)
+    {
+        CPPUNIT_ASSERT(i->second.offset % MeshSerializerImpl_Baked::DATA_ALIGNMENT == 0);
+    }
+
+    // Vertex and index buffers
+    SubMesh* sm = mesh->getSubMesh(0);
+    SubMesh* bakedSm = baked->getSubMesh(0);
+    CPPUNIT_ASSERT_EQUAL(sm->vertexData->vertexCount, bakedSm->vertexData->vertexCount);
+    HardwareVertexBufferSharedPtr vbuf = sm->vertexData->vertexBufferBinding->getBuffer(0);
+    HardwareVertexBufferSharedPtr bakedVbuf = bakedSm->vertexData->vertexBufferBinding->getBuffer(0);
+    CPPUNIT_ASSERT_EQUAL(vbuf->getSizeInBytes(), bakedVbuf->getSizeInBytes());
+    CPPUNIT_ASSERT(memcmp(vbuf->lock(HardwareBuffer::HBL_READ_ONLY),
+        bakedVbuf->lock(HardwareBuffer::HBL_READ_ONLY), vbuf->getSizeInBytes()) == 0);
+    vbuf->unlock();
+    bakedVbuf->unlock();
+
+    CPPUNIT_ASSERT_EQUAL(sm->indexData->indexCount, bakedSm->indexData->indexCount);
+    HardwareIndexBufferSharedPtr ibuf = sm->indexData->indexBuffer;
+    HardwareIndexBufferSharedPtr bakedIbuf = bakedSm->indexData->indexBuffer;
+    CPPUNIT_ASSERT_EQUAL(ibuf->getType(), bakedIbuf->getType());
+    CPPUNIT_ASSERT(memcmp(ibuf->lock(HardwareBuffer::HBL_READ_ONLY),
+        bakedIbuf->lock(HardwareBuffer::HBL_READ_ONLY), ibuf->getSizeInBytes()) == 0);
+    ibuf->unlock();
+    bakedIbuf->unlock();
+
+    // Edge list
+    EdgeData* edges = mesh->getEdgeList();
+    EdgeData* bakedEdges = baked->getEdgeList();
+    CPPUNIT_ASSERT(bakedEdges);
+    CPPUNIT_ASSERT_EQUAL(edges->isClosed, bakedEdges->isClosed);
+    CPPUNIT_ASSERT_EQUAL(edges->triangles.size(), bakedEdges->triangles.size());
+    for (size_t t = 0; t < edges->triangles.size(); ++t)
+    {
+        const EdgeData::Triangle& tri = edges->triangles[t];
+        const EdgeData::Triangle& bakedTri = bakedEdges->triangles[t];
+        CPPUNIT_ASSERT_EQUAL(tri.vertexSet, bakedTri.vertexSet);
+        for (size_t v = 0; v < 3; ++v)
+        {
+            CPPUNIT_ASSERT_EQUAL(tri.vertIndex[v], bakedTri.vertIndex[v]);
+            CPPUNIT_ASSERT_EQUAL(tri.sharedVertIndex[v], bakedTri.sharedVertIndex[v]);
+        }
+        CPPUNIT_ASSERT_EQUAL(edges->triangleFaceNormals[t], bakedEdges->triangleFaceNormals[t]);
+    }
+    CPPUNIT_ASSERT_EQUAL(edges->edgeGroups.size(), bakedEdges->edgeGroups.size());
+    for (size_t g = 0; g < edges->edgeGroups.size(); ++g)
+    {
+        const EdgeData::EdgeGroup& group = edges->edgeGroups[g];
+        const EdgeData::EdgeGroup& bakedGroup = bakedEdges->edgeGroups[g];
+        CPPUNIT_ASSERT_EQUAL(group.triCount, bakedGroup.triCount);
+        CPPUNIT_ASSERT(bakedGroup.vertexData == bakedSm->vertexData);
+        CPPUNIT_ASSERT_EQUAL(group.edges.size(), bakedGroup.edges.size());
+        for (size_t e = 0; e < group.edges.size(); ++e)
+        {
+            CPPUNIT_ASSERT_EQUAL(group.edges[e].triIndex[0], bakedGroup.edges[e].triIndex[0]);
+            CPPUNIT_ASSERT_EQUAL(group.edges[e].triIndex[1], bakedGroup.edges[e].triIndex[1]);
+            CPPUNIT_ASSERT_EQUAL(group.edges[e].vertIndex[0], bakedGroup.edges[e].vertIndex[0]);
+            CPPUNIT_ASSERT_EQUAL(group.edges[e].vertIndex[1], bakedGroup.edges[e].vertIndex[1]);
+            CPPUNIT_ASSERT_EQUAL(group.edges[e].degenerate, bakedGroup.edges[e].degenerate);
+        }
+    }
+
+    mMeshMgr->remove(baked->getHandle());
+    mMeshMgr->remove(mesh->getHandle());
+}
@@ -0,0 +1,279 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "NodeChildrenTests.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreStringConverter.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(NodeChildrenTests);
+
+/// Number of children created by most tests
+static const size_t NUM_CHILDREN = 10;
+
+//--------------------------------------------------------------------------
+void NodeChildrenTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+	mParent = mSceneMgr->getRootSceneNode()->createChildSceneNode("Parent");
+	mChildren.clear();
+	mNumCreated = 0;
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::tearDown()
+{
+	mChildren.clear();
+	OGRE_DELETE mRoot;
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::createChildren(size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+	{
+		Node* child = mParent->createChild("Child" + StringConverter::toString(mNumCreated++));
+		mChildren.insert(child);
+	}
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::checkChildren(void)
+{
+	CPPUNIT_ASSERT_EQUAL(mChildren.size(), (size_t)mParent->numChildren());
+
+	// Every index holds a different expected child
+	set<Node*>::type found;
+	for (unsigned short i = 0; i < mParent->numChildren(); ++i)
+	{
+		Node* child = mParent->getChild(i);
+		CPPUNIT_ASSERT(mChildren.count(child));
+		CPPUNIT_ASSERT(found.insert(child).second);
+		CPPUNIT_ASSERT(child->getParent() == mParent);
+	}
+
+	Node::ChildNodeIterator it = mParent->getChildIterator();
+	size_t count = 0;
+	while (it.hasMoreElements())
+	{
+		CPPUNIT_ASSERT(mChildren.count(it.getNext()));
+		++count;
+	}
+	CPPUNIT_ASSERT_EQUAL(mChildren.size(), count);
+
+	for (set<Node*>::type::iterator i = mChildren.begin(); i != mChildren.end(); ++i)
+		CPPUNIT_ASSERT(mParent->getChild((*i)->getName()) == *i);
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::checkRemoved(Node* child)
+{
+	CPPUNIT_ASSERT(mChildren.erase(child) == 1);
+	CPPUNIT_ASSERT(child->getParent() == 0);
+	try
+	{
+		mParent->getChild(child->getName());
+		CPPUNIT_FAIL("Expected ItemIdentityException!");
+	}
+	catch (const ItemIdentityException&)
+	{
+		// Ok
+	}
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::testRemoveChildByIndex()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createChildren(NUM_CHILDREN);
+	checkChildren();
+
+	// The last child moves into the slot of the removed one
+	Node* last = mParent->getChild(NUM_CHILDREN - 1);
+	Node* removed = mParent->getChild(2);
+	CPPUNIT_ASSERT(mParent->removeChild(2) == removed);
+	checkRemoved(removed);
+	CPPUNIT_ASSERT(mParent->getChild(2) == last);
+	checkChildren();
+
+	// Removing the moved child again, and the last one, by index
+	CPPUNIT_ASSERT(mParent->removeChild(2) == last);
+	checkRemoved(last);
+	checkChildren();
+	removed = mParent->getChild(mParent->numChildren() - 1);
+	CPPUNIT_ASSERT(mParent->removeChild(mParent->numChildren() - 1) == removed);
+	checkRemoved(removed);
+	checkChildren();
+
+	try
+	{
+		mParent->removeChild(mParent->numChildren());
+		CPPUNIT_FAIL("Expected InvalidParametersException!");
+	}
+	catch (const InvalidParametersException&)
+	{
+		// Ok
+	}
+	checkChildren();
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::testRemoveChildByPointer()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createChildren(NUM_CHILDREN);
+
+	Node* last = mParent->getChild(NUM_CHILDREN - 1);
+	Node* first = mParent->getChild(0);
+	CPPUNIT_ASSERT(mParent->removeChild(first) == first);
+	checkRemoved(first);
+	checkChildren();
+
+	// The last child was moved, its index must have followed
+	CPPUNIT_ASSERT(mParent->removeChild(last) == last);
+	checkRemoved(last);
+	checkChildren();
+
+	// Not a child of this node, left alone
+	Node* other = mSceneMgr->getRootSceneNode()->createChild("Other");
+	CPPUNIT_ASSERT(mParent->removeChild(other) == other);
+	CPPUNIT_ASSERT(other->getParent() == mSceneMgr->getRootSceneNode());
+	checkChildren();
+
+	// A removed child can be added back
+	mParent->addChild(first);
+	mChildren.insert(first);
+	checkChildren();
+
+	while (!mChildren.empty())
+	{
+		Node* child = *mChildren.begin();
+		CPPUNIT_ASSERT(mParent->removeChild(child) == child);
+		checkRemoved(child);
+		checkChildren();
+	}
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::testRemoveChildByName()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createChildren(NUM_CHILDREN);
+
+	// Removed before and after the name index is built
+	Node* child = mParent->getChild(3);
+	CPPUNIT_ASSERT(mParent->removeChild(child->getName()) == child);
+	checkRemoved(child);
+	checkChildren();
+	for (size_t i = 0; i < NUM_CHILDREN; i += 2)
+	{
+		String name = "Child" + StringConverter::toString(i);
+		if (mParent->numChildren() == 0 || name == child->getName())
+			continue;
+		Node* named = mParent->getChild(name);
+		CPPUNIT_ASSERT(mParent->removeChild(name) == named);
+		checkRemoved(named);
+		checkChildren();
+	}
+
+	try
+	{
+		mParent->removeChild("Child0");
+		CPPUNIT_FAIL("Expected ItemIdentityException!");
+	}
+	catch (const ItemIdentityException&)
+	{
+		// Ok
+	}
+	checkChildren();
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::testGetChildAfterRemovals()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createChildren(NUM_CHILDREN);
+	checkChildren();
+
+	// Mixed removals and additions while the name index exists
+	checkRemoved(mParent->removeChild(1));
+	checkRemoved(mParent->removeChild(mParent->getChild(4)));
+	checkRemoved(mParent->removeChild("Child7"));
+	createChildren(2);
+	Node* added = mParent->createChild("Added");
+	mChildren.insert(added);
+	checkChildren();
+
+	// Removing them all drops the index, which is built again on demand
+	mParent->removeAllChildren();
+	for (set<Node*>::type::iterator i = mChildren.begin(); i != mChildren.end(); ++i)
+		CPPUNIT_ASSERT((*i)->getParent() == 0);
+	mChildren.clear();
+	checkChildren();
+
+	mParent->addChild(added);
+	mChildren.insert(added);
+	checkChildren();
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::testNamelessChildren()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Generated names are unique and can be looked up
+	for (size_t i = 0; i < NUM_CHILDREN; ++i)
+		mChildren.insert(mParent->createChild());
+	checkChildren();
+
+	Node* child = mParent->getChild(5);
+	CPPUNIT_ASSERT(mParent->removeChild(child->getName()) == child);
+	checkRemoved(child);
+	checkChildren();
+}
+//--------------------------------------------------------------------------
+void NodeChildrenTests::testDuplicateName()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createChildren(NUM_CHILDREN);
+
+	// The scene manager refuses the name before the child is added
+	try
+	{
+		mParent->createChild("Child1");
+		CPPUNIT_FAIL("Expected ItemIdentityException!");
+	}
+	catch (const ItemIdentityException&)
+	{
+		// Ok
+	}
+	checkChildren();
+}
@@ -0,0 +1,172 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "PackArchiveTests.h"
+#include "OgrePackArchive.h"
+#include "OgreException.h"
+
+#include "UnitTestSuite.h"
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_APPLE
+#include "macUtils.h"
+#endif
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(PackArchiveTests);
+
+//--------------------------------------------------------------------------
+void PackArchiveTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    // ArchiveTest.zip packed with OgrePackTool -a 64
+#if OGRE_PLATFORM == OGRE_PLATFORM_APPLE
+    mTestPath = macBundlePath() + "/Contents/Resources/Media/misc/ArchiveTest.pack";
+#elif OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+    mTestPath = "../../Tests/OgreMain/misc/ArchiveTest.pack";
+#else
+    mTestPath = "./Tests/OgreMain/misc/ArchiveTest.pack";
+#endif
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::tearDown()
+{
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testListNonRecursive()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    PackArchive arch(mTestPath, "Pack");
+    arch.load();
+
+    StringVectorPtr vec = arch.list(false);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(1));
+
+    vec = arch.list(false, true);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("level2"), vec->at(1));
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testListRecursive()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    PackArchive arch(mTestPath, "Pack");
+    arch.load();
+
+    // Files are listed with their path, in index order
+    StringVectorPtr vec = arch.list(true);
+    CPPUNIT_ASSERT_EQUAL((size_t)6, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts/file.material"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts/file2.material"), vec->at(1));
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/file3.material"), vec->at(2));
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/file4.material"), vec->at(3));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), vec->at(4));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(5));
+
+    FileInfoListPtr fil = arch.listFileInfo(true, true);
+    CPPUNIT_ASSERT_EQUAL((size_t)6, fil->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts"), fil->at(2).filename);
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/"), fil->at(2).path);
+    CPPUNIT_ASSERT_EQUAL(String("scripts"), fil->at(2).basename);
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testFindFileInfo()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    PackArchive arch(mTestPath, "Pack");
+    arch.load();
+
+    FileInfoListPtr vec = arch.findFileInfo("*.material", true);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("file3.material"), vec->at(2).basename);
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/"), vec->at(2).path);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, arch.findFileInfo("*.material", false)->size());
+
+    // Looked up in the index
+    vec = arch.findFileInfo("Level1/Materials/Scripts/File2.material");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/scripts/file2.material"), vec->at(0).filename);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, arch.findFileInfo("level1/missing.material")->size());
+
+    vec = arch.findFileInfo("rootfile2.txt", false);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, vec->size());
+    CPPUNIT_ASSERT_EQUAL((size_t)156, vec->at(0).uncompressedSize);
+    CPPUNIT_ASSERT(vec->at(0).compressedSize < vec->at(0).uncompressedSize);
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testFileRead()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    PackArchive arch(mTestPath, "Pack");
+    arch.load();
+
+    CPPUNIT_ASSERT(arch.exists("ROOTFILE.TXT"));
+    CPPUNIT_ASSERT(arch.exists("level2/materials/scripts/file4.material"));
+    CPPUNIT_ASSERT(!arch.exists("file4.material"));
+
+    // Compressed with LZ4
+    DataStreamPtr stream = arch.open("rootfile.txt");
+    CPPUNIT_ASSERT_EQUAL((size_t)130, stream->size());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), stream->getLine());
+
+    // Stored files stay readable once the pack is unloaded
+    DataStreamPtr stored = arch.open("level1\\materials\\scripts\\file.material");
+    CPPUNIT_ASSERT(!stored.isNull());
+    arch.unload();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, stored->size());
+    CPPUNIT_ASSERT(stored->eof());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 4 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 5 in file 1"), stream->getLine());
+    CPPUNIT_ASSERT(stream->eof());
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testDecompressLZ4()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    // One literal repeated by an overlapping match, then the 5 last literals
+    const uchar block[] = { 0x1A, 'a', 0x01, 0x00, 0x50, 'a', 'a', 'a', 'a', 'b' };
+    uchar dest[20];
+    CPPUNIT_ASSERT(PackArchive::decompressLZ4(block, sizeof(block), dest, sizeof(dest)));
+    CPPUNIT_ASSERT_EQUAL(String(19, 'a') + "b", String(reinterpret_cast<char*>(dest), sizeof(dest)));
+
+    // Corrupted data is rejected without writing past the end
+    CPPUNIT_ASSERT(!PackArchive::decompressLZ4(block, sizeof(block), dest, sizeof(dest) - 1));
+    CPPUNIT_ASSERT(!PackArchive::decompressLZ4(block, sizeof(block) - 1, dest, sizeof(dest)));
+    const uchar badOffset[] = { 0x10, 'a', 0x02, 0x00, 0x50, 'a', 'a', 'a', 'a', 'b' };
+    CPPUNIT_ASSERT(!PackArchive::decompressLZ4(badOffset, sizeof(badOffset), dest, sizeof(dest)));
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,231 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ParallelAnimationUpdateTests.h"
+#include "OgreSceneManagerEnumerator.h"
+#include "OgreSkeletonManager.h"
+#include "OgreMeshManager.h"
+#include "OgreEntity.h"
+#include "OgreSceneNode.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationState.h"
+#include "OgreAnimationTrack.h"
+#include "OgreBone.h"
+#include "OgreKeyFrame.h"
+#include "OgreDefaultHardwareBufferManager.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelAnimationUpdateTests);
+
+/// Number of bones of the skeleton, in a single chain
+static const unsigned short NUM_BONES = 4;
+/// Number of entities, some of them sharing skeleton instances
+static const size_t NUM_ENTITIES = 6;
+
+/// Gives access to the stage evaluating the skeletons before culling
+class AnimationUpdateTestSceneManager : public DefaultSceneManager
+{
+public:
+	AnimationUpdateTestSceneManager()
+		: DefaultSceneManager("AnimationUpdateTestSceneManager")
+	{
+	}
+
+	using SceneManager::updateSkeletonPoses;
+};
+
+//--------------------------------------------------------------------------
+static Vector3 randomVector(Real range)
+{
+	return Vector3(Math::RangeRandom(-range, range),
+		Math::RangeRandom(-range, range), Math::RangeRandom(-range, range));
+}
+//--------------------------------------------------------------------------
+void ParallelAnimationUpdateTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same data on every run, so that failures reproduce
+	srand(0);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+	// Worker threads, so that the entities are spread across them
+	DefaultWorkQueueBase* queue = static_cast<DefaultWorkQueueBase*>(mRoot->getWorkQueue());
+	queue->setWorkerThreadCount(3);
+	queue->startup();
+
+	mSkeleton = SkeletonManager::getSingleton().create("ParallelAnimationUpdate",
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+	mSkeleton->load();
+	Bone* parent = 0;
+	for (unsigned short b = 0; b < NUM_BONES; ++b)
+	{
+		Bone* bone = mSkeleton->createBone();
+		if (parent)
+			parent->addChild(bone);
+		bone->setPosition(Vector3::UNIT_Y);
+		parent = bone;
+	}
+	mSkeleton->setBindingPose();
+
+	const char* names[] = { "Walk", "Wave" };
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Animation* anim = mSkeleton->createAnimation(names[i], 2);
+		for (unsigned short b = 0; b < NUM_BONES; ++b)
+		{
+			NodeAnimationTrack* track = anim->createNodeTrack(b);
+			for (size_t k = 0; k < 5; ++k)
+			{
+				TransformKeyFrame* kf = track->createNodeKeyFrame(0.5f * k);
+				kf->setTranslate(randomVector(0.5f));
+				kf->setRotation(Quaternion(Radian(Math::RangeRandom(-1, 1)),
+					randomVector(1).normalisedCopy()));
+			}
+		}
+	}
+
+	// Without submeshes, only the skeleton is animated
+	mMesh = MeshManager::getSingleton().createManual("ParallelAnimationUpdate",
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+	mMesh->setSkeletonName(mSkeleton->getName());
+	mMesh->_setBounds(AxisAlignedBox(-1, -1, -1, 1, 1, 1));
+
+	mSceneMgr = OGRE_NEW AnimationUpdateTestSceneManager();
+	for (size_t i = 0; i < NUM_ENTITIES; ++i)
+	{
+		Entity* ent = mSceneMgr->createEntity(mMesh->getName());
+		mSceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(ent);
+		mEntities.push_back(ent);
+	}
+	// 1 and 2 share the instance of 0, 4 that of 3, 5 has its own
+	mEntities[1]->shareSkeletonInstanceWith(mEntities[0]);
+	mEntities[2]->shareSkeletonInstanceWith(mEntities[0]);
+	mEntities[4]->shareSkeletonInstanceWith(mEntities[3]);
+}
+//--------------------------------------------------------------------------
+void ParallelAnimationUpdateTests::tearDown()
+{
+	mEntities.clear();
+	OGRE_DELETE mSceneMgr;
+	mMesh.setNull();
+	mSkeleton.setNull();
+	OGRE_DELETE mRoot;
+	OGRE_DELETE mBufMgr;
+}
+//--------------------------------------------------------------------------
+void ParallelAnimationUpdateTests::updateFrame(Real time, bool parallel)
+{
+	// A different pose for each instance, blending both animations on one
+	for (size_t i = 0; i < NUM_ENTITIES; ++i)
+	{
+		AnimationState* walk = mEntities[i]->getAnimationState("Walk");
+		walk->setEnabled(true);
+		walk->setTimePosition(time + 0.3f * i);
+	}
+	AnimationState* wave = mEntities[5]->getAnimationState("Wave");
+	wave->setEnabled(true);
+	wave->setWeight(0.5f);
+	wave->setTimePosition(time);
+
+	FrameEvent evt;
+	mRoot->_fireFrameRenderingQueued(evt);
+
+	mSceneMgr->setParallelAnimationUpdate(parallel);
+	static_cast<AnimationUpdateTestSceneManager*>(mSceneMgr)->updateSkeletonPoses();
+	// Every visible instance is evaluated before culling, or else when rendered
+	for (size_t i = 0; i < NUM_ENTITIES; ++i)
+		CPPUNIT_ASSERT_EQUAL(!parallel, mEntities[i]->_isBoneMatricesUpdatePending());
+	for (size_t i = 0; i < NUM_ENTITIES; ++i)
+		mEntities[i]->_updateAnimation();
+	for (size_t i = 0; i < NUM_ENTITIES; ++i)
+		CPPUNIT_ASSERT(!mEntities[i]->_isBoneMatricesUpdatePending());
+}
+//--------------------------------------------------------------------------
+void ParallelAnimationUpdateTests::getBoneMatrices(MatrixList& matrices) const
+{
+	matrices.clear();
+	for (size_t i = 0; i < NUM_ENTITIES; ++i)
+	{
+		CPPUNIT_ASSERT_EQUAL(NUM_BONES, mEntities[i]->_getNumBoneMatrices());
+		const Matrix4* m = mEntities[i]->_getBoneMatrices();
+		matrices.insert(matrices.end(), m, m + NUM_BONES);
+	}
+}
+//--------------------------------------------------------------------------
+void ParallelAnimationUpdateTests::testSharedSkeletons()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	const Real times[] = { 0.1f, 0.75f, 1.6f };
+	for (size_t t = 0; t < 3; ++t)
+	{
+		MatrixList serial;
+		MatrixList parallel;
+		updateFrame(times[t], false);
+		getBoneMatrices(serial);
+		updateFrame(times[t], true);
+		getBoneMatrices(parallel);
+
+		for (size_t i = 0; i < serial.size(); ++i)
+		{
+			for (size_t j = 0; j < 16; ++j)
+				CPPUNIT_ASSERT_EQUAL(serial[i][j / 4][j % 4], parallel[i][j / 4][j % 4]);
+		}
+
+		// Entities sharing an instance share its pose, and only them
+		for (unsigned short b = 0; b < NUM_BONES; ++b)
+		{
+			CPPUNIT_ASSERT(parallel[NUM_BONES + b] == parallel[b]);
+			CPPUNIT_ASSERT(parallel[2 * NUM_BONES + b] == parallel[b]);
+			CPPUNIT_ASSERT(parallel[4 * NUM_BONES + b] == parallel[3 * NUM_BONES + b]);
+		}
+		CPPUNIT_ASSERT(parallel[NUM_BONES - 1] != parallel[4 * NUM_BONES - 1]);
+		CPPUNIT_ASSERT(parallel[4 * NUM_BONES - 1] != parallel[6 * NUM_BONES - 1]);
+	}
+}
+//--------------------------------------------------------------------------
+void ParallelAnimationUpdateTests::testHiddenEntities()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Hidden entities are left to be evaluated if they ever get rendered
+	mEntities[5]->setVisible(false);
+	mEntities[5]->getAnimationState("Walk")->setEnabled(true);
+	FrameEvent evt;
+	mRoot->_fireFrameRenderingQueued(evt);
+	mSceneMgr->setParallelAnimationUpdate(true);
+	static_cast<AnimationUpdateTestSceneManager*>(mSceneMgr)->updateSkeletonPoses();
+	CPPUNIT_ASSERT(!mEntities[0]->_isBoneMatricesUpdatePending());
+	mEntities[5]->setVisible(true);
+	CPPUNIT_ASSERT(mEntities[5]->_isBoneMatricesUpdatePending());
+}
@@ -0,0 +1,214 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ParallelCullingTests.h"
+#include "OgreCamera.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMovableObject.h"
+#include "OgreParallelFor.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreStringConverter.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelCullingTests);
+
+/// Number of frames searched, the parallel search adapts its split meanwhile
+static const size_t NUM_FRAMES = 10;
+
+/// Object logging when it is added to the render queue
+class LoggingObject : public MovableObject
+{
+public:
+	LoggingObject(const String& name, StringVector& log)
+		: MovableObject(name), mBox(-Vector3(2), Vector3(2)), mLog(log)
+	{
+	}
+
+	const String& getMovableType(void) const
+	{
+		static String type = "LoggingObject";
+		return type;
+	}
+	const AxisAlignedBox& getBoundingBox(void) const
+	{
+		return mBox;
+	}
+	Real getBoundingRadius(void) const
+	{
+		return mBox.getMaximum().length();
+	}
+	void _updateRenderQueue(RenderQueue* queue)
+	{
+		mLog.push_back(mName);
+	}
+	void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables = false)
+	{
+	}
+
+private:
+	AxisAlignedBox mBox;
+	StringVector& mLog;
+};
+
+/// Scene node logging its _findVisibleObjects calls, then searching as usual
+class LoggingSceneNode : public SceneNode
+{
+public:
+	LoggingSceneNode(SceneManager* creator, const String& name, StringVector& log)
+		: SceneNode(creator, name), mLog(log)
+	{
+	}
+
+	void _findVisibleObjects(Camera* cam, RenderQueue* queue,
+		VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren = true,
+		bool displayNodes = false, bool onlyShadowCasters = false)
+	{
+		mLog.push_back(mName);
+		SceneNode::_findVisibleObjects(cam, queue, visibleBounds, includeChildren,
+			displayNodes, onlyShadowCasters);
+	}
+
+private:
+	StringVector& mLog;
+};
+
+//--------------------------------------------------------------------------
+void ParallelCullingTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same trees on every run, so that failures reproduce
+	srand(0);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mBufMgr = OGRE_NEW DefaultHardwareBufferManager();
+	mSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+
+	// Not registered with the SceneManager, which would need a RenderSystem
+	// to destroy it
+	mCamera = OGRE_NEW Camera("Camera", mSceneMgr);
+	mCamera->setNearClipDistance(1);
+	mCamera->setFarClipDistance(100);
+}
+//--------------------------------------------------------------------------
+void ParallelCullingTests::tearDown()
+{
+	OGRE_DELETE mCamera;
+	for (size_t i = 0; i < mDerivedNodes.size(); ++i)
+		OGRE_DELETE mDerivedNodes[i];
+	mDerivedNodes.clear();
+	OGRE_DELETE mRoot;
+	OGRE_DELETE mBufMgr;
+	for (size_t i = 0; i < mObjects.size(); ++i)
+		OGRE_DELETE mObjects[i];
+	mObjects.clear();
+	mLog.clear();
+}
+//--------------------------------------------------------------------------
+void ParallelCullingTests::createTree(size_t numNodes, bool derivedNodes)
+{
+	vector<SceneNode*>::type nodes;
+	nodes.push_back(mSceneMgr->getRootSceneNode());
+	for (size_t i = 1; i < numNodes; ++i)
+	{
+		// Deep enough for the search to be split, around the camera which
+		// looks down -Z so that about half of the objects are culled
+		SceneNode* parent = nodes[(size_t)Math::RangeRandom(0, i - 0.01f) / 2];
+		String name = "Node" + StringConverter::toString(i);
+		SceneNode* node;
+		if (derivedNodes && i % 7 == 0)
+		{
+			node = OGRE_NEW LoggingSceneNode(mSceneMgr, name, mLog);
+			parent->addChild(node);
+			mDerivedNodes.push_back(node);
+		}
+		else
+		{
+			node = parent->createChildSceneNode(name);
+		}
+		node->setPosition(Math::RangeRandom(-20, 20), Math::RangeRandom(-20, 20),
+			Math::RangeRandom(-20, 20));
+
+		LoggingObject* object = OGRE_NEW LoggingObject("Object" + StringConverter::toString(i), mLog);
+		mObjects.push_back(object);
+		node->attachObject(object);
+		nodes.push_back(node);
+	}
+	mSceneMgr->_updateSceneGraph(mCamera);
+}
+//--------------------------------------------------------------------------
+void ParallelCullingTests::checkSearch(void)
+{
+	for (size_t frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		mLog.clear();
+		VisibleObjectsBoundsInfo serialBounds;
+		mSceneMgr->setParallelFrustumCulling(false);
+		mSceneMgr->_findVisibleObjects(mCamera, &serialBounds, false);
+		StringVector serialLog = mLog;
+
+		mLog.clear();
+		VisibleObjectsBoundsInfo parallelBounds;
+		mSceneMgr->setParallelFrustumCulling(true);
+		mSceneMgr->_findVisibleObjects(mCamera, &parallelBounds, false);
+
+		CPPUNIT_ASSERT(!serialLog.empty());
+		CPPUNIT_ASSERT(serialLog == mLog);
+		CPPUNIT_ASSERT(serialBounds.aabb == parallelBounds.aabb);
+		CPPUNIT_ASSERT_EQUAL(serialBounds.minDistance, parallelBounds.minDistance);
+		CPPUNIT_ASSERT_EQUAL(serialBounds.maxDistance, parallelBounds.maxDistance);
+
+		mCamera->yaw(Degree(360.0f / NUM_FRAMES));
+	}
+}
+//--------------------------------------------------------------------------
+void ParallelCullingTests::testParallelMatchesSerial()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createTree(1000, false);
+	checkSearch();
+}
+//--------------------------------------------------------------------------
+void ParallelCullingTests::testDerivedSceneNodes()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	createTree(1000, true);
+	checkSearch();
+
+	// Some derived nodes were reached
+	size_t numReached = 0;
+	for (size_t i = 0; i < mDerivedNodes.size(); ++i)
+		numReached += std::count(mLog.begin(), mLog.end(), mDerivedNodes[i]->getName());
+	CPPUNIT_ASSERT(numReached > 0);
+}
@@ -0,0 +1,217 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "RenderQueueSortKeyTests.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMaterialManager.h"
+#include "OgreSceneManager.h"
+#include "OgreCamera.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(RenderQueueSortKeyTests);
+
+/// Renderable at a given depth
+class SortKeyTestRenderable : public Renderable
+{
+public:
+	SortKeyTestRenderable(Real depth) : mDepth(depth) {}
+
+	Real mDepth;
+
+	const MaterialPtr& getMaterial(void) const { return mMaterial; }
+	void getRenderOperation(RenderOperation& op) {}
+	void getWorldTransforms(Matrix4* xform) const { *xform = Matrix4::IDENTITY; }
+	Real getSquaredViewDepth(const Camera* cam) const { return mDepth; }
+	const LightList& getLights(void) const { return mLights; }
+
+private:
+	MaterialPtr mMaterial;
+	LightList mLights;
+};
+
+/// Gives a handful of hashes to many passes
+class SortKeyTestHashFunc : public Pass::HashFunc
+{
+public:
+	uint32 operator()(const Pass* p) const
+	{
+		// Descending with the index, so that the hash order is not the creation order
+		return 0x1000 - p->getIndex() % 3;
+	}
+};
+
+/// Records what it is shown
+class SortKeyTestVisitor : public QueuedRenderableVisitor
+{
+public:
+	vector<const Pass*>::type mPasses;
+	vector<std::pair<const Pass*, Renderable*> >::type mRenderables;
+
+	void visit(RenderablePass* rp)
+	{
+		mRenderables.push_back(std::make_pair(rp->pass, rp->renderable));
+	}
+	bool visit(const Pass* p)
+	{
+		mPasses.push_back(p);
+		return true;
+	}
+	void visit(Renderable* r)
+	{
+		mRenderables.push_back(std::make_pair(mPasses.back(), r));
+	}
+};
+
+static SortKeyTestHashFunc gSortKeyTestHashFunc;
+
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same data on every run, so that failures reproduce
+	srand(0);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mBufferManager = OGRE_NEW DefaultHardwareBufferManager();
+	SceneManager* sceneMgr = mRoot->createSceneManager(ST_GENERIC);
+	mCamera = OGRE_NEW Camera("Camera", sceneMgr);
+
+	MaterialPtr material = MaterialManager::getSingleton().create("SortKey",
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+	mTechnique = material->createTechnique();
+	Pass::setHashFunction(&gSortKeyTestHashFunc);
+}
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::tearDown()
+{
+	Pass::setHashFunction(Pass::MIN_TEXTURE_CHANGE);
+	for (size_t i = 0; i < mRenderables.size(); ++i)
+		OGRE_DELETE mRenderables[i];
+	mRenderables.clear();
+	OGRE_DELETE mCamera;
+	OGRE_DELETE mRoot;
+	OGRE_DELETE mBufferManager;
+}
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::queueRenderables(QueuedRenderableCollection& collection,
+	size_t numPasses, size_t numRenderables)
+{
+	while (mTechnique->getNumPasses() < numPasses)
+		mTechnique->createPass()->_recalculateHash();
+
+	for (size_t i = 0; i < numRenderables; ++i)
+	{
+		// Some items on the same pass at the same depth
+		Real depth = Math::Floor(Math::UnitRandom() * 50);
+		SortKeyTestRenderable* rend = OGRE_NEW SortKeyTestRenderable(depth);
+		mRenderables.push_back(rend);
+		Pass* pass = mTechnique->getPass(static_cast<unsigned short>(i % 7 ? rand() % numPasses : i % numPasses));
+		collection.addRenderable(pass, rend);
+	}
+}
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::checkVisit(QueuedRenderableCollection& collection,
+	size_t numPasses, QueuedRenderableCollection::OrganisationMode om)
+{
+	collection.sort(mCamera);
+	SortKeyTestVisitor visitor;
+	collection.acceptVisitor(&visitor, om);
+
+	// Every pass exactly once, in hash then pointer order
+	CPPUNIT_ASSERT_EQUAL(numPasses, visitor.mPasses.size());
+	set<const Pass*>::type seen(visitor.mPasses.begin(), visitor.mPasses.end());
+	CPPUNIT_ASSERT_EQUAL(numPasses, seen.size());
+	for (size_t i = 1; i < visitor.mPasses.size(); ++i)
+	{
+		const Pass* a = visitor.mPasses[i - 1];
+		const Pass* b = visitor.mPasses[i];
+		CPPUNIT_ASSERT(a->getHash() < b->getHash() || (a->getHash() == b->getHash() && a < b));
+	}
+
+	// Every renderable once, under its pass, front to back, ties in the order queued
+	CPPUNIT_ASSERT_EQUAL(mRenderables.size(), visitor.mRenderables.size());
+	map<Renderable*, size_t>::type queued;
+	for (size_t i = 0; i < mRenderables.size(); ++i)
+		queued[mRenderables[i]] = i;
+	for (size_t i = 0; i < visitor.mRenderables.size(); ++i)
+	{
+		CPPUNIT_ASSERT(queued.count(visitor.mRenderables[i].second) == 1);
+		if (i == 0 || visitor.mRenderables[i].first != visitor.mRenderables[i - 1].first)
+			continue;
+
+		const SortKeyTestRenderable* a =
+			static_cast<const SortKeyTestRenderable*>(visitor.mRenderables[i - 1].second);
+		const SortKeyTestRenderable* b =
+			static_cast<const SortKeyTestRenderable*>(visitor.mRenderables[i].second);
+		CPPUNIT_ASSERT(a->mDepth <= b->mDepth);
+		if (a->mDepth == b->mDepth)
+			CPPUNIT_ASSERT(queued[visitor.mRenderables[i - 1].second] < queued[visitor.mRenderables[i].second]);
+	}
+}
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::testPassesSharingHashes()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	QueuedRenderableCollection collection;
+	collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_KEY);
+	queueRenderables(collection, 6, 500);
+	checkVisit(collection, 6, QueuedRenderableCollection::OM_SORT_KEY);
+
+	// Again the next frame, the collection being reused
+	collection.clear();
+	for (size_t i = 0; i < mRenderables.size(); ++i)
+		OGRE_DELETE mRenderables[i];
+	mRenderables.clear();
+	queueRenderables(collection, 6, 300);
+	checkVisit(collection, 6, QueuedRenderableCollection::OM_SORT_KEY);
+}
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::testManyPasses()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	QueuedRenderableCollection collection;
+	collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_KEY);
+	queueRenderables(collection, 300, 3000);
+	checkVisit(collection, 300, QueuedRenderableCollection::OM_SORT_KEY);
+}
+//--------------------------------------------------------------------------
+void RenderQueueSortKeyTests::testPassGroupRequest()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	QueuedRenderableCollection collection;
+	collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_KEY);
+	queueRenderables(collection, 6, 200);
+	checkVisit(collection, 6, QueuedRenderableCollection::OM_PASS_GROUP);
+}
@@ -0,0 +1,192 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ResourcePrepareTests.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreResourceManager.h"
+#include "OgreStringConverter.h"
+
+#include "UnitTestSuite.h"
+
+#include <stdexcept>
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(ResourcePrepareTests);
+
+/// Number of resources in each group
+static const size_t NUM_RESOURCES = 64;
+
+/// Resource counting its preparations, those named "...Fail..." fail to prepare
+class PrepareTestResource : public Resource
+{
+public:
+	PrepareTestResource(ResourceManager* creator, const String& name,
+		ResourceHandle handle, const String& group)
+		: Resource(creator, name, handle, group), mPrepareCount(0), mLoadCount(0)
+	{
+	}
+
+	size_t mPrepareCount;
+	size_t mLoadCount;
+
+protected:
+	void prepareImpl(void)
+	{
+		++mPrepareCount;
+		// Not an Ogre::Exception, as thrown by third party decoders
+		if (mName.find("Fail") != String::npos)
+			throw std::runtime_error("Cannot prepare " + mName);
+	}
+	void loadImpl(void)
+	{
+		++mLoadCount;
+	}
+	void unloadImpl(void)
+	{
+	}
+	size_t calculateSize(void) const
+	{
+		return 0;
+	}
+};
+
+/// Manager of PrepareTestResource
+class PrepareTestResourceManager : public ResourceManager
+{
+public:
+	PrepareTestResourceManager()
+	{
+		mResourceType = "PrepareTest";
+		mLoadOrder = 1000;
+		ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+	}
+	~PrepareTestResourceManager()
+	{
+		ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+	}
+
+protected:
+	Resource* createImpl(const String& name, ResourceHandle handle,
+		const String& group, bool isManual, ManualResourceLoader* loader,
+		const NameValuePairList* createParams)
+	{
+		return OGRE_NEW PrepareTestResource(this, name, handle, group);
+	}
+};
+
+//--------------------------------------------------------------------------
+void ResourcePrepareTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mManager = OGRE_NEW PrepareTestResourceManager();
+}
+//--------------------------------------------------------------------------
+void ResourcePrepareTests::tearDown()
+{
+	OGRE_DELETE mManager;
+	OGRE_DELETE mRoot;
+}
+//--------------------------------------------------------------------------
+String ResourcePrepareTests::loadGroup(const String& group, bool parallel, bool fail)
+{
+	ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+	rgm.createResourceGroup(group);
+	for (size_t i = 0; i < NUM_RESOURCES; ++i)
+	{
+		String name = (fail && i == NUM_RESOURCES - 1) ? "Fail" : "Resource";
+		mManager->createResource(group + name + StringConverter::toString(i), group);
+	}
+
+	rgm.setParallelPrepare(parallel);
+	String error;
+	try
+	{
+		rgm.loadResourceGroup(group);
+	}
+	catch (std::exception& e)
+	{
+		error = e.what();
+	}
+	rgm.setParallelPrepare(false);
+	return error;
+}
+//--------------------------------------------------------------------------
+void ResourcePrepareTests::testParallelMatchesSerial()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	CPPUNIT_ASSERT(loadGroup("Serial", false, false).empty());
+	CPPUNIT_ASSERT(loadGroup("Parallel", true, false).empty());
+
+	for (size_t i = 0; i < NUM_RESOURCES; ++i)
+	{
+		String index = StringConverter::toString(i);
+		PrepareTestResource* serial = static_cast<PrepareTestResource*>(
+			mManager->getResourceByName("SerialResource" + index, "Serial").get());
+		PrepareTestResource* parallel = static_cast<PrepareTestResource*>(
+			mManager->getResourceByName("ParallelResource" + index, "Parallel").get());
+		CPPUNIT_ASSERT_EQUAL(Resource::LOADSTATE_LOADED, serial->getLoadingState());
+		CPPUNIT_ASSERT_EQUAL(Resource::LOADSTATE_LOADED, parallel->getLoadingState());
+		CPPUNIT_ASSERT_EQUAL((size_t)1, serial->mPrepareCount);
+		CPPUNIT_ASSERT_EQUAL((size_t)1, parallel->mPrepareCount);
+		CPPUNIT_ASSERT_EQUAL((size_t)1, serial->mLoadCount);
+		CPPUNIT_ASSERT_EQUAL((size_t)1, parallel->mLoadCount);
+	}
+}
+//--------------------------------------------------------------------------
+void ResourcePrepareTests::testFailedPrepare()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// The failure is raised by the load in both cases, not by the parallel
+	// prepare, so the resources before it are loaded the same way
+	String serialError = loadGroup("Serial", false, true);
+	String parallelError = loadGroup("Parallel", true, true);
+	CPPUNIT_ASSERT(!serialError.empty());
+	CPPUNIT_ASSERT_EQUAL(StringUtil::replaceAll(serialError, "Serial", "Parallel"), parallelError);
+
+	for (size_t i = 0; i < NUM_RESOURCES; ++i)
+	{
+		String name = (i == NUM_RESOURCES - 1 ? "Fail" : "Resource") + StringConverter::toString(i);
+		PrepareTestResource* serial = static_cast<PrepareTestResource*>(
+			mManager->getResourceByName("Serial" + name, "Serial").get());
+		PrepareTestResource* parallel = static_cast<PrepareTestResource*>(
+			mManager->getResourceByName("Parallel" + name, "Parallel").get());
+		CPPUNIT_ASSERT_EQUAL(serial->getLoadingState(), parallel->getLoadingState());
+		CPPUNIT_ASSERT_EQUAL(serial->mLoadCount, parallel->mLoadCount);
+	}
+
+	// Prepared again by the load after failing in the parallel stage
+	PrepareTestResource* failed = static_cast<PrepareTestResource*>(mManager->getResourceByName(
+		"ParallelFail" + StringConverter::toString(NUM_RESOURCES - 1), "Parallel").get());
+	CPPUNIT_ASSERT_EQUAL(Resource::LOADSTATE_UNLOADED, failed->getLoadingState());
+	CPPUNIT_ASSERT_EQUAL((size_t)2, failed->mPrepareCount);
+}
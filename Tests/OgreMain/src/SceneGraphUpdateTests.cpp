@@ -0,0 +1,279 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SceneGraphUpdateTests.h"
+#include "OgreMovableObject.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SceneGraphUpdateTests);
+
+/// Number of nodes of the trees
+static const size_t NUM_NODES = 200;
+/// Number of frames updated
+static const size_t NUM_FRAMES = 50;
+/// Tolerance on the derived transforms and bounds
+static const Real TOLERANCE = 1e-4f;
+
+/// Object with fixed bounds, so that nodes have world bounds
+class BoundedTestObject : public MovableObject
+{
+public:
+	BoundedTestObject(const AxisAlignedBox& box)
+		: mBox(box)
+	{
+	}
+
+	const String& getMovableType(void) const
+	{
+		static String type = "BoundedTestObject";
+		return type;
+	}
+	const AxisAlignedBox& getBoundingBox(void) const
+	{
+		return mBox;
+	}
+	Real getBoundingRadius(void) const
+	{
+		return mBox.getMaximum().length();
+	}
+	void _updateRenderQueue(RenderQueue* queue)
+	{
+	}
+	void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables = false)
+	{
+	}
+
+private:
+	AxisAlignedBox mBox;
+};
+
+/// Listener counting the updates of a node
+class NodeUpdateCounter : public Node::Listener
+{
+public:
+	NodeUpdateCounter() : mUpdates(0) {}
+	void nodeUpdated(const Node*) { ++mUpdates; }
+	size_t mUpdates;
+};
+
+//--------------------------------------------------------------------------
+static Vector3 randomVector(Real range)
+{
+	return Vector3(Math::RangeRandom(-range, range),
+		Math::RangeRandom(-range, range), Math::RangeRandom(-range, range));
+}
+//--------------------------------------------------------------------------
+static bool isAncestor(const Node* ancestor, const Node* node)
+{
+	for (; node; node = node->getParent())
+	{
+		if (node == ancestor)
+			return true;
+	}
+	return false;
+}
+//--------------------------------------------------------------------------
+static void checkVectors(const Vector3& expected, const Vector3& actual)
+{
+	for (size_t i = 0; i < 3; ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], TOLERANCE * (1 + Math::Abs(expected[i])));
+}
+//--------------------------------------------------------------------------
+static void checkQuaternions(const Quaternion& expected, const Quaternion& actual)
+{
+	// Quaternion::equals goes through acos, too coarse near 1 in single precision
+	for (size_t i = 0; i < 4; ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], TOLERANCE);
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same trees and changes on every run, so that failures reproduce
+	srand(0);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mFullSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+	mIncrementalSceneMgr = mRoot->createSceneManager(ST_GENERIC);
+	mIncrementalSceneMgr->setIncrementalSceneGraphUpdate(true);
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateTests::tearDown()
+{
+	OGRE_DELETE mRoot;
+	for (size_t i = 0; i < mObjects.size(); ++i)
+		OGRE_DELETE mObjects[i];
+	mObjects.clear();
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateTests::createTree(SceneManager* sceneMgr, SceneNodeList& nodes)
+{
+	nodes.clear();
+	nodes.push_back(sceneMgr->getRootSceneNode());
+	for (size_t i = 1; i < NUM_NODES; ++i)
+	{
+		// Mostly shallow with a few long chains
+		size_t parent = (i % 10 == 0) ? i - 1 : (size_t)Math::RangeRandom(0, (Real)i - 0.01f);
+		SceneNode* node = nodes[parent]->createChildSceneNode(randomVector(10),
+			Quaternion(Radian(Math::RangeRandom(0, Math::TWO_PI)), randomVector(1).normalisedCopy()));
+		node->setScale(Vector3(Math::RangeRandom(0.5f, 2)));
+		if (i % 3 == 0)
+		{
+			BoundedTestObject* object = OGRE_NEW BoundedTestObject(AxisAlignedBox(-Vector3(i % 5 + 1.0f), Vector3(i % 7 + 1.0f)));
+			mObjects.push_back(object);
+			node->attachObject(object);
+		}
+		nodes.push_back(node);
+	}
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateTests::checkTrees(const SceneNodeList& full, const SceneNodeList& incremental)
+{
+	for (size_t i = 0; i < full.size(); ++i)
+	{
+		const SceneNode* expected = full[i];
+		const SceneNode* actual = incremental[i];
+		CPPUNIT_ASSERT_EQUAL(expected->getParent() == 0, actual->getParent() == 0);
+		checkVectors(expected->_getDerivedPosition(), actual->_getDerivedPosition());
+		checkVectors(expected->_getDerivedScale(), actual->_getDerivedScale());
+		checkQuaternions(expected->_getDerivedOrientation(), actual->_getDerivedOrientation());
+
+		const AxisAlignedBox& expectedBox = expected->_getWorldAABB();
+		const AxisAlignedBox& actualBox = actual->_getWorldAABB();
+		CPPUNIT_ASSERT_EQUAL(expectedBox.isNull(), actualBox.isNull());
+		if (expectedBox.isFinite())
+		{
+			checkVectors(expectedBox.getMinimum(), actualBox.getMinimum());
+			checkVectors(expectedBox.getMaximum(), actualBox.getMaximum());
+		}
+	}
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateTests::testIncrementalMatchesFull()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	SceneNodeList full, incremental;
+	createTree(mFullSceneMgr, full);
+	srand(0);
+	createTree(mIncrementalSceneMgr, incremental);
+
+	mFullSceneMgr->_updateSceneGraph(0);
+	mIncrementalSceneMgr->_updateSceneGraph(0);
+	checkTrees(full, incremental);
+
+	for (size_t frame = 0; frame < NUM_FRAMES; ++frame)
+	{
+		// A few nodes change in every way, the same in both trees
+		size_t numChanges = frame % 5 == 4 ? 0 : (size_t)Math::RangeRandom(1, 10);
+		for (size_t c = 0; c < numChanges; ++c)
+		{
+			size_t i = (size_t)Math::RangeRandom(1, NUM_NODES - 0.01f);
+			Vector3 v = randomVector(5);
+			Real scale = Math::RangeRandom(0.5f, 2);
+			Quaternion q(Radian(Math::RangeRandom(0, Math::TWO_PI)), randomVector(1).normalisedCopy());
+			size_t parent = (size_t)Math::RangeRandom(0, NUM_NODES - 0.01f);
+			size_t change = c % 5;
+			for (size_t tree = 0; tree < 2; ++tree)
+			{
+				SceneNodeList& nodes = tree ? incremental : full;
+				SceneNode* node = nodes[i];
+				switch (change)
+				{
+				case 0:
+					node->translate(v);
+					break;
+				case 1:
+					node->rotate(q);
+					break;
+				case 2:
+					node->setScale(Vector3(scale));
+					break;
+				case 3:
+					node->setInheritScale(!node->getInheritScale());
+					break;
+				case 4:
+					// Moved under another node which is not below it
+					if (!isAncestor(node, nodes[parent]) && node->getParent())
+					{
+						node->getParent()->removeChild(node);
+						nodes[parent]->addChild(node);
+					}
+					break;
+				}
+			}
+		}
+
+		mFullSceneMgr->_updateSceneGraph(0);
+		mIncrementalSceneMgr->_updateSceneGraph(0);
+		checkTrees(full, incremental);
+	}
+}
+//--------------------------------------------------------------------------
+void SceneGraphUpdateTests::testDestroyAutoTrackingNode()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	SceneManager* sceneMgrs[] = { mFullSceneMgr, mIncrementalSceneMgr };
+	for (size_t s = 0; s < 2; ++s)
+	{
+		SceneManager* sceneMgr = sceneMgrs[s];
+		SceneNode* parent = sceneMgr->getRootSceneNode()->createChildSceneNode();
+		SceneNode* target = sceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(10, 0, 0));
+		SceneNode* tracking = parent->createChildSceneNode();
+		tracking->setAutoTracking(true, target);
+		sceneMgr->_updateSceneGraph(0);
+
+		// Updated directly after the scene graph as SceneManager::_renderScene
+		// does, then moved again before the next update
+		tracking->_autoTrack();
+		tracking->translate(Vector3(1, 0, 0));
+
+		// Once detached the parent must not update it anymore
+		NodeUpdateCounter counter;
+		tracking->setListener(&counter);
+		parent->removeChild(tracking);
+		sceneMgr->_updateSceneGraph(0);
+		CPPUNIT_ASSERT_EQUAL((size_t)0, counter.mUpdates);
+		tracking->setListener(0);
+
+		// Nor once destroyed
+		parent->addChild(tracking);
+		tracking->_autoTrack();
+		tracking->translate(Vector3(1, 0, 0));
+		sceneMgr->destroySceneNode(tracking);
+		sceneMgr->_updateSceneGraph(0);
+		CPPUNIT_ASSERT(!parent->_isUpdatePending());
+	}
+}
@@ -0,0 +1,331 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SkeletonPoseBatchTests.h"
+#include "OgreSkeletonPoseBatch.h"
+#include "OgreSkeletonManager.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationState.h"
+#include "OgreAnimationTrack.h"
+#include "OgreBone.h"
+#include "OgreKeyFrame.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SkeletonPoseBatchTests);
+
+/// Number of instances, enough for several blocks of 4 and a remainder
+static const size_t NUM_INSTANCES = 37;
+/// Length of the animations
+static const Real LENGTH = 2;
+/// Number of keys of each track
+static const size_t NUM_KEYS = 5;
+
+//--------------------------------------------------------------------------
+static Vector3 randomPoseVector(Real range)
+{
+	return Vector3(Math::RangeRandom(-range, range),
+		Math::RangeRandom(-range, range), Math::RangeRandom(-range, range));
+}
+//--------------------------------------------------------------------------
+static Quaternion randomPoseRotation(Real maxAngle)
+{
+	return Quaternion(Radian(Math::RangeRandom(-maxAngle, maxAngle)),
+		randomPoseVector(1).normalisedCopy());
+}
+//--------------------------------------------------------------------------
+static Vector3 randomPoseScale(void)
+{
+	return Vector3(Math::RangeRandom(0.8f, 1.2f),
+		Math::RangeRandom(0.8f, 1.2f), Math::RangeRandom(0.8f, 1.2f));
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same data on every run, so that failures reproduce
+	srand(0);
+
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+
+	// Two chains under the root bone, with scaled bones
+	mSkeleton = SkeletonManager::getSingleton().create("SkeletonPoseBatch",
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+	mSkeleton->load();
+	const unsigned short parents[] = { 0, 0, 1, 0, 3 };
+	for (unsigned short b = 0; b < 5; ++b)
+	{
+		Bone* bone = mSkeleton->createBone();
+		if (b > 0)
+			mSkeleton->getBone(parents[b])->addChild(bone);
+		bone->setPosition(randomPoseVector(1));
+		bone->setOrientation(randomPoseRotation(Math::PI));
+		bone->setScale(randomPoseScale());
+	}
+	mSkeleton->setBindingPose();
+
+	createAnimation(mSkeleton.get(), "Walk");
+	createAnimation(mSkeleton.get(), "Turn");
+	createAnimation(mSkeleton.get(), "Compressed");
+	mSkeleton->getAnimation("Compressed")->compressNodeTracks();
+
+	// Animations shared by another skeleton, at half the scale
+	mLinkedSkeleton = SkeletonManager::getSingleton().create("SkeletonPoseBatchLinked",
+		ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, true);
+	mLinkedSkeleton->load();
+	createAnimation(mLinkedSkeleton.get(), "Jump");
+	mSkeleton->addLinkedSkeletonAnimationSource("SkeletonPoseBatchLinked", 0.5f);
+
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+	{
+		SkeletonInstance* instance = OGRE_NEW SkeletonInstance(mSkeleton);
+		instance->load();
+		mInstances.push_back(instance);
+		AnimationStateSet* states = OGRE_NEW AnimationStateSet();
+		instance->_initAnimationState(states);
+		mAnimationStates.push_back(states);
+	}
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::tearDown()
+{
+	for (size_t i = 0; i < mInstances.size(); ++i)
+	{
+		OGRE_DELETE mAnimationStates[i];
+		OGRE_DELETE mInstances[i];
+	}
+	mAnimationStates.clear();
+	mInstances.clear();
+	mSkeleton.setNull();
+	mLinkedSkeleton.setNull();
+	OGRE_DELETE mRoot;
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::createAnimation(Skeleton* skeleton, const String& name)
+{
+	Animation* anim = skeleton->createAnimation(name, LENGTH);
+	for (unsigned short b = 0; b < 5; ++b)
+	{
+		NodeAnimationTrack* track = anim->createNodeTrack(b);
+		for (size_t k = 0; k < NUM_KEYS; ++k)
+		{
+			TransformKeyFrame* kf = track->createNodeKeyFrame(LENGTH * k / (NUM_KEYS - 1));
+			kf->setTranslate(randomPoseVector(0.5f));
+			// Large rotations, where linear and spherical interpolations differ
+			kf->setRotation(randomPoseRotation(Math::PI * 0.9f));
+			kf->setScale(randomPoseScale());
+		}
+	}
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::enableAnimation(const String& name, Real weight)
+{
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+	{
+		AnimationState* state = mAnimationStates[i]->getAnimationState(name);
+		state->setEnabled(true);
+		state->setTimePosition(LENGTH * i / NUM_INSTANCES);
+		state->setWeight(weight * (1 + 0.5f * (i % 3)));
+	}
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::checkInstances(bool parallel)
+{
+	size_t numBones = mSkeleton->getNumBones();
+	vector<Matrix4>::type expected(NUM_INSTANCES * numBones);
+	vector<Matrix4>::type actual(NUM_INSTANCES * numBones);
+
+	SkeletonPoseBatch batch;
+	batch.reset(mSkeleton.get());
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+		batch.add(mInstances[i], mAnimationStates[i], &actual[i * numBones]);
+	batch.evaluate(parallel);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, batch.getNumInstances());
+
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+	{
+		mInstances[i]->setAnimationState(*mAnimationStates[i]);
+		mInstances[i]->_getBoneMatrices(&expected[i * numBones]);
+	}
+
+	for (size_t m = 0; m < expected.size(); ++m)
+	{
+		for (size_t e = 0; e < 16; ++e)
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[m][0][e], actual[m][0][e], 1e-4);
+	}
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testBlendModes()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Weights adding up to more than 1, which the average mode scales down
+	enableAnimation("Walk", 0.8f);
+	enableAnimation("Turn", 0.7f);
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+		mInstances[i]->setBlendMode(ANIMBLEND_AVERAGE);
+	checkInstances(false);
+
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+		mInstances[i]->setBlendMode(ANIMBLEND_CUMULATIVE);
+	checkInstances(false);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testRotationInterpolation()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	enableAnimation("Walk", 0.6f);
+	enableAnimation("Turn", 0.3f);
+	mSkeleton->getAnimation("Walk")->setRotationInterpolationMode(Animation::RIM_LINEAR);
+	mSkeleton->getAnimation("Turn")->setRotationInterpolationMode(Animation::RIM_LINEAR);
+	checkInstances(false);
+
+	mSkeleton->getAnimation("Walk")->setRotationInterpolationMode(Animation::RIM_SPHERICAL);
+	mSkeleton->getAnimation("Turn")->setRotationInterpolationMode(Animation::RIM_SPHERICAL);
+	checkInstances(false);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testBlendMasks()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	enableAnimation("Walk", 0.5f);
+	enableAnimation("Turn", 0.5f);
+
+	// Partial and null weights on some bones of every other instance
+	for (size_t i = 0; i < NUM_INSTANCES; i += 2)
+	{
+		AnimationState* state = mAnimationStates[i]->getAnimationState("Walk");
+		state->createBlendMask(mSkeleton->getNumBones());
+		state->setBlendMaskEntry(i % 5, 0);
+		state->setBlendMaskEntry((i + 2) % 5, 0.25f);
+	}
+	checkInstances(false);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testDisabledBones()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	enableAnimation("Walk", 1);
+
+	// A different bone disabled on most instances, none on the others
+	vector<Skeleton::BoneMask>::type masks(NUM_INSTANCES,
+		Skeleton::BoneMask(mSkeleton->getNumBones(), false));
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+	{
+		if (i % 6 == 5)
+			continue;
+		masks[i][i % 5] = true;
+		mInstances[i]->_setDisabledBones(&masks[i]);
+	}
+	checkInstances(false);
+
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+		mInstances[i]->_setDisabledBones(0);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testNonInheritingBones()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	enableAnimation("Walk", 1);
+
+	// Flags differing between the instances of the same blocks
+	for (size_t i = 0; i < NUM_INSTANCES; i += 2)
+	{
+		mInstances[i]->getBone(2)->setInheritOrientation(false);
+		mInstances[i]->getBone(4)->setInheritScale(false);
+	}
+	for (size_t i = 0; i < NUM_INSTANCES; i += 3)
+		mInstances[i]->getBone(1)->setInheritScale(false);
+	checkInstances(false);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testLinkedSkeletonScale()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	enableAnimation("Jump", 1);
+	checkInstances(false);
+
+	enableAnimation("Walk", 0.5f);
+	checkInstances(false);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testCompressedTracks()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	CPPUNIT_ASSERT_EQUAL((unsigned short)0,
+		mSkeleton->getAnimation("Compressed")->getNumNodeTracks());
+	enableAnimation("Compressed", 1);
+	checkInstances(false);
+
+	enableAnimation("Walk", 0.5f);
+	checkInstances(false);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseBatchTests::testParallel()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	enableAnimation("Walk", 0.5f);
+	enableAnimation("Turn", 0.4f);
+	enableAnimation("Jump", 0.3f);
+	enableAnimation("Compressed", 0.2f);
+	mSkeleton->getAnimation("Turn")->setRotationInterpolationMode(Animation::RIM_SPHERICAL);
+
+	vector<Skeleton::BoneMask>::type masks(NUM_INSTANCES,
+		Skeleton::BoneMask(mSkeleton->getNumBones(), false));
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+	{
+		mInstances[i]->setBlendMode(i % 2 ? ANIMBLEND_AVERAGE : ANIMBLEND_CUMULATIVE);
+		if (i % 4 == 1)
+		{
+			AnimationState* state = mAnimationStates[i]->getAnimationState("Turn");
+			state->createBlendMask(mSkeleton->getNumBones());
+			state->setBlendMaskEntry(i % 5, 0.5f);
+		}
+		if (i % 5 == 2)
+		{
+			masks[i][(i + 1) % 5] = true;
+			mInstances[i]->_setDisabledBones(&masks[i]);
+		}
+		if (i % 3 == 0)
+			mInstances[i]->getBone(3)->setInheritOrientation(false);
+	}
+	checkInstances(true);
+
+	for (size_t i = 0; i < NUM_INSTANCES; ++i)
+		mInstances[i]->_setDisabledBones(0);
+}
@@ -0,0 +1,239 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SkeletonPoseCacheTests.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationState.h"
+#include "OgreAnimationTrack.h"
+#include "OgreBone.h"
+#include "OgreKeyFrame.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SkeletonPoseCacheTests);
+
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// The frame number comes from the root
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+
+	mSkeleton = OGRE_NEW Skeleton(0, "SkeletonPoseCache", 0, "General");
+	Bone* root = mSkeleton->createBone("Root");
+	root->addChild(mSkeleton->createBone("Child"));
+	mSkeleton->setBindingPose();
+
+	const char* names[] = { "Walk", "Wave" };
+	for (size_t i = 0; i < 2; ++i)
+	{
+		Animation* anim = mSkeleton->createAnimation(names[i], 1);
+		NodeAnimationTrack* track = anim->createNodeTrack(root->getHandle(), root);
+		track->createNodeKeyFrame(0);
+		track->createNodeKeyFrame(1)->setTranslate(Vector3::UNIT_X);
+	}
+
+	mAnimationStates = OGRE_NEW AnimationStateSet();
+	mSkeleton->_initAnimationState(mAnimationStates);
+	AnimationState* state = mAnimationStates->getAnimationState("Walk");
+	state->setEnabled(true);
+	state->setTimePosition(0.5f);
+
+	mCache = OGRE_NEW SkeletonPoseCache();
+	mCache->setEnabled(true);
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::tearDown()
+{
+	OGRE_DELETE mCache;
+	OGRE_DELETE mAnimationStates;
+	OGRE_DELETE mSkeleton;
+	OGRE_DELETE mRoot;
+}
+//--------------------------------------------------------------------------
+bool SkeletonPoseCacheTests::acquire(Matrix4*& matrices)
+{
+	bool evaluated = mCache->_acquirePose(mSkeleton, mSkeleton, *mAnimationStates, matrices);
+	CPPUNIT_ASSERT(matrices != 0);
+	return evaluated;
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::testHitsAndMisses()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	CPPUNIT_ASSERT_EQUAL(Real(0), mCache->getHitRate());
+
+	// The first lookup has to evaluate the pose, the next ones share it
+	Matrix4* first;
+	Matrix4* second;
+	Matrix4* third;
+	CPPUNIT_ASSERT(!acquire(first));
+	CPPUNIT_ASSERT(acquire(second));
+	CPPUNIT_ASSERT(acquire(third));
+	CPPUNIT_ASSERT(first == second && first == third);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mCache->getNumPoses());
+	CPPUNIT_ASSERT_EQUAL((size_t)2, mCache->getHitCount());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mCache->getMissCount());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 / 3.0, mCache->getHitRate(), 1e-6);
+
+	mCache->resetStatistics();
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mCache->getHitCount());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mCache->getMissCount());
+	CPPUNIT_ASSERT_EQUAL(Real(0), mCache->getHitRate());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mCache->getNumPoses());
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::testTimeQuantum()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	AnimationState* state = mAnimationStates->getAnimationState("Walk");
+	Matrix4* first;
+	Matrix4* second;
+
+	// Without a quantum only the same times are shared
+	CPPUNIT_ASSERT(!acquire(first));
+	state->setTimePosition(0.51f);
+	CPPUNIT_ASSERT(!acquire(second));
+	CPPUNIT_ASSERT(first != second);
+
+	// Times rounded to the same multiple of the quantum are
+	mCache->setTimeQuantum(0.1f);
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mCache->getNumPoses());
+	state->setTimePosition(0.5f);
+	CPPUNIT_ASSERT(!acquire(first));
+	state->setTimePosition(0.54f);
+	CPPUNIT_ASSERT(acquire(second));
+	CPPUNIT_ASSERT(first == second);
+	state->setTimePosition(0.46f);
+	CPPUNIT_ASSERT(acquire(second));
+	CPPUNIT_ASSERT(first == second);
+
+	// Others are not
+	state->setTimePosition(0.58f);
+	CPPUNIT_ASSERT(!acquire(second));
+	CPPUNIT_ASSERT(first != second);
+	CPPUNIT_ASSERT_EQUAL((size_t)2, mCache->getNumPoses());
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::testDifferentStates()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	AnimationState* walk = mAnimationStates->getAnimationState("Walk");
+	AnimationState* wave = mAnimationStates->getAnimationState("Wave");
+	Matrix4* matrices[5];
+
+	CPPUNIT_ASSERT(!acquire(matrices[0]));
+
+	// Another weight
+	walk->setWeight(0.5f);
+	CPPUNIT_ASSERT(!acquire(matrices[1]));
+	walk->setWeight(1);
+
+	// Another animation at the same time
+	walk->setEnabled(false);
+	wave->setEnabled(true);
+	wave->setTimePosition(0.5f);
+	CPPUNIT_ASSERT(!acquire(matrices[2]));
+
+	// Both animations
+	walk->setEnabled(true);
+	CPPUNIT_ASSERT(!acquire(matrices[3]));
+	wave->setEnabled(false);
+
+	// Disabled bones
+	Skeleton::BoneMask disabled(mSkeleton->getNumBones(), false);
+	disabled[1] = true;
+	mSkeleton->_setDisabledBones(&disabled);
+	CPPUNIT_ASSERT(!acquire(matrices[4]));
+	mSkeleton->_setDisabledBones(0);
+
+	for (size_t i = 0; i < 5; ++i)
+	{
+		for (size_t j = 0; j < i; ++j)
+			CPPUNIT_ASSERT(matrices[i] != matrices[j]);
+	}
+	CPPUNIT_ASSERT_EQUAL((size_t)5, mCache->getNumPoses());
+	CPPUNIT_ASSERT_EQUAL((size_t)0, mCache->getHitCount());
+
+	// The first pose is still there
+	Matrix4* again;
+	CPPUNIT_ASSERT(acquire(again));
+	CPPUNIT_ASSERT(again == matrices[0]);
+
+	// Blend masks are not cached nor counted
+	walk->createBlendMask(mSkeleton->getNumBones(), 1);
+	CPPUNIT_ASSERT(!mCache->_acquirePose(mSkeleton, mSkeleton, *mAnimationStates, again));
+	CPPUNIT_ASSERT(again == 0);
+	CPPUNIT_ASSERT_EQUAL((size_t)5, mCache->getNumPoses());
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mCache->getHitCount());
+	CPPUNIT_ASSERT_EQUAL((size_t)5, mCache->getMissCount());
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::testNextFrame()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	Matrix4* matrices;
+	CPPUNIT_ASSERT(!acquire(matrices));
+	CPPUNIT_ASSERT(acquire(matrices));
+
+	// Poses are evaluated again in the next frame
+	FrameEvent evt;
+	mRoot->_fireFrameRenderingQueued(evt);
+	CPPUNIT_ASSERT(!acquire(matrices));
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mCache->getNumPoses());
+	CPPUNIT_ASSERT_EQUAL((size_t)2, mCache->getMissCount());
+}
+//--------------------------------------------------------------------------
+void SkeletonPoseCacheTests::testDiscardPose()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	AnimationState* state = mAnimationStates->getAnimationState("Walk");
+	Matrix4* kept;
+	Matrix4* discarded;
+	CPPUNIT_ASSERT(!acquire(kept));
+	state->setTimePosition(0.75f);
+	CPPUNIT_ASSERT(!acquire(discarded));
+
+	// A pose which failed to evaluate is not shared
+	mCache->_discardPose(discarded);
+	CPPUNIT_ASSERT_EQUAL((size_t)1, mCache->getNumPoses());
+	CPPUNIT_ASSERT(!acquire(discarded));
+
+	state->setTimePosition(0.5f);
+	Matrix4* again;
+	CPPUNIT_ASSERT(acquire(again));
+	CPPUNIT_ASSERT(again == kept);
+}
@@ -0,0 +1,227 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SoftwareSkinningTests.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreMath.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SoftwareSkinningTests);
+
+/// Number of vertices, odd so that the implementations handle a remainder
+static const size_t NUM_VERTICES = 10003;
+/// Number of bones
+static const size_t NUM_BONES = 40;
+/// Tolerance on the blended positions and normals
+static const Real TOLERANCE = 1e-4f;
+
+//--------------------------------------------------------------------------
+static Vector3 randomVector(Real range)
+{
+	return Vector3(Math::RangeRandom(-range, range),
+		Math::RangeRandom(-range, range), Math::RangeRandom(-range, range));
+}
+//--------------------------------------------------------------------------
+static void checkVectors(const float* expected, const float* actual, size_t count)
+{
+	for (size_t i = 0; i < count * 3; ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], TOLERANCE);
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same data on every run, so that failures reproduce
+	srand(0);
+
+	// Rigid bone transforms, as dual quaternions do not support scale
+	mMatrices.resize(NUM_BONES);
+	mDualQuaternions.resize(NUM_BONES);
+	mBlendMatrices.resize(NUM_BONES);
+	mBlendDualQuaternions.resize(NUM_BONES);
+	for (size_t b = 0; b < NUM_BONES; ++b)
+	{
+		Quaternion q(Radian(Math::RangeRandom(-Math::PI, Math::PI)),
+			randomVector(1).normalisedCopy());
+		mMatrices[b].makeTransform(randomVector(2), Vector3::UNIT_SCALE, q);
+		mDualQuaternions[b].fromTransformationMatrix(mMatrices[b]);
+		mBlendMatrices[b] = &mMatrices[b];
+		mBlendDualQuaternions[b] = &mDualQuaternions[b];
+	}
+
+	// Up to 4 weights per vertex, the indices of unused weights being valid
+	// as with real meshes
+	mVertices.resize(NUM_VERTICES);
+	for (size_t v = 0; v < NUM_VERTICES; ++v)
+	{
+		Vertex& vertex = mVertices[v];
+		Vector3 position = randomVector(1);
+		Vector3 normal = randomVector(1).normalisedCopy();
+		memcpy(vertex.position, position.ptr(), sizeof(vertex.position));
+		memcpy(vertex.normal, normal.ptr(), sizeof(vertex.normal));
+
+		size_t numWeights = v % 4 + 1;
+		Real total = 0;
+		for (size_t w = 0; w < 4; ++w)
+		{
+			vertex.weights[w] = w < numWeights ? Math::RangeRandom(0.1f, 1) : 0;
+			vertex.indices[w] = w < numWeights ? (unsigned char)Math::RangeRandom(0, NUM_BONES - 1) : 0;
+			total += vertex.weights[w];
+		}
+		for (size_t w = 0; w < 4; ++w)
+			vertex.weights[w] /= total;
+	}
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::tearDown()
+{
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::skinMatrices(float* positions, float* normals)
+{
+	OptimisedUtil::getImplementation()->softwareVertexSkinning(
+		mVertices[0].position, positions,
+		mVertices[0].normal, normals,
+		mVertices[0].weights, mVertices[0].indices,
+		&mBlendMatrices[0],
+		sizeof(Vertex), sizeof(float) * 3,
+		sizeof(Vertex), sizeof(float) * 3,
+		sizeof(Vertex), sizeof(Vertex),
+		4, NUM_VERTICES);
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::skinDualQuaternions(float* positions, float* normals)
+{
+	OptimisedUtil::getImplementation()->softwareVertexDualQuaternionSkinning(
+		mVertices[0].position, positions,
+		mVertices[0].normal, normals,
+		mVertices[0].weights, mVertices[0].indices,
+		&mBlendDualQuaternions[0],
+		sizeof(Vertex), sizeof(float) * 3,
+		sizeof(Vertex), sizeof(float) * 3,
+		sizeof(Vertex), sizeof(Vertex),
+		4, NUM_VERTICES);
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::testMatrixSkinning()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	vector<float>::type expectedPositions(NUM_VERTICES * 3), expectedNormals(NUM_VERTICES * 3);
+	for (size_t v = 0; v < NUM_VERTICES; ++v)
+	{
+		const Vertex& vertex = mVertices[v];
+		Matrix4 blend = Matrix4::ZERO;
+		for (size_t w = 0; w < 4; ++w)
+			blend = blend + mMatrices[vertex.indices[w]] * vertex.weights[w];
+		// The weights only add up to one with rounding errors
+		blend[3][0] = blend[3][1] = blend[3][2] = 0;
+		blend[3][3] = 1;
+
+		Vector3 position = blend.transformAffine(Vector3(vertex.position));
+		Matrix3 linear;
+		blend.extract3x3Matrix(linear);
+		Vector3 normal = linear * Vector3(vertex.normal);
+		normal.normalise();
+		memcpy(&expectedPositions[v * 3], position.ptr(), sizeof(float) * 3);
+		memcpy(&expectedNormals[v * 3], normal.ptr(), sizeof(float) * 3);
+	}
+
+	vector<float>::type positions(NUM_VERTICES * 3), normals(NUM_VERTICES * 3);
+	skinMatrices(&positions[0], &normals[0]);
+	checkVectors(&expectedPositions[0], &positions[0], NUM_VERTICES);
+	checkVectors(&expectedNormals[0], &normals[0], NUM_VERTICES);
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::testDualQuaternionSkinning()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	vector<float>::type expectedPositions(NUM_VERTICES * 3), expectedNormals(NUM_VERTICES * 3);
+	for (size_t v = 0; v < NUM_VERTICES; ++v)
+	{
+		// Blend in the hemisphere of the first bone and normalise
+		const Vertex& vertex = mVertices[v];
+		const DualQuaternion& first = mDualQuaternions[vertex.indices[0]];
+		DualQuaternion blend(0, 0, 0, 0, 0, 0, 0, 0);
+		for (size_t w = 0; w < 4; ++w)
+		{
+			const DualQuaternion& dq = mDualQuaternions[vertex.indices[w]];
+			Real weight = vertex.weights[w];
+			if (dq.w * first.w + dq.x * first.x + dq.y * first.y + dq.z * first.z < 0)
+				weight = -weight;
+			blend = DualQuaternion(blend.w + dq.w * weight, blend.x + dq.x * weight,
+				blend.y + dq.y * weight, blend.z + dq.z * weight,
+				blend.dw + dq.dw * weight, blend.dx + dq.dx * weight,
+				blend.dy + dq.dy * weight, blend.dz + dq.dz * weight);
+		}
+		Real invLength = 1 / Math::Sqrt(blend.w * blend.w + blend.x * blend.x +
+			blend.y * blend.y + blend.z * blend.z);
+		blend = DualQuaternion(blend.w * invLength, blend.x * invLength,
+			blend.y * invLength, blend.z * invLength,
+			blend.dw * invLength, blend.dx * invLength,
+			blend.dy * invLength, blend.dz * invLength);
+
+		Quaternion rotation;
+		Vector3 translation;
+		blend.toRotationTranslation(rotation, translation);
+		Vector3 position = rotation * Vector3(vertex.position) + translation;
+		Vector3 normal = rotation * Vector3(vertex.normal);
+		normal.normalise();
+		memcpy(&expectedPositions[v * 3], position.ptr(), sizeof(float) * 3);
+		memcpy(&expectedNormals[v * 3], normal.ptr(), sizeof(float) * 3);
+	}
+
+	vector<float>::type positions(NUM_VERTICES * 3), normals(NUM_VERTICES * 3);
+	skinDualQuaternions(&positions[0], &normals[0]);
+	checkVectors(&expectedPositions[0], &positions[0], NUM_VERTICES);
+	checkVectors(&expectedNormals[0], &normals[0], NUM_VERTICES);
+}
+//--------------------------------------------------------------------------
+void SoftwareSkinningTests::testRigidSkinning()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	for (size_t v = 0; v < NUM_VERTICES; ++v)
+	{
+		Vertex& vertex = mVertices[v];
+		vertex.weights[0] = 1;
+		vertex.weights[1] = vertex.weights[2] = vertex.weights[3] = 0;
+	}
+
+	vector<float>::type matrixPositions(NUM_VERTICES * 3), matrixNormals(NUM_VERTICES * 3);
+	vector<float>::type positions(NUM_VERTICES * 3), normals(NUM_VERTICES * 3);
+	skinMatrices(&matrixPositions[0], &matrixNormals[0]);
+	skinDualQuaternions(&positions[0], &normals[0]);
+	checkVectors(&matrixPositions[0], &positions[0], NUM_VERTICES);
+	checkVectors(&matrixNormals[0], &normals[0], NUM_VERTICES);
+}
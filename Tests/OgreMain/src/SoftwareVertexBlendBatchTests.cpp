@@ -0,0 +1,227 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SoftwareVertexBlendBatchTests.h"
+#include "OgreSoftwareVertexBlendBatch.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreVertexIndexData.h"
+#include "OgreMesh.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SoftwareVertexBlendBatchTests);
+
+/// Number of vertices of each source
+static const size_t NUM_VERTICES = 1001;
+/// Number of bones
+static const size_t NUM_BONES = 20;
+/// Number of sources
+static const size_t NUM_SOURCES = 6;
+/// Blends of a source, the first sources being blended twice
+static const size_t NUM_SHARED_SOURCES = 2;
+
+//--------------------------------------------------------------------------
+static Vector3 randomBlendVector(Real range)
+{
+	return Vector3(Math::RangeRandom(-range, range),
+		Math::RangeRandom(-range, range), Math::RangeRandom(-range, range));
+}
+//--------------------------------------------------------------------------
+/// Creates a position and normal buffer, plus weights and indices for a source
+static VertexData* createBlendVertexData(bool source)
+{
+	VertexData* data = OGRE_NEW VertexData();
+	data->vertexCount = NUM_VERTICES;
+	VertexDeclaration* decl = data->vertexDeclaration;
+	size_t offset = decl->addElement(0, 0, VET_FLOAT3, VES_POSITION).getSize();
+	decl->addElement(0, offset, VET_FLOAT3, VES_NORMAL);
+	HardwareVertexBufferSharedPtr buf = HardwareBufferManager::getSingleton().createVertexBuffer(
+		decl->getVertexSize(0), NUM_VERTICES, HardwareBuffer::HBU_DYNAMIC);
+	data->vertexBufferBinding->setBinding(0, buf);
+
+	float* vertices = static_cast<float*>(buf->lock(HardwareBuffer::HBL_DISCARD));
+	for (size_t v = 0; v < NUM_VERTICES; ++v, vertices += 6)
+	{
+		Vector3 position = source ? randomBlendVector(1) : Vector3::ZERO;
+		Vector3 normal = source ? randomBlendVector(1).normalisedCopy() : Vector3::ZERO;
+		memcpy(vertices, position.ptr(), sizeof(float) * 3);
+		memcpy(vertices + 3, normal.ptr(), sizeof(float) * 3);
+	}
+	buf->unlock();
+	if (!source)
+		return data;
+
+	offset = decl->addElement(1, 0, VET_FLOAT4, VES_BLEND_WEIGHTS).getSize();
+	decl->addElement(1, offset, VET_UBYTE4, VES_BLEND_INDICES);
+	buf = HardwareBufferManager::getSingleton().createVertexBuffer(
+		decl->getVertexSize(1), NUM_VERTICES, HardwareBuffer::HBU_STATIC);
+	data->vertexBufferBinding->setBinding(1, buf);
+
+	unsigned char* blend = static_cast<unsigned char*>(buf->lock(HardwareBuffer::HBL_DISCARD));
+	for (size_t v = 0; v < NUM_VERTICES; ++v, blend += buf->getVertexSize())
+	{
+		float* weights = reinterpret_cast<float*>(blend);
+		unsigned char* indices = blend + offset;
+		size_t numWeights = v % 4 + 1;
+		float total = 0;
+		for (size_t w = 0; w < 4; ++w)
+		{
+			weights[w] = w < numWeights ? Math::RangeRandom(0.1f, 1) : 0;
+			indices[w] = w < numWeights ? (unsigned char)Math::RangeRandom(0, NUM_BONES - 1) : 0;
+			total += weights[w];
+		}
+		for (size_t w = 0; w < 4; ++w)
+			weights[w] /= total;
+	}
+	buf->unlock();
+	return data;
+}
+//--------------------------------------------------------------------------
+/// Checks that two targets hold the same positions and normals
+static void checkSameVertices(VertexData* expected, VertexData* actual)
+{
+	HardwareVertexBufferSharedPtr expectedBuf = expected->vertexBufferBinding->getBuffer(0);
+	HardwareVertexBufferSharedPtr actualBuf = actual->vertexBufferBinding->getBuffer(0);
+	const float* e = static_cast<const float*>(expectedBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+	const float* a = static_cast<const float*>(actualBuf->lock(HardwareBuffer::HBL_READ_ONLY));
+	for (size_t i = 0; i < NUM_VERTICES * 6; ++i)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(e[i], a[i], 1e-5);
+	actualBuf->unlock();
+	expectedBuf->unlock();
+}
+//--------------------------------------------------------------------------
+void SoftwareVertexBlendBatchTests::setUp()
+{
+	UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+	// Same data on every run, so that failures reproduce
+	srand(0);
+
+	// The root provides the work queue used by parallel batches
+	mRoot = OGRE_NEW Root(StringUtil::BLANK);
+	mBufferManager = OGRE_NEW DefaultHardwareBufferManager();
+
+	// Rigid bone transforms, as dual quaternions do not support scale
+	mMatrices.resize(NUM_BONES);
+	mDualQuaternions.resize(NUM_BONES);
+	mBlendMatrices.resize(NUM_BONES);
+	mBlendDualQuaternions.resize(NUM_BONES);
+	for (size_t b = 0; b < NUM_BONES; ++b)
+	{
+		Quaternion q(Radian(Math::RangeRandom(-Math::PI, Math::PI)),
+			randomBlendVector(1).normalisedCopy());
+		mMatrices[b].makeTransform(randomBlendVector(2), Vector3::UNIT_SCALE, q);
+		mDualQuaternions[b].fromTransformationMatrix(mMatrices[b]);
+		mBlendMatrices[b] = &mMatrices[b];
+		mBlendDualQuaternions[b] = &mDualQuaternions[b];
+	}
+
+	for (size_t s = 0; s < NUM_SOURCES; ++s)
+	{
+		mSources.push_back(createBlendVertexData(true));
+		size_t numBlends = s < NUM_SHARED_SOURCES ? 2 : 1;
+		for (size_t i = 0; i < numBlends * 2; ++i)
+			mTargets.push_back(createBlendVertexData(false));
+	}
+}
+//--------------------------------------------------------------------------
+void SoftwareVertexBlendBatchTests::tearDown()
+{
+	for (size_t i = 0; i < mTargets.size(); ++i)
+		OGRE_DELETE mTargets[i];
+	for (size_t i = 0; i < mSources.size(); ++i)
+		OGRE_DELETE mSources[i];
+	mTargets.clear();
+	mSources.clear();
+	OGRE_DELETE mRoot;
+	OGRE_DELETE mBufferManager;
+}
+//--------------------------------------------------------------------------
+void SoftwareVertexBlendBatchTests::checkBatch(bool parallel)
+{
+	SoftwareVertexBlendBatch batch;
+	for (size_t s = 0, t = 0; s < mSources.size(); ++s)
+	{
+		size_t numBlends = s < NUM_SHARED_SOURCES ? 2 : 1;
+		for (size_t i = 0; i < numBlends; ++i, t += 2)
+		{
+			// Alternate matrices and dual quaternions, with and without normals
+			bool blendNormals = (s + i) % 3 != 2;
+			if ((s + i) % 2)
+			{
+				Mesh::softwareVertexBlend(mSources[s], mTargets[t],
+					&mBlendDualQuaternions[0], NUM_BONES, blendNormals);
+				batch.add(mSources[s], mTargets[t + 1],
+					&mBlendDualQuaternions[0], NUM_BONES, blendNormals);
+			}
+			else
+			{
+				Mesh::softwareVertexBlend(mSources[s], mTargets[t],
+					&mBlendMatrices[0], NUM_BONES, blendNormals);
+				batch.add(mSources[s], mTargets[t + 1],
+					&mBlendMatrices[0], NUM_BONES, blendNormals);
+			}
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL(mTargets.size() / 2, batch.getNumBlends());
+
+	batch.execute(parallel);
+	CPPUNIT_ASSERT(batch.empty());
+	for (size_t t = 0; t < mTargets.size(); t += 2)
+		checkSameVertices(mTargets[t], mTargets[t + 1]);
+}
+//--------------------------------------------------------------------------
+void SoftwareVertexBlendBatchTests::testSerialMatchesImmediate()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	checkBatch(false);
+}
+//--------------------------------------------------------------------------
+void SoftwareVertexBlendBatchTests::testParallelMatchesImmediate()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	checkBatch(true);
+}
+//--------------------------------------------------------------------------
+void SoftwareVertexBlendBatchTests::testClear()
+{
+	UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+	// Blends cleared are not performed, nor kept for the next execute
+	SoftwareVertexBlendBatch batch;
+	batch.add(mSources[0], mTargets[1], &mBlendMatrices[0], NUM_BONES, true);
+	batch.clear();
+	CPPUNIT_ASSERT(batch.empty());
+	batch.execute(true);
+
+	checkSameVertices(mTargets[0], mTargets[1]);
+}
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "ZipArchiveTests.h"
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreZip.h"
+#include "OgreMappedZip.h"
 #include "OgreCommon.h"
 
 #include "UnitTestSuite.h"
@@ -382,3 +383,142 @@ void ZipArchiveTests::testReadInterleave()
     OGRE_DELETE arch;
 }
 //--------------------------------------------------------------------------
+void ZipArchiveTests::testMappedList()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    MappedZipArchive* arch = OGRE_NEW MappedZipArchive(mTestPath, "MappedZip");
+    try {
+        arch->load();
+    } catch (Ogre::Exception e) {
+        // If it starts in build/bin/debug
+        OGRE_DELETE arch;
+        arch = OGRE_NEW MappedZipArchive("../../../" + mTestPath, "MappedZip");
+        arch->load();
+    }
+
+    // Same results as ZipArchive
+    StringVectorPtr vec = arch->list(false);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("rootfile.txt"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(1));
+
+    vec = arch->list(true);
+    CPPUNIT_ASSERT_EQUAL((size_t)6, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("file.material"), vec->at(0));
+    CPPUNIT_ASSERT_EQUAL(String("file4.material"), vec->at(3));
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(5));
+
+    FileInfoListPtr fil = arch->listFileInfo(true, true);
+    CPPUNIT_ASSERT_EQUAL((size_t)6, fil->size());
+    CPPUNIT_ASSERT_EQUAL(String("level1"), fil->at(0).filename);
+    CPPUNIT_ASSERT_EQUAL(String("level1/materials/"), fil->at(2).path);
+    CPPUNIT_ASSERT_EQUAL(String("scripts"), fil->at(2).basename);
+
+    OGRE_DELETE arch;
+}
+//--------------------------------------------------------------------------
+void ZipArchiveTests::testMappedFindFileInfo()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    MappedZipArchive* arch = OGRE_NEW MappedZipArchive(mTestPath, "MappedZip");
+    try {
+        arch->load();
+    } catch (Ogre::Exception e) {
+        // If it starts in build/bin/debug
+        OGRE_DELETE arch;
+        arch = OGRE_NEW MappedZipArchive("../../../" + mTestPath, "MappedZip");
+        arch->load();
+    }
+
+    // Looked up in the index
+    FileInfoListPtr vec = arch->findFileInfo("ROOTFILE2.txt");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("rootfile2.txt"), vec->at(0).filename);
+    CPPUNIT_ASSERT_EQUAL(StringUtil::BLANK, vec->at(0).path);
+    CPPUNIT_ASSERT_EQUAL((size_t)45, vec->at(0).compressedSize);
+    CPPUNIT_ASSERT_EQUAL((size_t)156, vec->at(0).uncompressedSize);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, arch->findFileInfo("missing.txt")->size());
+
+    vec = arch->findFileInfo("file3.material");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("level2/materials/scripts/"), vec->at(0).path);
+
+    vec = arch->findFileInfo("*.material", true);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, vec->size());
+    CPPUNIT_ASSERT_EQUAL(String("file2.material"), vec->at(1).filename);
+
+    CPPUNIT_ASSERT(arch->exists("file4.material"));
+    CPPUNIT_ASSERT(arch->exists("level1/rootfile.txt"));
+    CPPUNIT_ASSERT(!arch->exists("missing.txt"));
+
+    OGRE_DELETE arch;
+}
+//--------------------------------------------------------------------------
+void ZipArchiveTests::testMappedReadInterleave()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    MappedZipArchive* arch = OGRE_NEW MappedZipArchive(mTestPath, "MappedZip");
+    try {
+        arch->load();
+    } catch (Ogre::Exception e) {
+        // If it starts in build/bin/debug
+        OGRE_DELETE arch;
+        arch = OGRE_NEW MappedZipArchive("../../../" + mTestPath, "MappedZip");
+        arch->load();
+    }
+
+    DataStreamPtr stream1 = arch->open("rootfile.txt");
+    DataStreamPtr stream2 = arch->open("rootfile2.txt");
+    CPPUNIT_ASSERT_EQUAL((size_t)130, stream1->size());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream1->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 2"), stream2->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), stream1->getLine());
+
+    // Streams outlive the archive
+    arch->unload();
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 1"), stream1->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 2"), stream2->getLine());
+
+    // Stored file in a folder, opened by path
+    arch->load();
+    DataStreamPtr stream3 = arch->open("level1/materials/scripts/file.material");
+    CPPUNIT_ASSERT(!stream3.isNull());
+    CPPUNIT_ASSERT_EQUAL((size_t)0, stream3->size());
+    CPPUNIT_ASSERT(stream3->eof());
+
+    OGRE_DELETE arch;
+}
+//--------------------------------------------------------------------------
+void ZipArchiveTests::testMappedOpenMultiple()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    MappedZipArchive* arch = OGRE_NEW MappedZipArchive(mTestPath, "MappedZip");
+    try {
+        arch->load();
+    } catch (Ogre::Exception e) {
+        // If it starts in build/bin/debug
+        OGRE_DELETE arch;
+        arch = OGRE_NEW MappedZipArchive("../../../" + mTestPath, "MappedZip");
+        arch->load();
+    }
+
+    StringVector names;
+    names.push_back("rootfile2.txt");
+    names.push_back("missing.txt");
+    names.push_back("rootfile.txt");
+    vector<DataStreamPtr>::type streams;
+    arch->openMultiple(names, streams);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)3, streams.size());
+    CPPUNIT_ASSERT(streams[1].isNull());
+    CPPUNIT_ASSERT_EQUAL((size_t)156, streams[0]->size());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 2"), streams[0]->getLine());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), streams[2]->getLine());
+
+    OGRE_DELETE arch;
+}
+//--------------------------------------------------------------------------
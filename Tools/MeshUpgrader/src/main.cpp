@@ -67,7 +67,7 @@ void help(void)
 	cout << "-E endian  = Set endian mode 'big' 'little' or 'native' (default)" << endl;
 	cout << "-b         = Recalculate bounding box (static meshes only)" << endl;
 	cout << "-V version = Specify OGRE version format to write instead of latest" << endl;
-	cout << "             Options are: 1.8, 1.7, 1.4, 1.0" << endl;
+	cout << "             Options are: 1.8, 1.7, 1.4, 1.0, baked" << endl;
     cout << "sourcefile = name of file to convert" << endl;
     cout << "destfile   = optional name of file to write to. If you don't" << endl;
     cout << "             specify this OGRE overwrites the existing file." << endl;
@@ -246,6 +246,8 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
 			opts.targetVersion = MESH_VERSION_1_4;
 		else if (bi->second == "1.0")
 			opts.targetVersion = MESH_VERSION_1_0;
+		else if (bi->second == "baked")
+			opts.targetVersion = MESH_VERSION_BAKED;
 		else
 			logMgr->stream() << "Unrecognised target mesh version '" << bi->second << "'";			
 	}
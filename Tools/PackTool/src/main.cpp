@@ -0,0 +1,357 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+
+#include "Ogre.h"
+#include "OgreFileSystem.h"
+#include "OgrePackArchive.h"
+
+#include <iostream>
+#include <fstream>
+
+using namespace std;
+using namespace Ogre;
+
+void help(void)
+{
+	// Print help message
+	cout << endl << "OgrePackTool: Packs a folder into a .pack file for the Pack archive type." << endl;
+	cout << endl;
+	cout << "Usage: OgrePackTool [opts] sourcefolder destfile" << endl;
+	cout << "-s           = Store files without compressing them" << endl;
+	cout << "-a alignment = Alignment of the file data in bytes (default 4096)" << endl;
+	cout << "sourcefolder = folder whose files, including those in subfolders, are packed" << endl;
+	cout << "destfile     = name of the pack to write" << endl;
+	cout << endl;
+}
+
+struct PackOptions
+{
+	bool store;
+	uint32 alignment;
+};
+
+/// A file to pack
+struct PackEntry
+{
+	String name;
+	/// Name used to sort the index, see PackArchive
+	String sortName;
+	uint64 offset;
+	uint32 compressedSize;
+	uint32 uncompressedSize;
+	uchar method;
+
+	/// Strings compare bytes as unsigned, as PackArchive does
+	bool operator<(const PackEntry& rhs) const { return sortName < rhs.sortName; }
+};
+
+PackOptions parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
+{
+	PackOptions opts;
+	opts.store = unOpts["-s"];
+	opts.alignment = 4096;
+
+	BinaryOptionList::iterator bi = binOpts.find("-a");
+	if (!bi->second.empty())
+	{
+		opts.alignment = StringConverter::parseUnsignedInt(bi->second);
+		if (opts.alignment == 0 || (opts.alignment & (opts.alignment - 1)) != 0)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"The alignment must be a power of two", "parseOpts");
+		}
+	}
+
+	return opts;
+}
+
+/// Writes the bytes extending a literal or match length of a LZ4 sequence
+void writeLZ4Length(std::vector<uchar>& dest, size_t length)
+{
+	for (; length >= 255; length -= 255)
+		dest.push_back(255);
+	dest.push_back(static_cast<uchar>(length));
+}
+
+/** Compresses data in the LZ4 block format read by PackArchive::decompressLZ4.
+@remarks
+	Greedy parsing with a single hash table, which compresses fast enough for
+	an offline tool; the decompression speed does not depend on it.
+*/
+void compressLZ4(const uchar* src, size_t size, std::vector<uchar>& dest)
+{
+	// Rules of the format: matches are at least 4 bytes long, the last 5
+	// bytes are always literals and the last match starts at least 12 bytes
+	// before the end
+	const size_t MIN_MATCH = 4;
+	const size_t LAST_LITERALS = 5;
+	const size_t MATCH_FIND_LIMIT = 12;
+	const size_t MAX_OFFSET = 65535;
+	const uint HASH_BITS = 16;
+
+	dest.clear();
+	dest.reserve(size + size / 255 + 16);
+
+	std::vector<size_t> table(1 << HASH_BITS, ~(size_t)0);
+	size_t anchor = 0;
+	size_t pos = 0;
+
+	if (size > MATCH_FIND_LIMIT)
+	{
+		size_t matchLimit = size - LAST_LITERALS;
+		size_t posLimit = size - MATCH_FIND_LIMIT;
+		while (pos < posLimit)
+		{
+			uint32 sequence;
+			memcpy(&sequence, src + pos, sizeof(sequence));
+			uint32 hash = (sequence * 2654435761U) >> (32 - HASH_BITS);
+			size_t candidate = table[hash];
+			table[hash] = pos;
+
+			if (candidate == ~(size_t)0 || pos - candidate > MAX_OFFSET ||
+				memcmp(src + candidate, src + pos, MIN_MATCH) != 0)
+			{
+				++pos;
+				continue;
+			}
+
+			size_t matchLength = MIN_MATCH;
+			while (pos + matchLength < matchLimit && src[candidate + matchLength] == src[pos + matchLength])
+				++matchLength;
+
+			size_t literalLength = pos - anchor;
+			size_t extraMatch = matchLength - MIN_MATCH;
+			dest.push_back(static_cast<uchar>((std::min(literalLength, (size_t)15) << 4) |
+				std::min(extraMatch, (size_t)15)));
+			if (literalLength >= 15)
+				writeLZ4Length(dest, literalLength - 15);
+			dest.insert(dest.end(), src + anchor, src + pos);
+			size_t offset = pos - candidate;
+			dest.push_back(static_cast<uchar>(offset & 0xFF));
+			dest.push_back(static_cast<uchar>(offset >> 8));
+			if (extraMatch >= 15)
+				writeLZ4Length(dest, extraMatch - 15);
+
+			pos += matchLength;
+			anchor = pos;
+		}
+	}
+
+	// Last literals
+	size_t literalLength = size - anchor;
+	dest.push_back(static_cast<uchar>(std::min(literalLength, (size_t)15) << 4));
+	if (literalLength >= 15)
+		writeLZ4Length(dest, literalLength - 15);
+	dest.insert(dest.end(), src + anchor, src + size);
+}
+
+void writeUInt16(ofstream& out, uint16 value)
+{
+	uchar bytes[2] = { uchar(value), uchar(value >> 8) };
+	out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+void writeUInt32(ofstream& out, uint32 value)
+{
+	uchar bytes[4] = { uchar(value), uchar(value >> 8), uchar(value >> 16), uchar(value >> 24) };
+	out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+void writeUInt64(ofstream& out, uint64 value)
+{
+	writeUInt32(out, static_cast<uint32>(value));
+	writeUInt32(out, static_cast<uint32>(value >> 32));
+}
+
+void writePadding(ofstream& out, uint32 alignment)
+{
+	uint64 pos = static_cast<uint64>(out.tellp());
+	uint64 padding = (alignment - pos % alignment) % alignment;
+	for (uint64 i = 0; i < padding; ++i)
+		out.put(0);
+}
+
+void pack(const String& source, const String& dest, const PackOptions& opts)
+{
+	FileSystemArchive folder(source, "FileSystem", true);
+	folder.load();
+	FileInfoListPtr files = folder.listFileInfo(true);
+
+	std::vector<PackEntry> entries;
+	entries.reserve(files->size());
+	for (FileInfoList::iterator i = files->begin(); i != files->end(); ++i)
+	{
+		PackEntry entry;
+		entry.name = i->filename;
+		entry.sortName = entry.name;
+		for (String::iterator c = entry.sortName.begin(); c != entry.sortName.end(); ++c)
+			*c = (*c >= 'A' && *c <= 'Z') ? static_cast<char>(*c + ('a' - 'A')) : *c;
+		entries.push_back(entry);
+	}
+	std::sort(entries.begin(), entries.end());
+	for (size_t i = 1; i < entries.size(); ++i)
+	{
+		if (entries[i].sortName == entries[i - 1].sortName)
+		{
+			OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
+				entries[i - 1].name + " and " + entries[i].name + " only differ by case",
+				"pack");
+		}
+	}
+
+	ofstream out(dest.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!out)
+	{
+		OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+			"Cannot open " + dest + " for writing", "pack");
+	}
+
+	// Header, written again once the index offset is known
+	for (size_t i = 0; i < PackArchive::HEADER_SIZE; ++i)
+		out.put(0);
+
+	uint64 totalSize = 0;
+	size_t numCompressed = 0;
+	std::vector<uchar> compressed;
+	for (std::vector<PackEntry>::iterator i = entries.begin(); i != entries.end(); ++i)
+	{
+		DataStreamPtr stream = folder.open(i->name);
+		MemoryDataStream data(stream);
+		if (data.size() > 0xFFFFFFFF)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				i->name + " is too large to be packed", "pack");
+		}
+
+		// Only keep the compressed data when it is smaller
+		i->method = PackArchive::PC_STORED;
+		const uchar* fileData = data.getPtr();
+		i->uncompressedSize = static_cast<uint32>(data.size());
+		i->compressedSize = i->uncompressedSize;
+		if (!opts.store && data.size() > 0)
+		{
+			compressLZ4(data.getPtr(), data.size(), compressed);
+			if (compressed.size() < data.size())
+			{
+				std::vector<uchar> check(data.size());
+				if (!PackArchive::decompressLZ4(&compressed[0], compressed.size(), &check[0], check.size()) ||
+					memcmp(&check[0], data.getPtr(), data.size()) != 0)
+				{
+					OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+						"Compression of " + i->name + " failed", "pack");
+				}
+				i->method = PackArchive::PC_LZ4;
+				i->compressedSize = static_cast<uint32>(compressed.size());
+				fileData = &compressed[0];
+				++numCompressed;
+			}
+		}
+
+		writePadding(out, opts.alignment);
+		i->offset = static_cast<uint64>(out.tellp());
+		out.write(reinterpret_cast<const char*>(fileData), i->compressedSize);
+		totalSize += i->uncompressedSize;
+	}
+
+	// Index, sorted records followed by the names
+	uint64 indexOffset = static_cast<uint64>(out.tellp());
+	uint32 nameOffset = 0;
+	for (std::vector<PackEntry>::iterator i = entries.begin(); i != entries.end(); ++i)
+	{
+		writeUInt64(out, i->offset);
+		writeUInt32(out, i->compressedSize);
+		writeUInt32(out, i->uncompressedSize);
+		writeUInt32(out, nameOffset);
+		writeUInt16(out, static_cast<uint16>(i->name.length()));
+		out.put(static_cast<char>(i->method));
+		out.put(0);
+		nameOffset += static_cast<uint32>(i->name.length());
+	}
+	for (std::vector<PackEntry>::iterator i = entries.begin(); i != entries.end(); ++i)
+		out.write(i->name.data(), i->name.length());
+	uint64 packSize = static_cast<uint64>(out.tellp());
+
+	out.seekp(0);
+	out.write("OGREPACK", 8);
+	writeUInt32(out, PackArchive::PACK_VERSION);
+	writeUInt32(out, opts.alignment);
+	writeUInt32(out, static_cast<uint32>(entries.size()));
+	writeUInt32(out, static_cast<uint32>(packSize - indexOffset));
+	writeUInt64(out, indexOffset);
+	out.close();
+	if (out.fail())
+	{
+		OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+			"Error while writing " + dest, "pack");
+	}
+
+	cout << "Packed " << entries.size() << " files (" << numCompressed << " compressed), "
+		<< totalSize << " bytes into " << packSize << " bytes" << endl;
+}
+
+int main(int numargs, char** args)
+{
+	if (numargs < 3)
+	{
+		help();
+		return -1;
+	}
+
+	LogManager* logMgr = new LogManager();
+	logMgr->createLog("OgrePackTool.log", true, false);
+
+	int retCode = 0;
+	try
+	{
+		UnaryOptionList unOptList;
+		BinaryOptionList binOptList;
+		unOptList["-s"] = false;
+		binOptList["-a"] = "";
+
+		int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+		if (numargs - startIdx < 2)
+		{
+			help();
+			delete logMgr;
+			return -1;
+		}
+		PackOptions opts = parseOpts(unOptList, binOptList);
+
+		pack(args[startIdx], args[startIdx + 1], opts);
+	}
+	catch (Exception& e)
+	{
+		cout << "Exception caught: " << e.getDescription() << endl;
+		retCode = 1;
+	}
+
+	delete logMgr;
+
+	return retCode;
+}